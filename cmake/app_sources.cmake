@@ -0,0 +1,79 @@
+# Application modules shared by the firmware and the Zephyr test apps.
+# Everything except src/main.cpp, so tests can provide their own main().
+set(APP_SRC_DIR ${CMAKE_CURRENT_LIST_DIR}/../src)
+set(APP_DRIVERS_DIR ${CMAKE_CURRENT_LIST_DIR}/../drivers)
+
+set(APP_LIB_SOURCES
+  ${APP_SRC_DIR}/sim_wheel.cpp
+  ${APP_SRC_DIR}/rx_handler.cpp
+  ${APP_SRC_DIR}/diagnostics.cpp
+  ${APP_SRC_DIR}/car_profiles.cpp
+)
+
+if(CONFIG_APP_LOG_BACKEND_CAN)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/log_backend_can.cpp)
+endif()
+
+if(CONFIG_APP_BLACKBOX)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/blackbox.cpp)
+endif()
+
+if(CONFIG_APP_SESSION_LOG)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/session_log.cpp)
+endif()
+
+if(CONFIG_APP_TRACE_REPLAY)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/trace_replay.cpp)
+  get_filename_component(APP_TRACE_FILE ${CONFIG_APP_TRACE_REPLAY_FILE}
+                         ABSOLUTE BASE_DIR ${CMAKE_CURRENT_LIST_DIR}/..)
+  generate_inc_file_for_target(app ${APP_TRACE_FILE}
+    ${ZEPHYR_BINARY_DIR}/include/generated/replay_trace.inc)
+endif()
+
+if(CONFIG_APP_RIG_SIM)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/rig_sim.cpp)
+endif()
+
+if(CONFIG_APP_CAN_NM)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/network_mgmt.cpp)
+endif()
+
+if(CONFIG_APP_LIVENESS)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/liveness.cpp)
+endif()
+
+if(CONFIG_APP_SECOC)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/secoc.cpp)
+endif()
+
+if(CONFIG_APP_SNIFFER)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/sniffer.cpp)
+endif()
+
+if(CONFIG_APP_RX_SUBSCRIPTIONS)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/subscriptions.cpp)
+endif()
+
+if(CONFIG_APP_CRASH_RING)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/crash_ring.cpp)
+endif()
+
+if(CONFIG_APP_SIGNAL_AGG)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/signal_agg.cpp)
+endif()
+
+if(CONFIG_APP_CAN_REDUNDANCY)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/redundancy.cpp)
+endif()
+
+if(CONFIG_APP_SLCAN)
+  list(APPEND APP_LIB_SOURCES ${APP_SRC_DIR}/slcan.cpp)
+endif()
+
+if(CONFIG_APP_CAN_FAULT)
+  list(APPEND APP_LIB_SOURCES ${APP_DRIVERS_DIR}/can/can_fault.cpp)
+endif()
+
+if(CONFIG_APP_CAN_VBUS)
+  list(APPEND APP_LIB_SOURCES ${APP_DRIVERS_DIR}/can/can_vbus.cpp)
+endif()
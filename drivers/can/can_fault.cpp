@@ -0,0 +1,701 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Fault-injection CAN controller
+ *
+ * Wraps another CAN controller and decides, per transmitted frame, whether
+ * to drop, delay, duplicate or corrupt it, to report a full TX mailbox, or
+ * to take the controller bus-off. Faults are injected on transmit so that
+ * every receiver on the (loopback) bus sees the same wire. RX filters and
+ * state changes are forwarded with this device as the reported source;
+ * TX callbacks come from the underlying controller unchanged.
+ */
+
+#define DT_DRV_COMPAT simrig_can_fault
+
+#include "can_fault.hpp"
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/spinlock.h>
+
+#include <cstdlib>
+#include <cstring>
+
+LOG_MODULE_REGISTER(can_fault, CONFIG_CAN_LOG_LEVEL);
+
+namespace {
+
+struct DelayedFrame {
+  struct can_frame frame;
+  int64_t due_ms;
+  can_tx_callback_t callback;
+  void* user_data;
+  bool used;
+};
+
+struct RxSlot {
+  const struct device* dev;
+  can_rx_callback_t callback;
+  void* user_data;
+  int lower_id;
+  bool used;
+};
+
+}  // namespace
+
+struct can_fault_config {
+  struct can_driver_config common;
+  const struct device* lower;
+  uint32_t seed;
+  uint16_t permille[FAULT_KIND_COUNT];  // Indexed by FaultKind
+  uint16_t delay_ms;
+  uint16_t bus_off_ms;
+};
+
+struct can_fault_data {
+  struct can_driver_data common;
+  const struct device* dev;
+  struct k_spinlock lock;
+  FaultPlan plan;
+  CanFaultStats stats;
+  bool bus_off;
+  DelayedFrame delayed[CONFIG_APP_CAN_FAULT_MAX_DELAYED];
+  RxSlot rx[CONFIG_APP_CAN_FAULT_MAX_FILTERS];
+  struct k_work_delayable delay_work;
+  struct k_work_delayable recover_work;
+};
+
+namespace {
+
+const struct device* lower_of(const struct device* dev) {
+  return static_cast<const struct can_fault_config*>(dev->config)->lower;
+}
+
+struct can_fault_data* data_of(const struct device* dev) {
+  return static_cast<struct can_fault_data*>(dev->data);
+}
+
+void notify_state(const struct device* dev, enum can_state state) {
+  struct can_fault_data* data = data_of(dev);
+  can_state_change_callback_t cb = data->common.state_change_cb;
+  struct can_bus_err_cnt err_cnt = {};
+
+  if (state == CAN_STATE_BUS_OFF) {
+    err_cnt.tx_err_cnt = 255;
+  }
+  if (cb != NULL) {
+    cb(dev, state, err_cnt, data->common.state_change_cb_user_data);
+  }
+}
+
+void enter_bus_off(const struct device* dev, uint32_t duration_ms) {
+  struct can_fault_data* data = data_of(dev);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  bool was_bus_off = data->bus_off;
+
+  data->bus_off = true;
+  k_spin_unlock(&data->lock, key);
+
+  if (!was_bus_off) {
+    notify_state(dev, CAN_STATE_BUS_OFF);
+  }
+#if defined(CONFIG_CAN_MANUAL_RECOVERY_MODE)
+  if ((data->common.mode & CAN_MODE_MANUAL_RECOVERY) != 0) {
+    return;  // Stays bus-off until can_recover()
+  }
+#endif
+  k_work_reschedule(&data->recover_work, K_MSEC(duration_ms));
+}
+
+void leave_bus_off(const struct device* dev) {
+  struct can_fault_data* data = data_of(dev);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  bool was_bus_off = data->bus_off;
+
+  data->bus_off = false;
+  k_spin_unlock(&data->lock, key);
+
+  if (was_bus_off) {
+    notify_state(dev, CAN_STATE_ERROR_ACTIVE);
+  }
+}
+
+void recover_work_handler(struct k_work* work) {
+  struct k_work_delayable* dwork = k_work_delayable_from_work(work);
+  struct can_fault_data* data =
+      CONTAINER_OF(dwork, struct can_fault_data, recover_work);
+
+  leave_bus_off(data->dev);
+}
+
+/* Sends every due delayed frame and re-arms for the next one. The sender's
+ * callback only runs once the lower controller is done with the frame, so
+ * a blocking can_send() (NULL callback) stalls for the whole delay. */
+void delay_work_handler(struct k_work* work) {
+  struct k_work_delayable* dwork = k_work_delayable_from_work(work);
+  struct can_fault_data* data =
+      CONTAINER_OF(dwork, struct can_fault_data, delay_work);
+  const struct device* lower = lower_of(data->dev);
+  int64_t now = k_uptime_get();
+  int64_t next_due = INT64_MAX;
+
+  for (DelayedFrame& entry : data->delayed) {
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    if (!entry.used) {
+      k_spin_unlock(&data->lock, key);
+      continue;
+    }
+    if (entry.due_ms > now) {
+      next_due = MIN(next_due, entry.due_ms);
+      k_spin_unlock(&data->lock, key);
+      continue;
+    }
+
+    DelayedFrame due = entry;
+    entry.used = false;
+    k_spin_unlock(&data->lock, key);
+
+    int ret = can_send(lower, &due.frame, K_NO_WAIT, due.callback,
+                       due.user_data);
+    if (ret != 0) {
+      due.callback(data->dev, ret, due.user_data);
+    }
+  }
+
+  if (next_due != INT64_MAX) {
+    k_work_reschedule(dwork, K_TIMEOUT_ABS_MS(next_due));
+  }
+}
+
+/* @return false if the pool is full */
+bool schedule_delayed(struct can_fault_data* data,
+                      const struct can_frame* frame, uint32_t delay_ms,
+                      can_tx_callback_t callback, void* user_data) {
+  int64_t due = k_uptime_get() + delay_ms;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  for (DelayedFrame& entry : data->delayed) {
+    if (!entry.used) {
+      entry = {.frame = *frame,
+               .due_ms = due,
+               .callback = callback,
+               .user_data = user_data,
+               .used = true};
+      k_spin_unlock(&data->lock, key);
+
+      /* Never pushes an earlier pending run back */
+      if (!k_work_delayable_is_pending(&data->delay_work) ||
+          k_work_delayable_remaining_get(&data->delay_work) >
+              k_ms_to_ticks_ceil32(delay_ms)) {
+        k_work_reschedule(&data->delay_work, K_MSEC(delay_ms));
+      }
+      return true;
+    }
+  }
+  k_spin_unlock(&data->lock, key);
+  return false;
+}
+
+void discard_tx_done(const struct device* dev, int error, void* user_data) {}
+
+/* Reads the slot under the lock, so a concurrent removal never has a stale
+ * callback called */
+void rx_forward(const struct device* lower, struct can_frame* frame,
+                void* user_data) {
+  RxSlot* slot = static_cast<RxSlot*>(user_data);
+  struct can_fault_data* data = data_of(slot->dev);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  RxSlot copy = *slot;
+
+  k_spin_unlock(&data->lock, key);
+
+  if (copy.used && copy.callback != NULL) {
+    copy.callback(copy.dev, frame, copy.user_data);
+  }
+}
+
+void lower_state_changed(const struct device* lower, enum can_state state,
+                         struct can_bus_err_cnt err_cnt, void* user_data) {
+  const struct device* dev = static_cast<const struct device*>(user_data);
+  struct can_fault_data* data = data_of(dev);
+  can_state_change_callback_t cb = data->common.state_change_cb;
+
+  /* An injected bus-off masks the real controller state */
+  if (cb != NULL && !data->bus_off) {
+    cb(dev, state, err_cnt, data->common.state_change_cb_user_data);
+  }
+}
+
+/* --------------------------------------------------------------------- */
+/* CAN driver API                                                         */
+/* --------------------------------------------------------------------- */
+
+int can_fault_get_capabilities(const struct device* dev, can_mode_t* cap) {
+  return can_get_capabilities(lower_of(dev), cap);
+}
+
+int can_fault_start(const struct device* dev) {
+  struct can_fault_data* data = data_of(dev);
+
+  if (data->common.started) {
+    return -EALREADY;
+  }
+
+  int ret = can_start(lower_of(dev));
+  if (ret != 0 && ret != -EALREADY) {
+    return ret;
+  }
+  data->common.started = true;
+  return 0;
+}
+
+int can_fault_stop(const struct device* dev) {
+  struct can_fault_data* data = data_of(dev);
+
+  if (!data->common.started) {
+    return -EALREADY;
+  }
+
+  int ret = can_stop(lower_of(dev));
+  if (ret != 0 && ret != -EALREADY) {
+    return ret;
+  }
+  data->common.started = false;
+  return 0;
+}
+
+int can_fault_set_mode(const struct device* dev, can_mode_t mode) {
+  struct can_fault_data* data = data_of(dev);
+  can_mode_t lower_mode = mode;
+
+#if defined(CONFIG_CAN_MANUAL_RECOVERY_MODE)
+  /* Recovery of injected bus-off is handled here */
+  lower_mode &= ~CAN_MODE_MANUAL_RECOVERY;
+#endif
+  int ret = can_set_mode(lower_of(dev), lower_mode);
+  if (ret == 0) {
+    data->common.mode = mode;
+  }
+  return ret;
+}
+
+int can_fault_set_timing(const struct device* dev,
+                         const struct can_timing* timing) {
+  return can_set_timing(lower_of(dev), timing);
+}
+
+int can_fault_send(const struct device* dev, const struct can_frame* frame,
+                   k_timeout_t timeout, can_tx_callback_t callback,
+                   void* user_data) {
+  struct can_fault_data* data = data_of(dev);
+  const struct device* lower = lower_of(dev);
+  struct can_frame copy;
+
+  if (!data->common.started) {
+    return -ENETDOWN;
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  bool bus_off = data->bus_off;
+  FaultAction action = {FaultKind::None, 0};
+
+  data->stats.frames++;
+  if (!bus_off) {
+    action = data->plan.next(frame->dlc);
+    data->stats.injected[static_cast<size_t>(action.kind)]++;
+  }
+  k_spin_unlock(&data->lock, key);
+
+  if (bus_off) {
+    return -ENETUNREACH;
+  }
+
+  switch (action.kind) {
+    case FaultKind::Drop:
+      /* Acknowledged on the wire, lost before any receiver */
+      callback(dev, 0, user_data);
+      return 0;
+
+    case FaultKind::Delay:
+      /* Completes late: a blocking sender waits out the delay too */
+      if (schedule_delayed(data, frame, action.arg, callback, user_data)) {
+        return 0;
+      }
+      key = k_spin_lock(&data->lock);
+      data->stats.delay_overflows++;
+      k_spin_unlock(&data->lock, key);
+      break;
+
+    case FaultKind::Duplicate: {
+      int ret = can_send(lower, frame, timeout, callback, user_data);
+      if (ret == 0) {
+        (void)can_send(lower, frame, K_NO_WAIT, discard_tx_done, NULL);
+      }
+      return ret;
+    }
+
+    case FaultKind::Corrupt:
+      copy = *frame;
+      copy.data[action.arg / 8] ^= BIT(action.arg % 8);
+      return can_send(lower, &copy, timeout, callback, user_data);
+
+    case FaultKind::MailboxFull:
+      /* As if no mailbox freed up within the timeout */
+      return -EAGAIN;
+
+    case FaultKind::BusOff:
+      enter_bus_off(dev, action.arg);
+      return -ENETUNREACH;
+
+    case FaultKind::None:
+      break;
+  }
+
+  return can_send(lower, frame, timeout, callback, user_data);
+}
+
+int can_fault_add_rx_filter(const struct device* dev, can_rx_callback_t cb,
+                            void* user_data, const struct can_filter* filter) {
+  struct can_fault_data* data = data_of(dev);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  int id = -ENOSPC;
+
+  for (size_t i = 0; i < ARRAY_SIZE(data->rx); i++) {
+    if (!data->rx[i].used) {
+      data->rx[i] = {.dev = dev,
+                     .callback = cb,
+                     .user_data = user_data,
+                     .lower_id = -1,
+                     .used = true};
+      id = static_cast<int>(i);
+      break;
+    }
+  }
+  k_spin_unlock(&data->lock, key);
+
+  if (id < 0) {
+    return id;
+  }
+
+  int lower_id =
+      can_add_rx_filter(lower_of(dev), rx_forward, &data->rx[id], filter);
+
+  key = k_spin_lock(&data->lock);
+  if (lower_id < 0) {
+    data->rx[id].used = false;
+  } else {
+    data->rx[id].lower_id = lower_id;
+  }
+  k_spin_unlock(&data->lock, key);
+  return (lower_id < 0) ? lower_id : id;
+}
+
+void can_fault_remove_rx_filter(const struct device* dev, int filter_id) {
+  struct can_fault_data* data = data_of(dev);
+
+  if (filter_id < 0 || filter_id >= static_cast<int>(ARRAY_SIZE(data->rx))) {
+    return;
+  }
+
+  /* Silence the slot first, but keep it reserved until the lower filter
+   * is gone, so a new filter cannot reuse it while frames still arrive */
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  RxSlot& slot = data->rx[filter_id];
+  int lower_id = slot.lower_id;
+  bool used = slot.used && slot.callback != NULL;
+
+  slot.callback = NULL;
+  k_spin_unlock(&data->lock, key);
+
+  if (!used) {
+    return;
+  }
+  can_remove_rx_filter(lower_of(dev), lower_id);
+
+  key = k_spin_lock(&data->lock);
+  slot.used = false;
+  slot.lower_id = -1;
+  k_spin_unlock(&data->lock, key);
+}
+
+#if defined(CONFIG_CAN_MANUAL_RECOVERY_MODE)
+int can_fault_recover(const struct device* dev, k_timeout_t timeout) {
+  struct can_fault_data* data = data_of(dev);
+
+  if (!data->common.started) {
+    return -ENETDOWN;
+  }
+  leave_bus_off(dev);
+  return 0;
+}
+#endif
+
+int can_fault_get_state(const struct device* dev, enum can_state* state,
+                        struct can_bus_err_cnt* err_cnt) {
+  struct can_fault_data* data = data_of(dev);
+
+  if (!data->bus_off) {
+    return can_get_state(lower_of(dev), state, err_cnt);
+  }
+  if (state != NULL) {
+    *state = CAN_STATE_BUS_OFF;
+  }
+  if (err_cnt != NULL) {
+    *err_cnt = {.tx_err_cnt = 255, .rx_err_cnt = 0};
+  }
+  return 0;
+}
+
+void can_fault_set_state_change_callback(const struct device* dev,
+                                         can_state_change_callback_t cb,
+                                         void* user_data) {
+  struct can_fault_data* data = data_of(dev);
+
+  data->common.state_change_cb = cb;
+  data->common.state_change_cb_user_data = user_data;
+}
+
+int can_fault_get_core_clock(const struct device* dev, uint32_t* rate) {
+  return can_get_core_clock(lower_of(dev), rate);
+}
+
+int can_fault_get_max_filters(const struct device* dev, bool ide) {
+  int lower = can_get_max_filters(lower_of(dev), ide);
+
+  return MIN(lower, CONFIG_APP_CAN_FAULT_MAX_FILTERS);
+}
+
+void apply_defaults(const struct device* dev, uint32_t seed) {
+  const struct can_fault_config* config =
+      static_cast<const struct can_fault_config*>(dev->config);
+  struct can_fault_data* data = data_of(dev);
+
+  data->plan = FaultPlan(seed);
+  for (size_t i = 1; i < FAULT_KIND_COUNT; i++) {
+    data->plan.set_probability(static_cast<FaultKind>(i), config->permille[i]);
+  }
+  data->plan.set_delay_ms(config->delay_ms);
+  data->plan.set_bus_off_ms(config->bus_off_ms);
+  data->stats = {};
+}
+
+int can_fault_init(const struct device* dev) {
+  const struct can_fault_config* config =
+      static_cast<const struct can_fault_config*>(dev->config);
+  struct can_fault_data* data = data_of(dev);
+
+  if (!device_is_ready(config->lower)) {
+    LOG_ERR("Underlying CAN controller %s not ready", config->lower->name);
+    return -ENODEV;
+  }
+
+  data->dev = dev;
+  apply_defaults(dev, config->seed);
+  k_work_init_delayable(&data->delay_work, delay_work_handler);
+  k_work_init_delayable(&data->recover_work, recover_work_handler);
+  can_set_state_change_callback(config->lower, lower_state_changed,
+                                const_cast<struct device*>(dev));
+  return 0;
+}
+
+}  // namespace
+
+static DEVICE_API(can, can_fault_api) = {
+    .get_capabilities = can_fault_get_capabilities,
+    .start = can_fault_start,
+    .stop = can_fault_stop,
+    .set_mode = can_fault_set_mode,
+    .set_timing = can_fault_set_timing,
+    .send = can_fault_send,
+    .add_rx_filter = can_fault_add_rx_filter,
+    .remove_rx_filter = can_fault_remove_rx_filter,
+#if defined(CONFIG_CAN_MANUAL_RECOVERY_MODE)
+    .recover = can_fault_recover,
+#endif
+    .get_state = can_fault_get_state,
+    .set_state_change_callback = can_fault_set_state_change_callback,
+    .get_core_clock = can_fault_get_core_clock,
+    .get_max_filters = can_fault_get_max_filters,
+    /* Same limits as the loopback driver; timing is passed through */
+    .timing_min = {.sjw = 0x01,
+                   .prop_seg = 0x01,
+                   .phase_seg1 = 0x01,
+                   .phase_seg2 = 0x01,
+                   .prescaler = 0x01},
+    .timing_max = {.sjw = 0x0F,
+                   .prop_seg = 0x0F,
+                   .phase_seg1 = 0x0F,
+                   .phase_seg2 = 0x0F,
+                   .prescaler = 0xFFFF},
+};
+
+namespace {
+bool is_fault_device(const struct device* dev) {
+  return dev != NULL && dev->api == &can_fault_api;
+}
+}  // namespace
+
+int can_fault_set_probability(const struct device* dev, FaultKind kind,
+                              uint16_t permille) {
+  if (!is_fault_device(dev)) {
+    return -ENOTSUP;
+  }
+
+  struct can_fault_data* data = data_of(dev);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  data->plan.set_probability(kind, permille);
+  k_spin_unlock(&data->lock, key);
+  return 0;
+}
+
+int can_fault_set_script(const struct device* dev, const FaultStep* steps,
+                         size_t count) {
+  if (!is_fault_device(dev)) {
+    return -ENOTSUP;
+  }
+
+  struct can_fault_data* data = data_of(dev);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  data->plan.set_script(steps, count);
+  k_spin_unlock(&data->lock, key);
+  return 0;
+}
+
+int can_fault_bus_off(const struct device* dev, uint32_t duration_ms) {
+  if (!is_fault_device(dev)) {
+    return -ENOTSUP;
+  }
+
+  struct can_fault_data* data = data_of(dev);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  data->stats.injected[static_cast<size_t>(FaultKind::BusOff)]++;
+  k_spin_unlock(&data->lock, key);
+  enter_bus_off(dev, duration_ms);
+  return 0;
+}
+
+int can_fault_reset(const struct device* dev, uint32_t seed) {
+  if (!is_fault_device(dev)) {
+    return -ENOTSUP;
+  }
+
+  struct can_fault_data* data = data_of(dev);
+
+  k_work_cancel_delayable(&data->recover_work);
+  leave_bus_off(dev);
+
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  apply_defaults(dev, seed);
+  k_spin_unlock(&data->lock, key);
+  return 0;
+}
+
+CanFaultStats can_fault_stats(const struct device* dev) {
+  CanFaultStats stats = {};
+
+  if (is_fault_device(dev)) {
+    struct can_fault_data* data = data_of(dev);
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    stats = data->stats;
+    k_spin_unlock(&data->lock, key);
+  }
+  return stats;
+}
+
+#define CAN_FAULT_INIT(inst)                                               \
+  static const struct can_fault_config can_fault_config_##inst = {         \
+      .common = CAN_DT_DRIVER_CONFIG_INST_GET(inst, 0, 1000000),           \
+      .lower = DEVICE_DT_GET(DT_INST_PHANDLE(inst, can_controller)),       \
+      .seed = DT_INST_PROP(inst, seed),                                    \
+      .permille = {0, DT_INST_PROP(inst, drop_permille),                   \
+                   DT_INST_PROP(inst, delay_permille),                     \
+                   DT_INST_PROP(inst, duplicate_permille),                 \
+                   DT_INST_PROP(inst, corrupt_permille),                   \
+                   DT_INST_PROP(inst, mailbox_full_permille),              \
+                   DT_INST_PROP(inst, bus_off_permille)},                  \
+      .delay_ms = DT_INST_PROP(inst, delay_ms),                            \
+      .bus_off_ms = DT_INST_PROP(inst, bus_off_ms),                        \
+  };                                                                       \
+  static struct can_fault_data can_fault_data_##inst;                      \
+  CAN_DEVICE_DT_INST_DEFINE(inst, can_fault_init, NULL,                    \
+                            &can_fault_data_##inst,                        \
+                            &can_fault_config_##inst, POST_KERNEL,         \
+                            CONFIG_APP_CAN_FAULT_INIT_PRIORITY,            \
+                            &can_fault_api);
+
+DT_INST_FOREACH_STATUS_OKAY(CAN_FAULT_INIT)
+
+#if defined(CONFIG_SHELL)
+namespace {
+const struct device* const shell_dev = DEVICE_DT_GET(DT_DRV_INST(0));
+
+constexpr const char* KIND_NAMES[FAULT_KIND_COUNT] = {
+    "none", "drop", "delay", "duplicate", "corrupt", "mailbox-full", "bus-off"};
+
+int parse_kind(const char* name, FaultKind& kind) {
+  for (size_t i = 1; i < FAULT_KIND_COUNT; i++) {
+    if (strcmp(name, KIND_NAMES[i]) == 0) {
+      kind = static_cast<FaultKind>(i);
+      return 0;
+    }
+  }
+  return -EINVAL;
+}
+
+int cmd_prob(const struct shell* sh, size_t argc, char** argv) {
+  FaultKind kind;
+
+  if (parse_kind(argv[1], kind) != 0) {
+    shell_error(sh, "Unknown fault: %s", argv[1]);
+    return -EINVAL;
+  }
+  return can_fault_set_probability(
+      shell_dev, kind, static_cast<uint16_t>(strtoul(argv[2], NULL, 0)));
+}
+
+int cmd_busoff(const struct shell* sh, size_t argc, char** argv) {
+  uint32_t ms = (argc > 1) ? strtoul(argv[1], NULL, 0) : 100;
+
+  return can_fault_bus_off(shell_dev, ms);
+}
+
+int cmd_reset(const struct shell* sh, size_t argc, char** argv) {
+  uint32_t seed = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1;
+
+  return can_fault_reset(shell_dev, seed);
+}
+
+int cmd_stats(const struct shell* sh, size_t argc, char** argv) {
+  CanFaultStats stats = can_fault_stats(shell_dev);
+
+  shell_print(sh, "frames %u, delay pool overflows %u", stats.frames,
+              stats.delay_overflows);
+  for (size_t i = 1; i < FAULT_KIND_COUNT; i++) {
+    shell_print(sh, "  %-12s %u", KIND_NAMES[i], stats.injected[i]);
+  }
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    canfault_cmds,
+    SHELL_CMD_ARG(prob, NULL, "Set fault probability: prob <kind> <permille>",
+                  cmd_prob, 3, 0),
+    SHELL_CMD_ARG(busoff, NULL, "Go bus-off now: busoff [ms]", cmd_busoff, 1,
+                  1),
+    SHELL_CMD_ARG(reset, NULL, "Devicetree defaults: reset [seed]", cmd_reset,
+                  1, 1),
+    SHELL_CMD(stats, NULL, "Injected fault counters", cmd_stats),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(canfault, &canfault_cmds, "CAN fault injection", NULL);
+#endif /* CONFIG_SHELL */
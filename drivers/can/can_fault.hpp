@@ -0,0 +1,47 @@
+/*
+ * drivers/can/can_fault.hpp
+ * Fault-injection CAN controller (compatible "simrig,can-fault")
+ */
+
+#pragma once
+
+#include <zephyr/device.h>
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint16_t, uint32_t
+
+#include "core/fault_plan.hpp"
+
+struct CanFaultStats {
+  uint32_t frames;                       // can_send() calls seen
+  uint32_t injected[FAULT_KIND_COUNT];   // Indexed by FaultKind
+  uint32_t delay_overflows;              // Delays sent on time: pool full
+};
+
+/**
+ * @brief Set the probability of one fault kind.
+ * * @return 0, or -ENOTSUP if dev is not a fault-injection controller
+ */
+int can_fault_set_probability(const struct device* dev, FaultKind kind,
+                              uint16_t permille);
+
+/**
+ * @brief Run a fault script against the following TX frames.
+ * * steps must be sorted by frame and stay valid while the script runs.
+ * Frames not named by the script still see the random faults.
+ */
+int can_fault_set_script(const struct device* dev, const FaultStep* steps,
+                         size_t count);
+
+/**
+ * @brief Go bus-off now and recover automatically after duration_ms.
+ */
+int can_fault_bus_off(const struct device* dev, uint32_t duration_ms);
+
+/**
+ * @brief Back to the devicetree defaults with a new seed; clears the
+ * script, statistics and any injected bus-off.
+ */
+int can_fault_reset(const struct device* dev, uint32_t seed);
+
+CanFaultStats can_fault_stats(const struct device* dev);
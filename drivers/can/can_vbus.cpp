@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Timing-accurate virtual CAN bus
+ *
+ * Every enabled simrig,can-vbus controller is a node on one simulated bus
+ * (core/virtual_bus.hpp). A bus thread runs arbitration whenever the bus
+ * is idle, sleeps for the winner's transmission time and then delivers
+ * the frame to the RX filters of every started node: the sender only
+ * hears itself in CAN_MODE_LOOPBACK, as with a real controller. A node in
+ * CAN_MODE_LISTENONLY receives everything but cannot transmit.
+ */
+
+#define DT_DRV_COMPAT simrig_can_vbus
+
+#include "can_vbus.hpp"
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/spinlock.h>
+
+LOG_MODULE_REGISTER(can_vbus, CONFIG_CAN_LOG_LEVEL);
+
+namespace {
+
+constexpr size_t NODE_COUNT = DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT);
+constexpr size_t MAILBOXES = CONFIG_APP_CAN_VBUS_TX_MAILBOXES;
+constexpr uint32_t CORE_CLOCK_HZ = 80000000;
+constexpr size_t BUS_THREAD_STACK_SIZE = 1536;
+
+struct RxFilter {
+  can_rx_callback_t callback;
+  void* user_data;
+  struct can_filter filter;
+  bool used;
+};
+
+struct TxContext {
+  can_tx_callback_t callback;
+  void* user_data;
+};
+
+}  // namespace
+
+struct can_vbus_config {
+  struct can_driver_config common;
+  size_t index;
+};
+
+struct can_vbus_data {
+  struct can_driver_data common;
+  struct k_sem tx_sem;  // Free mailboxes
+  struct k_mutex filter_lock;
+  RxFilter filters[CONFIG_APP_CAN_VBUS_MAX_FILTERS];
+};
+
+namespace {
+
+/* Bus state, guarded by bus_lock */
+struct k_spinlock bus_lock;
+VirtualBus<NODE_COUNT, MAILBOXES> bus(500000);
+TxContext tx_ctx[NODE_COUNT][MAILBOXES];
+const struct device* nodes[NODE_COUNT];
+
+K_SEM_DEFINE(bus_kick, 0, 1);
+
+uint64_t now_ns() { return k_ticks_to_ns_floor64(k_uptime_ticks()); }
+
+size_t index_of(const struct device* dev) {
+  return static_cast<const struct can_vbus_config*>(dev->config)->index;
+}
+
+struct can_vbus_data* data_of(const struct device* dev) {
+  return static_cast<struct can_vbus_data*>(dev->data);
+}
+
+void deliver(const BusTransmission& tx) {
+  for (size_t n = 0; n < NODE_COUNT; n++) {
+    const struct device* dev = nodes[n];
+    struct can_vbus_data* data = data_of(dev);
+
+    if (!data->common.started ||
+        (n == tx.node && (data->common.mode & CAN_MODE_LOOPBACK) == 0)) {
+      continue;
+    }
+
+    k_mutex_lock(&data->filter_lock, K_FOREVER);
+    for (const RxFilter& f : data->filters) {
+      if (f.used && can_frame_matches_filter(&tx.frame, &f.filter)) {
+        struct can_frame frame = tx.frame;
+
+#if defined(CONFIG_CAN_RX_TIMESTAMP)
+        frame.timestamp = static_cast<uint16_t>(tx.end_ns / 1000U);
+#endif
+        f.callback(dev, &frame, f.user_data);
+      }
+    }
+    k_mutex_unlock(&data->filter_lock);
+  }
+}
+
+void bus_thread_entry(void* arg1, void* arg2, void* arg3) {
+  BusTransmission tx;
+
+  while (1) {
+    k_sem_take(&bus_kick, K_FOREVER);
+
+    while (1) {
+      k_spinlock_key_t key = k_spin_lock(&bus_lock);
+      bool started = bus.start_next(now_ns(), tx);
+      k_spin_unlock(&bus_lock, key);
+
+      if (!started) {
+        break;
+      }
+
+      /* The frame is on the wire until its last intermission bit */
+      k_sleep(K_TIMEOUT_ABS_TICKS(k_ns_to_ticks_ceil64(tx.end_ns)));
+      deliver(tx);
+
+      key = k_spin_lock(&bus_lock);
+      TxContext ctx = tx_ctx[tx.node][tx.mailbox];
+      bus.finish(tx);
+      k_spin_unlock(&bus_lock, key);
+
+      k_sem_give(&data_of(nodes[tx.node])->tx_sem);
+      ctx.callback(nodes[tx.node], 0, ctx.user_data);
+    }
+  }
+}
+
+/* --------------------------------------------------------------------- */
+/* CAN driver API                                                         */
+/* --------------------------------------------------------------------- */
+
+int can_vbus_get_capabilities(const struct device* dev, can_mode_t* cap) {
+  *cap = CAN_MODE_NORMAL | CAN_MODE_LOOPBACK | CAN_MODE_LISTENONLY;
+  return 0;
+}
+
+int can_vbus_start(const struct device* dev) {
+  struct can_vbus_data* data = data_of(dev);
+
+  if (data->common.started) {
+    return -EALREADY;
+  }
+  data->common.started = true;
+  return 0;
+}
+
+int can_vbus_stop(const struct device* dev) {
+  struct can_vbus_data* data = data_of(dev);
+  size_t index = index_of(dev);
+  TxContext aborted[MAILBOXES];
+  size_t count = 0;
+
+  if (!data->common.started) {
+    return -EALREADY;
+  }
+  data->common.started = false;
+
+  k_spinlock_key_t key = k_spin_lock(&bus_lock);
+  bus.abort(index, [&](size_t mb) { aborted[count++] = tx_ctx[index][mb]; });
+  k_spin_unlock(&bus_lock, key);
+
+  for (size_t i = 0; i < count; i++) {
+    k_sem_give(&data->tx_sem);
+    aborted[i].callback(dev, -ENETDOWN, aborted[i].user_data);
+  }
+  return 0;
+}
+
+int can_vbus_set_mode(const struct device* dev, can_mode_t mode) {
+  struct can_vbus_data* data = data_of(dev);
+
+  if (data->common.started) {
+    return -EBUSY;
+  }
+  if ((mode & ~(CAN_MODE_LOOPBACK | CAN_MODE_LISTENONLY)) != 0) {
+    return -ENOTSUP;
+  }
+  data->common.mode = mode;
+  return 0;
+}
+
+int can_vbus_set_timing(const struct device* dev,
+                        const struct can_timing* timing) {
+  struct can_vbus_data* data = data_of(dev);
+  uint32_t tq = 1U + timing->prop_seg + timing->phase_seg1 +
+                timing->phase_seg2;
+
+  if (data->common.started) {
+    return -EBUSY;
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&bus_lock);
+  bus.set_bitrate(index_of(dev), CORE_CLOCK_HZ / (timing->prescaler * tq));
+  k_spin_unlock(&bus_lock, key);
+  return 0;
+}
+
+int can_vbus_send(const struct device* dev, const struct can_frame* frame,
+                  k_timeout_t timeout, can_tx_callback_t callback,
+                  void* user_data) {
+  struct can_vbus_data* data = data_of(dev);
+  size_t index = index_of(dev);
+
+  if ((frame->flags & ~(CAN_FRAME_IDE | CAN_FRAME_RTR)) != 0) {
+    return -ENOTSUP;
+  }
+  if (frame->dlc > CAN_MAX_DLC) {
+    return -EINVAL;
+  }
+  if (!data->common.started) {
+    return -ENETDOWN;
+  }
+  if ((data->common.mode & CAN_MODE_LISTENONLY) != 0) {
+    return -EIO;  // Never drives the bus, not even an ACK
+  }
+  if (k_sem_take(&data->tx_sem, timeout) != 0) {
+    return -EAGAIN;
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&bus_lock);
+  int mb = bus.enqueue(index, *frame, now_ns());
+
+  __ASSERT_NO_MSG(mb >= 0);  // tx_sem counts free mailboxes
+  tx_ctx[index][mb] = {.callback = callback, .user_data = user_data};
+  k_spin_unlock(&bus_lock, key);
+
+  k_sem_give(&bus_kick);
+  return 0;
+}
+
+int can_vbus_add_rx_filter(const struct device* dev, can_rx_callback_t cb,
+                           void* user_data, const struct can_filter* filter) {
+  struct can_vbus_data* data = data_of(dev);
+  int id = -ENOSPC;
+
+  if ((filter->flags & ~CAN_FILTER_IDE) != 0) {
+    return -ENOTSUP;
+  }
+
+  k_mutex_lock(&data->filter_lock, K_FOREVER);
+  for (size_t i = 0; i < ARRAY_SIZE(data->filters); i++) {
+    if (!data->filters[i].used) {
+      data->filters[i] = {.callback = cb,
+                          .user_data = user_data,
+                          .filter = *filter,
+                          .used = true};
+      id = static_cast<int>(i);
+      break;
+    }
+  }
+  k_mutex_unlock(&data->filter_lock);
+  return id;
+}
+
+void can_vbus_remove_rx_filter(const struct device* dev, int filter_id) {
+  struct can_vbus_data* data = data_of(dev);
+
+  if (filter_id < 0 ||
+      filter_id >= static_cast<int>(ARRAY_SIZE(data->filters))) {
+    return;
+  }
+  k_mutex_lock(&data->filter_lock, K_FOREVER);
+  data->filters[filter_id].used = false;
+  k_mutex_unlock(&data->filter_lock);
+}
+
+int can_vbus_get_state(const struct device* dev, enum can_state* state,
+                       struct can_bus_err_cnt* err_cnt) {
+  if (state != NULL) {
+    *state = data_of(dev)->common.started ? CAN_STATE_ERROR_ACTIVE
+                                          : CAN_STATE_STOPPED;
+  }
+  if (err_cnt != NULL) {
+    *err_cnt = {};
+  }
+  return 0;
+}
+
+void can_vbus_set_state_change_callback(const struct device* dev,
+                                        can_state_change_callback_t cb,
+                                        void* user_data) {
+  struct can_vbus_data* data = data_of(dev);
+
+  /* The virtual bus never sees errors, so the callback never fires */
+  data->common.state_change_cb = cb;
+  data->common.state_change_cb_user_data = user_data;
+}
+
+int can_vbus_get_core_clock(const struct device* dev, uint32_t* rate) {
+  *rate = CORE_CLOCK_HZ;
+  return 0;
+}
+
+int can_vbus_get_max_filters(const struct device* dev, bool ide) {
+  return CONFIG_APP_CAN_VBUS_MAX_FILTERS;
+}
+
+int can_vbus_init(const struct device* dev) {
+  const struct can_vbus_config* config =
+      static_cast<const struct can_vbus_config*>(dev->config);
+  struct can_vbus_data* data = data_of(dev);
+
+  nodes[config->index] = dev;
+  k_sem_init(&data->tx_sem, MAILBOXES, MAILBOXES);
+  k_mutex_init(&data->filter_lock);
+  bus.set_bitrate(config->index, config->common.bitrate);
+  return 0;
+}
+
+}  // namespace
+
+K_THREAD_DEFINE(can_vbus_tid, BUS_THREAD_STACK_SIZE, bus_thread_entry, NULL,
+                NULL, NULL, CONFIG_APP_CAN_VBUS_THREAD_PRIORITY, 0, 0);
+
+static DEVICE_API(can, can_vbus_api) = {
+    .get_capabilities = can_vbus_get_capabilities,
+    .start = can_vbus_start,
+    .stop = can_vbus_stop,
+    .set_mode = can_vbus_set_mode,
+    .set_timing = can_vbus_set_timing,
+    .send = can_vbus_send,
+    .add_rx_filter = can_vbus_add_rx_filter,
+    .remove_rx_filter = can_vbus_remove_rx_filter,
+    .get_state = can_vbus_get_state,
+    .set_state_change_callback = can_vbus_set_state_change_callback,
+    .get_core_clock = can_vbus_get_core_clock,
+    .get_max_filters = can_vbus_get_max_filters,
+    .timing_min = {.sjw = 0x01,
+                   .prop_seg = 0x01,
+                   .phase_seg1 = 0x01,
+                   .phase_seg2 = 0x01,
+                   .prescaler = 0x01},
+    .timing_max = {.sjw = 0x0F,
+                   .prop_seg = 0x0F,
+                   .phase_seg1 = 0x0F,
+                   .phase_seg2 = 0x0F,
+                   .prescaler = 0xFFFF},
+};
+
+VirtualBusStats can_vbus_stats() {
+  k_spinlock_key_t key = k_spin_lock(&bus_lock);
+  VirtualBusStats stats = bus.stats();
+
+  k_spin_unlock(&bus_lock, key);
+  return stats;
+}
+
+uint32_t can_vbus_arbitration_losses(const struct device* dev) {
+  if (dev == NULL || dev->api != &can_vbus_api) {
+    return 0;
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&bus_lock);
+  uint32_t losses = bus.arbitration_losses(index_of(dev));
+
+  k_spin_unlock(&bus_lock, key);
+  return losses;
+}
+
+#define CAN_VBUS_INIT(inst)                                                \
+  static const struct can_vbus_config can_vbus_config_##inst = {           \
+      .common = CAN_DT_DRIVER_CONFIG_INST_GET(inst, 0, 1000000),           \
+      .index = inst,                                                       \
+  };                                                                       \
+  static struct can_vbus_data can_vbus_data_##inst;                        \
+  CAN_DEVICE_DT_INST_DEFINE(inst, can_vbus_init, NULL,                     \
+                            &can_vbus_data_##inst,                         \
+                            &can_vbus_config_##inst, POST_KERNEL,          \
+                            CONFIG_CAN_INIT_PRIORITY, &can_vbus_api);
+
+DT_INST_FOREACH_STATUS_OKAY(CAN_VBUS_INIT)
@@ -0,0 +1,23 @@
+/*
+ * drivers/can/can_vbus.hpp
+ * Timing-accurate virtual CAN bus (compatible "simrig,can-vbus")
+ */
+
+#pragma once
+
+#include <zephyr/device.h>
+
+#include <cstdint>  // uint32_t
+
+#include "core/virtual_bus.hpp"
+
+/**
+ * @brief Totals of the shared virtual bus since boot.
+ */
+VirtualBusStats can_vbus_stats();
+
+/**
+ * @brief Arbitration rounds the controller took part in and lost.
+ * * @return Count, or 0 if dev is not a virtual bus controller
+ */
+uint32_t can_vbus_arbitration_losses(const struct device* dev);
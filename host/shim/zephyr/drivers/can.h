@@ -0,0 +1,50 @@
+/*
+ * host/shim/zephyr/drivers/can.h
+ * Layout-compatible subset of Zephyr's CAN driver types for the host build
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <zephyr/sys/util.h>
+
+#define CAN_STD_ID_MASK 0x7FFU
+#define CAN_EXT_ID_MASK 0x1FFFFFFFU
+#define CAN_MAX_DLC 8U
+#define CAN_MAX_DLEN 8U
+
+#define CAN_FRAME_IDE BIT(0)
+#define CAN_FRAME_RTR BIT(1)
+#define CAN_FRAME_FDF BIT(2)
+#define CAN_FRAME_BRS BIT(3)
+#define CAN_FRAME_ESI BIT(4)
+
+#define CAN_FILTER_IDE BIT(0)
+
+struct device;
+
+struct can_frame {
+  uint32_t id;
+  uint8_t dlc;
+  uint8_t flags;
+  uint16_t timestamp;
+  union {
+    uint8_t data[CAN_MAX_DLEN];
+    uint32_t data_32[DIV_ROUND_UP(CAN_MAX_DLEN, sizeof(uint32_t))];
+  };
+};
+
+struct can_filter {
+  uint32_t id;
+  uint32_t mask;
+  uint8_t flags;
+};
+
+inline uint8_t can_dlc_to_bytes(uint8_t dlc) {
+  return (dlc > CAN_MAX_DLC) ? CAN_MAX_DLC : dlc;
+}
+
+inline uint8_t can_bytes_to_dlc(uint8_t num_bytes) {
+  return (num_bytes > CAN_MAX_DLEN) ? CAN_MAX_DLC : num_bytes;
+}
@@ -0,0 +1,53 @@
+/*
+ * host/shim/zephyr/kernel.h
+ * Minimal stand-in for the Zephyr kernel API on the host build.
+ * Only the timing pieces used by src/core and src/app_config.hpp exist here.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <zephyr/sys/util.h>
+
+typedef struct {
+  int64_t ticks;  // Milliseconds on the host; -1 means forever
+} k_timeout_t;
+
+#define K_NO_WAIT (k_timeout_t{0})
+#define K_FOREVER (k_timeout_t{-1})
+#define K_MSEC(ms) (k_timeout_t{static_cast<int64_t>(ms)})
+#define K_SECONDS(s) K_MSEC((s) * 1000)
+#define K_TIMEOUT_ABS_MS(ms) K_MSEC(ms)
+
+#define K_LOWEST_APPLICATION_THREAD_PRIO 14
+
+namespace zephyr_shim {
+inline const std::chrono::steady_clock::time_point boot =
+    std::chrono::steady_clock::now();
+
+inline uint64_t elapsed_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - boot)
+      .count();
+}
+}  // namespace zephyr_shim
+
+/* One host "cycle" is one nanosecond of steady_clock */
+inline uint32_t sys_clock_hw_cycles_per_sec() { return 1000000000U; }
+
+inline uint64_t k_cycle_get_64() { return zephyr_shim::elapsed_ns(); }
+
+inline uint32_t k_cycle_get_32() {
+  return static_cast<uint32_t>(zephyr_shim::elapsed_ns());
+}
+
+inline int64_t k_uptime_get() {
+  return static_cast<int64_t>(zephyr_shim::elapsed_ns() / 1000000U);
+}
+
+inline uint32_t k_uptime_get_32() {
+  return static_cast<uint32_t>(k_uptime_get());
+}
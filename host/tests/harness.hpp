@@ -0,0 +1,48 @@
+/*
+ * host/tests/harness.hpp
+ * Minimal self-registering test harness for the host core tests
+ */
+
+#pragma once
+
+#include <cstdio>
+
+namespace harness {
+
+using TestFn = void (*)();
+
+struct TestCase {
+  const char* name;
+  TestFn fn;
+  TestCase* next;
+};
+
+inline TestCase* registry = nullptr;
+inline int failures = 0;
+
+struct Registrar {
+  TestCase test;
+
+  Registrar(const char* name, TestFn fn) : test{name, fn, registry} {
+    registry = &test;
+  }
+};
+
+}  // namespace harness
+
+#define HOST_TEST(suite, name)                                         \
+  static void suite##_##name();                                        \
+  static harness::Registrar suite##_##name##_reg(#suite "." #name,     \
+                                                 suite##_##name);      \
+  static void suite##_##name()
+
+#define CHECK(cond)                                                    \
+  do {                                                                 \
+    if (!(cond)) {                                                     \
+      std::printf("  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,   \
+                  #cond);                                              \
+      harness::failures++;                                             \
+    }                                                                  \
+  } while (0)
+
+#define CHECK_EQ(a, b) CHECK((a) == (b))
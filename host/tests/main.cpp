@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Runs every test registered with HOST_TEST.
+ */
+
+#include <cstdio>
+
+#include "harness.hpp"
+
+int main() {
+  int count = 0;
+
+  for (harness::TestCase* t = harness::registry; t != nullptr; t = t->next) {
+    int before = harness::failures;
+
+    t->fn();
+    std::printf("%s %s\n", (harness::failures == before) ? "PASS" : "FAIL",
+                t->name);
+    count++;
+  }
+
+  std::printf("%d tests, %d failed checks\n", count, harness::failures);
+  return (harness::failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the black-box ring, frame compression and slot layout.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <cstring>
+#include <vector>
+
+#include "core/blackbox_format.hpp"
+#include "core/crc32.hpp"
+#include "core/frame_compress.hpp"
+#include "core/frame_ring.hpp"
+#include "harness.hpp"
+
+namespace {
+
+TimedFrame make_frame(uint32_t ts, uint32_t id, uint8_t dlc, uint8_t fill,
+                      FrameDir dir) {
+  struct can_frame frame = {};
+
+  frame.id = id;
+  frame.dlc = dlc;
+  memset(frame.data, fill, sizeof(frame.data));
+  return TimedFrame::from(frame, dir, ts);
+}
+
+bool same_frame(const TimedFrame& a, const TimedFrame& b) {
+  return a.timestamp_us == b.timestamp_us && a.id == b.id &&
+         a.flags == b.flags && a.dlc == b.dlc && a.dir == b.dir &&
+         memcmp(a.data, b.data, a.dlc) == 0;
+}
+
+BlackboxHeader make_header(uint32_t sequence) {
+  BlackboxHeader hdr = {.magic = BlackboxHeader::MAGIC,
+                        .sequence = sequence,
+                        .trigger = 0,
+                        .entry_count = 1,
+                        .payload_len = 3,
+                        .payload_crc = 0,
+                        .trigger_timestamp_us = 0,
+                        .header_crc = 0};
+
+  hdr.header_crc = hdr.compute_crc();
+  return hdr;
+}
+
+}  // namespace
+
+HOST_TEST(crc32, check_value) {
+  const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+  CHECK_EQ(crc32(check, sizeof(check)), 0xCBF43926U);
+  CHECK_EQ(crc32_update(crc32(check, 4), &check[4], 5), 0xCBF43926U);
+  CHECK_EQ(crc32(check, 0), 0U);
+}
+
+HOST_TEST(frame_ring, keeps_newest_n) {
+  FrameRing<4> ring;
+
+  CHECK_EQ(ring.size(), 0U);
+  for (uint32_t i = 0; i < 6; i++) {
+    ring.push(make_frame(i, 0x100 + i, 1, 0, FrameDir::Rx));
+  }
+
+  CHECK_EQ(ring.size(), 4U);
+  for (size_t age = 0; age < 4; age++) {
+    CHECK_EQ(ring.newest(age).id, 0x105U - age);
+  }
+
+  ring.clear();
+  CHECK_EQ(ring.size(), 0U);
+}
+
+HOST_TEST(frame_ring, from_clamps_and_masks) {
+  struct can_frame frame = {};
+
+  frame.id = 0x1ABCDE;
+  frame.flags = CAN_FRAME_IDE | CAN_FRAME_FDF;
+  frame.dlc = 12;
+  TimedFrame tf = TimedFrame::from(frame, FrameDir::Tx, 7);
+
+  CHECK_EQ(tf.dlc, 8);
+  CHECK_EQ(tf.flags, CAN_FRAME_IDE);
+  CHECK(tf.dir == FrameDir::Tx);
+}
+
+HOST_TEST(frame_compress, round_trip) {
+  std::vector<TimedFrame> in = {
+      make_frame(1000000, 0x100, 1, 3, FrameDir::Tx),
+      make_frame(1000040, 0x100, 1, 3, FrameDir::Rx),  // loopback echo
+      make_frame(999000, 0x6F0, 8, 0x5A, FrameDir::Tx),  // older: delta < 0
+      make_frame(999000, 0x6F0, 8, 0x5B, FrameDir::Tx),
+      make_frame(0xFFFFFFF0, 0x1FFFFFFF, 0, 0, FrameDir::Rx),
+  };
+  in.back().flags = CAN_FRAME_IDE | CAN_FRAME_RTR;
+  uint8_t buf[5 * FrameCompress::MAX_ENTRY_SIZE];
+  FrameEncoder enc;
+  FrameDecoder dec;
+  size_t len = 0;
+
+  for (const TimedFrame& f : in) {
+    size_t n = enc.encode(f, &buf[len], sizeof(buf) - len);
+    CHECK(n > 0);
+    len += n;
+  }
+
+  size_t pos = 0;
+  for (const TimedFrame& f : in) {
+    TimedFrame out;
+    size_t n = dec.decode(&buf[pos], len - pos, out);
+    CHECK(n > 0);
+    CHECK(same_frame(out, f));
+    pos += n;
+  }
+  CHECK_EQ(pos, len);
+}
+
+HOST_TEST(frame_compress, echo_is_small) {
+  FrameEncoder enc;
+  uint8_t buf[2 * FrameCompress::MAX_ENTRY_SIZE];
+  TimedFrame tx = make_frame(5000, 0x100, 1, 2, FrameDir::Tx);
+  TimedFrame rx = make_frame(5030, 0x100, 1, 2, FrameDir::Rx);
+
+  CHECK(enc.encode(tx, buf, sizeof(buf)) > 0);
+  CHECK_EQ(enc.encode(rx, buf, sizeof(buf)), 2U);
+}
+
+HOST_TEST(frame_compress, full_buffer_keeps_state) {
+  FrameEncoder enc;
+  FrameEncoder ref;
+  uint8_t a[FrameCompress::MAX_ENTRY_SIZE];
+  uint8_t b[FrameCompress::MAX_ENTRY_SIZE];
+  TimedFrame first = make_frame(10, 0x200, 8, 1, FrameDir::Rx);
+  TimedFrame second = make_frame(20, 0x201, 8, 2, FrameDir::Rx);
+
+  CHECK(enc.encode(first, a, sizeof(a)) > 0);
+  CHECK(ref.encode(first, b, sizeof(b)) > 0);
+  CHECK_EQ(enc.encode(second, a, 4), 0U);
+
+  size_t n = enc.encode(second, a, sizeof(a));
+  CHECK_EQ(n, ref.encode(second, b, sizeof(b)));
+  CHECK(memcmp(a, b, n) == 0);
+}
+
+HOST_TEST(frame_compress, rejects_truncated) {
+  FrameEncoder enc;
+  FrameDecoder dec;
+  uint8_t buf[FrameCompress::MAX_ENTRY_SIZE];
+  TimedFrame out;
+  size_t n = enc.encode(make_frame(123456, 0x7E0, 8, 9, FrameDir::Rx), buf,
+                        sizeof(buf));
+
+  for (size_t len = 0; len < n; len++) {
+    CHECK_EQ(dec.decode(buf, len, out), 0U);
+  }
+  CHECK_EQ(dec.decode(buf, n, out), n);
+}
+
+HOST_TEST(blackbox_format, header_validation) {
+  BlackboxHeader hdr = make_header(5);
+
+  CHECK(hdr.is_valid(4096));
+  hdr.payload_len = 4096;
+  CHECK(!hdr.is_valid(4096));
+
+  hdr = make_header(5);
+  hdr.sequence = 6;
+  CHECK(!hdr.is_valid(4096));
+}
+
+HOST_TEST(blackbox_format, next_slot) {
+  std::vector<BlackboxHeader> slots(4);
+  std::vector<bool> readable(4, true);
+  uint32_t latest_seq;
+  bool found;
+  auto header_at = [&](size_t i) -> const BlackboxHeader* {
+    return readable[i] ? &slots[i] : nullptr;
+  };
+
+  /* Blank area: erased flash reads as 0xFF */
+  memset(slots.data(), 0xFF, slots.size() * sizeof(BlackboxHeader));
+  CHECK_EQ(blackbox_next_slot(4, 4096, header_at, latest_seq, found), 0U);
+  CHECK(!found);
+
+  /* Wrapped: slot 1 holds the newest snapshot */
+  slots[0] = make_header(8);
+  slots[1] = make_header(9);
+  slots[2] = make_header(6);
+  slots[3] = make_header(7);
+  CHECK_EQ(blackbox_next_slot(4, 4096, header_at, latest_seq, found), 2U);
+  CHECK(found);
+  CHECK_EQ(latest_seq, 9U);
+
+  /* Torn or unreadable latest slot falls back to the previous one */
+  slots[1].payload_crc ^= 1;
+  CHECK_EQ(blackbox_next_slot(4, 4096, header_at, latest_seq, found), 1U);
+  CHECK_EQ(latest_seq, 8U);
+
+  readable[0] = false;
+  CHECK_EQ(blackbox_next_slot(4, 4096, header_at, latest_seq, found), 0U);
+  CHECK_EQ(latest_seq, 7U);
+}
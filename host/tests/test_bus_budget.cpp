@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the compile-time bus load budget.
+ */
+
+#include <array>
+
+#include "app_config.hpp"
+#include "core/bus_budget.hpp"
+#include "harness.hpp"
+
+using BusBudget::PPM;
+
+HOST_TEST(bus_budget, frame_load) {
+  /* 135 bits every 1 ms at 500 kbit/s is 27% */
+  CHECK_EQ(BusBudget::frame_load_ppm(false, 8, 1, 500000), 270000U);
+  /* 65 bits every 3 ms: 43333.3 ppm, rounded up */
+  CHECK_EQ(BusBudget::frame_load_ppm(false, 1, 3, 500000), 43334U);
+  /* 200 frames a second of 135 bits */
+  CHECK_EQ(BusBudget::rate_load_ppm(false, 8, 200, 500000), 54000U);
+  static_assert(BusBudget::frame_load_ppm(true, 8, 1, 500000) >
+                BusBudget::frame_load_ppm(false, 8, 1, 500000));
+}
+
+HOST_TEST(bus_budget, table_load) {
+  static constexpr std::array<MessageSpec, 2> table = {{
+      {.id = 0x100, .dlc = 1, .period_ms = 1, .deadline_ms = 1},
+      {.id = 0x200, .dlc = 8, .period_ms = 1, .deadline_ms = 1},
+  }};
+
+  CHECK_EQ(BusBudget::table_load_ppm(table, 500000), 130000U + 270000U);
+
+  /* Four more bytes on 0x100: 105 bits */
+  uint64_t grown = BusBudget::table_load_ppm(
+      table, 500000, [](const MessageSpec& spec) {
+        return static_cast<uint8_t>(spec.dlc + (spec.id == 0x100 ? 4 : 0));
+      });
+  CHECK_EQ(grown, 210000U + 270000U);
+}
+
+HOST_TEST(bus_budget, car_profiles_within_default_ceiling) {
+  /* The firmware checks the same with CONFIG_APP_BUS_LOAD_LIMIT_PERCENT */
+  for (const CarProfile& car : Config::CAR_PROFILES) {
+    CHECK(BusBudget::table_load_ppm(car.schedule, 500000) < PPM * 30 / 100);
+  }
+}
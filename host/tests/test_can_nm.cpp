@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the CanNm state machine and the sleep/wake simulation.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include "core/can_nm.hpp"
+#include "core/nm_sim.hpp"
+#include "harness.hpp"
+
+namespace {
+
+constexpr NmTiming TIMING = {.msg_cycle_ms = 100,
+                             .timeout_ms = 500,
+                             .repeat_message_ms = 300,
+                             .wait_bus_sleep_ms = 400};
+
+constexpr uint64_t ms(uint64_t v) { return v * 1000; }
+
+}  // namespace
+
+HOST_TEST(can_nm, local_request_to_bus_sleep) {
+  CanNm nm(3, TIMING);
+  uint8_t cbv = 0;
+  uint32_t sent = 0;
+
+  CHECK(nm.state() == NmState::BusSleep);
+  CHECK_EQ(nm.next_event_us(), UINT64_MAX);
+
+  nm.network_request(ms(10));
+  CHECK(nm.state() == NmState::RepeatMessage);
+  CHECK(nm.poll(ms(10), cbv));
+  CHECK_EQ(cbv, NmCbv::ACTIVE_WAKEUP);
+  CHECK_EQ(nm.next_event_us(), ms(110));
+
+  /* RepeatMessage ends at 310 ms; PDUs keep their 100 ms cycle */
+  for (uint64_t t = 20; t <= 1000; t += 10) {
+    sent += nm.poll(ms(t), cbv) ? 1 : 0;
+  }
+  CHECK(nm.state() == NmState::NormalOperation);
+  CHECK_EQ(sent, 9U);  // 110, 210 .. 910
+  CHECK_EQ(cbv, 0);
+
+  nm.network_release(ms(1005));
+  CHECK(nm.state() == NmState::ReadySleep);
+  CHECK(!nm.poll(ms(1010), cbv));  // No PDUs once released
+
+  /* Timeout runs from our last PDU at 910 ms */
+  CHECK_EQ(nm.next_event_us(), ms(1410));
+  CHECK(!nm.poll(ms(1410), cbv));
+  CHECK(nm.state() == NmState::PrepareBusSleep);
+  CHECK_EQ(nm.next_event_us(), ms(1810));
+  nm.poll(ms(1810), cbv);
+  CHECK(nm.state() == NmState::BusSleep);
+  CHECK_EQ(nm.stats().sleeps, 1U);
+  CHECK_EQ(nm.stats().wakeups, 1U);
+  CHECK_EQ(nm.stats().state_since_us, ms(1810));
+}
+
+HOST_TEST(can_nm, remote_pdus_wake_and_hold_the_bus) {
+  CanNm nm(1, TIMING);
+  uint8_t cbv = 0;
+
+  nm.on_rx(NmCbv::ACTIVE_WAKEUP, ms(0));
+  CHECK(nm.state() == NmState::RepeatMessage);
+  CHECK(nm.poll(ms(0), cbv));
+  CHECK_EQ(cbv, 0);  // Woken, not waking
+
+  /* Not requested locally: ReadySleep after RepeatMessage */
+  nm.poll(ms(300), cbv);
+  CHECK(nm.state() == NmState::ReadySleep);
+
+  /* Someone else's PDUs keep it there past its own timeout */
+  for (uint64_t t = 400; t <= 2000; t += 100) {
+    nm.on_rx(0, ms(t));
+    nm.poll(ms(t), cbv);
+  }
+  CHECK(nm.state() == NmState::ReadySleep);
+
+  /* A repeat message request brings it back to announcing itself */
+  nm.on_rx(NmCbv::REPEAT_MESSAGE_REQUEST, ms(2050));
+  CHECK(nm.state() == NmState::RepeatMessage);
+  CHECK(nm.poll(ms(2050), cbv));
+}
+
+HOST_TEST(can_nm, request_cancels_prepare_bus_sleep) {
+  CanNm nm(2, TIMING);
+  uint8_t cbv = 0;
+
+  nm.on_rx(0, ms(0));
+  nm.poll(ms(0), cbv);
+  nm.poll(ms(300), cbv);
+  nm.poll(ms(500), cbv);
+  CHECK(nm.state() == NmState::PrepareBusSleep);
+
+  nm.network_request(ms(600));
+  CHECK(nm.state() == NmState::RepeatMessage);
+  CHECK(nm.poll(ms(600), cbv));
+  CHECK_EQ(cbv, NmCbv::ACTIVE_WAKEUP);
+  CHECK_EQ(nm.stats().wakeups, 2U);
+}
+
+HOST_TEST(can_nm, pdu_codec) {
+  struct can_frame f;
+  uint8_t node = 0;
+  uint8_t cbv = 0;
+
+  encode_nm_frame(7, NmCbv::ACTIVE_WAKEUP, f);
+  CHECK_EQ(f.id, Config::CAN_NM_BASE_ID + 7);
+  CHECK(decode_nm_frame(f, node, cbv));
+  CHECK_EQ(node, 7);
+  CHECK_EQ(cbv, NmCbv::ACTIVE_WAKEUP);
+
+  f.id = Config::CAN_GEAR_MSG_ID;
+  CHECK(!decode_nm_frame(f, node, cbv));
+  f.id = Config::CAN_NM_BASE_ID;
+  f.flags = CAN_FRAME_IDE;
+  CHECK(!decode_nm_frame(f, node, cbv));
+}
+
+HOST_TEST(nm_sim, synchronized_sleep_and_fast_wake) {
+  static NmSim<16> sim(12, 500000);
+  const NmTiming& t = NmSimConfig::TIMING;
+  NmSleepWakeReport r = sim.sleep_wake(50, 5);
+
+  CHECK(r.slept);
+  CHECK(r.woke);
+
+  /* Timeout from the last PDU (at most one cycle before the last
+   * release), then the bus-sleep wait */
+  CHECK(r.sleep_entry_us() <= ms(t.timeout_ms + t.wait_bus_sleep_ms));
+  CHECK(r.sleep_entry_us() >=
+        ms(t.timeout_ms + t.wait_bus_sleep_ms - t.msg_cycle_ms));
+
+  /* Everyone heard the same last PDU */
+  CHECK(r.sleep_skew_us() < 1000);
+
+  /* One PDU on the wire wakes all the others */
+  CHECK(r.wake_latency_us() < 1000);
+  CHECK(sim.all([](const CanNm& c) { return c.network_mode(); }));
+  CHECK(sim.node(5).state() == NmState::RepeatMessage);
+  CHECK(r.pdus > 0);
+}
+
+HOST_TEST(nm_sim, one_requester_keeps_everyone_awake) {
+  static NmSim<8> sim(4, 500000);
+
+  for (size_t n = 0; n < 4; n++) {
+    sim.request(n);
+  }
+  sim.advance(ms(3000));
+  for (size_t n = 1; n < 4; n++) {
+    sim.release(n);
+  }
+
+  bool slept = sim.run_until(ms(20000), [&] {
+    return !sim.all([](const CanNm& c) { return c.network_mode(); });
+  });
+  CHECK(!slept);
+  CHECK(sim.node(0).state() == NmState::NormalOperation);
+  CHECK(sim.node(1).state() == NmState::ReadySleep);
+
+  /* Only the requester sends: one PDU per cycle */
+  uint32_t before = sim.pdus();
+  sim.advance(ms(21000));
+  CHECK_EQ(sim.pdus() - before, 5U);
+}
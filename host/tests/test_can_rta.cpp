@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the CAN response time analysis and the priority
+ * assignment, against values worked out by hand at 500 kbit/s (2 us per
+ * bit: 270 us for an 8-byte frame, 130 us for a 1-byte frame).
+ */
+
+#include <array>
+
+#include "app_config.hpp"
+#include "core/can_rta.hpp"
+#include "harness.hpp"
+
+namespace {
+
+constexpr uint32_t BITRATE = 500000;
+constexpr uint64_t US = 1000;
+constexpr uint64_t MS = 1000 * US;
+
+constexpr RtaMessage msg(uint32_t id, uint8_t dlc, uint64_t period_ns,
+                         uint64_t deadline_ns, uint64_t jitter_ns = 0) {
+  return {.id = id,
+          .extended = false,
+          .dlc = dlc,
+          .period_ns = period_ns,
+          .deadline_ns = deadline_ns,
+          .jitter_ns = jitter_ns};
+}
+
+}  // namespace
+
+HOST_TEST(can_rta, single_message) {
+  const RtaMessage set[] = {msg(0x100, 8, 10 * MS, 10 * MS)};
+  RtaResult r = CanRta::response_by_id(set, 1, 0, BITRATE);
+
+  CHECK_EQ(r.frame_ns, 270 * US);
+  CHECK_EQ(r.blocking_ns, 0U);
+  CHECK_EQ(r.response_ns, 270 * US);
+  CHECK_EQ(r.instances, 1U);
+  CHECK(r.schedulable);
+}
+
+HOST_TEST(can_rta, blocking_and_interference) {
+  const RtaMessage set[] = {msg(0x100, 1, 1 * MS, 1 * MS),
+                            msg(0x200, 8, 10 * MS, 10 * MS)};
+
+  /* 0x100 waits for a 0x200 that just won arbitration */
+  RtaResult high = CanRta::response_by_id(set, 2, 0, BITRATE);
+  CHECK_EQ(high.blocking_ns, 270 * US);
+  CHECK_EQ(high.response_ns, 400 * US);
+
+  /* 0x200 is never blocked but lets one 0x100 go first */
+  RtaResult low = CanRta::response_by_id(set, 2, 1, BITRATE);
+  CHECK_EQ(low.blocking_ns, 0U);
+  CHECK_EQ(low.response_ns, 400 * US);
+}
+
+HOST_TEST(can_rta, release_jitter) {
+  const RtaMessage set[] = {msg(0x100, 1, 1 * MS, 2 * MS, 1 * MS),
+                            msg(0x200, 8, 10 * MS, 10 * MS)};
+
+  /* Jitter adds to the response of the message itself... */
+  CHECK_EQ(CanRta::response_by_id(set, 2, 0, BITRATE).response_ns,
+           1400 * US);
+  /* ...and lets two of its instances hit a lower priority one */
+  CHECK_EQ(CanRta::response_by_id(set, 2, 1, BITRATE).response_ns,
+           530 * US);
+}
+
+HOST_TEST(can_rta, overload_is_unschedulable) {
+  const RtaMessage set[] = {msg(0x100, 8, 500 * US, 1 * MS),
+                            msg(0x200, 8, 500 * US, 10 * MS)};
+
+  CHECK(CanRta::response_by_id(set, 2, 0, BITRATE).schedulable);
+  CHECK(!CanRta::response_by_id(set, 2, 1, BITRATE).schedulable);
+}
+
+HOST_TEST(can_rta, audsley_assignment) {
+  /* 0x200 has the tightest deadline but the lowest priority */
+  const RtaMessage set[] = {msg(0x100, 8, 100 * MS, 100 * MS),
+                            msg(0x180, 8, 100 * MS, 100 * MS),
+                            msg(0x200, 1, 1 * MS, 500 * US)};
+  std::array<size_t, 3> order;
+
+  CHECK_EQ(CanRta::response_by_id(set, 3, 2, BITRATE).response_ns,
+           670 * US);
+  CHECK(CanRta::assign_priorities(set, 3, BITRATE, order));
+  CHECK_EQ(order[0], 2U);
+  CHECK_EQ(order[1], 0U);
+  CHECK_EQ(order[2], 1U);
+
+  /* With the IDs handed out in that order, everything fits */
+  RtaMessage moved[] = {set[0], set[1], set[2]};
+  moved[2].id = 0x100;
+  moved[0].id = 0x180;
+  moved[1].id = 0x200;
+  for (size_t i = 0; i < 3; i++) {
+    CHECK(CanRta::response_by_id(moved, 3, i, BITRATE).schedulable);
+  }
+  CHECK_EQ(CanRta::response_by_id(moved, 3, 2, BITRATE).response_ns,
+           400 * US);
+}
+
+HOST_TEST(can_rta, feasible_order_is_kept) {
+  const RtaMessage set[] = {msg(0x300, 8, 10 * MS, 10 * MS),
+                            msg(0x100, 8, 10 * MS, 10 * MS),
+                            msg(0x200, 8, 10 * MS, 10 * MS)};
+  std::array<size_t, 3> order;
+
+  CHECK(CanRta::assign_priorities(set, 3, BITRATE, order));
+  CHECK_EQ(order[0], 1U);
+  CHECK_EQ(order[1], 2U);
+  CHECK_EQ(order[2], 0U);
+}
+
+HOST_TEST(can_rta, infeasible_set) {
+  const RtaMessage set[] = {msg(0x100, 8, 300 * US, 300 * US),
+                            msg(0x200, 8, 300 * US, 300 * US)};
+  std::array<size_t, 2> order;
+
+  CHECK(!CanRta::assign_priorities(set, 2, BITRATE, order));
+}
+
+HOST_TEST(can_rta, car_profiles_meet_deadlines) {
+  for (const CarProfile& p : Config::CAR_PROFILES) {
+    std::array<RtaMessage, CarProfile::MESSAGES> set;
+
+    for (size_t i = 0; i < set.size(); i++) {
+      const MessageSpec& s = p.schedule[i];
+      set[i] = msg(s.id, s.dlc, s.period_ms * MS, s.deadline_ms * MS, MS);
+    }
+    for (size_t i = 0; i < set.size(); i++) {
+      CHECK(CanRta::response_by_id(set.data(), set.size(), i, BITRATE)
+                .schedulable);
+    }
+  }
+}
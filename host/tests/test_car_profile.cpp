@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the car profiles and the double-buffered profile switch.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include "app_config.hpp"
+#include "core/car_profile.hpp"
+#include "core/gear_codec.hpp"
+#include "core/scheduler.hpp"
+#include "harness.hpp"
+
+namespace {
+const CarProfile& GT3 = Config::CAR_PROFILES[0];
+const CarProfile& ROAD = Config::CAR_PROFILES[1];
+const CarProfile& FORMULA = Config::CAR_PROFILES[2];
+}  // namespace
+
+HOST_TEST(car_profile, profiles_are_consistent) {
+  for (const CarProfile& p : Config::CAR_PROFILES) {
+    bool sends_gear = false;
+    bool hears_gear = false;
+    bool hears_diag = false;
+
+    for (const MessageSpec& m : p.schedule) {
+      CHECK(m.deadline_ms <= m.period_ms);
+      sends_gear |= (m.id == p.gear_layout.id && m.dlc == p.gear_layout.dlc);
+    }
+    for (const struct can_filter& f : p.filters) {
+      hears_gear |= (f.id == p.gear_layout.id);
+      hears_diag |= (f.id == Config::CAN_DIAG_REQ_MSG_ID);
+    }
+    CHECK(sends_gear);
+    CHECK(hears_gear);
+    CHECK(hears_diag);
+    CHECK(p.forward_gears >= 1 &&
+          p.forward_gears <= static_cast<uint8_t>(Gear::Sixth));
+    CHECK(p.gear_layout.gear.start_bit + p.gear_layout.gear.length <=
+          8 * p.gear_layout.dlc);
+  }
+}
+
+HOST_TEST(car_profile, gear_layouts) {
+  struct can_frame legacy;
+  struct can_frame f;
+  Gear g = Gear::N;
+
+  /* The default profile keeps the original frame */
+  encode_gear_frame(Gear::Fourth, legacy);
+  encode_gear_frame(Gear::Fourth, GT3.gear_layout, f);
+  CHECK(f.id == legacy.id && f.dlc == legacy.dlc &&
+        f.data[0] == legacy.data[0]);
+
+  encode_gear_frame(Gear::Fifth, FORMULA.gear_layout, f);
+  CHECK_EQ(f.id, 0x110U);
+  CHECK_EQ(f.dlc, 2);
+  CHECK_EQ(f.data[0], 0);
+  CHECK_EQ(f.data[1], 5);
+  CHECK(decode_gear_frame(f, FORMULA.gear_layout, g));
+  CHECK(g == Gear::Fifth);
+  CHECK(!decode_gear_frame(f, GT3.gear_layout, g));
+
+  f.data[1] = 0x07;  // Out of range
+  CHECK(!decode_gear_frame(f, FORMULA.gear_layout, g));
+}
+
+HOST_TEST(car_profile, frames_queued_across_a_switch_decode) {
+  struct can_frame f;
+  Gear g = Gear::N;
+
+  /* Sent as GT3, processed after the switch to FORMULA */
+  encode_gear_frame(Gear::Third, GT3.gear_layout, f);
+  CHECK(!decode_gear_frame(f, FORMULA, nullptr, g));
+  CHECK(decode_gear_frame(f, FORMULA, &GT3, g));
+  CHECK(g == Gear::Third);
+
+  encode_gear_frame(Gear::Fifth, FORMULA.gear_layout, f);
+  CHECK(decode_gear_frame(f, FORMULA, &GT3, g));
+  CHECK(g == Gear::Fifth);
+}
+
+HOST_TEST(car_profile, gears_above_the_gearbox_are_rejected) {
+  struct can_frame f;
+  Gear g = Gear::N;
+
+  /* Same frame layout; the road car has no sixth gear */
+  encode_gear_frame(Gear::Sixth, ROAD.gear_layout, f);
+  CHECK(decode_gear_frame(f, GT3, nullptr, g));
+  CHECK(g == Gear::Sixth);
+
+  g = Gear::Second;
+  CHECK(!decode_gear_frame(f, ROAD, nullptr, g));
+  CHECK(!decode_gear_frame(f, ROAD, &GT3, g));
+  CHECK(g == Gear::Second);
+
+  encode_gear_frame(Gear::Fifth, ROAD.gear_layout, f);
+  CHECK(decode_gear_frame(f, ROAD, &GT3, g));
+  CHECK(g == Gear::Fifth);
+}
+
+HOST_TEST(car_profile, gear_models) {
+  Gear g = Gear::N;
+
+  for (int i = 0; i < ROAD.forward_gears; i++) {
+    g = next_gear(g, ROAD.forward_gears);
+  }
+  CHECK(g == Gear::Fifth);
+  CHECK(next_gear(g, ROAD.forward_gears) == Gear::N);
+  CHECK(next_gear(g, GT3.forward_gears) == Gear::Sixth);
+
+  /* Switching to a smaller gearbox while above its top gear goes to N */
+  CHECK(next_gear(Gear::Sixth, ROAD.forward_gears) == Gear::N);
+}
+
+HOST_TEST(car_profile, switch_flips_between_two_buffers) {
+  ProfileSwitch sw(GT3);
+  const ProfileTables* first = &sw.active();
+
+  CHECK(sw.apply(100) == nullptr);
+  CHECK(sw.active().profile == &GT3);
+  CHECK(sw.previous_profile() == nullptr);
+
+  CHECK(sw.request(FORMULA, 1000));
+  CHECK(sw.pending());
+  CHECK(!sw.request(ROAD, 1100));  // One switch in flight
+  CHECK(&sw.profile() == &GT3);   // Not before the cycle boundary
+
+  const ProfileTables* t = sw.apply(1500);
+  CHECK(t != nullptr && t != first);
+  CHECK(t == &sw.active());
+  CHECK(t->profile == &FORMULA);
+  CHECK_EQ(t->schedule[0].period_ms, 100U);
+  CHECK_EQ(t->filters[0].id, 0x110U);
+  CHECK(&sw.profile() == &FORMULA);
+  CHECK(!sw.pending());
+
+  CHECK(sw.previous_profile() == &GT3);
+
+  CHECK(sw.request(ROAD, 2000));
+  CHECK(sw.apply(2200) == first);
+  CHECK(sw.active().profile == &ROAD);
+  CHECK(sw.previous_profile() == &FORMULA);
+
+  ProfileSwitchStats s = sw.stats();
+  CHECK_EQ(s.switches, 2U);
+  CHECK_EQ(s.rejected, 1U);
+  CHECK_EQ(s.last_latency_ns, 200ULL);
+  CHECK_EQ(s.max_latency_ns, 500ULL);
+}
+
+HOST_TEST(car_profile, switch_keeps_tx_running) {
+  /* The TX loop of main.cpp with a 1 ms tick: poll, then apply */
+  ProfileSwitch sw(GT3);
+  const ProfileTables* t = &sw.active();
+  PeriodicScheduler sched(t->schedule, 0);
+  int64_t last_gear_ms = 0;
+  int64_t max_gap_ms = 0;
+  uint32_t gt3_gears = 0;
+  uint32_t formula_gears = 0;
+
+  for (int64_t now = 0; now < 10000; now++) {
+    sched.poll(now, [&](const MessageSpec& m) {
+      if (m.id != t->profile->gear_layout.id) {
+        return;
+      }
+      max_gap_ms = (now - last_gear_ms > max_gap_ms) ? now - last_gear_ms
+                                                      : max_gap_ms;
+      last_gear_ms = now;
+      if (t->profile == &GT3) {
+        gt3_gears++;
+      } else {
+        formula_gears++;
+      }
+    });
+
+    if (now == 4321) {
+      CHECK(sw.request(FORMULA, now));
+    }
+    const ProfileTables* next = sw.apply(now);
+    if (next != nullptr) {
+      t = next;
+      sched.rebind(t->schedule, now);
+    }
+  }
+
+  /* Releases at 0, 2000, 4000; then 4321 and every 100 ms after */
+  CHECK_EQ(gt3_gears, 3U);
+  CHECK_EQ(formula_gears, 57U);
+  CHECK(max_gap_ms <= GT3.schedule[0].period_ms);
+  CHECK_EQ(sched.deadline_misses(), 0U);
+}
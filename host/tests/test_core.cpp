@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the gear model, codecs, scheduler and queue.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <vector>
+
+#include "app_config.hpp"
+#include "core/diag_codec.hpp"
+#include "core/gear.hpp"
+#include "core/gear_codec.hpp"
+#include "core/scheduler.hpp"
+#include "core/signal_codec.hpp"
+#include "core/spsc_queue.hpp"
+#include "harness.hpp"
+
+HOST_TEST(gear, wraps_after_sixth) {
+  Gear gear = Gear::Fifth;
+
+  CHECK_EQ(++gear, Gear::Sixth);
+  CHECK_EQ(++gear, Gear::N);
+  CHECK_EQ(++gear, Gear::First);
+}
+
+HOST_TEST(gear_codec, round_trip) {
+  struct can_frame frame;
+  Gear gear = Gear::N;
+
+  encode_gear_frame(Gear::Fifth, frame);
+  CHECK_EQ(frame.id, Config::CAN_GEAR_MSG_ID);
+  CHECK_EQ(frame.dlc, Config::CAN_MSG_DLC);
+  CHECK(decode_gear_frame(frame, gear));
+  CHECK_EQ(gear, Gear::Fifth);
+
+  frame.data[0] = 7;
+  CHECK(!decode_gear_frame(frame, gear));
+  frame.data[0] = 1;
+  frame.id = 0x101;
+  CHECK(!decode_gear_frame(frame, gear));
+}
+
+HOST_TEST(signal_codec, pack_preserves_neighbours) {
+  uint8_t data[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+  constexpr SignalSpec sig = {.start_bit = 4, .length = 12};
+
+  pack_signal(data, sig, 0x000);
+  CHECK_EQ(data[0], 0x0F);
+  CHECK_EQ(data[1], 0x00);
+  CHECK_EQ(data[2], 0xFF);
+
+  pack_signal(data, sig, 0xABC);
+  CHECK_EQ(unpack_signal(data, sig), 0xABCU);
+  CHECK_EQ(data[0], 0xCF);
+  CHECK_EQ(data[1], 0xAB);
+}
+
+HOST_TEST(signal_codec, signed_and_full_width) {
+  uint8_t data[8] = {};
+  constexpr SignalSpec temp = {.start_bit = 8, .length = 10};
+  constexpr SignalSpec all = {.start_bit = 0, .length = 64};
+
+  pack_signal(data, temp, static_cast<uint64_t>(-5));
+  CHECK_EQ(unpack_signed(data, temp), -5);
+
+  pack_signal(data, all, 0x0123456789ABCDEFULL);
+  CHECK_EQ(data[0], 0xEF);
+  CHECK_EQ(data[7], 0x01);
+  CHECK_EQ(unpack_signal(data, all), 0x0123456789ABCDEFULL);
+}
+
+HOST_TEST(signal_codec, constexpr_usable) {
+  constexpr auto packed = [] {
+    std::array<uint8_t, 8> d{};
+    pack_signal(d.data(), {.start_bit = 3, .length = 5}, 0x15);
+    return d;
+  }();
+  static_assert(packed[0] == (0x15 << 3));
+}
+
+HOST_TEST(scheduler, releases_without_drift) {
+  static constexpr std::array<MessageSpec, 2> table = {{
+      {.id = 1, .dlc = 1, .period_ms = 10, .deadline_ms = 2},
+      {.id = 2, .dlc = 1, .period_ms = 25, .deadline_ms = 25},
+  }};
+  PeriodicScheduler sched(table, 100);
+  std::vector<uint32_t> sent;
+  auto record = [&](const MessageSpec& m) { sent.push_back(m.id); };
+
+  CHECK_EQ(sched.poll(100, record), 2U);
+  CHECK_EQ(sched.next_due_ms(), 110);
+
+  /* Serviced 1 ms late: the next release still lands on the grid */
+  CHECK_EQ(sched.poll(111, record), 1U);
+  CHECK_EQ(sched.next_due_ms(), 120);
+  CHECK_EQ(sched.deadline_misses(), 0U);
+  CHECK_EQ(sent.size(), 3U);
+}
+
+HOST_TEST(scheduler, counts_late_and_skipped_releases) {
+  static constexpr std::array<MessageSpec, 1> table = {{
+      {.id = 1, .dlc = 1, .period_ms = 10, .deadline_ms = 2},
+  }};
+  PeriodicScheduler sched(table, 0);
+  auto ignore = [](const MessageSpec&) {};
+
+  sched.poll(0, ignore);
+  sched.poll(13, ignore);  // 3 ms late
+  CHECK_EQ(sched.deadline_misses(), 1U);
+  CHECK_EQ(sched.next_due_ms(), 20);
+
+  sched.poll(45, ignore);  // Releases at 20 and 30 lost, 40 late
+  CHECK_EQ(sched.deadline_misses(), 4U);
+  CHECK_EQ(sched.next_due_ms(), 50);
+
+  sched.poll(61, ignore);  // 50 lost, 60 serviced within its deadline
+  CHECK_EQ(sched.deadline_misses(), 5U);
+  CHECK_EQ(sched.next_due_ms(), 70);
+}
+
+HOST_TEST(scheduler, serviced_release_counts_once) {
+  static constexpr std::array<MessageSpec, 1> table = {{
+      {.id = 1, .dlc = 1, .period_ms = 10, .deadline_ms = 10},
+  }};
+  PeriodicScheduler sched(table, 0);
+  auto ignore = [](const MessageSpec&) {};
+
+  /* Release 0 lost, release 10 serviced 5 ms late: one miss, not two */
+  sched.poll(15, ignore);
+  CHECK_EQ(sched.deadline_misses(), 1U);
+  CHECK_EQ(sched.next_due_ms(), 20);
+
+  sched.poll(30, ignore);  // 20 lost, 30 on time
+  CHECK_EQ(sched.deadline_misses(), 2U);
+}
+
+HOST_TEST(spsc_queue, fifo_full_and_watermark) {
+  SpscQueue<int, 4> queue;
+  int value = 0;
+
+  CHECK(!queue.pop(value));
+  for (int i = 0; i < 4; i++) {
+    CHECK(queue.push(i));
+  }
+  CHECK(!queue.push(99));
+  CHECK_EQ(queue.high_watermark(), 4U);
+
+  for (int i = 0; i < 4; i++) {
+    CHECK(queue.pop(value));
+    CHECK_EQ(value, i);
+  }
+  CHECK_EQ(queue.size(), 0U);
+
+  /* Indices keep wrapping past the capacity */
+  for (int i = 0; i < 10; i++) {
+    CHECK(queue.push(i));
+    CHECK(queue.pop(value));
+    CHECK_EQ(value, i);
+  }
+}
+
+HOST_TEST(diag_codec, round_trip_and_saturation) {
+  struct can_frame frame;
+  DiagPayload out = {};
+  DiagPayload in = {.cpu_load_pct = 42,
+                    .max_queue_depth = 9,
+                    .deadline_misses = 3,
+                    .tx_errors = 255,
+                    .bus_off_count = 2,
+                    .alive_counter = 15,
+                    .uptime_s = 86400};
+
+  encode_diag_frame(in, frame);
+  CHECK_EQ(frame.id, Config::CAN_DIAG_MSG_ID);
+  CHECK_EQ(frame.dlc, Config::CAN_DIAG_MSG_DLC);
+  CHECK(decode_diag_frame(frame, out));
+  CHECK_EQ(out.cpu_load_pct, 42);
+  CHECK_EQ(out.max_queue_depth, 9);
+  CHECK_EQ(out.deadline_misses, 3);
+  CHECK_EQ(out.tx_errors, 255);
+  CHECK_EQ(out.bus_off_count, 2);
+  CHECK_EQ(out.alive_counter, 15);
+  CHECK_EQ(out.uptime_s, 86400U);
+
+  /* Fields clamp instead of wrapping */
+  in.bus_off_count = 40;
+  in.max_queue_depth = 200;
+  encode_diag_frame(in, frame);
+  CHECK(decode_diag_frame(frame, out));
+  CHECK_EQ(out.bus_off_count, 15);
+  CHECK_EQ(out.max_queue_depth, 63);
+  CHECK_EQ(out.tx_errors, 255);
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the retained crash ring: the record is left in place
+ * between two begin() calls the way a warm reset leaves no-init RAM, and
+ * filled with garbage for a cold boot.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <cstring>
+
+#include "core/crash_ring.hpp"
+#include "core/diag_codec.hpp"
+#include "harness.hpp"
+
+namespace {
+
+constexpr size_t FRAMES = 4;
+
+using Record = CrashRecord<FRAMES>;
+using Report = CrashReport<FRAMES>;
+
+TimedFrame frame(uint32_t id, uint32_t ts_us) {
+  struct can_frame f = {};
+
+  f.id = id;
+  f.dlc = 2;
+  f.data[0] = static_cast<uint8_t>(id);
+  f.data[1] = static_cast<uint8_t>(id >> 8);
+  return TimedFrame::from(f, FrameDir::Tx, ts_us);
+}
+
+/* Power-on contents of the no-init section */
+void cold(Record& record) {
+  auto* bytes = reinterpret_cast<uint8_t*>(&record);
+
+  for (size_t i = 0; i < sizeof(record); i++) {
+    bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+  }
+}
+
+CrashCounters counters(uint32_t base) {
+  return {.tx_frames = base,
+          .tx_errors = base + 1,
+          .rx_frames = base + 2,
+          .rx_dropped = base + 3,
+          .deadline_misses = base + 4,
+          .bus_off_count = base + 5};
+}
+
+}  // namespace
+
+HOST_TEST(crash_ring, cold_boot_is_not_a_report) {
+  Record record;
+  Report report;
+
+  cold(record);
+  CHECK(!record.begin(report));
+  CHECK_EQ(report.frame_count, size_t{0});
+  CHECK_EQ(record.warm_resets, 0U);
+}
+
+HOST_TEST(crash_ring, warm_reset_keeps_counters_and_frames) {
+  Record record;
+  Report report;
+
+  cold(record);
+  record.begin(report);
+  record.record(frame(0x100, 10));
+  record.record(frame(0x101, 20));
+  record.seal(counters(50), {.uptime_ms = 1234,
+                             .next_due_ms = 1240,
+                             .polls = 99,
+                             .profile = 2,
+                             .reserved = {}});
+
+  CHECK(record.begin(report));
+  CHECK_EQ(report.warm_resets, 1U);
+  CHECK_EQ(report.counters.tx_frames, 50U);
+  CHECK_EQ(report.counters.bus_off_count, 55U);
+  CHECK_EQ(report.sched.uptime_ms, 1234U);
+  CHECK_EQ(report.sched.polls, 99U);
+  CHECK_EQ(report.sched.profile, uint8_t{2});
+  CHECK_EQ(report.frame_count, size_t{2});
+  CHECK_EQ(report.frames[0].id, 0x101U);  // Newest first
+  CHECK_EQ(report.frames[1].timestamp_us, 10U);
+
+  /* The next run starts empty but counts resets in a row */
+  CHECK(record.begin(report));
+  CHECK_EQ(report.warm_resets, 2U);
+  CHECK_EQ(report.frame_count, size_t{0});
+}
+
+HOST_TEST(crash_ring, keeps_the_newest_after_wrapping) {
+  Record record;
+  Report report;
+
+  cold(record);
+  record.begin(report);
+  for (uint32_t i = 0; i < 10; i++) {
+    record.record(frame(0x200 + i, i));
+  }
+
+  CHECK(record.begin(report));
+  CHECK_EQ(report.frame_count, FRAMES);
+  for (size_t i = 0; i < FRAMES; i++) {
+    CHECK_EQ(report.frames[i].id, 0x209U - i);
+  }
+}
+
+HOST_TEST(crash_ring, drops_a_torn_entry) {
+  Record record;
+  Report report;
+
+  cold(record);
+  record.begin(report);
+  record.record(frame(0x300, 1));
+  record.record(frame(0x301, 2));
+  record.record(frame(0x302, 3));
+
+  /* Reset in the middle of writing the second entry */
+  record.entries[1].frame.data[0] ^= 0xFF;
+
+  CHECK(record.begin(report));
+  CHECK_EQ(report.frame_count, size_t{2});
+  CHECK_EQ(report.frames[0].id, 0x302U);
+  CHECK_EQ(report.frames[1].id, 0x300U);
+}
+
+HOST_TEST(crash_ring, corrupted_header_is_not_a_report) {
+  Record record;
+  Report report;
+
+  cold(record);
+  record.begin(report);
+  record.record(frame(0x400, 1));
+  record.seal(counters(7), {});
+  record.counters.tx_errors ^= 1;
+
+  CHECK(!record.begin(report));
+  CHECK_EQ(report.frame_count, size_t{0});
+  CHECK_EQ(record.warm_resets, 0U);
+}
+
+HOST_TEST(crash_ring, report_frame_round_trips) {
+  CrashReportPayload sent = {.warm_resets = 3,
+                             .uptime_s = 86400,
+                             .profile = 1,
+                             .deadline_misses = 200,
+                             .tx_errors = 4,
+                             .rx_dropped = 5,
+                             .bus_off_count = 20,  // Saturates to 15
+                             .frames = 9};
+  CrashReportPayload got = {};
+  struct can_frame f;
+
+  encode_crash_report_frame(sent, f);
+  CHECK_EQ(f.id, Config::CAN_CRASH_REPORT_MSG_ID);
+  CHECK(decode_crash_report_frame(f, got));
+  CHECK_EQ(got.warm_resets, uint8_t{3});
+  CHECK_EQ(got.uptime_s, 86400U);
+  CHECK_EQ(got.profile, uint8_t{1});
+  CHECK_EQ(got.deadline_misses, uint8_t{200});
+  CHECK_EQ(got.rx_dropped, uint8_t{5});
+  CHECK_EQ(got.bus_off_count, uint8_t{15});
+  CHECK_EQ(got.frames, uint8_t{9});
+
+  f.id = Config::CAN_DIAG_MSG_ID;
+  CHECK(!decode_crash_report_frame(f, got));
+}
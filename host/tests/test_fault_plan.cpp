@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the fault-injection decision plan.
+ */
+
+#include <array>
+
+#include "core/fault_plan.hpp"
+#include "harness.hpp"
+
+HOST_TEST(fault_plan, clean_by_default) {
+  FaultPlan plan(7);
+
+  for (int i = 0; i < 1000; i++) {
+    CHECK(plan.next(8).kind == FaultKind::None);
+  }
+}
+
+HOST_TEST(fault_plan, script_hits_exact_frames) {
+  static const FaultStep script[] = {
+      {.frame = 1, .kind = FaultKind::Drop, .arg = 0},
+      {.frame = 3, .kind = FaultKind::Delay, .arg = 25},
+      {.frame = 3, .kind = FaultKind::Drop, .arg = 0},  // Same frame: ignored
+      {.frame = 4, .kind = FaultKind::BusOff, .arg = 80},
+  };
+  FaultPlan plan(1);
+
+  plan.set_script(script, 4);
+  CHECK(plan.next(1).kind == FaultKind::None);
+  CHECK(plan.next(1).kind == FaultKind::Drop);
+  CHECK(plan.next(1).kind == FaultKind::None);
+
+  FaultAction delay = plan.next(1);
+  CHECK(delay.kind == FaultKind::Delay);
+  CHECK_EQ(delay.arg, 25U);
+
+  FaultAction bus_off = plan.next(1);
+  CHECK(bus_off.kind == FaultKind::BusOff);
+  CHECK_EQ(bus_off.arg, 80U);
+  CHECK(plan.script_done());
+  CHECK(plan.next(1).kind == FaultKind::None);
+}
+
+HOST_TEST(fault_plan, corrupt_stays_in_payload) {
+  static const FaultStep script[] = {
+      {.frame = 0, .kind = FaultKind::Corrupt, .arg = 63},
+      {.frame = 1, .kind = FaultKind::Corrupt, .arg = 63},
+      {.frame = 2, .kind = FaultKind::Corrupt, .arg = 5},
+  };
+  FaultPlan plan(3);
+
+  plan.set_script(script, 3);
+  CHECK_EQ(plan.next(8).arg, 63U);
+  CHECK(plan.next(2).arg < 16U);  // Out of range: random bit in payload
+  CHECK(plan.next(0).kind == FaultKind::None);
+
+  plan.set_probability(FaultKind::Corrupt, 1000);
+  for (int i = 0; i < 100; i++) {
+    FaultAction a = plan.next(3);
+    CHECK(a.kind == FaultKind::Corrupt);
+    CHECK(a.arg < 24U);
+  }
+}
+
+HOST_TEST(fault_plan, probability_and_seed) {
+  FaultPlan a(42);
+  FaultPlan b(42);
+  int drops = 0;
+
+  a.set_probability(FaultKind::Drop, 250);
+  b.set_probability(FaultKind::Drop, 250);
+  for (int i = 0; i < 10000; i++) {
+    FaultKind ka = a.next(8).kind;
+
+    CHECK(ka == b.next(8).kind);
+    drops += (ka == FaultKind::Drop) ? 1 : 0;
+  }
+  CHECK(drops > 2300 && drops < 2700);
+
+  a.set_probability(FaultKind::Drop, 5000);
+  CHECK_EQ(a.probability(FaultKind::Drop), 1000);
+}
+
+HOST_TEST(fault_plan, random_defaults_carry_arguments) {
+  FaultPlan plan(9);
+
+  plan.set_delay_ms(33);
+  plan.set_probability(FaultKind::Delay, 1000);
+  FaultAction a = plan.next(8);
+  CHECK(a.kind == FaultKind::Delay);
+  CHECK_EQ(a.arg, 33U);
+
+  plan.set_bus_off_ms(120);
+  plan.set_probability(FaultKind::BusOff, 1000);
+  a = plan.next(8);
+  CHECK(a.kind == FaultKind::BusOff);  // Rolled before delay
+  CHECK_EQ(a.arg, 120U);
+}
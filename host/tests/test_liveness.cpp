@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the heartbeat frame and the peer liveness table.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+
+#include "app_config.hpp"
+#include "core/liveness.hpp"
+#include "harness.hpp"
+
+namespace {
+
+struct Events {
+  std::array<uint32_t, 64> up{};
+  std::array<uint32_t, 64> down{};
+  uint32_t now = 0;  // Time of the sweep that reported the change
+  uint32_t last_down_at = 0;
+};
+
+void record(uint8_t peer, bool alive, void* user_data) {
+  Events& ev = *static_cast<Events*>(user_data);
+
+  if (alive) {
+    ev.up[peer]++;
+  } else {
+    ev.down[peer]++;
+    ev.last_down_at = ev.now;
+  }
+}
+
+}  // namespace
+
+HOST_TEST(liveness, heartbeat_codec) {
+  struct can_frame frame;
+  uint8_t node = 0;
+
+  encode_heartbeat_frame(0x2A, 0x13, frame);
+  CHECK_EQ(frame.id, Config::CAN_HEARTBEAT_BASE_ID + 0x2A);
+  CHECK_EQ(frame.dlc, 1);
+  CHECK_EQ(frame.data[0], 0x03);  // 4-bit counter
+  CHECK(decode_heartbeat_frame(frame, node));
+  CHECK_EQ(node, 0x2A);
+
+  frame.id = Config::CAN_NM_BASE_ID + 0x2A;
+  CHECK(!decode_heartbeat_frame(frame, node));
+  frame.id = Config::CAN_HEARTBEAT_BASE_ID;
+  frame.dlc = 0;
+  CHECK(!decode_heartbeat_frame(frame, node));
+}
+
+HOST_TEST(liveness, appear_and_timeout_callbacks) {
+  Events ev;
+  PeerTable<64> table(30, record, &ev);
+
+  CHECK_EQ(table.sweep(0), 0U);
+  table.note(5, 1);
+  table.note(40, 2);
+  table.note(200, 3);  // Out of range: ignored
+  CHECK_EQ(table.sweep(5), 2U);
+  CHECK_EQ(ev.up[5], 1U);
+  CHECK_EQ(ev.up[40], 1U);
+  CHECK(table.is_alive(5) && table.is_alive(40));
+
+  /* Heard again: no second appear event */
+  table.note(5, 20);
+  CHECK_EQ(table.sweep(25), 2U);
+  CHECK_EQ(ev.up[5], 1U);
+
+  /* 40 last seen at 2 ms, so 33 ms is past the 30 ms timeout */
+  CHECK_EQ(table.sweep(32), 2U);
+  CHECK_EQ(table.sweep(33), 1U);
+  CHECK_EQ(ev.down[40], 1U);
+  CHECK(!table.is_alive(40));
+  CHECK_EQ(table.lost(), 1U);
+
+  /* A lost peer that comes back is reported again */
+  table.note(40, 40);
+  CHECK_EQ(table.sweep(45), 2U);
+  CHECK_EQ(ev.up[40], 2U);
+}
+
+HOST_TEST(liveness, dead_wheel_detected_within_timeout_plus_sweep) {
+  constexpr uint32_t HEARTBEAT_MS = 10;
+  constexpr uint32_t TIMEOUT_MS = 30;
+  constexpr uint32_t SWEEP_MS = 5;
+  constexpr uint8_t WHEEL = 0x10;
+  constexpr uint32_t LAST_HEARTBEAT = 494;  // (t + WHEEL) % 10 == 0
+  Events ev;
+  PeerTable<64> table(TIMEOUT_MS, record, &ev);
+
+  /* 64 peers with staggered 10 ms heartbeats, swept every 5 ms */
+  for (uint32_t t = 0; t <= 1000; t++) {
+    for (uint8_t p = 0; p < 64; p++) {
+      bool dead = p == WHEEL && t > LAST_HEARTBEAT;
+
+      if (!dead && (t + p) % HEARTBEAT_MS == 0) {
+        table.note(p, t);
+      }
+    }
+    if (t % SWEEP_MS == 0) {
+      ev.now = t;
+      table.sweep(t);
+    }
+  }
+
+  for (uint8_t p = 0; p < 64; p++) {
+    CHECK_EQ(ev.up[p], 1U);
+    CHECK_EQ(ev.down[p], p == WHEEL ? 1U : 0U);
+  }
+  CHECK(ev.last_down_at > LAST_HEARTBEAT + TIMEOUT_MS);
+  CHECK(ev.last_down_at <= LAST_HEARTBEAT + TIMEOUT_MS + SWEEP_MS);
+}
+
+HOST_TEST(liveness, uptime_wraparound) {
+  Events ev;
+  PeerTable<32> table(30, record, &ev);
+  uint32_t t = UINT32_MAX - 10;
+
+  table.note(3, t);
+  table.sweep(t);
+  CHECK(table.is_alive(3));
+
+  /* 20 ms later, across the 32-bit wrap */
+  CHECK_EQ(table.sweep(t + 20), 1U);
+  CHECK_EQ(ev.down[3], 0U);
+  CHECK_EQ(table.sweep(t + 31), 0U);
+  CHECK_EQ(ev.down[3], 1U);
+}
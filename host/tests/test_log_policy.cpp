@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the hot-path log policy (sampling, rate limit, summaries).
+ */
+
+#include "core/log_policy.hpp"
+#include "harness.hpp"
+
+HOST_TEST(log_policy, sampling_one_in_n) {
+  HotLogSite site(4, 1000, 1000);
+  uint32_t admitted = 0;
+
+  for (int i = 0; i < 100; i++) {
+    if (site.admit(0)) {
+      admitted++;
+      CHECK_EQ(i % 4, 0);  // First event, then every 4th
+    }
+  }
+  CHECK_EQ(admitted, 25U);
+  CHECK_EQ(site.suppressed_total(), 75U);
+}
+
+HOST_TEST(log_policy, rate_limit_and_suppressed_count) {
+  HotLogSite site(1, 10, 3);
+  uint32_t admitted = 0;
+
+  /* 1000 events within one millisecond: only the burst gets through */
+  for (int i = 0; i < 1000; i++) {
+    admitted += site.admit(0) ? 1 : 0;
+  }
+  CHECK_EQ(admitted, 3U);
+  CHECK_EQ(site.take_suppressed(), 997U);
+  CHECK_EQ(site.take_suppressed(), 0U);
+
+  /* 10 lines per second sustained */
+  admitted = 0;
+  for (int64_t ms = 1; ms <= 1000; ms++) {
+    admitted += site.admit(ms) ? 1 : 0;
+  }
+  CHECK_EQ(admitted, 10U);
+  CHECK_EQ(site.suppressed_total(), 997U + 990U);
+}
+
+HOST_TEST(log_policy, zero_sampling_logs_everything) {
+  HotLogSite site(0, 1000, 1000);
+
+  CHECK(site.admit(0));
+  CHECK(site.admit(0));
+}
+
+HOST_TEST(log_policy, event_window) {
+  EventWindow window(1000);
+  EventSummary s;
+
+  CHECK(!window.close(5000, s));  // No events yet
+  for (int64_t ms = 100; ms < 1100; ms++) {
+    window.note(ms, ms % 250 == 0);
+  }
+  CHECK(!window.close(1099, s));
+  CHECK(window.close(1100, s));
+  CHECK_EQ(s.events, 1000U);
+  CHECK_EQ(s.errors, 4U);
+  CHECK_EQ(s.window_ms, 1000U);
+
+  /* After an idle gap, the window re-aligns instead of reporting zeros */
+  window.note(5300);
+  CHECK(window.close(6100, s));
+  CHECK_EQ(s.events, 1U);
+  CHECK(!window.close(6500, s));
+  CHECK(window.close(7100, s));
+  CHECK_EQ(s.events, 0U);
+}
+
+HOST_TEST(log_policy, summary_only_when_lines_were_lost) {
+  HotPathLog quiet(1, 5, 10, 1000);
+  HotPathLog busy(1, 5, 10, 1000);
+  EventSummary s;
+
+  /* One event every 500 ms: all logged, no summary needed */
+  for (int64_t ms = 0; ms <= 3000; ms += 500) {
+    CHECK(quiet.event(ms));
+    CHECK(!quiet.summary(ms, s));
+  }
+
+  /* 1 kHz: the burst and 5 lines/s get through, the summary reports the
+   * rest */
+  uint32_t admitted = 0;
+  for (int64_t ms = 0; ms < 1000; ms++) {
+    admitted += busy.event(ms, ms == 500) ? 1 : 0;
+  }
+  CHECK(busy.summary(1000, s));
+  CHECK_EQ(s.events, 1000U);
+  CHECK_EQ(s.errors, 1U);
+  CHECK_EQ(s.suppressed, 1000U - admitted);
+  CHECK(admitted <= 15U);
+}
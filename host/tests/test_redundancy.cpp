@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for redundant transmission: receiver dedup of the copies from
+ * two buses and the failover/recovery decisions.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include "core/redundancy.hpp"
+#include "harness.hpp"
+
+namespace {
+
+constexpr int64_t RECOVER_US = 1000000;
+constexpr int64_t RESTART_US = 500000;
+constexpr int64_t PERIOD_US = 10000;  // Between two gear frames
+
+/* The RX path: check, then accept what passes */
+bool receive(AliveFilter& filter, uint8_t alive, int64_t now_us) {
+  if (filter.check(alive, now_us) != AliveVerdict::New) {
+    return false;
+  }
+  filter.accept(alive, now_us);
+  return true;
+}
+
+}  // namespace
+
+HOST_TEST(redundancy, alive_round_trips) {
+  struct can_frame f = {};
+  uint8_t alive = 0;
+
+  f.dlc = 2;
+  f.data[0] = 0x11;
+  f.data[1] = 0x22;
+  CHECK(Redundancy::append_alive(f, 0xA5));
+  CHECK_EQ(f.dlc, uint8_t{3});
+  CHECK(Redundancy::strip_alive(f, alive));
+  CHECK_EQ(alive, uint8_t{0xA5});
+  CHECK_EQ(f.dlc, uint8_t{2});
+  CHECK_EQ(f.data[1], uint8_t{0x22});
+
+  f.dlc = 8;
+  CHECK(!Redundancy::append_alive(f, 1));
+  f.dlc = 0;
+  CHECK(!Redundancy::strip_alive(f, alive));
+}
+
+HOST_TEST(redundancy, keeps_first_copy_of_each_counter) {
+  AliveFilter filter(RESTART_US);
+  uint32_t delivered = 0;
+
+  /* Both buses, wrapping the counter, either copy first */
+  for (uint32_t i = 0; i < 600; i++) {
+    uint8_t alive = static_cast<uint8_t>(i);
+
+    delivered += receive(filter, alive, i * PERIOD_US);
+    delivered += receive(filter, alive, i * PERIOD_US + 100);
+  }
+  CHECK_EQ(delivered, 600U);
+  CHECK_EQ(filter.duplicates(), 600U);
+  CHECK_EQ(filter.lost(), 0U);
+}
+
+HOST_TEST(redundancy, lagging_bus_copies_are_stale) {
+  AliveFilter filter(RESTART_US);
+  uint32_t delivered = 0;
+
+  /* The second bus runs three frames behind the first */
+  for (uint32_t i = 0; i < 20; i++) {
+    delivered += receive(filter, static_cast<uint8_t>(i), i * PERIOD_US);
+    if (i >= 3) {
+      delivered +=
+          receive(filter, static_cast<uint8_t>(i - 3), i * PERIOD_US + 100);
+    }
+  }
+  CHECK_EQ(delivered, 20U);
+  CHECK_EQ(filter.stale(), 17U);
+  CHECK_EQ(filter.resyncs(), 0U);
+}
+
+HOST_TEST(redundancy, backlog_flush_does_not_go_back) {
+  AliveFilter filter(RESTART_US);
+  int64_t now = 0;
+
+  /* The second bus stalls while the first delivers 0..9 */
+  for (uint8_t i = 0; i < 10; i++) {
+    CHECK(receive(filter, i, now));
+    now += PERIOD_US;
+  }
+
+  /* Then it flushes its backlog in one go, right behind the first bus */
+  for (uint8_t i = 6; i < 10; i++) {
+    CHECK(!receive(filter, i, now + i));
+  }
+  CHECK_EQ(filter.stale(), 3U);
+  CHECK_EQ(filter.duplicates(), 1U);
+  CHECK_EQ(filter.resyncs(), 0U);
+
+  /* The quiet gap before the next frame does not matter either */
+  CHECK(!receive(filter, 9, now + RESTART_US / 2));
+  CHECK(receive(filter, 10, now + RESTART_US));
+  CHECK_EQ(filter.lost(), 0U);
+}
+
+HOST_TEST(redundancy, counts_counters_lost_on_both_buses) {
+  AliveFilter filter(RESTART_US);
+
+  receive(filter, 10, 0);
+  receive(filter, 11, PERIOD_US);
+  receive(filter, 15, 2 * PERIOD_US);  // 12..14 on neither bus
+  CHECK_EQ(filter.lost(), 3U);
+  CHECK_EQ(filter.accepted(), 3U);
+}
+
+HOST_TEST(redundancy, resyncs_after_sender_restart) {
+  AliveFilter filter(RESTART_US);
+  int64_t now = 0;
+
+  for (uint8_t i = 0; i < 100; i++) {
+    receive(filter, i, now);
+    now += PERIOD_US;
+  }
+
+  /* The sender rebooted and counts from 0 again: old counters until the
+   * restart time has passed since the last accepted one */
+  int64_t last = now - PERIOD_US;
+
+  CHECK(!receive(filter, 0, last + RESTART_US / 2));
+  CHECK(!receive(filter, 1, last + RESTART_US - 1));
+  CHECK(receive(filter, 2, last + RESTART_US));
+  CHECK_EQ(filter.resyncs(), 1U);
+  CHECK(receive(filter, 3, last + RESTART_US + PERIOD_US));
+  CHECK(!receive(filter, 3, last + RESTART_US + PERIOD_US + 100));
+}
+
+HOST_TEST(redundancy, uncommitted_counter_does_not_shadow) {
+  AliveFilter filter(RESTART_US);
+
+  receive(filter, 5, 0);
+
+  /* A copy of 6 that failed its checks is not accepted... */
+  CHECK(filter.check(6, PERIOD_US) == AliveVerdict::New);
+
+  /* ...so the genuine copy on the other bus still gets through */
+  CHECK(receive(filter, 6, PERIOD_US + 100));
+}
+
+HOST_TEST(redundancy, error_state_fails_over_at_once) {
+  BusFailover<2> failover(3, RECOVER_US);
+
+  CHECK(failover.note_state(0, false, 1000));
+  CHECK_EQ(failover.mask(), 0b10U);
+  CHECK_EQ(failover.failovers(), 1U);
+  CHECK_EQ(failover.last_failover_us(), int64_t{0});
+
+  /* Already out: no second failover */
+  CHECK(!failover.note_state(0, false, 2000));
+  CHECK_EQ(failover.failovers(), 1U);
+}
+
+HOST_TEST(redundancy, tx_errors_fail_over_after_threshold) {
+  BusFailover<2> failover(3, RECOVER_US);
+
+  CHECK(!failover.note_tx(1, false, 100));
+  CHECK(!failover.note_tx(1, true, 200));  // A success resets the run
+  CHECK(!failover.note_tx(1, false, 300));
+  CHECK(!failover.note_tx(1, false, 400));
+  CHECK(failover.note_tx(1, false, 500));
+  CHECK_EQ(failover.mask(), 0b01U);
+  CHECK_EQ(failover.last_failover_us(), int64_t{200});
+  CHECK_EQ(failover.max_failover_us(), int64_t{200});
+}
+
+HOST_TEST(redundancy, keeps_the_last_bus) {
+  BusFailover<2> failover(1, RECOVER_US);
+
+  CHECK(failover.note_state(0, false, 0));
+  CHECK(!failover.note_state(1, false, 0));
+  CHECK(!failover.note_tx(1, false, 10));
+  CHECK_EQ(failover.mask(), 0b10U);
+  CHECK(failover.in_service(1));
+}
+
+HOST_TEST(redundancy, recovers_after_quiet_time) {
+  constexpr int64_t OK_AT = 1000 + 2 * RECOVER_US;
+  BusFailover<2> failover(2, RECOVER_US);
+
+  failover.note_state(0, false, 1000);
+
+  /* Still bus-off: however long, the bus stays out */
+  CHECK_EQ(failover.poll(OK_AT), size_t{0});
+
+  /* The quiet time starts when the controller is fine again */
+  failover.note_state(0, true, OK_AT);
+  CHECK_EQ(failover.poll(OK_AT + RECOVER_US - 1), size_t{0});
+  CHECK_EQ(failover.poll(OK_AT + RECOVER_US), size_t{1});
+  CHECK_EQ(failover.mask(), 0b11U);
+  CHECK_EQ(failover.recoveries(), 1U);
+
+  /* Back with a clean TX error run */
+  CHECK(!failover.note_tx(0, false, OK_AT + 2 * RECOVER_US));
+  CHECK(failover.note_tx(0, false, OK_AT + 2 * RECOVER_US + 10));
+}
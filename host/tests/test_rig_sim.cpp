@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the multi-node rig simulation.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include "core/can_timing.hpp"
+#include "core/rig_sim.hpp"
+#include "harness.hpp"
+
+namespace {
+
+constexpr uint32_t BITRATE = 500000;
+
+}  // namespace
+
+HOST_TEST(rig_sim, single_node_latency_is_frame_time) {
+  RigSim<4> sim(1, BITRATE);
+  RigReport r = sim.run(1000);
+
+  /* A lone base node: 500 status frames plus one diag frame at t = 0 */
+  CHECK_EQ(r.frames, 501U);
+  CHECK_EQ(r.deadline_misses, 0U);
+  CHECK_EQ(r.dropped, 0U);
+  CHECK_EQ(sim.node(0).received, 0U);
+
+  /* The diag frame waits for the status frame released with it */
+  CHECK(r.max_latency_ns <= can_bits_to_ns(2 * CanTiming::max_frame_bits(
+                                                   false, 8),
+                                           BITRATE));
+  CHECK(r.load_permille() > 0);
+}
+
+HOST_TEST(rig_sim, nodes_hear_their_peers) {
+  RigSim<4> sim(3, BITRATE);
+  RigReport r = sim.run(100);
+  const RigNodeStats& base = sim.node(0);
+  const RigNodeStats& pedals = sim.node(1);
+  const RigNodeStats& wheel = sim.node(2);
+
+  CHECK_EQ(r.deadline_misses, 0U);
+  /* Diagnostic frames (one per node at t = 0) match no filter */
+  CHECK_EQ(base.received, pedals.sent + wheel.sent - 2);
+  CHECK_EQ(pedals.received, base.sent - 1);
+  CHECK_EQ(wheel.received, pedals.received);
+}
+
+HOST_TEST(rig_sim, load_grows_until_timing_breaks) {
+  uint32_t prev_load = 0;
+  size_t first_broken = 0;
+
+  for (size_t n = 1; n <= 32; n++) {
+    RigSim<32> sim(n, BITRATE);
+    RigReport r = sim.run(200);
+
+    /* Monotonic until the bus saturates */
+    CHECK(r.load_permille() >= prev_load || prev_load >= 990);
+    CHECK(r.load_permille() <= 1000);
+    prev_load = r.load_permille();
+    if (first_broken == 0 && r.deadline_misses + r.dropped != 0) {
+      first_broken = n;
+    }
+  }
+
+  /* About 24 % load per base/pedals/wheel triple at 500 kbit/s */
+  CHECK(first_broken > 3);
+  CHECK(first_broken <= 16);
+  CHECK(prev_load > 950);
+}
+
+HOST_TEST(rig_sim, overload_never_looks_faster) {
+  uint64_t prev_max = 0;
+
+  for (size_t n = 10; n <= 20; n++) {
+    RigSim<32> sim(n, BITRATE);
+    RigReport r = sim.run(500);
+
+    /* Frames that never got on the bus count at their age */
+    CHECK(r.max_latency_ns >= prev_max);
+    CHECK(r.deadline_misses >= r.dropped);
+    prev_max = r.max_latency_ns;
+  }
+
+  /* The diag frames released at t = 0 starve for the whole run */
+  CHECK_EQ(prev_max, 500ULL * 1000000ULL);
+}
+
+HOST_TEST(rig_sim, deterministic) {
+  RigSim<16> a(12, BITRATE);
+  RigSim<16> b(12, BITRATE);
+  RigReport ra = a.run(500);
+  RigReport rb = b.run(500);
+
+  CHECK_EQ(ra.frames, rb.frames);
+  CHECK_EQ(ra.busy_ns, rb.busy_ns);
+  CHECK_EQ(ra.max_latency_ns, rb.max_latency_ns);
+  for (size_t n = 0; n < 12; n++) {
+    CHECK_EQ(a.node(n).latency_sum_ns, b.node(n).latency_sum_ns);
+  }
+}
+
+HOST_TEST(rig_sim, reset_matches_fresh_instance) {
+  RigSim<16> reused(16, 1000000);
+  RigSim<16> fresh(5, BITRATE);
+
+  reused.run(300);
+  reused.reset(5, BITRATE);
+  RigReport a = reused.run(300);
+  RigReport b = fresh.run(300);
+
+  CHECK_EQ(reused.size(), 5U);
+  CHECK_EQ(a.frames, b.frames);
+  CHECK_EQ(a.busy_ns, b.busy_ns);
+  CHECK_EQ(a.max_latency_ns, b.max_latency_ns);
+  CHECK_EQ(reused.arbitration_losses(1), fresh.arbitration_losses(1));
+}
+
+HOST_TEST(rig_sim, node_count_is_clamped) {
+  RigSim<4> sim(10, BITRATE);
+
+  CHECK_EQ(sim.size(), 4U);
+}
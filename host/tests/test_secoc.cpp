@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for AES-128, AES-CMAC (FIPS-197 and RFC 4493 vectors) and
+ * SecOC-style frame authentication.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstring>
+
+#include "app_config.hpp"
+#include "core/aes128.hpp"
+#include "core/cmac.hpp"
+#include "core/gear_codec.hpp"
+#include "core/secoc.hpp"
+#include "harness.hpp"
+
+namespace {
+
+using Block = std::array<uint8_t, 16>;
+
+/* RFC 4493 section 4 */
+constexpr Block RFC_KEY = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                           0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+
+constexpr std::array<uint8_t, 64> RFC_MSG = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+    0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03,
+    0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51, 0x30,
+    0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19,
+    0x1a, 0x0a, 0x52, 0xef, 0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b,
+    0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10};
+
+bool same(const uint8_t* a, const Block& b) {
+  return std::memcmp(a, b.data(), b.size()) == 0;
+}
+
+/* A gear frame protected by its own sender, as the wheel sends it */
+struct can_frame secured_gear(SecOcSender& tx, const Cmac& cmac, Gear g) {
+  struct can_frame frame;
+
+  encode_gear_frame(g, frame);
+  tx.protect(cmac, frame);
+  return frame;
+}
+
+}  // namespace
+
+HOST_TEST(secoc, aes128_fips197_vector) {
+  Block key{};
+  Block pt{};
+  Block ct{};
+
+  for (uint8_t i = 0; i < 16; i++) {
+    key[i] = i;
+    pt[i] = static_cast<uint8_t>(i * 0x11);
+  }
+  Aes128 aes(key.data());
+  aes.encrypt(pt.data(), ct.data());
+  CHECK(same(ct.data(), {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+                         0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a}));
+
+  /* The key schedule is constexpr, so this is worked out at build time */
+  constexpr Aes128 built(RFC_KEY.data());
+  Block zero{};
+  Block a{};
+  Block b{};
+  built.encrypt(zero.data(), a.data());
+  Aes128(RFC_KEY.data()).encrypt(zero.data(), b.data());
+  CHECK(a == b);
+}
+
+HOST_TEST(secoc, cmac_rfc4493_vectors) {
+  Cmac cmac(RFC_KEY.data());
+  Block mac{};
+
+  CHECK(cmac.subkey1() == Block({0xfb, 0xee, 0xd6, 0x18, 0x35, 0x71, 0x33,
+                                 0x66, 0x7c, 0x85, 0xe0, 0x8f, 0x72, 0x36,
+                                 0xa8, 0xde}));
+  CHECK(cmac.subkey2() == Block({0xf7, 0xdd, 0xac, 0x30, 0x6a, 0xe2, 0x66,
+                                 0xcc, 0xf9, 0x0b, 0xc1, 0x1e, 0xe4, 0x6d,
+                                 0x51, 0x3b}));
+
+  cmac.compute(RFC_MSG.data(), 0, mac.data());
+  CHECK(same(mac.data(), {0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28,
+                          0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46}));
+  cmac.compute(RFC_MSG.data(), 16, mac.data());
+  CHECK(same(mac.data(), {0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44,
+                          0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c}));
+  cmac.compute(RFC_MSG.data(), 40, mac.data());
+  CHECK(same(mac.data(), {0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30,
+                          0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27}));
+  cmac.compute(RFC_MSG.data(), 64, mac.data());
+  CHECK(same(mac.data(), {0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92,
+                          0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe}));
+
+  CHECK(cmac.verify(RFC_MSG.data(), 64, mac.data(), 3));
+  mac[2] ^= 0x01;
+  CHECK(!cmac.verify(RFC_MSG.data(), 64, mac.data(), 3));
+  CHECK(cmac.verify(RFC_MSG.data(), 64, mac.data(), 2));
+}
+
+HOST_TEST(secoc, protect_verify_round_trip) {
+  Cmac cmac(RFC_KEY.data());
+  SecOcSender tx;
+  SecOcReceiver rx;
+  Gear gear;
+
+  struct can_frame frame = secured_gear(tx, cmac, Gear::Third);
+  CHECK_EQ(frame.dlc, Config::CAN_MSG_DLC + SECOC_AUTH_BYTES);
+  CHECK_EQ(frame.data[1], 0x01);  // Truncated FV of the first frame
+
+  CHECK(rx.verify(cmac, frame) == SecOcVerdict::Ok);
+  CHECK_EQ(frame.dlc, Config::CAN_MSG_DLC);
+  CHECK(decode_gear_frame(frame, gear));
+  CHECK(gear == Gear::Third);
+  CHECK_EQ(rx.freshness_value(), 1U);
+
+  /* Payloads that leave no room for the authenticator are refused */
+  frame.dlc = 5;
+  CHECK(!tx.protect(cmac, frame));
+  CHECK_EQ(tx.freshness_value(), 1U);
+}
+
+HOST_TEST(secoc, rejects_forgery_tampering_and_replay) {
+  Cmac cmac(RFC_KEY.data());
+  Block other_key = RFC_KEY;
+  other_key[0] ^= 0xFF;
+  Cmac attacker(other_key.data());
+  SecOcSender tx;
+  SecOcSender forger;
+  SecOcReceiver rx;
+
+  /* Raw, unauthenticated gear byte */
+  struct can_frame raw;
+  encode_gear_frame(Gear::Sixth, raw);
+  CHECK(rx.verify(cmac, raw) == SecOcVerdict::TooShort);
+
+  /* Right layout, wrong key */
+  struct can_frame forged = secured_gear(forger, attacker, Gear::Sixth);
+  CHECK(rx.verify(cmac, forged) == SecOcVerdict::BadMac);
+
+  /* Payload changed in flight */
+  struct can_frame frame = secured_gear(tx, cmac, Gear::First);
+  struct can_frame tampered = frame;
+  tampered.data[0] = static_cast<uint8_t>(Gear::Sixth);
+  CHECK(rx.verify(cmac, tampered) == SecOcVerdict::BadMac);
+
+  /* Same frame recorded and sent again */
+  struct can_frame replay = frame;
+  CHECK(rx.verify(cmac, frame) == SecOcVerdict::Ok);
+  CHECK(rx.verify(cmac, replay) == SecOcVerdict::BadMac);
+  CHECK(rx.verify(cmac, tampered) == SecOcVerdict::BadMac);
+  CHECK_EQ(rx.freshness_value(), 1U);
+}
+
+HOST_TEST(secoc, freshness_survives_truncation_wrap_and_losses) {
+  Cmac cmac(RFC_KEY.data());
+  SecOcSender tx;
+  SecOcReceiver rx;
+
+  /* 600 frames: the 8-bit FV wraps twice, every third frame is lost */
+  for (uint32_t i = 1; i <= 600; i++) {
+    struct can_frame frame = secured_gear(tx, cmac, Gear::Second);
+
+    if (i % 3 != 0) {
+      CHECK(rx.verify(cmac, frame) == SecOcVerdict::Ok);
+    }
+  }
+  CHECK_EQ(rx.freshness_value(), 599U);
+
+  /* A full FV cycle lost: out of sync, as with AUTOSAR's window */
+  for (uint32_t i = 0; i < 256; i++) {
+    secured_gear(tx, cmac, Gear::Second);
+  }
+  struct can_frame late = secured_gear(tx, cmac, Gear::Second);
+  CHECK(rx.verify(cmac, late) == SecOcVerdict::BadMac);
+}
+
+HOST_TEST(secoc, sync_brings_back_a_lagging_or_restarted_receiver) {
+  Cmac cmac(RFC_KEY.data());
+  SecOcSender tx;
+  SecOcReceiver rx;
+  struct can_frame sync;
+
+  for (uint32_t i = 0; i < 300; i++) {
+    secured_gear(tx, cmac, Gear::Third);
+  }
+
+  /* Receiver restarted while the sender is past 255: lost until a sync */
+  struct can_frame frame = secured_gear(tx, cmac, Gear::Third);
+  CHECK(rx.verify(cmac, frame) == SecOcVerdict::BadMac);
+
+  tx.sync_frame(cmac, Config::CAN_SECOC_SYNC_MSG_ID, sync);
+  CHECK_EQ(sync.dlc, SECOC_SYNC_DLC);
+  CHECK(rx.sync(cmac, sync) == SecOcVerdict::Ok);
+  CHECK_EQ(rx.freshness_value(), 301U);
+  CHECK_EQ(rx.resync_count(), 1U);
+
+  frame = secured_gear(tx, cmac, Gear::Fourth);
+  CHECK(rx.verify(cmac, frame) == SecOcVerdict::Ok);
+
+  /* A sync is authenticated like a frame */
+  sync.data[0] ^= 0x01;
+  CHECK(rx.sync(cmac, sync) == SecOcVerdict::BadMac);
+}
+
+HOST_TEST(secoc, sender_reset_warm_and_cold) {
+  Cmac cmac(RFC_KEY.data());
+  SecOcSender tx;
+  SecOcReceiver rx;
+  struct can_frame frame;
+
+  for (uint32_t i = 0; i < 300; i++) {
+    frame = secured_gear(tx, cmac, Gear::Fifth);
+    CHECK(rx.verify(cmac, frame) == SecOcVerdict::Ok);
+  }
+
+  /* Warm reset: the FV kept in no-init RAM, no FV used twice */
+  SecOcSender warm;
+  warm.restore(tx.freshness_value());
+  frame = secured_gear(warm, cmac, Gear::Fifth);
+  CHECK(rx.verify(cmac, frame) == SecOcVerdict::Ok);
+  CHECK_EQ(rx.freshness_value(), 301U);
+
+  /* Cold boot: the sender starts over, and its frames fail... */
+  SecOcSender cold;
+  frame = secured_gear(cold, cmac, Gear::First);
+  CHECK(rx.verify(cmac, frame) == SecOcVerdict::BadMac);
+
+  /* ...and its sync cannot take the receiver back */
+  struct can_frame sync;
+  cold.sync_frame(cmac, Config::CAN_SECOC_SYNC_MSG_ID, sync);
+  CHECK(rx.sync(cmac, sync) == SecOcVerdict::Behind);
+  CHECK_EQ(rx.freshness_value(), 301U);
+
+  /* It asks for the receiver's FV and continues after it */
+  constexpr uint32_t NONCE = 0xC0FFEE01;
+  struct can_frame request;
+  struct can_frame answer;
+  uint64_t fv = 0;
+
+  SecOcSender::fv_request(Config::CAN_SECOC_FV_REQ_MSG_ID, NONCE, request);
+  CHECK_EQ(request.dlc, SECOC_NONCE_BYTES);
+  CHECK(rx.fv_answer(cmac, Config::CAN_SECOC_FV_ANSWER_MSG_ID, request,
+                     answer));
+  CHECK(!SecOcSender::fv_answer(cmac, NONCE + 1, answer, fv));
+  CHECK(SecOcSender::fv_answer(cmac, NONCE, answer, fv));
+  CHECK_EQ(fv, 301U);
+  cold.restore(fv);
+
+  frame = secured_gear(cold, cmac, Gear::Second);
+  CHECK(rx.verify(cmac, frame) == SecOcVerdict::Ok);
+  CHECK_EQ(rx.freshness_value(), 302U);
+
+  /* A tampered answer is refused */
+  answer.data[4] ^= 0x01;
+  CHECK(!SecOcSender::fv_answer(cmac, NONCE, answer, fv));
+}
+
+HOST_TEST(secoc, forged_frames_and_old_sync_cannot_reopen_replays) {
+  Cmac cmac(RFC_KEY.data());
+  SecOcSender tx;
+  SecOcReceiver rx;
+  struct can_frame old_sync;
+  struct can_frame recorded[3];
+
+  /* An attacker records a sync and gear frames early on */
+  tx.sync_frame(cmac, Config::CAN_SECOC_SYNC_MSG_ID, old_sync);
+  for (struct can_frame& frame : recorded) {
+    frame = secured_gear(tx, cmac, Gear::N);
+
+    struct can_frame copy = frame;
+    CHECK(rx.verify(cmac, copy) == SecOcVerdict::Ok);
+  }
+  for (uint32_t i = 0; i < 100; i++) {
+    struct can_frame frame = secured_gear(tx, cmac, Gear::Third);
+    CHECK(rx.verify(cmac, frame) == SecOcVerdict::Ok);
+  }
+
+  /* Garbage gear frames, then the old but authentic sync */
+  for (uint32_t i = 0; i < 2; i++) {
+    struct can_frame forged = secured_gear(tx, cmac, Gear::First);
+
+    forged.data[forged.dlc - 1] ^= 0xFF;
+    CHECK(rx.verify(cmac, forged) == SecOcVerdict::BadMac);
+  }
+  CHECK(rx.sync(cmac, old_sync) == SecOcVerdict::Behind);
+  CHECK_EQ(rx.freshness_value(), 103U);
+
+  /* The recorded frames stay dead */
+  for (struct can_frame& frame : recorded) {
+    CHECK(rx.verify(cmac, frame) == SecOcVerdict::BadMac);
+  }
+  CHECK_EQ(rx.resync_count(), 0U);
+
+  /* The wheel's own next frame still verifies */
+  struct can_frame frame = secured_gear(tx, cmac, Gear::Fourth);
+  CHECK(rx.verify(cmac, frame) == SecOcVerdict::Ok);
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the session log blocks: double buffering, drops when the
+ * writer falls behind, timestamp wraps and corrupt blocks.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "core/session_log.hpp"
+#include "harness.hpp"
+
+namespace {
+
+constexpr size_t BLOCK = 512;
+
+using Buffers = SessionBuffers<BLOCK>;
+
+TimedFrame frame(uint32_t n, uint32_t ts_us) {
+  struct can_frame f = {};
+
+  f.id = 0x100 + (n % 16);
+  f.dlc = 8;
+  for (uint8_t i = 0; i < 8; i++) {
+    f.data[i] = static_cast<uint8_t>(n * 7 + i);
+  }
+  return TimedFrame::from(f, FrameDir::Rx, ts_us);
+}
+
+struct Decoded {
+  std::vector<uint8_t> first_bytes;
+  std::vector<uint64_t> times;
+};
+
+/* What the writer would put in the file, decoded block by block */
+size_t drain(Buffers& buffers, Decoded& out) {
+  size_t blocks = 0;
+
+  while (const uint8_t* block = buffers.ready()) {
+    int n = SessionLog::decode_block(block, BLOCK,
+                                     [&](const TimedFrame& f, uint64_t ts) {
+                                       out.first_bytes.push_back(f.data[0]);
+                                       out.times.push_back(ts);
+                                     });
+    CHECK(n > 0);
+    buffers.release();
+    blocks++;
+  }
+  return blocks;
+}
+
+}  // namespace
+
+HOST_TEST(session_log, blocks_round_trip) {
+  static Buffers buffers;
+  Decoded out;
+  size_t blocks = 0;
+
+  for (uint32_t n = 0; n < 200; n++) {
+    CHECK(buffers.append(frame(n, n * 100)));
+    blocks += drain(buffers, out);  // A writer that always keeps up
+  }
+  CHECK(buffers.seal());
+  CHECK(!buffers.seal());  // Nothing left to seal
+  blocks += drain(buffers, out);
+
+  CHECK(blocks > 2);
+  CHECK_EQ(buffers.blocks_sealed(), static_cast<uint32_t>(blocks));
+  CHECK_EQ(out.times.size(), size_t{200});
+  for (uint32_t n = 0; n < 200; n++) {
+    CHECK_EQ(out.first_bytes[n], static_cast<uint8_t>(n * 7));
+    CHECK_EQ(out.times[n], uint64_t{n} * 100);
+  }
+  CHECK_EQ(buffers.dropped(), 0U);
+}
+
+HOST_TEST(session_log, drops_when_every_block_waits) {
+  static Buffers buffers;
+  Decoded out;
+  uint32_t n = 0;
+
+  /* No writer: the first block seals, the second fills and seals */
+  while (buffers.sealed() < 2) {
+    CHECK(buffers.append(frame(n, n)));
+    n++;
+    buffers.seal();
+  }
+  CHECK(!buffers.append(frame(n, n)));
+  CHECK_EQ(buffers.dropped(), 1U);
+
+  /* The writer catches up and logging resumes, oldest block first */
+  buffers.release();
+  CHECK(buffers.append(frame(n + 1, n + 1)));
+  buffers.seal();
+  drain(buffers, out);
+  CHECK_EQ(out.times.size(), size_t{2});
+  CHECK_EQ(out.times[0], uint64_t{1});
+  CHECK_EQ(out.times[1], uint64_t{n + 1});
+}
+
+HOST_TEST(session_log, timestamps_continue_past_wrap) {
+  static Buffers buffers;
+  Decoded out;
+  uint32_t ts = 0xFFFFFF00U;
+
+  for (uint32_t n = 0; n < 100; n++) {
+    buffers.append(frame(n, ts));
+    ts += 10;  // Wraps after 26 frames
+    drain(buffers, out);
+  }
+  buffers.seal();
+  drain(buffers, out);
+
+  CHECK_EQ(out.times.size(), size_t{100});
+  for (size_t i = 1; i < out.times.size(); i++) {
+    CHECK_EQ(out.times[i] - out.times[i - 1], uint64_t{10});
+  }
+  CHECK_EQ(out.times.back(), 0xFFFFFF00ULL + 990);
+}
+
+HOST_TEST(session_log, corrupt_block_is_rejected) {
+  static Buffers buffers;
+  static uint8_t copy[BLOCK];
+
+  for (uint32_t n = 0; n < 10; n++) {
+    buffers.append(frame(n, n));
+  }
+  buffers.seal();
+  std::memcpy(copy, buffers.ready(), BLOCK);
+
+  auto ignore = [](const TimedFrame&, uint64_t) {};
+  CHECK_EQ(SessionLog::decode_block(copy, BLOCK, ignore), 10);
+
+  copy[sizeof(SessionBlockHeader) + 5] ^= 0x01;  // Payload
+  CHECK_EQ(SessionLog::decode_block(copy, BLOCK, ignore), -1);
+
+  std::memcpy(copy, buffers.ready(), BLOCK);
+  copy[8] ^= 0x01;  // Header
+  CHECK_EQ(SessionLog::decode_block(copy, BLOCK, ignore), -1);
+  CHECK_EQ(SessionLog::decode_block(copy, 16, ignore), -1);
+
+  std::memset(copy, 0, BLOCK);  // Preallocated but never written
+  CHECK_EQ(SessionLog::decode_block(copy, BLOCK, ignore), -1);
+}
+
+HOST_TEST(session_log, file_names) {
+  char name[SessionLog::FILE_NAME_LEN + 1];
+  uint32_t index = 0;
+
+  std::snprintf(name, sizeof(name), SessionLog::FILE_NAME_FORMAT, 42U);
+  CHECK_EQ(std::strlen(name), SessionLog::FILE_NAME_LEN);
+  CHECK(SessionLog::parse_file_name(name, index));
+  CHECK_EQ(index, 42U);
+
+  CHECK(!SessionLog::parse_file_name("SES0004.LOG", index));
+  CHECK(!SessionLog::parse_file_name("SES00042.TXT", index));
+  CHECK(!SessionLog::parse_file_name("SES00042.LOGX", index));
+  CHECK(!SessionLog::parse_file_name("BBX00042.LOG", index));
+  CHECK(!SessionLog::parse_file_name("", index));
+}
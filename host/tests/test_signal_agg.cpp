@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the signal aggregation windows: results against a
+ * brute-force pass over the same samples, window boundaries, several
+ * consumers of one signal and the frame layout.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <vector>
+
+#include "app_config.hpp"
+#include "core/signal_agg.hpp"
+#include "harness.hpp"
+
+namespace {
+
+constexpr std::array<AggSignal, 2> SIGNALS = {{
+    {.name = "angle", .sample_hz = 1000, .raw_dlc = 2},
+    {.name = "clutch", .sample_hz = 500, .raw_dlc = 2},
+}};
+
+constexpr std::array<AggStage, 3> STAGES = {{
+    {.consumer = "fast",
+     .signal = 0,
+     .id = 0x120,
+     .outputs = SignalAgg::ALL,
+     .samples = 10,
+     .window_ms = 0},
+    {.consumer = "slow",
+     .signal = 0,
+     .id = 0x320,
+     .outputs = SignalAgg::MIN | SignalAgg::MAX,
+     .samples = 0,
+     .window_ms = 100},
+    {.consumer = "clutch",
+     .signal = 1,
+     .id = 0x121,
+     .outputs = SignalAgg::LAST,
+     .samples = 4,
+     .window_ms = 0},
+}};
+
+struct Emitted {
+  size_t stage;
+  AggResult result;
+};
+
+int16_t sample(uint32_t i) {
+  return static_cast<int16_t>((i * 7919U) % 2001U) - 1000;
+}
+
+}  // namespace
+
+HOST_TEST(signal_agg, window_matches_brute_force) {
+  AggWindow window;
+  int16_t values[] = {-3, 7, 7, -32768, 32767, 0, -1};
+  int64_t sum = 0;
+
+  for (int16_t v : values) {
+    window.add(v);
+    sum += v;
+  }
+  AggResult r = window.take();
+
+  CHECK_EQ(r.min, int16_t{-32768});
+  CHECK_EQ(r.max, int16_t{32767});
+  CHECK_EQ(r.last, int16_t{-1});
+  CHECK_EQ(r.count, 7U);
+  CHECK_EQ(r.mean, static_cast<int16_t>(sum / 7));
+  CHECK_EQ(window.count(), 0U);  // The next window starts empty
+}
+
+HOST_TEST(signal_agg, mean_rounds_to_nearest) {
+  AggWindow window;
+
+  window.add(1);
+  window.add(2);
+  CHECK_EQ(window.take().mean, int16_t{2});  // 1.5
+  window.add(-1);
+  window.add(-2);
+  CHECK_EQ(window.take().mean, int16_t{-2});  // -1.5
+  window.add(-1);
+  window.add(-1);
+  window.add(0);
+  CHECK_EQ(window.take().mean, int16_t{-1});  // -0.67
+}
+
+HOST_TEST(signal_agg, consumers_get_their_own_rates) {
+  SignalAggregator<2, 3> agg(SIGNALS, STAGES);
+  std::vector<Emitted> out;
+  auto emit = [&](size_t stage, const AggResult& r) {
+    out.push_back({stage, r});
+  };
+
+  /* One second: angle every ms, clutch every other ms */
+  for (uint32_t ms = 0; ms < 1000; ms++) {
+    agg.feed(0, sample(ms), ms, emit);
+    if (ms % 2 == 0) {
+      agg.feed(1, static_cast<int16_t>(ms), ms, emit);
+    }
+  }
+
+  CHECK_EQ(agg.windows(0), 100U);  // 100 Hz
+  CHECK_EQ(agg.windows(1), 9U);    // 10 Hz; the last one is still open
+  CHECK_EQ(agg.windows(2), 125U);  // 500 Hz / 4
+  CHECK_EQ(agg.samples(), uint64_t{1500});
+  CHECK_EQ(out.size(), size_t{234});
+
+  /* Every fast window against its samples */
+  size_t fast = 0;
+  for (const Emitted& e : out) {
+    if (e.stage != 0) {
+      continue;
+    }
+    int16_t lo = INT16_MAX;
+    int16_t hi = INT16_MIN;
+    for (uint32_t i = fast * 10; i < fast * 10 + 10; i++) {
+      lo = (sample(i) < lo) ? sample(i) : lo;
+      hi = (sample(i) > hi) ? sample(i) : hi;
+    }
+    CHECK_EQ(e.result.min, lo);
+    CHECK_EQ(e.result.max, hi);
+    CHECK_EQ(e.result.last, sample(fast * 10 + 9));
+    CHECK_EQ(e.result.count, 10U);
+    fast++;
+  }
+  CHECK_EQ(fast, size_t{100});
+}
+
+HOST_TEST(signal_agg, time_windows_do_not_drift) {
+  SignalAggregator<2, 3> agg(SIGNALS, STAGES);
+  std::vector<Emitted> out;
+  auto emit = [&](size_t stage, const AggResult& r) {
+    if (stage == 1) {
+      out.push_back({stage, r});
+    }
+  };
+
+  /* Samples every 30 ms from t = 5: windows [5, 105), [105, 205), ... */
+  for (uint32_t t = 5; t < 1000; t += 30) {
+    agg.feed(0, static_cast<int16_t>(t), t, emit);
+  }
+
+  CHECK_EQ(out.size(), size_t{9});
+  CHECK_EQ(out[0].result.min, int16_t{5});
+  CHECK_EQ(out[0].result.max, int16_t{95});
+  CHECK_EQ(out[1].result.min, int16_t{125});  // 105..204
+  CHECK_EQ(out[1].result.max, int16_t{185});
+  CHECK_EQ(out[8].result.min, int16_t{815});  // 805..904
+}
+
+HOST_TEST(signal_agg, empty_time_windows_send_nothing) {
+  SignalAggregator<2, 3> agg(SIGNALS, STAGES);
+  uint32_t emitted = 0;
+  AggResult last = {};
+  auto emit = [&](size_t stage, const AggResult& r) {
+    if (stage == 1) {
+      emitted++;
+      last = r;
+    }
+  };
+
+  agg.feed(0, 1, 0, emit);
+  agg.feed(0, 2, 50, emit);
+  agg.feed(0, 3, 730, emit);  // Sensor stalled: [100, 700) had no samples
+  CHECK_EQ(emitted, 1U);
+  CHECK_EQ(last.count, 2U);
+  agg.feed(0, 4, 810, emit);  // Closes [700, 800)
+  CHECK_EQ(emitted, 2U);
+  CHECK_EQ(last.min, int16_t{3});
+}
+
+HOST_TEST(signal_agg, frame_round_trips) {
+  AggResult r = {.min = -900, .max = 850, .mean = -12, .last = 300,
+                 .count = 10};
+  AggResult got = {};
+  struct can_frame f;
+
+  encode_agg_frame(STAGES[0], r, f);
+  CHECK_EQ(f.id, 0x120U);
+  CHECK_EQ(f.dlc, uint8_t{8});
+  CHECK(decode_agg_frame(STAGES[0], f, got));
+  CHECK_EQ(got.min, int16_t{-900});
+  CHECK_EQ(got.max, int16_t{850});
+  CHECK_EQ(got.mean, int16_t{-12});
+  CHECK_EQ(got.last, int16_t{300});
+
+  /* Only the selected outputs, in order */
+  encode_agg_frame(STAGES[1], r, f);
+  CHECK_EQ(f.dlc, uint8_t{4});
+  CHECK_EQ(f.data[2], uint8_t{850 & 0xFF});
+  CHECK(!decode_agg_frame(STAGES[0], f, got));
+}
+
+HOST_TEST(signal_agg, bus_load_saved) {
+  constexpr uint32_t BITRATE = 500000;
+  constexpr uint64_t raw = SignalAgg::raw_load_ppm(SIGNALS, BITRATE);
+  constexpr uint64_t agg =
+      SignalAgg::stages_load_ppm(SIGNALS, STAGES, BITRATE);
+
+  /* 1500 raw frames a second against 100 + 10 + 125 longer aggregates */
+  CHECK(raw > 4 * agg);
+
+  /* An N-sample stage costs what a frame every N / sample_hz costs */
+  CHECK_EQ(SignalAgg::stage_load_ppm(STAGES[0], SIGNALS[0], BITRATE),
+           BusBudget::frame_load_ppm(false, 8, 10, BITRATE));
+
+  static_assert(SignalAgg::valid(SIGNALS, STAGES));
+  static_assert(
+      SignalAgg::valid(Config::AGG_SIGNALS, Config::AGG_STAGES));
+  CHECK(SignalAgg::stages_load_ppm(Config::AGG_SIGNALS, Config::AGG_STAGES,
+                                   BITRATE) <
+        SignalAgg::raw_load_ppm(Config::AGG_SIGNALS, BITRATE));
+}
+
+HOST_TEST(signal_agg, rejects_bad_tables) {
+  constexpr std::array<AggStage, 1> BOTH = {{{.consumer = "x",
+                                              .signal = 0,
+                                              .id = 0x100,
+                                              .outputs = SignalAgg::MIN,
+                                              .samples = 10,
+                                              .window_ms = 10}}};
+  constexpr std::array<AggStage, 1> NO_SIGNAL = {{{.consumer = "x",
+                                                   .signal = 2,
+                                                   .id = 0x100,
+                                                   .outputs = SignalAgg::MIN,
+                                                   .samples = 10,
+                                                   .window_ms = 0}}};
+
+  CHECK(!SignalAgg::valid(SIGNALS, BOTH));
+  CHECK(!SignalAgg::valid(SIGNALS, NO_SIGNAL));
+}
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the SLCAN bridge protocol: ASCII and binary frames, the
+ * command parser, the Lawicel replies and the link rate a full bus needs.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/slcan.hpp"
+#include "harness.hpp"
+
+namespace {
+
+struct can_frame make(uint32_t id, uint8_t dlc, uint8_t flags = 0) {
+  struct can_frame f = {};
+
+  f.id = id;
+  f.dlc = dlc;
+  f.flags = flags;
+  for (uint8_t i = 0; i < dlc; i++) {
+    f.data[i] = static_cast<uint8_t>(0x11 * (i + 1));
+  }
+  return f;
+}
+
+std::string ascii(const struct can_frame& f, bool timestamp = false,
+                  uint32_t ms = 0) {
+  char buf[Slcan::MAX_ASCII_BYTES];
+
+  return std::string(buf, Slcan::encode_ascii(f, timestamp, ms, buf));
+}
+
+/* Every reply to a stream of commands, concatenated */
+std::string session_replies(SlcanSession& session, std::string_view input,
+                            bool send_ok, std::vector<can_frame>* sent) {
+  SlcanParser parser;
+  SlcanCommand cmd;
+  std::string out;
+  auto send = [&](const struct can_frame& f) {
+    if (sent != nullptr) {
+      sent->push_back(f);
+    }
+    return send_ok;
+  };
+
+  for (char c : input) {
+    if (parser.feed(c, cmd)) {
+      char reply[Slcan::MAX_REPLY];
+      size_t n = session.handle(cmd, Slcan::FLAG_OVERRUN, send, reply);
+
+      out.append(reply, n);
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+HOST_TEST(slcan, encodes_ascii_frames) {
+  CHECK(ascii(make(0x100, 2)) == "t10021122\r");
+  CHECK(ascii(make(0x12345678, 1, CAN_FRAME_IDE)) == "T12345678111\r");
+  CHECK(ascii(make(0x7FF, 0)) == "t7FF0\r");
+  CHECK(ascii(make(0x123, 4, CAN_FRAME_RTR)) == "r1234\r");
+  CHECK(ascii(make(0x1ABCDEF0, 8, CAN_FRAME_IDE | CAN_FRAME_RTR)) ==
+        "R1ABCDEF08\r");
+
+  /* Timestamps wrap at 60 s */
+  CHECK(ascii(make(0x100, 1), true, 0x1F40) == "t100111" "1F40\r");
+  CHECK(ascii(make(0x100, 0), true, 60001) == "t1000" "0001\r");
+
+  /* The longest line fits the buffer */
+  std::string longest = ascii(make(0x1FFFFFFF, 8, CAN_FRAME_IDE), true, 1);
+  CHECK_EQ(longest.size(), Slcan::MAX_ASCII_BYTES);
+  CHECK_EQ(longest.size(), Slcan::frame_bytes(Slcan::Format::Ascii, true,
+                                              false, 8, true));
+}
+
+HOST_TEST(slcan, parses_what_it_encodes) {
+  const struct can_frame frames[] = {
+      make(0x000, 0),
+      make(0x7FF, 8),
+      make(0x1FFFFFFF, 3, CAN_FRAME_IDE),
+      make(0x321, 5, CAN_FRAME_RTR),
+      make(0x00000001, 8, CAN_FRAME_IDE | CAN_FRAME_RTR),
+  };
+
+  for (const struct can_frame& f : frames) {
+    std::string line = ascii(f);
+    struct can_frame got;
+
+    line.pop_back();  // CR
+    CHECK(Slcan::parse_frame(line, got));
+    CHECK_EQ(got.id, f.id);
+    CHECK_EQ(got.dlc, f.dlc);
+    CHECK_EQ(got.flags, f.flags);
+    if ((f.flags & CAN_FRAME_RTR) == 0) {
+      CHECK(std::string_view(reinterpret_cast<const char*>(got.data),
+                             got.dlc) ==
+            std::string_view(reinterpret_cast<const char*>(f.data), f.dlc));
+    }
+  }
+
+  /* Lowercase hex is accepted too */
+  struct can_frame f;
+  CHECK(Slcan::parse_frame("t1ab2deAD", f));
+  CHECK_EQ(f.id, 0x1ABU);
+  CHECK_EQ(f.data[0], uint8_t{0xDE});
+}
+
+HOST_TEST(slcan, rejects_malformed_frames) {
+  struct can_frame f;
+
+  CHECK(!Slcan::parse_frame("t10", f));           // Short ID
+  CHECK(!Slcan::parse_frame("t8001AA", f));       // Over 11 bits
+  CHECK(!Slcan::parse_frame("T200000000", f));    // Over 29 bits
+  CHECK(!Slcan::parse_frame("t1009", f));         // DLC 9
+  CHECK(!Slcan::parse_frame("t1002AA", f));       // One byte short
+  CHECK(!Slcan::parse_frame("t1001AABB", f));     // One byte over
+  CHECK(!Slcan::parse_frame("t1001AG", f));       // Not hex
+  CHECK(!Slcan::parse_frame("t1001AA1F40", f));   // Timestamp
+  CHECK(!Slcan::parse_frame("r1002AABB", f));     // Remote with data
+  CHECK(!Slcan::parse_frame("x1001AA", f));
+}
+
+HOST_TEST(slcan, parses_commands) {
+  CHECK(parse_slcan_command("O").kind == SlcanCmd::Open);
+  CHECK(parse_slcan_command("L").kind == SlcanCmd::ListenOnly);
+  CHECK(parse_slcan_command("C").kind == SlcanCmd::Close);
+  CHECK(parse_slcan_command("V").kind == SlcanCmd::Version);
+  CHECK(parse_slcan_command("N").kind == SlcanCmd::Serial);
+  CHECK(parse_slcan_command("F").kind == SlcanCmd::Status);
+  CHECK(parse_slcan_command("").kind == SlcanCmd::None);
+
+  SlcanCommand s6 = parse_slcan_command("S6");
+  CHECK(s6.kind == SlcanCmd::Bitrate);
+  CHECK_EQ(s6.arg, 500000U);
+  CHECK_EQ(parse_slcan_command("S8").arg, 1000000U);
+  CHECK_EQ(parse_slcan_command("Z1").arg, 1U);
+
+  CHECK(parse_slcan_command("S9").kind == SlcanCmd::Invalid);
+  CHECK(parse_slcan_command("S").kind == SlcanCmd::Invalid);
+  CHECK(parse_slcan_command("Z2").kind == SlcanCmd::Invalid);
+  CHECK(parse_slcan_command("OX").kind == SlcanCmd::Invalid);
+  CHECK(parse_slcan_command("s031C").kind == SlcanCmd::Invalid);
+  CHECK(parse_slcan_command("t10").kind == SlcanCmd::Invalid);
+
+  SlcanCommand t = parse_slcan_command("T0000ABCD2BEEF");
+  CHECK(t.kind == SlcanCmd::Transmit);
+  CHECK_EQ(t.frame.id, 0xABCDU);
+  CHECK_EQ(t.frame.data[1], uint8_t{0xEF});
+}
+
+HOST_TEST(slcan, parser_splits_the_stream) {
+  SlcanParser parser;
+  SlcanCommand cmd;
+  std::vector<SlcanCmd> kinds;
+  std::string overlong = "t1008" + std::string(40, 'A') + "\r";
+  std::string input = "S6\r\nO\rt1001AA\r" + overlong + "C\r";
+
+  for (char c : input) {
+    if (parser.feed(c, cmd)) {
+      kinds.push_back(cmd.kind);
+    }
+  }
+
+  CHECK_EQ(kinds.size(), size_t{5});
+  CHECK(kinds[0] == SlcanCmd::Bitrate);
+  CHECK(kinds[1] == SlcanCmd::Open);  // LF ignored
+  CHECK(kinds[2] == SlcanCmd::Transmit);
+  CHECK(kinds[3] == SlcanCmd::Invalid);  // Over MAX_LINE, as a whole
+  CHECK(kinds[4] == SlcanCmd::Close);    // The next line is fine
+}
+
+HOST_TEST(slcan, session_answers_like_an_adapter) {
+  SlcanSession session(500000, 0x0010);
+  std::vector<can_frame> sent;
+
+  /* slcand -o -c -s6: close, bitrate, open */
+  CHECK(session_replies(session, "C\rS6\rO\r", true, &sent) == "\r\r\r");
+  CHECK(session.is_open());
+  CHECK(session_replies(session, "t1002AA55\rT000001231FF\r", true,
+                        &sent) == "z\rZ\r");
+  CHECK_EQ(sent.size(), size_t{2});
+  CHECK_EQ(sent[0].data[1], uint8_t{0x55});
+  CHECK(session_replies(session, "V\rN\rF\r", true, &sent) ==
+        "V0101\rN0010\rF08\r");
+
+  /* Bitrate, timestamps and a second open only while closed */
+  CHECK(session_replies(session, "S6\rZ1\rO\r", true, &sent) == "\a\a\a");
+  CHECK(session_replies(session, "C\rZ1\rS8\rS6\r", true, &sent) ==
+        "\r\r\a\r");
+  CHECK(session.timestamps());
+
+  /* Nothing is sent closed, listen-only, or when the controller refuses */
+  sent.clear();
+  CHECK(session_replies(session, "t1000\rF\r", true, &sent) == "\a\a");
+  CHECK(session_replies(session, "L\rt1000\r", true, &sent) == "\r\a");
+  CHECK(session.listen_only());
+  CHECK(sent.empty());
+  CHECK(session_replies(session, "C\rO\rt1000\r", false, &sent) == "\r\r\a");
+  CHECK_EQ(sent.size(), size_t{1});
+
+  CHECK(session_replies(session, "\rX\r", true, &sent) == "\a");
+}
+
+HOST_TEST(slcan, binary_round_trips_and_resyncs) {
+  const struct can_frame frames[] = {
+      make(0x100, 2),
+      make(0x1ABCDEF0, 8, CAN_FRAME_IDE),
+      make(0x0AA, 0),
+      make(0x7FF, 3, CAN_FRAME_RTR),
+  };
+  std::vector<uint8_t> stream = {0x12, Slcan::SYNC, 0x3F};  // Mid-stream
+  SlcanBinaryDecoder decoder;
+  std::vector<can_frame> got;
+  std::vector<uint16_t> stamps;
+
+  for (size_t i = 0; i < 4; i++) {
+    uint8_t buf[Slcan::MAX_BINARY_BYTES];
+    size_t n = Slcan::encode_binary(frames[i], 65536 + 1000 * i, buf);
+    const struct can_frame& f = frames[i];
+
+    CHECK_EQ(n, Slcan::frame_bytes(Slcan::Format::Binary,
+                                   (f.flags & CAN_FRAME_IDE) != 0,
+                                   (f.flags & CAN_FRAME_RTR) != 0, f.dlc,
+                                   true));
+    if (i == 2) {
+      buf[3] ^= 0x01;  // Corrupt the record after the extended frame
+    }
+    stream.insert(stream.end(), buf, buf + n);
+  }
+
+  for (uint8_t b : stream) {
+    struct can_frame f;
+    uint16_t ms;
+
+    if (decoder.feed(b, f, ms)) {
+      got.push_back(f);
+      stamps.push_back(ms);
+    }
+  }
+
+  CHECK_EQ(got.size(), size_t{3});
+  CHECK_EQ(got[0].id, 0x100U);
+  CHECK_EQ(got[0].data[1], uint8_t{0x22});
+  CHECK_EQ(got[1].id, 0x1ABCDEF0U);
+  CHECK_EQ(got[1].flags, uint8_t{CAN_FRAME_IDE});
+  CHECK_EQ(got[1].data[7], uint8_t{0x88});
+  CHECK_EQ(got[2].id, 0x7FFU);
+  CHECK_EQ(got[2].dlc, uint8_t{3});
+  CHECK_EQ(got[2].flags, uint8_t{CAN_FRAME_RTR});
+  CHECK_EQ(stamps[0], uint16_t{0});  // 65536 wrapped
+  CHECK_EQ(stamps[2], uint16_t{3000});
+  CHECK(decoder.errors() >= 1U);
+}
+
+HOST_TEST(slcan, link_rate_for_a_full_bus) {
+  using Slcan::Format;
+
+  /* 8-byte standard frames back to back at 500 kbit/s */
+  CHECK_EQ(Slcan::bus_frames_per_s(500000, false, 8), 4504U);
+
+  /* ASCII: 8-byte extended frames, 27 bytes per 131 bits */
+  CHECK_EQ(Slcan::full_rate_baud(Format::Ascii, false, 500000),
+           uint64_t{(27 * 10 * 500000ULL + 130) / 131});
+  /* Binary: empty standard frames, 7 bytes per 47 bits */
+  CHECK_EQ(Slcan::full_rate_baud(Format::Binary, true, 500000),
+           uint64_t{(7 * 10 * 500000ULL + 46) / 47});
+
+  /* ASCII with timestamps needs a 1.5 Mbaud link; binary fits 1 Mbaud */
+  CHECK(Slcan::full_rate_baud(Format::Ascii, true, 500000) > 1000000);
+  CHECK(Slcan::full_rate_baud(Format::Ascii, true, 500000) <= 1500000);
+  CHECK(Slcan::full_rate_baud(Format::Binary, true, 500000) <= 1000000);
+}
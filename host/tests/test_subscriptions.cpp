@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for runtime RX subscriptions: the make-before-break filter
+ * swap against a model controller that keeps receiving during the change,
+ * and the subscription table.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cerrno>
+
+#include "core/filter_swap.hpp"
+#include "core/subscriptions.hpp"
+#include "harness.hpp"
+
+namespace {
+
+struct can_filter filter(uint32_t id, uint32_t mask = CAN_STD_ID_MASK) {
+  return {.id = id, .mask = mask, .flags = 0};
+}
+
+struct can_frame frame(uint32_t id) {
+  struct can_frame f = {};
+
+  f.id = id;
+  f.dlc = 8;
+  return f;
+}
+
+/* Controller with a few filter slots. Every add or remove takes as long as
+ * FRAMES_PER_OP frames on the bus, all of them wanted */
+class FakeController {
+ public:
+  static constexpr size_t SLOTS = 8;
+  static constexpr uint32_t FRAMES_PER_OP = 5;
+
+  std::array<struct can_filter, SLOTS> slots{};
+  std::array<bool, SLOTS> used{};
+  uint32_t wanted_id = 0;
+  uint32_t sent = 0;
+  uint32_t accepted = 0;
+  uint32_t adds = 0;
+  uint32_t removes = 0;
+
+  int add(const struct can_filter& f) {
+    stream();
+    adds++;
+    for (size_t i = 0; i < SLOTS; i++) {
+      if (!used[i]) {
+        slots[i] = f;
+        used[i] = true;
+        return static_cast<int>(i);
+      }
+    }
+    return -ENOSPC;
+  }
+
+  void remove(int id) {
+    stream();
+    removes++;
+    used[id] = false;
+  }
+
+ private:
+  void stream() {
+    for (uint32_t n = 0; n < FRAMES_PER_OP; n++) {
+      sent++;
+      for (size_t i = 0; i < SLOTS; i++) {
+        if (used[i] && filter_matches(slots[i], frame(wanted_id))) {
+          accepted++;
+          break;
+        }
+      }
+    }
+  }
+};
+
+}  // namespace
+
+HOST_TEST(subscriptions, filter_matches) {
+  struct can_frame ext = frame(0x300);
+
+  ext.flags = CAN_FRAME_IDE;
+  CHECK(filter_matches(filter(0x300), frame(0x300)));
+  CHECK(!filter_matches(filter(0x300), frame(0x301)));
+  CHECK(filter_matches(filter(0x300, 0x7F0), frame(0x30F)));
+  CHECK(!filter_matches(filter(0x300), ext));
+}
+
+HOST_TEST(subscriptions, swap_keeps_shared_filters) {
+  FakeController can;
+  const struct can_filter old[] = {filter(0x100), filter(0x200)};
+  const struct can_filter next[] = {filter(0x200), filter(0x300)};
+  int old_ids[2];
+  int next_ids[2];
+
+  old_ids[0] = can.add(old[0]);
+  old_ids[1] = can.add(old[1]);
+  can.adds = 0;
+
+  swap_filters(
+      old, old_ids, 2, next, next_ids, 2,
+      [&](const struct can_filter& f) { return can.add(f); },
+      [&](int id) { can.remove(id); });
+
+  CHECK_EQ(next_ids[0], old_ids[1]);  // 0x200 is not reinstalled
+  CHECK(next_ids[1] >= 0 && next_ids[1] != old_ids[1]);
+  CHECK_EQ(can.adds, 1U);
+  CHECK_EQ(can.removes, 1U);
+  CHECK(!can.used[old_ids[0]]);
+}
+
+HOST_TEST(subscriptions, no_loss_while_widening_under_load) {
+  /* Deeper monitoring: 0x305 moves from an exact filter to a range that
+   * also covers its neighbours. Frames of 0x305 flow during every step */
+  const struct can_filter old[] = {filter(0x100), filter(0x305)};
+  const struct can_filter next[] = {filter(0x100), filter(0x300, 0x7F0)};
+  int old_ids[2];
+  int next_ids[2];
+
+  FakeController mbb;
+  mbb.wanted_id = 0x305;
+  old_ids[0] = mbb.add(old[0]);
+  old_ids[1] = mbb.add(old[1]);
+  mbb.sent = 0;
+  mbb.accepted = 0;
+  swap_filters(
+      old, old_ids, 2, next, next_ids, 2,
+      [&](const struct can_filter& f) { return mbb.add(f); },
+      [&](int id) { mbb.remove(id); });
+  CHECK(mbb.sent > 0);
+  CHECK_EQ(mbb.accepted, mbb.sent);
+
+  /* The naive order (remove everything, then add) has a gap */
+  FakeController bbm;
+  bbm.wanted_id = 0x305;
+  old_ids[0] = bbm.add(old[0]);
+  old_ids[1] = bbm.add(old[1]);
+  bbm.sent = 0;
+  bbm.accepted = 0;
+  bbm.remove(old_ids[0]);
+  bbm.remove(old_ids[1]);
+  bbm.add(next[0]);
+  bbm.add(next[1]);
+  CHECK(bbm.accepted < bbm.sent);
+}
+
+HOST_TEST(subscriptions, table_add_remove_match) {
+  SubscriptionTable<2> table;
+
+  CHECK(table.add(filter(0x100)));
+  CHECK(!table.add(filter(0x100)));  // Already subscribed
+  CHECK(table.add(filter(0x200, 0x700)));
+  CHECK(!table.add(filter(0x300)));  // Full
+  CHECK_EQ(table.size(), 2U);
+
+  /* Nothing is installed yet, so nothing is dispatched */
+  CHECK_EQ(table.match(frame(0x100)), -1);
+
+  SubscriptionTable<2> empty;
+  int next_id = 0;
+  table.swap_from(
+      empty, [&](const struct can_filter&) { return next_id++; },
+      [](int) {});
+  CHECK_EQ(table.match(frame(0x100)), 0);
+  CHECK_EQ(table.match(frame(0x2AB)), 1);
+  CHECK_EQ(table.match(frame(0x101)), -1);
+
+  CHECK(!table.remove(filter(0x300)));
+  CHECK(table.remove(filter(0x100)));
+  CHECK_EQ(table.size(), 1U);
+  CHECK_EQ(table.match(frame(0x2AB)), 0);
+  CHECK_EQ(table.filter_id(0), 1);
+}
+
+HOST_TEST(subscriptions, frame_gaps) {
+  SubscriptionTable<1> table;
+
+  table.add(filter(0x100));
+  table.note(0, 1000);
+  table.note(0, 1010);
+  table.note(0, 1040);
+  table.note(0, 1045);
+
+  const SubscriptionStats& s = table.stats(0);
+  CHECK_EQ(s.frames, 4U);
+  CHECK_EQ(s.last_ms, 1045U);
+  CHECK_EQ(s.min_gap_ms, 5U);
+  CHECK_EQ(s.max_gap_ms, 30U);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for candump trace iteration and replay pacing.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <string_view>
+
+#include "core/trace_replay.hpp"
+#include "harness.hpp"
+
+namespace {
+
+constexpr std::string_view TRACE =
+    "(100.000000) can0 100#01\n"
+    "# comment\n"
+    "\n"
+    "(100.010000) can0 200#0102\r\n"
+    "(100.020000) can0 123##1AA\n"
+    "(100.030000) can0 12345678#DEADBEEF";  // No trailing newline
+
+}  // namespace
+
+HOST_TEST(candump_reader, iterates_and_skips) {
+  CandumpReader reader(TRACE);
+  CandumpRecord rec = {};
+
+  CHECK(reader.next(rec));
+  CHECK_EQ(rec.frame.id, 0x100U);
+  CHECK(reader.next(rec));
+  CHECK_EQ(rec.frame.id, 0x200U);
+  CHECK_EQ(rec.frame.dlc, 2);
+  CHECK(reader.next(rec));
+  CHECK_EQ(rec.frame.id, 0x12345678U);
+  CHECK_EQ(rec.timestamp_us, 100030000U);
+  CHECK(!reader.next(rec));
+  CHECK_EQ(reader.skipped(), 2U);
+
+  reader.rewind();
+  CHECK_EQ(reader.skipped(), 0U);
+  CHECK(reader.next(rec));
+  CHECK_EQ(rec.frame.id, 0x100U);
+}
+
+HOST_TEST(candump_reader, empty_trace) {
+  CandumpReader reader("");
+  CandumpRecord rec = {};
+
+  CHECK(!reader.next(rec));
+  CHECK_EQ(reader.skipped(), 0U);
+}
+
+HOST_TEST(replay_pacer, scales_from_first_frame) {
+  ReplayPacer original(1, 5000);
+  ReplayPacer fast(10, 5000);
+
+  CHECK_EQ(original.due_us(1000000), 5000U);
+  CHECK_EQ(original.due_us(1250000), 255000U);
+  CHECK_EQ(fast.due_us(1000000), 5000U);
+  CHECK_EQ(fast.due_us(1250000), 30000U);
+  CHECK_EQ(fast.trace_span_us(), 250000U);
+}
+
+HOST_TEST(replay_pacer, max_speed_is_immediate) {
+  ReplayPacer pacer(0, 777);
+
+  CHECK_EQ(pacer.due_us(1), 777U);
+  CHECK_EQ(pacer.due_us(9000000), 777U);
+  pacer.note_injected(777, 5000);
+  CHECK_EQ(pacer.max_lag(), 0U);
+}
+
+HOST_TEST(replay_pacer, backward_step_does_not_stall) {
+  ReplayPacer pacer(1, 0);
+
+  CHECK_EQ(pacer.due_us(1000), 0U);
+  CHECK_EQ(pacer.due_us(3000), 2000U);
+  CHECK_EQ(pacer.due_us(2500), 2000U);  // Reordered capture
+  CHECK_EQ(pacer.due_us(4000), 3000U);
+}
+
+HOST_TEST(replay_pacer, tracks_worst_lag) {
+  ReplayPacer pacer(2, 0);
+
+  pacer.note_injected(100, 90);
+  CHECK_EQ(pacer.max_lag(), 0U);
+  pacer.note_injected(100, 150);
+  pacer.note_injected(200, 230);
+  CHECK_EQ(pacer.max_lag(), 50U);
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for the SocketCAN pcap reader and the one-pass trace
+ * analyzer.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <cstring>
+
+#include "core/diag_codec.hpp"
+#include "core/gear_codec.hpp"
+#include "core/pcap_reader.hpp"
+#include "core/trace_stats.hpp"
+#include "harness.hpp"
+
+namespace {
+
+/* Builds a pcap capture in memory, little- or big-endian */
+struct PcapWriter {
+  uint8_t buf[1024] = {};
+  size_t len = 0;
+  bool big_endian;
+
+  void put32(uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+      int shift = big_endian ? 24 - 8 * i : 8 * i;
+      buf[len++] = static_cast<uint8_t>(v >> shift);
+    }
+  }
+
+  PcapWriter(bool be, uint32_t magic, uint32_t linktype = 227)
+      : big_endian(be) {
+    put32(magic);
+    put32(0x00040002);  // Version 2.4 (two 16-bit fields, order ignored)
+    put32(0);           // thiszone
+    put32(0);           // sigfigs
+    put32(65535);       // snaplen
+    put32(linktype);
+  }
+
+  void frame(uint32_t sec, uint32_t frac, uint32_t can_id, uint8_t dlc,
+             const uint8_t* data, uint32_t caplen = 16) {
+    put32(sec);
+    put32(frac);
+    put32(caplen);
+    put32(caplen);
+    /* The SocketCAN ID word is big-endian in either file byte order */
+    buf[len++] = static_cast<uint8_t>(can_id >> 24);
+    buf[len++] = static_cast<uint8_t>(can_id >> 16);
+    buf[len++] = static_cast<uint8_t>(can_id >> 8);
+    buf[len++] = static_cast<uint8_t>(can_id);
+    buf[len++] = dlc;
+    len += 3;
+    memcpy(buf + len, data, (dlc > 8) ? 8 : dlc);
+    len += caplen - 8;
+  }
+};
+
+const uint8_t PAYLOAD[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+}  // namespace
+
+HOST_TEST(pcap_reader, both_byte_orders) {
+  for (bool be : {false, true}) {
+    PcapWriter w(be, Pcap::MAGIC_US);
+    uint64_t ts = 0;
+    struct can_frame f = {};
+
+    w.frame(10, 250, 0x100, 1, PAYLOAD);
+    w.frame(11, 0, 0x80000000U | 0x1ABCDE, 8, PAYLOAD);
+    w.frame(12, 0, 0x40000000U | 0x123, 0, PAYLOAD);
+
+    PcapReader r(w.buf, w.len);
+    CHECK(r.valid());
+
+    CHECK(r.next(ts, f));
+    CHECK_EQ(ts, 10000250ULL);
+    CHECK_EQ(f.id, 0x100U);
+    CHECK_EQ(f.dlc, 1);
+    CHECK_EQ(f.flags, 0);
+    CHECK_EQ(f.data[0], 0x11);
+
+    CHECK(r.next(ts, f));
+    CHECK_EQ(f.id, 0x1ABCDEU);
+    CHECK_EQ(f.flags, CAN_FRAME_IDE);
+    CHECK(memcmp(f.data, PAYLOAD, 8) == 0);
+
+    CHECK(r.next(ts, f));
+    CHECK_EQ(f.flags, CAN_FRAME_RTR);
+    CHECK(!r.next(ts, f));
+    CHECK_EQ(r.skipped(), 0U);
+  }
+}
+
+HOST_TEST(pcap_reader, nanoseconds_and_skips) {
+  PcapWriter w(false, Pcap::MAGIC_NS);
+  uint64_t ts = 0;
+  struct can_frame f = {};
+
+  w.frame(1, 500000000, 0x20000000U | 0x4, 8, PAYLOAD);  // Error frame
+  w.frame(1, 500000000, 0x101, 12, PAYLOAD, 24);         // CAN FD length
+  w.frame(2, 1500, 0x102, 2, PAYLOAD);
+  w.frame(3, 0, 0x103, 2, PAYLOAD);
+  w.len -= 4;  // Truncate the last record
+
+  PcapReader r(w.buf, w.len);
+  CHECK(r.next(ts, f));
+  CHECK_EQ(ts, 2000001ULL);
+  CHECK_EQ(f.id, 0x102U);
+  CHECK(!r.next(ts, f));
+  CHECK_EQ(r.skipped(), 3U);
+}
+
+HOST_TEST(pcap_reader, rejects_other_formats) {
+  PcapWriter ethernet(false, Pcap::MAGIC_US, 1);
+  const char text[] = "(1.000000) can0 100#01\n(1.000000) can0 100#01\n";
+
+  CHECK(!PcapReader(ethernet.buf, ethernet.len).valid());
+  CHECK(!PcapReader(reinterpret_cast<const uint8_t*>(text), sizeof(text))
+             .valid());
+  CHECK(!PcapReader(nullptr, 0).valid());
+}
+
+HOST_TEST(trace_stats, id_timing) {
+  static TraceAnalyzer<64, 8> a;
+  struct can_frame f = {};
+
+  f.id = 0x200;
+  f.dlc = 1;
+  for (uint64_t t : {1000ULL, 2000ULL, 3500ULL, 3400ULL, 4500ULL}) {
+    a.add(t, f);
+  }
+  f.id = 0x200;
+  f.flags = CAN_FRAME_IDE;
+  a.add(9000, f);
+  a.finish();
+
+  const IdTiming* std_id = a.timing(0x200);
+  CHECK(std_id != nullptr);
+  CHECK_EQ(std_id->count, 5U);
+  CHECK_EQ(std_id->min_gap_us, 1000ULL);
+  CHECK_EQ(std_id->max_gap_us, 1500ULL);
+  CHECK_EQ(std_id->reordered, 1U);
+  CHECK_EQ(std_id->mean_gap_us(), 875ULL);  // 3500 us over 4 gaps
+
+  const IdTiming* ext_id = a.timing(0x200, true);
+  CHECK(ext_id != nullptr);
+  CHECK_EQ(ext_id->count, 1U);
+  CHECK_EQ(a.distinct_ids(), 2U);
+  CHECK_EQ(a.frames(), 6ULL);
+  CHECK(a.timing(0x201) == nullptr);
+}
+
+HOST_TEST(trace_stats, id_table_overflow) {
+  static TraceAnalyzer<16, 8> a;
+  struct can_frame f = {};
+
+  for (uint32_t id = 0; id < 20; id++) {
+    f.id = id;
+    a.add(id, f);
+  }
+  a.finish();
+  CHECK_EQ(a.distinct_ids(), 12U);  // 3/4 of the table
+  CHECK_EQ(a.overflow(), 8ULL);
+}
+
+HOST_TEST(trace_stats, signal_histograms_match_scalar_decode) {
+  static TraceAnalyzer<256, 16> a;
+  uint64_t expected_gear[7] = {};
+  uint64_t expected_load[128] = {};
+  struct can_frame f = {};
+
+  /* 100 frames: more than a batch, ending in a partial one */
+  for (uint32_t i = 0; i < 100; i++) {
+    if (i % 3 == 0) {
+      DiagPayload d = {};
+
+      d.cpu_load_pct = static_cast<uint8_t>(i % 101);
+      d.uptime_s = i * 1000;
+      encode_diag_frame(d, f);
+      expected_load[unpack_signal(f.data, DiagSignals::CPU_LOAD)]++;
+    } else {
+      Gear g = static_cast<Gear>(i % 7);
+      encode_gear_frame(g, f);
+      expected_gear[i % 7]++;
+    }
+    a.add(i * 1000, f);
+  }
+
+  /* A truncated diag frame and a remote gear frame carry no signals */
+  f = {};
+  f.id = Config::CAN_DIAG_MSG_ID;
+  f.dlc = 0;
+  a.add(200000, f);
+  f.id = Config::CAN_GEAR_MSG_ID;
+  f.dlc = 1;
+  f.flags = CAN_FRAME_RTR;
+  a.add(200001, f);
+  a.finish();
+
+  const SignalHistogram& gear = a.histogram(0);
+  CHECK_EQ(gear.count(), 66ULL);
+  for (size_t g = 0; g < 7; g++) {
+    CHECK_EQ(gear.bin(g), expected_gear[g]);
+  }
+  CHECK_EQ(gear.max(), 6ULL);
+
+  const SignalHistogram& load = a.histogram(1);
+  CHECK_EQ(load.count(), 34ULL);
+  for (size_t v = 0; v < 128; v++) {
+    CHECK_EQ(load.bin(v), expected_load[v]);
+  }
+
+  /* uptime is 24 bits wide: 65536 values per bin */
+  const SignalHistogram& uptime = a.histogram(7);
+  CHECK_EQ(uptime.count(), 34ULL);
+  CHECK_EQ(uptime.max(), 99000ULL);
+  CHECK_EQ(uptime.bin(0), 22ULL);  // 0 .. 65000
+  CHECK_EQ(uptime.bin(1), 12ULL);  // 66000 .. 99000
+  CHECK_EQ(uptime.bin_start(1), 65536ULL);
+}
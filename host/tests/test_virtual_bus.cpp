@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Host tests for frame timing (bit stuffing) and the virtual bus model.
+ */
+
+#include <zephyr/drivers/can.h>
+
+#include <cstring>
+
+#include "core/can_timing.hpp"
+#include "core/virtual_bus.hpp"
+#include "harness.hpp"
+
+namespace {
+
+struct can_frame make(uint32_t id, uint8_t dlc, uint8_t fill,
+                      uint8_t flags = 0) {
+  struct can_frame f = {};
+
+  f.id = id;
+  f.dlc = dlc;
+  f.flags = flags;
+  memset(f.data, fill, dlc);
+  return f;
+}
+
+}  // namespace
+
+HOST_TEST(can_timing, exact_bits) {
+  struct can_frame diag = make(0x6F0, 8, 0);
+  const uint8_t payload[8] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
+  struct can_frame ext = make(0x1ABCDE, 2, 0, CAN_FRAME_IDE);
+
+  memcpy(diag.data, payload, sizeof(payload));
+  ext.data[0] = 0xAA;
+  ext.data[1] = 0x55;
+
+  /* Reference values from an independent bit-level encoder */
+  CHECK_EQ(can_frame_bits(make(0x100, 1, 3)), 59U);
+  CHECK_EQ(can_frame_bits(make(0x000, 8, 0x00)), 127U);
+  CHECK_EQ(can_frame_bits(make(0x7FF, 8, 0xFF)), 126U);
+  CHECK_EQ(can_frame_bits(diag), 115U);
+  CHECK_EQ(can_frame_bits(ext), 86U);
+  CHECK_EQ(can_frame_bits(make(0x123, 0, 0, CAN_FRAME_RTR)), 48U);
+}
+
+HOST_TEST(can_timing, within_bounds) {
+  for (uint8_t dlc = 0; dlc <= 8; dlc++) {
+    for (uint32_t id = 0; id < 0x800; id += 0x55) {
+      for (uint8_t fill : {0x00, 0xFF, 0xAA, 0x0F}) {
+        uint32_t bits = can_frame_bits(make(id, dlc, fill));
+
+        CHECK(bits >= CanTiming::min_frame_bits(false, dlc));
+        CHECK(bits <= CanTiming::max_frame_bits(false, dlc));
+      }
+    }
+  }
+  CHECK_EQ(CanTiming::max_frame_bits(false, 8), 135U);
+  CHECK_EQ(CanTiming::min_frame_bits(false, 8), 111U);
+  CHECK_EQ(CanTiming::max_frame_bits(true, 8), 160U);
+}
+
+HOST_TEST(can_timing, bit_time) {
+  CHECK_EQ(can_bits_to_ns(1, 500000), 2000U);
+  CHECK_EQ(can_bits_to_ns(135, 500000), 270000U);
+  CHECK_EQ(can_bits_to_ns(1, 3), 333333334U);  // Rounded up
+}
+
+HOST_TEST(can_timing, arbitration_order) {
+  CHECK(can_arbitration_key(make(0x100, 0, 0)) <
+        can_arbitration_key(make(0x101, 0, 0)));
+  /* Data beats remote with the same ID */
+  CHECK(can_arbitration_key(make(0x100, 0, 0)) <
+        can_arbitration_key(make(0x100, 0, 0, CAN_FRAME_RTR)));
+  /* Standard beats extended with the same base ID */
+  CHECK(can_arbitration_key(make(0x100, 0, 0)) <
+        can_arbitration_key(make(0x100 << 18, 0, 0, CAN_FRAME_IDE)));
+  /* ...but the base ID is compared first */
+  CHECK(can_arbitration_key(make(0x0FF << 18, 0, 0, CAN_FRAME_IDE)) <
+        can_arbitration_key(make(0x100, 0, 0)));
+}
+
+HOST_TEST(virtual_bus, arbitration_and_timing) {
+  VirtualBus<3, 2> bus(500000);
+  BusTransmission tx;
+
+  CHECK(!bus.start_next(0, tx));
+  CHECK_EQ(bus.enqueue(0, make(0x700, 8, 0xFF), 0), 0);
+  CHECK(bus.start_next(1000, tx));
+  CHECK_EQ(tx.node, 0U);
+  CHECK_EQ(tx.start_ns, 1000U);
+
+  /* Queued while the bus is busy: arbitrate at the end of the frame */
+  CHECK(bus.enqueue(1, make(0x300, 1, 0), 2000) >= 0);
+  CHECK(bus.enqueue(2, make(0x100, 1, 0), 3000) >= 0);
+  CHECK(!bus.start_next(4000, tx));  // Still busy
+
+  BusTransmission first = tx;
+  bus.finish(first);
+  CHECK(bus.start_next(first.end_ns + 10, tx));
+  CHECK_EQ(tx.frame.id, 0x100U);
+  CHECK_EQ(tx.start_ns, first.end_ns + 10);
+  CHECK_EQ(tx.end_ns - tx.start_ns,
+           can_bits_to_ns(can_frame_bits(tx.frame), 500000));
+  CHECK_EQ(bus.arbitration_losses(1), 1U);
+
+  bus.finish(tx);
+  CHECK(bus.start_next(0, tx));  // Late caller: starts when the bus freed
+  CHECK_EQ(tx.frame.id, 0x300U);
+  CHECK_EQ(tx.start_ns, bus.stats().busy_ns + 1000 + 10);
+  bus.finish(tx);
+
+  CHECK_EQ(bus.stats().frames, 3U);
+  CHECK_EQ(bus.pending(1), 0U);
+}
+
+HOST_TEST(virtual_bus, mailboxes_and_abort) {
+  VirtualBus<2, 2> bus(250000);
+  BusTransmission tx;
+
+  CHECK_EQ(bus.enqueue(0, make(0x200, 1, 0), 0), 0);
+  CHECK_EQ(bus.enqueue(0, make(0x100, 1, 0), 0), 1);
+  CHECK_EQ(bus.enqueue(0, make(0x300, 1, 0), 0), -1);
+
+  /* A node sends its own highest-priority mailbox first */
+  CHECK(bus.start_next(0, tx));
+  CHECK_EQ(tx.frame.id, 0x100U);
+
+  bus.abort(0);
+  CHECK_EQ(bus.pending(0), 1U);  // The frame on the wire stays
+  bus.finish(tx);
+  CHECK_EQ(bus.pending(0), 0U);
+  CHECK(!bus.start_next(tx.end_ns, tx));
+}
+
+HOST_TEST(virtual_bus, per_node_bitrate) {
+  VirtualBus<2, 1> bus(500000);
+  BusTransmission tx;
+  struct can_frame f = make(0x100, 8, 0x55);
+
+  bus.set_bitrate(1, 125000);
+  bus.enqueue(1, f, 0);
+  CHECK(bus.start_next(0, tx));
+  CHECK_EQ(tx.end_ns, can_bits_to_ns(can_frame_bits(f), 125000));
+}
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Offline schedulability check of the bus (core/can_rta.hpp): worst-case
+ * response time of every message in each car profile's TX table, or of a
+ * simulated rig, at the bitrate of the chosen CAN controller in a
+ * devicetree overlay. If a deadline can be missed, suggests an assignment
+ * of the same IDs that meets every deadline. Exits with 1 unless the
+ * current IDs are schedulable.
+ *
+ *   can_rta --overlay app.overlay          # every car profile
+ *   can_rta --bitrate 250000 --jitter-us 500
+ *   can_rta --overlay app.overlay --rig 6  # rig_sim message set
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "app_config.hpp"
+#include "core/can_rta.hpp"
+#include "core/rig_sim.hpp"
+
+namespace {
+
+constexpr size_t MAX_MESSAGES = 128;
+constexpr size_t MAX_RIG_NODES = MAX_MESSAGES / 2;
+
+/* The TX thread releases on k_uptime_get(), i.e. to the millisecond */
+constexpr uint32_t DEFAULT_JITTER_US = 1000;
+
+struct MessageSet {
+  const char* name;
+  std::array<RtaMessage, MAX_MESSAGES> msgs;
+  size_t count;
+};
+
+double us(uint64_t ns) { return static_cast<double>(ns) / 1000.0; }
+
+std::string strip_comments(const std::string& text) {
+  std::string out;
+
+  for (size_t i = 0; i < text.size(); i++) {
+    if (text.compare(i, 2, "/*") == 0) {
+      size_t end = text.find("*/", i + 2);
+      i = (end == std::string::npos) ? text.size() : end + 1;
+    } else if (text.compare(i, 2, "//") == 0) {
+      size_t end = text.find('\n', i);
+      i = (end == std::string::npos) ? text.size() : end - 1;
+    } else {
+      out += text[i];
+    }
+  }
+  return out;
+}
+
+/* First "bitrate" or "bus-speed" in the node block starting at pos */
+uint32_t node_bitrate(const std::string& dts, size_t pos) {
+  size_t open = dts.find('{', pos);
+  int depth = 0;
+
+  for (size_t i = open; open != std::string::npos && i < dts.size(); i++) {
+    if (dts[i] == '{') {
+      depth++;
+    } else if (dts[i] == '}' && --depth == 0) {
+      break;
+    } else if (depth == 1 && (dts.compare(i, 7, "bitrate") == 0 ||
+                              dts.compare(i, 9, "bus-speed") == 0)) {
+      size_t value = dts.find('<', i);
+      return (value == std::string::npos)
+                 ? 0
+                 : static_cast<uint32_t>(
+                       std::strtoul(dts.c_str() + value + 1, NULL, 0));
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Bitrate of the node chosen as zephyr,canbus, or 0.
+ * * Looks in the "label: node { ... }" definition and in "&label { ... }"
+ * overrides; properties inherited from board files are not seen.
+ */
+uint32_t overlay_bitrate(const char* path) {
+  std::ifstream file(path);
+  std::stringstream text;
+
+  if (!file) {
+    return 0;
+  }
+  text << file.rdbuf();
+
+  std::string dts = strip_comments(text.str());
+  size_t chosen = dts.find("zephyr,canbus");
+  size_t amp = dts.find('&', chosen);
+  if (chosen == std::string::npos || amp == std::string::npos) {
+    return 0;
+  }
+
+  size_t end = dts.find_first_of(" \t\n;", amp);
+  std::string label = dts.substr(amp + 1, end - amp - 1);
+  for (const std::string& ref : {label + ":", "&" + label + " "}) {
+    for (size_t pos = dts.find(ref); pos != std::string::npos;
+         pos = dts.find(ref, pos + 1)) {
+      uint32_t bitrate = node_bitrate(dts, pos);
+      if (bitrate != 0) {
+        return bitrate;
+      }
+    }
+  }
+  return 0;
+}
+
+RtaMessage to_rta(const MessageSpec& spec, uint32_t id, uint64_t jitter_ns) {
+  return {.id = id,
+          .extended = false,
+          .dlc = spec.dlc,
+          .period_ns = spec.period_ms * 1000000ULL,
+          .deadline_ns = spec.deadline_ms * 1000000ULL,
+          .jitter_ns = jitter_ns};
+}
+
+void print_table(const MessageSet& set, uint32_t bitrate,
+                 const uint32_t* ids) {
+  std::array<RtaMessage, MAX_MESSAGES> msgs = set.msgs;
+
+  for (size_t i = 0; i < set.count; i++) {
+    msgs[i].id = ids[i];
+  }
+
+  std::printf("%7s %3s %9s %11s %9s %8s %8s %9s %9s\n", "id", "dlc",
+              "period_ms", "deadline_ms", "jitter_us", "frame_us",
+              "block_us", "resp_us", "slack_us");
+  for (size_t i = 0; i < set.count; i++) {
+    const RtaMessage& m = msgs[i];
+    RtaResult r = CanRta::response_by_id(msgs.data(), set.count, i, bitrate);
+    double slack = us(m.deadline_ns) - us(r.response_ns);
+
+    std::printf("  0x%03X %3u %9.1f %11.1f %9.1f %8.1f %8.1f ", m.id, m.dlc,
+                us(m.period_ns) / 1000.0, us(m.deadline_ns) / 1000.0,
+                us(m.jitter_ns), us(r.frame_ns), us(r.blocking_ns));
+    if (r.response_ns == CanRta::UNBOUNDED) {
+      std::printf("%9s %9s  MISS (bus overloaded)\n", "-", "-");
+    } else {
+      std::printf("%9.1f %9.1f%s\n", us(r.response_ns),
+                  r.schedulable ? slack : 0.0, r.schedulable ? "" : "  MISS");
+    }
+  }
+}
+
+/**
+ * @brief Analyze one message set with its IDs, and suggest new ones if a
+ * deadline can be missed. @return true if the current IDs are fine
+ */
+bool analyze(const MessageSet& set, uint32_t bitrate) {
+  std::array<uint32_t, MAX_MESSAGES> ids{};
+  uint64_t load_ppm = 0;
+  bool ok = true;
+
+  for (size_t i = 0; i < set.count; i++) {
+    const RtaMessage& m = set.msgs[i];
+
+    ids[i] = m.id;
+    load_ppm += CanRta::frame_ns(m, bitrate) * 1000000 / m.period_ns;
+    ok &= CanRta::response_by_id(set.msgs.data(), set.count, i, bitrate)
+              .schedulable;
+  }
+
+  std::printf("\n%s: %zu messages, %u bit/s, worst-case load %.1f %%\n",
+              set.name, set.count, bitrate, load_ppm / 10000.0);
+  print_table(set, bitrate, ids.data());
+  if (ok) {
+    std::printf("schedulable\n");
+    return true;
+  }
+
+  /* Hand out the same IDs in the order Audsley's algorithm found */
+  std::array<size_t, MAX_MESSAGES> order;
+  if (!CanRta::assign_priorities(set.msgs.data(), set.count, bitrate,
+                                 order)) {
+    std::printf("NOT schedulable, and no ID assignment meets every "
+                "deadline at %u bit/s\n",
+                bitrate);
+    return false;
+  }
+
+  std::array<uint32_t, MAX_MESSAGES> sorted = ids;
+  std::sort(sorted.begin(), sorted.begin() + set.count);
+  for (size_t level = 0; level < set.count; level++) {
+    ids[order[level]] = sorted[level];
+  }
+
+  std::printf("NOT schedulable; with these IDs every deadline is met:\n");
+  for (size_t i = 0; i < set.count; i++) {
+    if (ids[i] != set.msgs[i].id) {
+      std::printf("  0x%03X -> 0x%03X\n", set.msgs[i].id, ids[i]);
+    }
+  }
+  print_table(set, bitrate, ids.data());
+  return false;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* overlay = nullptr;
+  uint32_t bitrate = 0;
+  uint32_t jitter_us = DEFAULT_JITTER_US;
+  size_t rig_nodes = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--overlay") == 0 && i + 1 < argc) {
+      overlay = argv[++i];
+    } else if (std::strcmp(argv[i], "--bitrate") == 0 && i + 1 < argc) {
+      bitrate = static_cast<uint32_t>(std::strtoul(argv[++i], NULL, 0));
+    } else if (std::strcmp(argv[i], "--jitter-us") == 0 && i + 1 < argc) {
+      jitter_us = static_cast<uint32_t>(std::strtoul(argv[++i], NULL, 0));
+    } else if (std::strcmp(argv[i], "--rig") == 0 && i + 1 < argc) {
+      rig_nodes = std::strtoul(argv[++i], NULL, 0);
+    } else {
+      std::printf("usage: %s (--overlay FILE | --bitrate BPS) "
+                  "[--jitter-us US] [--rig NODES]\n",
+                  argv[0]);
+      return (std::strcmp(argv[i], "--help") == 0) ? 0 : 1;
+    }
+  }
+
+  if (overlay != nullptr && bitrate == 0) {
+    bitrate = overlay_bitrate(overlay);
+    if (bitrate == 0) {
+      std::fprintf(stderr, "%s: no bitrate for the zephyr,canbus node\n",
+                   overlay);
+      return 1;
+    }
+  }
+  if (bitrate == 0 || rig_nodes > MAX_RIG_NODES) {
+    std::fprintf(stderr, "need a bitrate > 0 and at most %zu rig nodes\n",
+                 MAX_RIG_NODES);
+    return 1;
+  }
+
+  uint64_t jitter_ns = uint64_t{jitter_us} * 1000;
+  static MessageSet set;
+  bool ok = true;
+
+  if (rig_nodes != 0) {
+    set.name = "rig";
+    set.count = 0;
+    for (size_t n = 0; n < rig_nodes; n++) {
+      for (const MessageSpec& spec : rig_node_profile(rig_node_kind(n)).tx) {
+        set.msgs[set.count++] =
+            to_rta(spec, spec.id + static_cast<uint32_t>(n), jitter_ns);
+      }
+    }
+    return analyze(set, bitrate) ? 0 : 1;
+  }
+
+  for (const CarProfile& profile : Config::CAR_PROFILES) {
+    set.name = profile.name;
+    set.count = 0;
+    for (const MessageSpec& spec : profile.schedule) {
+      set.msgs[set.count++] = to_rta(spec, spec.id, jitter_ns);
+    }
+    ok &= analyze(set, bitrate);
+  }
+  return ok ? 0 : 1;
+}
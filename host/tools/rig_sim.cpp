@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Simulate N rig nodes (base, pedals, wheels) on one CAN bus and report
+ * bus load and latency, per node or as a scaling curve over N.
+ *
+ *   rig_sim                      # curve for N = 1..32 at 500 kbit/s
+ *   rig_sim --nodes 12 --bitrate 1000000 --duration 5000
+ *   rig_sim --nm                 # CanNm bus-sleep entry and wake-up latency
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "core/nm_sim.hpp"
+#include "core/rig_sim.hpp"
+
+namespace {
+
+constexpr size_t MAX_NODES = 32;
+
+double us(uint64_t ns) { return static_cast<double>(ns) / 1000.0; }
+
+void print_nodes(size_t nodes, uint32_t bitrate, uint32_t duration_ms) {
+  static RigSim<MAX_NODES> sim(nodes, bitrate);
+  RigReport r = sim.run(duration_ms);
+
+  std::printf("%zu nodes, %u bit/s, %u ms: load %.1f %%, %u frames\n",
+              r.nodes, bitrate, duration_ms, r.load_permille() / 10.0,
+              r.frames);
+  std::printf("%4s %-7s %8s %8s %7s %8s %6s %10s %10s %8s\n", "node",
+              "kind", "sent", "dropped", "unsent", "rx", "miss", "mean_us",
+              "max_us", "lost");
+
+  for (size_t n = 0; n < sim.size(); n++) {
+    const RigNodeStats& s = sim.node(n);
+    uint64_t mean = (s.sent != 0) ? s.latency_sum_ns / s.sent : 0;
+
+    std::printf("%4zu %-7s %8u %8u %7u %8u %6u %10.1f %10.1f %8u\n", n,
+                rig_node_profile(rig_node_kind(n)).name, s.sent, s.dropped,
+                s.unsent, s.received, s.deadline_misses, us(mean),
+                us(s.max_latency_ns), sim.arbitration_losses(n));
+  }
+}
+
+void print_curve(size_t max_nodes, uint32_t bitrate, uint32_t duration_ms) {
+  std::printf("%u bit/s, %u ms per point\n", bitrate, duration_ms);
+  std::printf("%5s %7s %8s %10s %8s %8s %7s\n", "nodes", "load_%",
+              "frames", "max_us", "miss", "dropped", "unsent");
+
+  for (size_t n = 1; n <= max_nodes; n++) {
+    RigSim<MAX_NODES> sim(n, bitrate);
+    RigReport r = sim.run(duration_ms);
+
+    std::printf("%5zu %7.1f %8u %10.1f %8u %8u %7u%s\n", n,
+                r.load_permille() / 10.0, r.frames, us(r.max_latency_ns),
+                r.deadline_misses, r.dropped, r.unsent,
+                (r.deadline_misses != 0) ? "  <- timing broken" : "");
+  }
+}
+
+void print_nm(size_t max_nodes, uint32_t bitrate) {
+  constexpr uint32_t RELEASE_SPREAD_MS = 100;
+  static NmSim<MAX_NODES> sim(1, bitrate);
+  const NmTiming& t = NmSimConfig::TIMING;
+
+  std::printf("CanNm: %u bit/s, cycle %u ms, timeout %u ms, wait bus-sleep "
+              "%u ms; nodes release %u ms apart, then the last one wakes "
+              "the bus\n",
+              bitrate, t.msg_cycle_ms, t.timeout_ms, t.wait_bus_sleep_ms,
+              RELEASE_SPREAD_MS);
+  std::printf("%5s %14s %10s %10s %8s\n", "nodes", "sleep_entry_ms",
+              "skew_us", "wake_us", "pdus");
+
+  for (size_t n = 1; n <= max_nodes; n++) {
+    sim.reset(n, bitrate);
+    NmSleepWakeReport r = sim.sleep_wake(RELEASE_SPREAD_MS, n - 1);
+
+    if (!r.slept || !r.woke) {
+      std::printf("%5zu %s\n", n, r.slept ? "did not wake" : "did not sleep");
+      continue;
+    }
+    std::printf("%5zu %14.1f %10llu %10llu %8u\n", n,
+                r.sleep_entry_us() / 1000.0,
+                static_cast<unsigned long long>(r.sleep_skew_us()),
+                static_cast<unsigned long long>(r.wake_latency_us()), r.pdus);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t nodes = 0;  // 0: scaling curve
+  size_t max_nodes = MAX_NODES;
+  uint32_t bitrate = 500000;
+  uint32_t duration_ms = 2000;
+  bool nm = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--nodes") == 0 && i + 1 < argc) {
+      nodes = std::strtoul(argv[++i], NULL, 0);
+    } else if (std::strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+      max_nodes = std::strtoul(argv[++i], NULL, 0);
+    } else if (std::strcmp(argv[i], "--bitrate") == 0 && i + 1 < argc) {
+      bitrate = static_cast<uint32_t>(std::strtoul(argv[++i], NULL, 0));
+    } else if (std::strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+      duration_ms = static_cast<uint32_t>(std::strtoul(argv[++i], NULL, 0));
+    } else if (std::strcmp(argv[i], "--nm") == 0) {
+      nm = true;
+    } else {
+      std::printf("usage: %s [--nodes N | --max-nodes N] [--bitrate BPS] "
+                  "[--duration MS] [--nm]\n",
+                  argv[0]);
+      return (std::strcmp(argv[i], "--help") == 0) ? 0 : 1;
+    }
+  }
+
+  if (nodes > MAX_NODES || max_nodes > MAX_NODES || bitrate == 0) {
+    std::fprintf(stderr, "at most %zu nodes, bitrate > 0\n", MAX_NODES);
+    return 1;
+  }
+
+  if (nm) {
+    print_nm((nodes != 0) ? nodes : max_nodes, bitrate);
+  } else if (nodes != 0) {
+    print_nodes(nodes, bitrate, duration_ms);
+  } else {
+    print_curve(max_nodes, bitrate, duration_ms);
+  }
+  return 0;
+}
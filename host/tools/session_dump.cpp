@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Print a session log file (CONFIG_APP_SESSION_LOG) as candump lines, so
+ * trace_analyze and the can-utils read it.
+ *
+ *   session_dump /media/sd/SES00012.LOG > session.log
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "core/candump.hpp"
+#include "core/session_log.hpp"
+
+int main(int argc, char** argv) {
+  const char* iface = "can0";
+  const char* path = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--iface") == 0 && i + 1 < argc) {
+      iface = argv[++i];
+    } else if (std::strcmp(argv[i], "--help") == 0) {
+      std::printf("usage: %s [--iface NAME] SESnnnnn.LOG\n", argv[0]);
+      return 0;
+    } else {
+      path = argv[i];
+    }
+  }
+  if (path == nullptr) {
+    std::fprintf(stderr, "usage: %s [--iface NAME] SESnnnnn.LOG\n", argv[0]);
+    return 2;
+  }
+
+  FILE* in = std::fopen(path, "rb");
+  if (in == nullptr) {
+    std::perror(path);
+    return 1;
+  }
+
+  /* The first header gives the block size of the whole file */
+  SessionBlockHeader first;
+  if (std::fread(&first, sizeof(first), 1, in) != 1 || !first.is_valid()) {
+    std::fprintf(stderr, "%s: not a session log\n", path);
+    std::fclose(in);
+    return 1;
+  }
+  std::rewind(in);
+
+  std::vector<uint8_t> block(first.block_size);
+  uint64_t frames = 0;
+  uint32_t blocks = 0;
+  uint32_t bad_blocks = 0;
+  char line[128];
+
+  while (std::fread(block.data(), block.size(), 1, in) == 1) {
+    int n = SessionLog::decode_block(
+        block.data(), block.size(), [&](const TimedFrame& tf, uint64_t ts) {
+          struct can_frame frame = {};
+
+          frame.id = tf.id;
+          frame.flags = tf.flags;
+          frame.dlc = tf.dlc;
+          std::memcpy(frame.data, tf.data, sizeof(tf.data));
+          if (format_candump_line(ts, iface, frame, line, sizeof(line))) {
+            std::fputs(line, stdout);
+          }
+        });
+
+    if (n < 0) {
+      bad_blocks++;  // Torn by a power cut; the next one stands alone
+    } else {
+      frames += static_cast<uint64_t>(n);
+    }
+    blocks++;
+  }
+
+  std::fprintf(stderr, "%llu frames in %u blocks of %u bytes, %u corrupt\n",
+               static_cast<unsigned long long>(frames), blocks,
+               first.block_size, bad_blocks);
+  std::fclose(in);
+  return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * One-pass analysis of a bus capture: per-ID timing statistics and
+ * histograms of this node's signals (core/trace_stats.hpp). The capture
+ * is mmap()ed and read once, so multi-GB sessions take seconds.
+ *
+ *   trace_analyze session.log        # candump -l / candump -L output
+ *   trace_analyze session.pcap       # tcpdump -i can0 -w session.pcap
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+#include "core/pcap_reader.hpp"
+#include "core/trace_replay.hpp"
+#include "core/trace_stats.hpp"
+
+namespace {
+
+constexpr size_t ID_CAPACITY = 4096;
+constexpr int BAR_WIDTH = 40;
+
+using Analyzer = TraceAnalyzer<ID_CAPACITY>;
+
+double ms(uint64_t us) { return static_cast<double>(us) / 1000.0; }
+
+void print_ids(const Analyzer& analyzer) {
+  static const IdTiming* sorted[ID_CAPACITY];
+  size_t n = 0;
+
+  analyzer.for_each_id([&](const IdTiming& t) { sorted[n++] = &t; });
+  std::sort(sorted, sorted + n, [](const IdTiming* a, const IdTiming* b) {
+    return a->key < b->key;
+  });
+
+  std::printf("\n%10s %10s %9s %10s %10s %10s %8s\n", "id", "frames",
+              "rate_hz", "mean_ms", "min_ms", "max_ms", "reorder");
+  for (size_t i = 0; i < n; i++) {
+    const IdTiming& t = *sorted[i];
+    bool ext = (t.key & 0x80000000U) != 0;
+    uint64_t span = t.last_us - t.first_us;
+    double rate = (span != 0) ? (t.count - 1) * 1e6 / span : 0.0;
+    uint64_t min_gap = (t.count > 1) ? t.min_gap_us : 0;
+
+    /* candump style: 3 hex digits for standard IDs, 8 for extended */
+    std::printf(ext ? "%10.8X %10u %9.1f %10.3f %10.3f %10.3f %8u\n"
+                    : "%10.3X %10u %9.1f %10.3f %10.3f %10.3f %8u\n",
+                t.key & CAN_EXT_ID_MASK, t.count, rate, ms(t.mean_gap_us()),
+                ms(min_gap), ms(t.max_gap_us), t.reordered);
+  }
+  if (analyzer.overflow() != 0) {
+    std::printf("(%llu frames of IDs beyond the %zu-entry table)\n",
+                static_cast<unsigned long long>(analyzer.overflow()),
+                ID_CAPACITY);
+  }
+}
+
+void print_histograms(const Analyzer& analyzer) {
+  for (size_t s = 0; s < TraceSignals::NODE.size(); s++) {
+    const SignalHistogram& h = analyzer.histogram(s);
+    uint64_t peak = 0;
+
+    if (h.count() == 0) {
+      continue;
+    }
+    for (size_t b = 0; b < SignalHistogram::BINS; b++) {
+      peak = std::max(peak, h.bin(b));
+    }
+
+    std::printf("\n%s (0x%03X): %llu samples, min %llu, max %llu\n",
+                TraceSignals::NODE[s].name, TraceSignals::NODE[s].id,
+                static_cast<unsigned long long>(h.count()),
+                static_cast<unsigned long long>(h.min()),
+                static_cast<unsigned long long>(h.max()));
+    for (size_t b = 0; b < SignalHistogram::BINS; b++) {
+      if (h.bin(b) == 0) {
+        continue;
+      }
+      int bar = static_cast<int>(h.bin(b) * BAR_WIDTH / peak);
+
+      std::printf("  %10llu %12llu %.*s\n",
+                  static_cast<unsigned long long>(h.bin_start(b)),
+                  static_cast<unsigned long long>(h.bin(b)), bar,
+                  "########################################");
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 2 || std::strcmp(argv[1], "--help") == 0) {
+    std::printf("usage: %s CAPTURE (candump log or SocketCAN pcap)\n",
+                argv[0]);
+    return (argc == 2) ? 0 : 1;
+  }
+
+  int fd = open(argv[1], O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    std::perror(argv[1]);
+    return 1;
+  }
+
+  size_t size = static_cast<size_t>(st.st_size);
+  const uint8_t* data = nullptr;
+  if (size != 0) {
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+      std::perror("mmap");
+      return 1;
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+    data = static_cast<const uint8_t*>(map);
+  }
+  close(fd);
+
+  static Analyzer analyzer;
+  uint32_t skipped = 0;
+  const char* format;
+  auto start = std::chrono::steady_clock::now();
+
+  PcapReader pcap(data, size);
+  if (pcap.valid()) {
+    uint64_t ts;
+    struct can_frame frame;
+
+    format = "pcap";
+    while (pcap.next(ts, frame)) {
+      analyzer.add(ts, frame);
+    }
+    skipped = pcap.skipped();
+  } else {
+    CandumpReader reader(
+        std::string_view(reinterpret_cast<const char*>(data), size));
+    CandumpRecord rec;
+
+    format = "candump";
+    while (reader.next(rec)) {
+      analyzer.add(rec.timestamp_us, rec.frame);
+    }
+    skipped = reader.skipped();
+  }
+  analyzer.finish();
+
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  double mb = static_cast<double>(size) / 1e6;
+
+  std::printf("%s: %s, %.1f MB, %llu frames, %zu IDs, %u skipped\n",
+              argv[1], format, mb,
+              static_cast<unsigned long long>(analyzer.frames()),
+              analyzer.distinct_ids(), skipped);
+  std::printf("analyzed in %.3f s (%.0f MB/s)\n", elapsed.count(),
+              (elapsed.count() > 0) ? mb / elapsed.count() : 0.0);
+
+  print_ids(analyzer);
+  print_histograms(analyzer);
+  return 0;
+}
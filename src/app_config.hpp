@@ -7,18 +7,176 @@
 
 #include <zephyr/kernel.h>  // Required for K_SECONDS, K_MSEC
 
+#include <array>
 #include <cstdint>  // Required for uint32_t, uint8_t
 
+#include "core/car_profile.hpp"
+#include "core/message_spec.hpp"
+#include "core/signal_agg.hpp"
+
 namespace Config {
 // CAN Bus Settings
 constexpr uint32_t CAN_GEAR_MSG_ID = 0x100;
 constexpr uint8_t CAN_MSG_DLC = 1;
+constexpr uint32_t CAN_DIAG_MSG_ID = 0x6F0;  // Low priority, health report
+constexpr uint8_t CAN_DIAG_MSG_DLC = 8;
+constexpr uint32_t CAN_DIAG_REQ_MSG_ID = 0x7E0;  // Commands to this node
+constexpr uint32_t CAN_CRASH_REPORT_MSG_ID = 0x6E0;  // Reply to 0x7E0#05
+constexpr uint32_t CAN_SECOC_SYNC_MSG_ID = 0x6F2;  // Full FV of gear frames
+constexpr uint32_t CAN_SECOC_FV_REQ_MSG_ID = 0x6F3;  // Sender lost its FV
+constexpr uint32_t CAN_SECOC_FV_ANSWER_MSG_ID = 0x6F4;  // Receiver's FV
+constexpr uint32_t CAN_NM_BASE_ID = 0x500;  // + node ID, see core/can_nm.hpp
+constexpr uint32_t CAN_NM_ID_MASK = 0x7C0;  // 64 nodes
+constexpr uint8_t CAN_NM_DLC = 2;
+constexpr uint32_t CAN_HEARTBEAT_BASE_ID = 0x700;  // + node ID
+constexpr uint32_t CAN_HEARTBEAT_ID_MASK = 0x7C0;  // 64 nodes
+constexpr uint8_t CAN_HEARTBEAT_DLC = 1;
+// Authenticated gear frames, SecOC profile 1 (8-bit FV, 24-bit MAC)
+constexpr uint8_t SECOC_FRESHNESS_BYTES = 1;
+constexpr uint8_t SECOC_MAC_BYTES = 3;
+constexpr uint8_t SECOC_SYNC_FV_BYTES = 5;
 
 // Thread Settings
 constexpr size_t TX_THREAD_STACK_SIZE = 2048;
 constexpr int TX_THREAD_PRIORITY = 5;
+constexpr size_t RX_THREAD_STACK_SIZE = 2048;
+constexpr int RX_THREAD_PRIORITY = 6;
+constexpr size_t BLACKBOX_THREAD_STACK_SIZE = 2048;
+constexpr int BLACKBOX_THREAD_PRIORITY = K_LOWEST_APPLICATION_THREAD_PRIO;
+constexpr size_t SESSION_LOG_THREAD_STACK_SIZE = 2048;
+constexpr int SESSION_LOG_THREAD_PRIORITY = K_LOWEST_APPLICATION_THREAD_PRIO;
+constexpr size_t REPLAY_THREAD_STACK_SIZE = 2048;
+constexpr int REPLAY_THREAD_PRIORITY = RX_THREAD_PRIORITY + 1;  // RX drains
+constexpr size_t NM_THREAD_STACK_SIZE = 1024;
+constexpr int NM_THREAD_PRIORITY = TX_THREAD_PRIORITY - 1;  // Bus-wide timers
+constexpr size_t LIVENESS_THREAD_STACK_SIZE = 1024;
+constexpr int LIVENESS_THREAD_PRIORITY = TX_THREAD_PRIORITY - 1;
+constexpr size_t SIGNAL_AGG_THREAD_STACK_SIZE = 1024;
+constexpr int SIGNAL_AGG_THREAD_PRIORITY = TX_THREAD_PRIORITY - 1;  // Sampling
+constexpr size_t SLCAN_THREAD_STACK_SIZE = 2048;
+constexpr int SLCAN_THREAD_PRIORITY = RX_THREAD_PRIORITY + 1;  // PC commands
+constexpr size_t LIVENESS_MAX_LISTENERS = 4;
+
+// Queue Settings
+constexpr size_t RX_QUEUE_DEPTH = 16;  // Must be a power of two
+constexpr size_t SUB_QUEUE_DEPTH = 16;  // Subscribed frames, power of two
 
 // Timing Settings
-constexpr auto GEAR_SHIFT_INTERVAL = K_SECONDS(2);
+constexpr uint32_t GEAR_SHIFT_INTERVAL_MS = 2000;
+constexpr uint32_t GEAR_DEADLINE_MS = 10;
+constexpr uint32_t DIAG_INTERVAL_MS = 1000;
+constexpr uint32_t DIAG_DEADLINE_MS = 100;
 constexpr auto TX_TIMEOUT = K_MSEC(100);
-}  // namespace Config
\ No newline at end of file
+
+// Message Table (drives the TX scheduler)
+constexpr std::array<MessageSpec, 2> TX_MESSAGES = {{
+    {.id = CAN_GEAR_MSG_ID,
+     .dlc = CAN_MSG_DLC,
+     .period_ms = GEAR_SHIFT_INTERVAL_MS,
+     .deadline_ms = GEAR_DEADLINE_MS},
+    {.id = CAN_DIAG_MSG_ID,
+     .dlc = CAN_DIAG_MSG_DLC,
+     .period_ms = DIAG_INTERVAL_MS,
+     .deadline_ms = DIAG_DEADLINE_MS},
+}};
+
+// Car Profiles (switched at runtime, see src/car_profiles.cpp)
+constexpr GearLayout GEAR_LAYOUT = {.id = CAN_GEAR_MSG_ID,
+                                    .dlc = CAN_MSG_DLC,
+                                    .gear = {.start_bit = 0, .length = 8}};
+
+constexpr struct can_filter std_filter(uint32_t id) {
+  return {.id = id, .mask = CAN_STD_ID_MASK, .flags = 0};
+}
+
+constexpr std::array<CarProfile, 3> CAR_PROFILES = {{
+    /* The defaults above: sequential six-speed */
+    {.name = "gt3",
+     .schedule = TX_MESSAGES,
+     .gear_layout = GEAR_LAYOUT,
+     .forward_gears = 6,
+     .filters = {{std_filter(CAN_GEAR_MSG_ID),
+                  std_filter(CAN_DIAG_REQ_MSG_ID)}}},
+    /* H-pattern five-speed, slower diagnostics */
+    {.name = "road",
+     .schedule = {{{.id = CAN_GEAR_MSG_ID,
+                    .dlc = CAN_MSG_DLC,
+                    .period_ms = GEAR_SHIFT_INTERVAL_MS,
+                    .deadline_ms = GEAR_DEADLINE_MS},
+                   {.id = CAN_DIAG_MSG_ID,
+                    .dlc = CAN_DIAG_MSG_DLC,
+                    .period_ms = 2000,
+                    .deadline_ms = DIAG_DEADLINE_MS}}},
+     .gear_layout = GEAR_LAYOUT,
+     .forward_gears = 5,
+     .filters = {{std_filter(CAN_GEAR_MSG_ID),
+                  std_filter(CAN_DIAG_REQ_MSG_ID)}}},
+    /* Paddle shifts at 10 Hz; gear in the low nibble of byte 1 of 0x110 */
+    {.name = "formula",
+     .schedule = {{{.id = 0x110, .dlc = 2, .period_ms = 100, .deadline_ms = 5},
+                   {.id = CAN_DIAG_MSG_ID,
+                    .dlc = CAN_DIAG_MSG_DLC,
+                    .period_ms = DIAG_INTERVAL_MS,
+                    .deadline_ms = DIAG_DEADLINE_MS}}},
+     .gear_layout = {.id = 0x110,
+                     .dlc = 2,
+                     .gear = {.start_bit = 8, .length = 4}},
+     .forward_gears = 6,
+     .filters = {{std_filter(0x110), std_filter(CAN_DIAG_REQ_MSG_ID)}}},
+}};
+constexpr size_t DEFAULT_CAR_PROFILE = 0;
+
+// Aggregated Signals (see src/signal_agg.cpp)
+constexpr size_t AGG_STEERING = 0;   // 0.1 degree
+constexpr size_t AGG_CLUTCH = 1;     // 0.1 %
+constexpr size_t AGG_LOAD_CELL = 2;  // Brake load cell, 0.1 kg
+
+constexpr std::array<AggSignal, 3> AGG_SIGNALS = {{
+    {.name = "steering", .sample_hz = 1000, .raw_dlc = 2},
+    {.name = "clutch", .sample_hz = 500, .raw_dlc = 2},
+    {.name = "load_cell", .sample_hz = 1000, .raw_dlc = 2},
+}};
+
+/* Each consumer gets its own rate of the same signal: the base unit
+ * closes its force-feedback and pedal loops at 100 Hz, the dashboard
+ * refreshes at 10 Hz and the telemetry logger keeps 1 Hz trends */
+constexpr std::array<AggStage, 6> AGG_STAGES = {{
+    {.consumer = "base",
+     .signal = AGG_STEERING,
+     .id = 0x120,
+     .outputs = SignalAgg::MEAN | SignalAgg::LAST,
+     .samples = 10,
+     .window_ms = 0},
+    {.consumer = "base",
+     .signal = AGG_CLUTCH,
+     .id = 0x121,
+     .outputs = SignalAgg::MAX | SignalAgg::LAST,
+     .samples = 5,
+     .window_ms = 0},
+    {.consumer = "base",
+     .signal = AGG_LOAD_CELL,
+     .id = 0x122,
+     .outputs = SignalAgg::MAX | SignalAgg::MEAN,
+     .samples = 10,
+     .window_ms = 0},
+    {.consumer = "dash",
+     .signal = AGG_STEERING,
+     .id = 0x320,
+     .outputs = SignalAgg::MIN | SignalAgg::MAX | SignalAgg::LAST,
+     .samples = 0,
+     .window_ms = 100},
+    {.consumer = "dash",
+     .signal = AGG_LOAD_CELL,
+     .id = 0x322,
+     .outputs = SignalAgg::ALL,
+     .samples = 0,
+     .window_ms = 100},
+    {.consumer = "logger",
+     .signal = AGG_CLUTCH,
+     .id = 0x3A1,
+     .outputs = SignalAgg::MIN | SignalAgg::MAX | SignalAgg::MEAN,
+     .samples = 0,
+     .window_ms = 1000},
+}};
+static_assert(SignalAgg::valid(AGG_SIGNALS, AGG_STAGES));
+}  // namespace Config
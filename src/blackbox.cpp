@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Black-box recorder (CONFIG_APP_BLACKBOX)
+ *
+ * TX/RX paths only copy frames into a RAM ring. A trigger freezes the ring
+ * and wakes a lowest-priority writer thread, which compresses the frozen
+ * ring in small chunks into the next flash slot and then unfreezes it.
+ */
+
+#include "blackbox.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/atomic.h>
+
+#include <cstring>
+
+#include "app_config.hpp"
+#include "core/candump.hpp"
+#include "core/frame_compress.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+#if DT_HAS_FIXED_PARTITION_LABEL(blackbox_partition)
+#define BLACKBOX_AREA_ID FIXED_PARTITION_ID(blackbox_partition)
+#else
+#define BLACKBOX_AREA_ID FIXED_PARTITION_ID(storage_partition)
+#endif
+
+namespace {
+constexpr size_t SLOT_SIZE = CONFIG_APP_BLACKBOX_SLOT_SIZE;
+constexpr size_t CHUNK_SIZE = 256;
+constexpr size_t PAYLOAD_CAPACITY = SLOT_SIZE - sizeof(BlackboxHeader);
+
+FrameRing<CONFIG_APP_BLACKBOX_RING_SIZE> ring;
+struct k_spinlock ring_lock;
+bool frozen;  // Guarded by ring_lock
+BlackboxTrigger pending_reason;
+uint32_t trigger_timestamp;
+
+K_SEM_DEFINE(commit_sem, 0, 1);
+
+/* Writer thread state */
+const struct flash_area* area;
+size_t slot_count;
+size_t next_slot;
+uint32_t next_sequence;
+uint8_t chunk[CHUNK_SIZE] __aligned(4);
+
+atomic_t commits;
+atomic_t commit_errors;
+atomic_t frames_skipped;
+
+uint32_t now_us() {
+  return static_cast<uint32_t>(k_ticks_to_us_floor64(k_uptime_ticks()));
+}
+
+off_t slot_offset(size_t slot) { return static_cast<off_t>(slot * SLOT_SIZE); }
+
+/* Final write of a snapshot part, padded to the flash write block */
+int write_padded(off_t off, size_t len) {
+  size_t padded = ROUND_UP(len, flash_area_align(area));
+
+  memset(&chunk[len], 0xFF, padded - len);
+  return flash_area_write(area, off, chunk, padded);
+}
+
+int commit_snapshot() {
+  size_t align = flash_area_align(area);
+  off_t base = slot_offset(next_slot);
+  off_t write_off = base + sizeof(BlackboxHeader);
+  FrameEncoder encoder;
+  size_t fill = 0;
+  size_t payload_len = 0;
+  uint32_t payload_crc = 0;
+  uint32_t entries = 0;
+  int ret;
+
+  ret = flash_area_erase(area, base, SLOT_SIZE);
+  if (ret != 0) {
+    return ret;
+  }
+
+  /* Newest first, so running out of slot space only loses the oldest */
+  for (size_t age = 0; age < ring.size(); age++) {
+    if (payload_len + FrameCompress::MAX_ENTRY_SIZE > PAYLOAD_CAPACITY) {
+      break;
+    }
+
+    const TimedFrame& entry = ring.newest(age);
+    size_t n = encoder.encode(entry, &chunk[fill], CHUNK_SIZE - fill);
+
+    if (n == 0) {
+      /* Chunk full: write the aligned part, keep the tail for next time */
+      size_t len = ROUND_DOWN(fill, align);
+
+      ret = flash_area_write(area, write_off, chunk, len);
+      if (ret != 0) {
+        return ret;
+      }
+      write_off += len;
+      fill -= len;
+      memmove(chunk, &chunk[len], fill);
+      k_yield();
+
+      n = encoder.encode(entry, &chunk[fill], CHUNK_SIZE - fill);
+    }
+
+    payload_crc = crc32_update(payload_crc, &chunk[fill], n);
+    fill += n;
+    payload_len += n;
+    entries++;
+  }
+
+  if (fill != 0) {
+    ret = write_padded(write_off, fill);
+    if (ret != 0) {
+      return ret;
+    }
+  }
+
+  /* Header last: it is the commit marker */
+  BlackboxHeader hdr = {
+      .magic = BlackboxHeader::MAGIC,
+      .sequence = next_sequence,
+      .trigger = static_cast<uint32_t>(pending_reason),
+      .entry_count = entries,
+      .payload_len = static_cast<uint32_t>(payload_len),
+      .payload_crc = payload_crc,
+      .trigger_timestamp_us = trigger_timestamp,
+      .header_crc = 0,
+  };
+  hdr.header_crc = hdr.compute_crc();
+
+  memcpy(chunk, &hdr, sizeof(hdr));
+  ret = write_padded(base, sizeof(hdr));
+  if (ret != 0) {
+    return ret;
+  }
+
+  LOG_INF("Black box: %u frames (%u bytes) -> slot %u, seq %u", entries,
+          static_cast<uint32_t>(payload_len), static_cast<uint32_t>(next_slot),
+          next_sequence);
+
+  next_slot = (next_slot + 1) % slot_count;
+  next_sequence++;
+  return 0;
+}
+
+int read_header(size_t slot, BlackboxHeader& hdr) {
+  return flash_area_read(area, slot_offset(slot), &hdr, sizeof(hdr));
+}
+
+void blackbox_thread_entry(void* arg1, void* arg2, void* arg3) {
+  if (blackbox_mount() != 0) {
+    return;
+  }
+
+  while (1) {
+    k_sem_take(&commit_sem, K_FOREVER);
+
+    if (commit_snapshot() == 0) {
+      atomic_inc(&commits);
+    } else {
+      atomic_inc(&commit_errors);
+      LOG_ERR("Black box commit to slot %u failed",
+              static_cast<uint32_t>(next_slot));
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&ring_lock);
+    frozen = false;
+    k_spin_unlock(&ring_lock, key);
+  }
+}
+}  // namespace
+
+K_THREAD_DEFINE(blackbox_tid, Config::BLACKBOX_THREAD_STACK_SIZE,
+                blackbox_thread_entry, NULL, NULL, NULL,
+                Config::BLACKBOX_THREAD_PRIORITY, 0, 0);
+
+void blackbox_record(const struct can_frame& frame, FrameDir dir) {
+  TimedFrame entry = TimedFrame::from(frame, dir, now_us());
+  k_spinlock_key_t key = k_spin_lock(&ring_lock);
+
+  if (frozen) {
+    k_spin_unlock(&ring_lock, key);
+    atomic_inc(&frames_skipped);
+    return;
+  }
+
+  ring.push(entry);
+  k_spin_unlock(&ring_lock, key);
+}
+
+void blackbox_trigger(BlackboxTrigger reason) {
+  k_spinlock_key_t key = k_spin_lock(&ring_lock);
+
+  if (frozen || area == NULL) {
+    k_spin_unlock(&ring_lock, key);
+    return;
+  }
+
+  frozen = true;
+  pending_reason = reason;
+  trigger_timestamp = now_us();
+  k_spin_unlock(&ring_lock, key);
+
+  k_sem_give(&commit_sem);
+}
+
+void blackbox_note_deadline_misses(uint32_t total_misses) {
+  static uint32_t window_base;
+  static int64_t window_start_ms;
+  int64_t now = k_uptime_get();
+
+  if (now - window_start_ms >= CONFIG_APP_BLACKBOX_MISS_WINDOW_MS) {
+    window_start_ms = now;
+    window_base = total_misses;
+  }
+
+  if (total_misses - window_base >= CONFIG_APP_BLACKBOX_MISS_BURST) {
+    window_base = total_misses;
+    blackbox_trigger(BlackboxTrigger::DeadlineMissBurst);
+  }
+}
+
+int blackbox_mount() {
+  static BlackboxHeader hdr;
+  const struct flash_area* fa = area;
+  uint32_t latest_seq;
+  bool found;
+
+  if (fa == NULL) {
+    int ret = flash_area_open(BLACKBOX_AREA_ID, &fa);
+    if (ret != 0) {
+      LOG_ERR("Black box flash area unavailable: %d", ret);
+      return ret;
+    }
+  }
+
+  /* Triggers only freeze the ring while a writer can commit it */
+  size_t count = fa->fa_size / SLOT_SIZE;
+  k_spinlock_key_t key = k_spin_lock(&ring_lock);
+
+  slot_count = count;
+  area = (count == 0) ? NULL : fa;
+  k_spin_unlock(&ring_lock, key);
+
+  if (count == 0) {
+    LOG_ERR("Black box area smaller than one slot");
+    flash_area_close(fa);
+    return -ENOSPC;
+  }
+
+  next_slot = blackbox_next_slot(
+      slot_count, SLOT_SIZE,
+      [](size_t slot) -> const BlackboxHeader* {
+        return (read_header(slot, hdr) == 0) ? &hdr : nullptr;
+      },
+      latest_seq, found);
+  next_sequence = found ? latest_seq + 1 : 0;
+  return 0;
+}
+
+int blackbox_read_latest(BlackboxHeader& hdr, BlackboxFrameFn on_frame,
+                         void* user_data) {
+  static uint8_t buf[CHUNK_SIZE + FrameCompress::MAX_ENTRY_SIZE];
+  int ret;
+
+  if (area == NULL || slot_count == 0) {
+    return -ENODEV;
+  }
+
+  size_t latest = (next_slot + slot_count - 1) % slot_count;
+
+  ret = read_header(latest, hdr);
+  if (ret != 0) {
+    return ret;
+  }
+  if (!hdr.is_valid(SLOT_SIZE)) {
+    return -ENOENT;
+  }
+
+  /* Pass 1: verify the payload before handing out any frame */
+  off_t payload_off = slot_offset(latest) + sizeof(BlackboxHeader);
+  uint32_t crc = 0;
+  for (size_t done = 0; done < hdr.payload_len;) {
+    size_t n = MIN(sizeof(buf), hdr.payload_len - done);
+
+    ret = flash_area_read(area, payload_off + done, buf, n);
+    if (ret != 0) {
+      return ret;
+    }
+    crc = crc32_update(crc, buf, n);
+    done += n;
+  }
+  if (crc != hdr.payload_crc) {
+    return -EBADMSG;
+  }
+
+  /* Pass 2: decode, carrying partial entries across reads */
+  FrameDecoder decoder;
+  TimedFrame frame;
+  size_t have = 0;
+  size_t read_pos = 0;
+  uint32_t delivered = 0;
+
+  while (delivered < hdr.entry_count) {
+    size_t want = MIN(sizeof(buf) - have, hdr.payload_len - read_pos);
+
+    if (want != 0) {
+      ret = flash_area_read(area, payload_off + read_pos, &buf[have], want);
+      if (ret != 0) {
+        return ret;
+      }
+      have += want;
+      read_pos += want;
+    }
+
+    size_t pos = 0;
+    while (delivered < hdr.entry_count &&
+           (have - pos >= FrameCompress::MAX_ENTRY_SIZE ||
+            read_pos == hdr.payload_len)) {
+      size_t used = decoder.decode(&buf[pos], have - pos, frame);
+      if (used == 0) {
+        return -EBADMSG;
+      }
+      on_frame(frame, user_data);
+      pos += used;
+      delivered++;
+    }
+
+    memmove(buf, &buf[pos], have - pos);
+    have -= pos;
+  }
+
+  return static_cast<int>(delivered);
+}
+
+BlackboxStatus blackbox_status() {
+  k_spinlock_key_t key = k_spin_lock(&ring_lock);
+  bool is_frozen = frozen;
+  k_spin_unlock(&ring_lock, key);
+
+  return BlackboxStatus{
+      .mounted = area != NULL,
+      .frozen = is_frozen,
+      .slot_count = slot_count,
+      .next_slot = next_slot,
+      .next_sequence = next_sequence,
+      .commits = static_cast<uint32_t>(atomic_get(&commits)),
+      .commit_errors = static_cast<uint32_t>(atomic_get(&commit_errors)),
+      .frames_skipped = static_cast<uint32_t>(atomic_get(&frames_skipped)),
+  };
+}
+
+#if defined(CONFIG_SHELL)
+namespace {
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  BlackboxStatus st = blackbox_status();
+
+  shell_print(sh, "mounted %d, frozen %d, slot %u/%u, seq %u", st.mounted,
+              st.frozen, static_cast<uint32_t>(st.next_slot),
+              static_cast<uint32_t>(st.slot_count), st.next_sequence);
+  shell_print(sh, "commits %u, errors %u, frames skipped %u", st.commits,
+              st.commit_errors, st.frames_skipped);
+  return 0;
+}
+
+int cmd_trigger(const struct shell* sh, size_t argc, char** argv) {
+  blackbox_trigger(BlackboxTrigger::Manual);
+  return 0;
+}
+
+void print_frame(const TimedFrame& tf, void* user_data) {
+  const struct shell* sh = static_cast<const struct shell*>(user_data);
+  struct can_frame frame = {};
+  char line[80];
+
+  frame.id = tf.id;
+  frame.flags = tf.flags;
+  frame.dlc = tf.dlc;
+  memcpy(frame.data, tf.data, sizeof(tf.data));
+
+  const char* dir = (tf.dir == FrameDir::Tx) ? "tx" : "rx";
+
+  if (format_candump_line(tf.timestamp_us, dir, frame, line, sizeof(line)) !=
+      0) {
+    shell_fprintf(sh, SHELL_NORMAL, "%s", line);
+  }
+}
+
+/* Prints candump lines (newest first) that host tools can parse */
+int cmd_dump(const struct shell* sh, size_t argc, char** argv) {
+  BlackboxHeader hdr;
+  int ret =
+      blackbox_read_latest(hdr, print_frame, const_cast<struct shell*>(sh));
+
+  if (ret < 0) {
+    shell_error(sh, "No readable snapshot (%d)", ret);
+    return ret;
+  }
+  shell_print(sh, "seq %u, trigger %u, %d frames", hdr.sequence, hdr.trigger,
+              ret);
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    blackbox_cmds,
+    SHELL_CMD(status, NULL, "Recorder and flash slot status", cmd_status),
+    SHELL_CMD(trigger, NULL, "Freeze the ring and commit to flash",
+              cmd_trigger),
+    SHELL_CMD(dump, NULL, "Print the latest snapshot as candump", cmd_dump),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(blackbox, &blackbox_cmds, "Black-box recorder", NULL);
+#endif /* CONFIG_SHELL */
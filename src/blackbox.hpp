@@ -0,0 +1,71 @@
+/*
+ * src/blackbox.hpp
+ * Black-box recorder: RAM ring of recent bus traffic committed to flash
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
+
+#include "core/blackbox_format.hpp"
+#include "core/frame_ring.hpp"
+
+struct BlackboxStatus {
+  bool mounted;
+  bool frozen;           // A snapshot is being committed
+  size_t slot_count;
+  size_t next_slot;
+  uint32_t next_sequence;
+  uint32_t commits;
+  uint32_t commit_errors;
+  uint32_t frames_skipped;  // Frames seen while the ring was frozen
+};
+
+using BlackboxFrameFn = void (*)(const TimedFrame& frame, void* user_data);
+
+#if defined(CONFIG_APP_BLACKBOX)
+
+/**
+ * @brief Record a frame in the RAM ring.
+ * * Safe from ISR and driver callbacks: a short spinlock and a 20-byte copy.
+ */
+void blackbox_record(const struct can_frame& frame, FrameDir dir);
+
+/**
+ * @brief Freeze the ring and let the writer thread commit it to flash.
+ * * Safe from ISR. Ignored while a previous snapshot is still being written.
+ */
+void blackbox_trigger(BlackboxTrigger reason);
+
+/**
+ * @brief Feed the running deadline-miss total; triggers on a burst.
+ */
+void blackbox_note_deadline_misses(uint32_t total_misses);
+
+/**
+ * @brief (Re)scan the flash area for the latest snapshot.
+ * * Runs once in the writer thread at boot; exposed so tests can simulate a
+ * reboot.
+ */
+int blackbox_mount();
+
+/**
+ * @brief Decode the latest valid snapshot, newest frame first.
+ * * @return Number of frames delivered, -ENOENT if there is no snapshot,
+ * -EBADMSG if the payload CRC does not match, or a flash error
+ */
+int blackbox_read_latest(BlackboxHeader& hdr, BlackboxFrameFn on_frame,
+                         void* user_data);
+
+BlackboxStatus blackbox_status();
+
+#else
+
+inline void blackbox_record(const struct can_frame&, FrameDir) {}
+inline void blackbox_trigger(BlackboxTrigger) {}
+inline void blackbox_note_deadline_misses(uint32_t) {}
+
+#endif /* CONFIG_APP_BLACKBOX */
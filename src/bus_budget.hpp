@@ -0,0 +1,86 @@
+/*
+ * src/bus_budget.hpp
+ * Bitrate of the chosen CAN controller and this node's worst-case load
+ */
+
+#pragma once
+
+#include <zephyr/devicetree.h>
+
+#include <cstdint>  // uint32_t, uint64_t
+
+#include "app_config.hpp"
+#include "core/bus_budget.hpp"
+
+#if defined(CONFIG_APP_SECOC)
+#include "core/secoc.hpp"
+#endif
+#if defined(CONFIG_APP_CAN_REDUNDANCY)
+#include "core/redundancy.hpp"
+#endif
+
+namespace BusBudget {
+/* Nominal bitrate of zephyr,canbus ("bitrate", or the older "bus-speed");
+ * 0 if the devicetree sets neither */
+constexpr uint32_t BITRATE =
+    DT_PROP_OR(DT_CHOSEN(zephyr_canbus), bitrate,
+               DT_PROP_OR(DT_CHOSEN(zephyr_canbus), bus_speed, 0));
+
+constexpr uint64_t LIMIT_PPM =
+    uint64_t{CONFIG_APP_BUS_LOAD_LIMIT_PERCENT} * PPM / 100;
+
+/**
+ * @brief Load of the busiest car profile's TX table.
+ * * Gear frames count with their SecOC authenticator and alive counter.
+ */
+constexpr uint64_t schedule_ppm() {
+  uint64_t worst = 0;
+
+  for (const CarProfile& car : Config::CAR_PROFILES) {
+    uint64_t ppm =
+        table_load_ppm(car.schedule, BITRATE, [&](const MessageSpec& spec) {
+          uint8_t dlc = spec.dlc;
+
+          if (spec.id == car.gear_layout.id) {
+#if defined(CONFIG_APP_SECOC)
+            dlc += SECOC_AUTH_BYTES;
+#endif
+#if defined(CONFIG_APP_CAN_REDUNDANCY)
+            dlc += Redundancy::ALIVE_BYTES;
+#endif
+          }
+          return dlc;
+        });
+    worst = (ppm > worst) ? ppm : worst;
+  }
+  return worst;
+}
+
+/**
+ * @brief Worst-case load of everything this node sends periodically.
+ */
+constexpr uint64_t node_ppm() {
+  uint64_t ppm = schedule_ppm();
+
+#if defined(CONFIG_APP_SECOC)
+  ppm += frame_load_ppm(false, SECOC_SYNC_DLC, CONFIG_APP_SECOC_SYNC_MS,
+                        BITRATE);
+#endif
+#if defined(CONFIG_APP_CAN_NM)
+  ppm += frame_load_ppm(false, Config::CAN_NM_DLC,
+                        CONFIG_APP_CAN_NM_MSG_CYCLE_MS, BITRATE);
+#endif
+#if defined(CONFIG_APP_LIVENESS)
+  ppm += frame_load_ppm(false, Config::CAN_HEARTBEAT_DLC,
+                        CONFIG_APP_LIVENESS_HEARTBEAT_MS, BITRATE);
+#endif
+#if defined(CONFIG_APP_SIGNAL_AGG)
+  ppm += SignalAgg::stages_load_ppm(Config::AGG_SIGNALS, Config::AGG_STAGES,
+                                    BITRATE);
+#endif
+#if defined(CONFIG_APP_LOG_BACKEND_CAN)
+  ppm += rate_load_ppm(false, CAN_MAX_DLEN, CONFIG_APP_LOG_CAN_RATE, BITRATE);
+#endif
+  return ppm;
+}
+}  // namespace BusBudget
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Car profile hot-swap: request from the shell or a diagnostic command,
+ * applied by the TX thread at a cycle boundary
+ */
+
+#include "car_profiles.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+#include <array>
+#include <cstring>
+
+#include "app_config.hpp"
+#include "core/filter_swap.hpp"
+#include "rx_handler.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+ProfileSwitch profile_switch(
+    Config::CAR_PROFILES[Config::DEFAULT_CAR_PROFILE]);
+K_SEM_DEFINE(switch_sem, 0, 1);
+
+/* Filter IDs of the active plan, slot for slot; TX thread only after init */
+std::array<int, CarProfile::FILTERS> filter_ids;
+
+uint64_t now_ns() { return k_ticks_to_ns_floor64(k_uptime_ticks()); }
+}  // namespace
+
+void car_profiles_init(const struct device* dev) {
+  const ProfileTables& t = profile_switch.active();
+
+  for (size_t i = 0; i < t.filters.size(); i++) {
+    filter_ids[i] = can_add_rx_filter(dev, &can_rx_callback, NULL,
+                                      &t.filters[i]);
+  }
+}
+
+int car_profile_request(size_t index) {
+  if (index >= Config::CAR_PROFILES.size()) {
+    return -EINVAL;
+  }
+  if (!profile_switch.request(Config::CAR_PROFILES[index], now_ns())) {
+    return -EBUSY;
+  }
+
+  k_sem_give(&switch_sem);
+  return 0;
+}
+
+int car_profile_find(const char* name) {
+  for (size_t i = 0; i < Config::CAR_PROFILES.size(); i++) {
+    if (strcmp(Config::CAR_PROFILES[i].name, name) == 0) {
+      return static_cast<int>(i);
+    }
+  }
+  return -ENOENT;
+}
+
+const CarProfile& car_profile_current() { return profile_switch.profile(); }
+
+const CarProfile* car_profile_previous() {
+  return profile_switch.previous_profile();
+}
+
+const ProfileTables& car_profile_tables() { return profile_switch.active(); }
+
+const ProfileTables* car_profile_apply(const struct device* dev) {
+  /* Once flipped, the old side may be rebuilt by the next request */
+  const std::array<struct can_filter, CarProfile::FILTERS> old =
+      profile_switch.active().filters;
+  const ProfileTables* next = profile_switch.apply(now_ns());
+
+  if (next == nullptr) {
+    return nullptr;
+  }
+
+  /* Make before break: shared filters stay, new ones are added before
+   * the rest of the old plan is removed */
+  std::array<int, CarProfile::FILTERS> ids;
+
+  swap_filters(
+      old.data(), filter_ids.data(), old.size(), next->filters.data(),
+      ids.data(), ids.size(),
+      [&](const struct can_filter& f) {
+        int id = can_add_rx_filter(dev, &can_rx_callback, NULL, &f);
+
+        if (id < 0) {
+          LOG_ERR("Profile %s: RX filter 0x%03x not added (%d)",
+                  next->profile->name, f.id, id);
+        }
+        return id;
+      },
+      [&](int id) { can_remove_rx_filter(dev, id); });
+  filter_ids = ids;
+
+  ProfileSwitchStats s = profile_switch.stats();
+  LOG_INF("Car profile -> %s (switch latency %u us)", next->profile->name,
+          static_cast<uint32_t>(s.last_latency_ns / 1000));
+  return next;
+}
+
+void car_profile_wait(int64_t until_ms) {
+  k_sem_take(&switch_sem, K_TIMEOUT_ABS_MS(until_ms));
+}
+
+ProfileSwitchStats car_profile_stats() { return profile_switch.stats(); }
+
+#if defined(CONFIG_SHELL)
+namespace {
+int cmd_list(const struct shell* sh, size_t argc, char** argv) {
+  const CarProfile* current = &car_profile_current();
+
+  for (const CarProfile& p : Config::CAR_PROFILES) {
+    shell_print(sh, "%c %-8s gear 0x%03x every %u ms, %u gears",
+                (&p == current) ? '*' : ' ', p.name, p.gear_layout.id,
+                p.schedule[0].period_ms, p.forward_gears);
+  }
+  return 0;
+}
+
+int cmd_set(const struct shell* sh, size_t argc, char** argv) {
+  int index = car_profile_find(argv[1]);
+
+  if (index < 0) {
+    shell_error(sh, "Unknown profile %s", argv[1]);
+    return index;
+  }
+
+  int ret = car_profile_request(index);
+  if (ret != 0) {
+    shell_error(sh, "Switch not accepted (%d)", ret);
+  }
+  return ret;
+}
+
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  ProfileSwitchStats s = car_profile_stats();
+
+  shell_print(sh, "profile %s, %u switches, %u rejected",
+              car_profile_current().name, s.switches, s.rejected);
+  shell_print(sh, "switch latency last %u us, max %u us",
+              static_cast<uint32_t>(s.last_latency_ns / 1000),
+              static_cast<uint32_t>(s.max_latency_ns / 1000));
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    profile_cmds,
+    SHELL_CMD(list, NULL, "Available car profiles", cmd_list),
+    SHELL_CMD_ARG(set, NULL, "Switch to a car profile: set <name>", cmd_set,
+                  2, 0),
+    SHELL_CMD(status, NULL, "Current profile and switch latency", cmd_status),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(profile, &profile_cmds, "Car profiles", NULL);
+#endif /* CONFIG_SHELL */
@@ -0,0 +1,63 @@
+/*
+ * src/car_profiles.hpp
+ * Runtime switching between the car profiles in Config::CAR_PROFILES
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstddef>  // size_t
+#include <cstdint>  // int64_t
+
+#include "core/car_profile.hpp"
+
+/**
+ * @brief Install the default profile's RX filter plan.
+ */
+void car_profiles_init(const struct device* dev);
+
+/**
+ * @brief Ask the TX thread to switch to Config::CAR_PROFILES[index].
+ * * Any thread. The switch takes effect at the TX thread's next cycle
+ * boundary.
+ * * @return 0, -EINVAL for an unknown profile, -EBUSY while another switch
+ * is pending
+ */
+int car_profile_request(size_t index);
+
+/**
+ * @brief Index into Config::CAR_PROFILES of the profile name, or -ENOENT.
+ */
+int car_profile_find(const char* name);
+
+/**
+ * @brief The profile currently in effect; any thread.
+ */
+const CarProfile& car_profile_current();
+
+/**
+ * @brief The profile before the last switch, or nullptr; any thread.
+ */
+const CarProfile* car_profile_previous();
+
+/**
+ * @brief TX thread only: the schedule and filter plan in use.
+ */
+const ProfileTables& car_profile_tables();
+
+/**
+ * @brief TX thread only: apply a pending switch between two polls.
+ * * New RX filters are added before the old ones are removed, so no frame
+ * addressed to either profile is lost around the switch.
+ * * @return The new tables, or nullptr if no switch was pending
+ */
+const ProfileTables* car_profile_apply(const struct device* dev);
+
+/**
+ * @brief TX thread only: sleep until until_ms or until a switch is
+ * requested, whichever comes first.
+ */
+void car_profile_wait(int64_t until_ms);
+
+ProfileSwitchStats car_profile_stats();
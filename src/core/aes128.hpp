@@ -0,0 +1,169 @@
+/*
+ * src/core/aes128.hpp
+ * AES-128 block encryption (FIPS-197) with a compile-time T-table
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t
+
+namespace aes_detail {
+constexpr uint8_t xtime(uint8_t x) {
+  return static_cast<uint8_t>((x << 1) ^ ((x & 0x80U) ? 0x1BU : 0U));
+}
+
+constexpr uint8_t rotl8(uint8_t x, int n) {
+  return static_cast<uint8_t>((x << n) | (x >> (8 - n)));
+}
+
+/* S-box from the multiplicative inverse, walking GF(2^8) with generator 3 */
+constexpr std::array<uint8_t, 256> make_sbox() {
+  std::array<uint8_t, 256> sbox{};
+  uint8_t p = 1;
+  uint8_t q = 1;
+
+  do {
+    p = static_cast<uint8_t>(p ^ xtime(p));  // p * 3
+    q = static_cast<uint8_t>(q ^ (q << 1));  // q / 3
+    q = static_cast<uint8_t>(q ^ (q << 2));
+    q = static_cast<uint8_t>(q ^ (q << 4));
+    if (q & 0x80U) {
+      q ^= 0x09U;
+    }
+    sbox[p] = static_cast<uint8_t>(q ^ rotl8(q, 1) ^ rotl8(q, 2) ^
+                                   rotl8(q, 3) ^ rotl8(q, 4) ^ 0x63U);
+  } while (p != 1);
+  sbox[0] = 0x63;
+  return sbox;
+}
+
+inline constexpr std::array<uint8_t, 256> sbox = make_sbox();
+
+/* SubBytes + MixColumns of one column byte; the other three rows are
+ * rotations of it, so one 1 KiB table serves all four */
+constexpr std::array<uint32_t, 256> make_te() {
+  std::array<uint32_t, 256> te{};
+
+  for (size_t i = 0; i < 256; i++) {
+    uint32_t s = sbox[i];
+    uint32_t s2 = xtime(sbox[i]);
+
+    te[i] = (s2 << 24) | (s << 16) | (s << 8) | (s2 ^ s);
+  }
+  return te;
+}
+
+inline constexpr std::array<uint32_t, 256> te = make_te();
+
+constexpr uint32_t ror(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+constexpr uint32_t load_be32(const uint8_t* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) |
+         (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+constexpr void store_be32(uint32_t v, uint8_t* p) {
+  p[0] = static_cast<uint8_t>(v >> 24);
+  p[1] = static_cast<uint8_t>(v >> 16);
+  p[2] = static_cast<uint8_t>(v >> 8);
+  p[3] = static_cast<uint8_t>(v);
+}
+
+constexpr uint32_t sub_word(uint32_t w) {
+  return (static_cast<uint32_t>(sbox[w >> 24]) << 24) |
+         (static_cast<uint32_t>(sbox[(w >> 16) & 0xFFU]) << 16) |
+         (static_cast<uint32_t>(sbox[(w >> 8) & 0xFFU]) << 8) |
+         sbox[w & 0xFFU];
+}
+}  // namespace aes_detail
+
+/**
+ * @brief Aes128 Class
+ * * Encrypt-only AES-128, which is all CMAC needs. The key schedule is
+ * expanded once when the key is set and kept (176 bytes). Everything is
+ * constexpr, so a key known at build time can be expanded by the compiler.
+ * Table lookups depend on the data: fine for MACs over bus traffic, not
+ * for a setting where an attacker can time the node's own encryptions.
+ */
+class Aes128 {
+ public:
+  static constexpr size_t BLOCK_SIZE = 16;
+  static constexpr size_t KEY_SIZE = 16;
+
+ private:
+  static constexpr size_t ROUNDS = 10;
+
+  std::array<uint32_t, 4 * (ROUNDS + 1)> rk{};
+
+ public:
+  constexpr Aes128() = default;
+  constexpr explicit Aes128(const uint8_t* key) { set_key(key); }
+
+  constexpr void set_key(const uint8_t* key) {
+    using namespace aes_detail;
+    uint8_t rcon = 0x01;
+
+    for (size_t i = 0; i < 4; i++) {
+      rk[i] = load_be32(key + 4 * i);
+    }
+    for (size_t i = 4; i < rk.size(); i++) {
+      uint32_t t = rk[i - 1];
+
+      if (i % 4 == 0) {
+        t = sub_word((t << 8) | (t >> 24)) ^
+            (static_cast<uint32_t>(rcon) << 24);
+        rcon = xtime(rcon);
+      }
+      rk[i] = rk[i - 4] ^ t;
+    }
+  }
+
+  /**
+   * @brief Encrypt one 16-byte block; in and out may alias.
+   */
+  constexpr void encrypt(const uint8_t* in, uint8_t* out) const {
+    using namespace aes_detail;
+    uint32_t s0 = load_be32(in) ^ rk[0];
+    uint32_t s1 = load_be32(in + 4) ^ rk[1];
+    uint32_t s2 = load_be32(in + 8) ^ rk[2];
+    uint32_t s3 = load_be32(in + 12) ^ rk[3];
+
+    for (size_t r = 1; r < ROUNDS; r++) {
+      const uint32_t* k = &rk[4 * r];
+      uint32_t t0 = te[s0 >> 24] ^ ror(te[(s1 >> 16) & 0xFFU], 8) ^
+                    ror(te[(s2 >> 8) & 0xFFU], 16) ^
+                    ror(te[s3 & 0xFFU], 24) ^ k[0];
+      uint32_t t1 = te[s1 >> 24] ^ ror(te[(s2 >> 16) & 0xFFU], 8) ^
+                    ror(te[(s3 >> 8) & 0xFFU], 16) ^
+                    ror(te[s0 & 0xFFU], 24) ^ k[1];
+      uint32_t t2 = te[s2 >> 24] ^ ror(te[(s3 >> 16) & 0xFFU], 8) ^
+                    ror(te[(s0 >> 8) & 0xFFU], 16) ^
+                    ror(te[s1 & 0xFFU], 24) ^ k[2];
+      uint32_t t3 = te[s3 >> 24] ^ ror(te[(s0 >> 16) & 0xFFU], 8) ^
+                    ror(te[(s1 >> 8) & 0xFFU], 16) ^
+                    ror(te[s2 & 0xFFU], 24) ^ k[3];
+
+      s0 = t0;
+      s1 = t1;
+      s2 = t2;
+      s3 = t3;
+    }
+
+    /* Last round: SubBytes and ShiftRows only */
+    const uint32_t* k = &rk[4 * ROUNDS];
+    auto last = [](uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+      return (static_cast<uint32_t>(sbox[a >> 24]) << 24) |
+             (static_cast<uint32_t>(sbox[(b >> 16) & 0xFFU]) << 16) |
+             (static_cast<uint32_t>(sbox[(c >> 8) & 0xFFU]) << 8) |
+             sbox[d & 0xFFU];
+    };
+
+    store_be32(last(s0, s1, s2, s3) ^ k[0], out);
+    store_be32(last(s1, s2, s3, s0) ^ k[1], out + 4);
+    store_be32(last(s2, s3, s0, s1) ^ k[2], out + 8);
+    store_be32(last(s3, s0, s1, s2) ^ k[3], out + 12);
+  }
+};
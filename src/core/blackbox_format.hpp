@@ -0,0 +1,75 @@
+/*
+ * src/core/blackbox_format.hpp
+ * On-flash layout of black-box snapshots
+ *
+ * The flash area is split into equal slots. Each trigger writes one
+ * snapshot into the slot after the most recent one, so erases rotate
+ * evenly over the whole area. A slot holds a 32-byte header followed by
+ * the FrameCompress payload, newest frame first. The header is written
+ * last and acts as the commit marker: a slot interrupted mid-write simply
+ * fails validation.
+ */
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
+
+#include "crc32.hpp"
+
+enum class BlackboxTrigger : uint32_t {
+  Manual = 0,
+  BusOff = 1,
+  DeadlineMissBurst = 2,
+  DiagnosticRequest = 3,
+};
+
+struct BlackboxHeader {
+  uint32_t magic;
+  uint32_t sequence;     // Increments per snapshot; highest is the latest
+  uint32_t trigger;      // BlackboxTrigger
+  uint32_t entry_count;
+  uint32_t payload_len;
+  uint32_t payload_crc;  // CRC-32 of the compressed payload
+  uint32_t trigger_timestamp_us;
+  uint32_t header_crc;   // CRC-32 of the fields above
+
+  static constexpr uint32_t MAGIC = 0x31584242;  // "BBX1"
+
+  uint32_t compute_crc() const {
+    return crc32(reinterpret_cast<const uint8_t*>(this),
+                 offsetof(BlackboxHeader, header_crc));
+  }
+
+  bool is_valid(size_t slot_size) const {
+    return magic == MAGIC && header_crc == compute_crc() &&
+           payload_len <= slot_size - sizeof(BlackboxHeader);
+  }
+};
+static_assert(sizeof(BlackboxHeader) == 32);
+
+/**
+ * @brief Pick the slot for the next snapshot from the slot headers.
+ * * header_at(i) returns a pointer to slot i's header, or nullptr if it
+ * could not be read. Returns the slot after the one with the highest valid
+ * sequence (slot 0 on a blank area) and that sequence via latest_seq.
+ */
+template <typename F>
+size_t blackbox_next_slot(size_t slot_count, size_t slot_size, F&& header_at,
+                          uint32_t& latest_seq, bool& found) {
+  size_t latest = slot_count - 1;
+
+  found = false;
+  latest_seq = 0;
+  for (size_t i = 0; i < slot_count; i++) {
+    const BlackboxHeader* hdr = header_at(i);
+
+    if (hdr != nullptr && hdr->is_valid(slot_size) &&
+        (!found || hdr->sequence > latest_seq)) {
+      latest = i;
+      latest_seq = hdr->sequence;
+      found = true;
+    }
+  }
+  return (latest + 1) % slot_count;
+}
@@ -0,0 +1,65 @@
+/*
+ * src/core/bus_budget.hpp
+ * Worst-case bus load of periodic frames, for compile-time budget checks
+ *
+ * Loads are in parts per million of the bus and rounded up, with every
+ * frame at its stuffed maximum (CanTiming::max_frame_bits), so the sum
+ * over a node's messages never understates what it can put on the bus.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t, uint64_t
+
+#include "can_timing.hpp"
+#include "message_spec.hpp"
+
+namespace BusBudget {
+constexpr uint64_t PPM = 1000000;
+
+/**
+ * @brief Load of one frame sent every period_ms at bitrate, in ppm.
+ */
+constexpr uint64_t frame_load_ppm(bool extended, uint8_t dlc,
+                                  uint32_t period_ms, uint32_t bitrate) {
+  uint64_t bits = CanTiming::max_frame_bits(extended, dlc);
+  uint64_t capacity = uint64_t{bitrate} * period_ms;  // Bits per 1000 periods
+
+  return (bits * PPM * 1000 + capacity - 1) / capacity;
+}
+
+/**
+ * @brief Load of up to frames_per_s frames a second, in ppm.
+ */
+constexpr uint64_t rate_load_ppm(bool extended, uint8_t dlc,
+                                 uint32_t frames_per_s, uint32_t bitrate) {
+  uint64_t bits = CanTiming::max_frame_bits(extended, dlc);
+
+  return (bits * frames_per_s * PPM + bitrate - 1) / bitrate;
+}
+
+/**
+ * @brief Load of a message table, in ppm.
+ * * dlc(spec) gives the length actually sent, e.g. with an authenticator
+ * appended to the payload.
+ */
+template <size_t N, typename Dlc>
+constexpr uint64_t table_load_ppm(const std::array<MessageSpec, N>& table,
+                                  uint32_t bitrate, Dlc&& dlc) {
+  uint64_t ppm = 0;
+
+  for (const MessageSpec& spec : table) {
+    ppm += frame_load_ppm(false, dlc(spec), spec.period_ms, bitrate);
+  }
+  return ppm;
+}
+
+template <size_t N>
+constexpr uint64_t table_load_ppm(const std::array<MessageSpec, N>& table,
+                                  uint32_t bitrate) {
+  return table_load_ppm(table, bitrate,
+                        [](const MessageSpec& spec) { return spec.dlc; });
+}
+}  // namespace BusBudget
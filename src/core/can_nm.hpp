@@ -0,0 +1,272 @@
+/*
+ * src/core/can_nm.hpp
+ * Network management modeled on AUTOSAR CanNm: coordinated bus sleep and
+ * wake-up of all nodes on the bus
+ *
+ * NM PDU (CAN_NM_BASE_ID + node, CAN_NM_DLC bytes):
+ *   data[0] source node | data[1] control bit vector (CBV)
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstdint>  // uint8_t, uint32_t, uint64_t
+
+#include "app_config.hpp"
+
+enum class NmState : uint8_t {
+  BusSleep,
+  PrepareBusSleep,
+  RepeatMessage,    // Network mode, announcing ourselves after a wake-up
+  NormalOperation,  // Network mode, bus requested locally
+  ReadySleep,       // Network mode, released; waiting for the others
+};
+
+/* Control bit vector flags */
+namespace NmCbv {
+constexpr uint8_t REPEAT_MESSAGE_REQUEST = 0x01;
+constexpr uint8_t ACTIVE_WAKEUP = 0x10;  // Sender woke the network
+}  // namespace NmCbv
+
+struct NmTiming {
+  uint32_t msg_cycle_ms;       // NM PDU period while the bus is requested
+  uint32_t timeout_ms;         // No PDU for this long: nobody needs the bus
+  uint32_t repeat_message_ms;  // Time spent in RepeatMessage after waking
+  uint32_t wait_bus_sleep_ms;  // PrepareBusSleep -> BusSleep
+};
+
+struct NmStats {
+  uint32_t pdus_sent;
+  uint32_t pdus_received;
+  uint32_t sleeps;        // Entries into BusSleep
+  uint32_t wakeups;       // Entries into network mode from sleep
+  uint64_t state_since_us;  // Time of the last state change
+};
+
+inline void encode_nm_frame(uint8_t node, uint8_t cbv,
+                            struct can_frame& frame) {
+  frame = {};
+  frame.id = Config::CAN_NM_BASE_ID + node;
+  frame.dlc = Config::CAN_NM_DLC;
+  frame.data[0] = node;
+  frame.data[1] = cbv;
+}
+
+/**
+ * @brief Decode an NM PDU.
+ * * @return false if the frame is not one
+ */
+inline bool decode_nm_frame(const struct can_frame& frame, uint8_t& node,
+                            uint8_t& cbv) {
+  if ((frame.flags & (CAN_FRAME_IDE | CAN_FRAME_RTR)) != 0 ||
+      (frame.id & Config::CAN_NM_ID_MASK) != Config::CAN_NM_BASE_ID ||
+      frame.dlc < Config::CAN_NM_DLC) {
+    return false;
+  }
+
+  node = frame.data[0];
+  cbv = frame.data[1];
+  return true;
+}
+
+/**
+ * @brief CanNm Class
+ * * The CanNm state machine of one node, driven by time (µs): feed it
+ * local requests and releases and the NM PDUs of other nodes, and call
+ * poll() at next_event_us() to run the timers and learn when to send.
+ *
+ * While any node requests the bus it sends NM PDUs, which keep every
+ * node's NM timeout from expiring. Once all have released the bus, the
+ * PDUs stop; since every node restarted its timeout on the same last PDU,
+ * all of them enter PrepareBusSleep and then BusSleep within a frame time
+ * of each other. An NM PDU or a local request wakes a node into
+ * RepeatMessage, which announces it to the others at once.
+ * Not thread-safe; one owner calls everything.
+ */
+class CanNm {
+ private:
+  NmTiming timing{};
+  uint8_t node = 0;
+  NmState st = NmState::BusSleep;
+  bool requested = false;
+  uint8_t wake_bits = 0;  // ACTIVE_WAKEUP while announcing our own wake-up
+  uint64_t timeout_at = 0;
+  uint64_t repeat_until = 0;
+  uint64_t sleep_at = 0;
+  uint64_t next_tx_at = 0;
+  NmStats counters{};
+
+  static constexpr uint64_t us(uint32_t ms) {
+    return static_cast<uint64_t>(ms) * 1000;
+  }
+
+  void enter(NmState next, uint64_t now_us) {
+    if (!in_network_mode(st) && in_network_mode(next)) {
+      counters.wakeups++;
+      timeout_at = now_us + us(timing.timeout_ms);
+    }
+
+    switch (next) {
+      case NmState::RepeatMessage:
+        repeat_until = now_us + us(timing.repeat_message_ms);
+        next_tx_at = now_us;
+        break;
+      case NmState::NormalOperation:
+        /* Send at once out of ReadySleep; after RepeatMessage the PDU
+         * cycle just continues */
+        if (!sending()) {
+          next_tx_at = now_us;
+        }
+        break;
+      case NmState::PrepareBusSleep:
+        sleep_at = now_us + us(timing.wait_bus_sleep_ms);
+        break;
+      case NmState::BusSleep:
+        counters.sleeps++;
+        break;
+      case NmState::ReadySleep:
+        break;
+    }
+
+    st = next;
+    counters.state_since_us = now_us;
+  }
+
+  bool sending() const {
+    return st == NmState::RepeatMessage || st == NmState::NormalOperation;
+  }
+
+ public:
+  static constexpr bool in_network_mode(NmState s) {
+    return s == NmState::RepeatMessage || s == NmState::NormalOperation ||
+           s == NmState::ReadySleep;
+  }
+
+  constexpr CanNm() = default;
+  constexpr CanNm(uint8_t node_id, NmTiming t) : timing(t), node(node_id) {}
+
+  /**
+   * @brief This node needs the bus; wakes the network if it is asleep.
+   */
+  void network_request(uint64_t now_us) {
+    requested = true;
+    if (!in_network_mode(st)) {
+      wake_bits = NmCbv::ACTIVE_WAKEUP;
+      enter(NmState::RepeatMessage, now_us);
+    } else if (st == NmState::ReadySleep) {
+      enter(NmState::NormalOperation, now_us);
+    }
+  }
+
+  /**
+   * @brief This node no longer needs the bus.
+   */
+  void network_release(uint64_t now_us) {
+    requested = false;
+    if (st == NmState::NormalOperation) {
+      enter(NmState::ReadySleep, now_us);
+    }
+  }
+
+  /**
+   * @brief An NM PDU from another node.
+   */
+  void on_rx(uint8_t cbv, uint64_t now_us) {
+    counters.pdus_received++;
+
+    if (!in_network_mode(st)) {
+      wake_bits = 0;
+      enter(NmState::RepeatMessage, now_us);  // Remote wake-up
+      return;
+    }
+
+    timeout_at = now_us + us(timing.timeout_ms);
+    if ((cbv & NmCbv::REPEAT_MESSAGE_REQUEST) != 0 &&
+        st != NmState::RepeatMessage) {
+      enter(NmState::RepeatMessage, now_us);
+    }
+  }
+
+  /**
+   * @brief Run the timers due at now_us.
+   * * @return true if an NM PDU with control bits cbv must be sent now
+   */
+  bool poll(uint64_t now_us, uint8_t& cbv) {
+    if (st == NmState::PrepareBusSleep && now_us >= sleep_at) {
+      enter(NmState::BusSleep, now_us);
+    }
+    if (!in_network_mode(st)) {
+      return false;
+    }
+
+    if (st == NmState::RepeatMessage && now_us >= repeat_until) {
+      wake_bits = 0;
+      enter(requested ? NmState::NormalOperation : NmState::ReadySleep,
+            now_us);
+    }
+    if (now_us >= timeout_at) {
+      if (st == NmState::ReadySleep) {
+        enter(NmState::PrepareBusSleep, now_us);
+        return false;
+      }
+      timeout_at = now_us + us(timing.timeout_ms);
+    }
+
+    if (!sending() || now_us < next_tx_at) {
+      return false;
+    }
+
+    /* Drift-free PDU cycle; our own PDU counts as bus activity too */
+    uint64_t cycle = us(timing.msg_cycle_ms);
+    next_tx_at += ((now_us - next_tx_at) / cycle + 1) * cycle;
+    timeout_at = now_us + us(timing.timeout_ms);
+    cbv = wake_bits;
+    counters.pdus_sent++;
+    return true;
+  }
+
+  /**
+   * @brief When poll() next has something to do (UINT64_MAX: only an
+   * event can wake this node).
+   */
+  uint64_t next_event_us() const {
+    switch (st) {
+      case NmState::BusSleep:
+        return UINT64_MAX;
+      case NmState::PrepareBusSleep:
+        return sleep_at;
+      case NmState::RepeatMessage: {
+        uint64_t t = (repeat_until < timeout_at) ? repeat_until : timeout_at;
+        return (next_tx_at < t) ? next_tx_at : t;
+      }
+      case NmState::NormalOperation:
+        return (next_tx_at < timeout_at) ? next_tx_at : timeout_at;
+      case NmState::ReadySleep:
+        return timeout_at;
+    }
+    return UINT64_MAX;
+  }
+
+  NmState state() const { return st; }
+  bool network_mode() const { return in_network_mode(st); }
+  bool network_requested() const { return requested; }
+  uint8_t node_id() const { return node; }
+  const NmStats& stats() const { return counters; }
+};
+
+constexpr const char* nm_state_name(NmState s) {
+  switch (s) {
+    case NmState::BusSleep:
+      return "bus-sleep";
+    case NmState::PrepareBusSleep:
+      return "prepare-bus-sleep";
+    case NmState::RepeatMessage:
+      return "repeat-message";
+    case NmState::NormalOperation:
+      return "normal";
+    case NmState::ReadySleep:
+      return "ready-sleep";
+  }
+  return "?";
+}
@@ -0,0 +1,208 @@
+/*
+ * src/core/can_rta.hpp
+ * Worst-case response time analysis of a CAN message set
+ *
+ * The analysis of Davis, Burns, Bril and Lukkien, "Controller Area Network
+ * (CAN) schedulability analysis: Refuted, revisited and revised" (2007).
+ * A message waits for at most one lower priority frame that already won
+ * arbitration, then for every higher priority frame queued before it wins.
+ * Frames are not preempted, so an instance can also be pushed back by its
+ * own earlier instances; every instance in the busy period is checked.
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t, UINT64_MAX
+
+#include "can_timing.hpp"
+
+struct RtaMessage {
+  uint32_t id;
+  bool extended;
+  uint8_t dlc;
+  uint64_t period_ns;
+  uint64_t deadline_ns;  // Relative to the release
+  uint64_t jitter_ns;    // Release to queued in the controller, worst case
+};
+
+struct RtaResult {
+  uint64_t frame_ns;     // C: longest transmission, stuff bits included
+  uint64_t blocking_ns;  // B: longest lower priority frame
+  uint64_t response_ns;  // R, the first value past the deadline, or UNBOUNDED
+  uint32_t instances;    // Instances in the longest busy period
+  bool schedulable;
+};
+
+namespace CanRta {
+/* A busy period longer than this is treated as unbounded (load >= 100%) */
+constexpr uint64_t HORIZON_NS = 60ULL * 1000000000ULL;
+constexpr uint64_t UNBOUNDED = UINT64_MAX;
+
+constexpr uint64_t ceil_div(uint64_t a, uint64_t b) { return (a + b - 1) / b; }
+
+constexpr uint64_t frame_ns(const RtaMessage& m, uint32_t bitrate) {
+  return can_bits_to_ns(CanTiming::max_frame_bits(m.extended, m.dlc),
+                        bitrate);
+}
+
+constexpr uint64_t priority_key(const RtaMessage& m) {
+  struct can_frame f = {};
+
+  f.id = m.id;
+  f.flags = m.extended ? CAN_FRAME_IDE : 0;
+  return can_arbitration_key(f);
+}
+
+/**
+ * @brief Worst-case response time of msgs[m], release to end of frame.
+ * * higher(k) tells whether msgs[k] wins arbitration against msgs[m];
+ * all other messages can only block it.
+ */
+template <typename Higher>
+constexpr RtaResult response(const RtaMessage* msgs, size_t n, size_t m,
+                             uint32_t bitrate, Higher&& higher) {
+  const RtaMessage& self = msgs[m];
+  uint64_t bit = can_bits_to_ns(1, bitrate);
+  RtaResult r = {.frame_ns = frame_ns(self, bitrate),
+                 .blocking_ns = 0,
+                 .response_ns = 0,
+                 .instances = 0,
+                 .schedulable = false};
+
+  for (size_t k = 0; k < n; k++) {
+    if (k != m && !higher(k) && frame_ns(msgs[k], bitrate) > r.blocking_ns) {
+      r.blocking_ns = frame_ns(msgs[k], bitrate);
+    }
+  }
+
+  /* Longest time the bus stays busy with this priority or higher */
+  auto interference = [&](uint64_t window, uint64_t extra) {
+    uint64_t sum = 0;
+
+    for (size_t k = 0; k < n; k++) {
+      if (k != m && higher(k)) {
+        sum += ceil_div(window + msgs[k].jitter_ns + extra,
+                        msgs[k].period_ns) *
+               frame_ns(msgs[k], bitrate);
+      }
+    }
+    return sum;
+  };
+
+  uint64_t busy = r.blocking_ns + r.frame_ns;
+  for (;;) {
+    uint64_t next = r.blocking_ns + interference(busy, 0) +
+                    ceil_div(busy + self.jitter_ns, self.period_ns) *
+                        r.frame_ns;
+    if (next == busy) {
+      break;
+    }
+    if (next > HORIZON_NS) {
+      r.response_ns = UNBOUNDED;
+      return r;
+    }
+    busy = next;
+  }
+  r.instances =
+      static_cast<uint32_t>(ceil_div(busy + self.jitter_ns, self.period_ns));
+
+  for (uint32_t q = 0; q < r.instances; q++) {
+    uint64_t base = r.blocking_ns + q * r.frame_ns;
+    uint64_t w = base;
+    uint64_t release = q * self.period_ns;
+
+    for (;;) {
+      uint64_t next = base + interference(w, bit);
+
+      /* w only grows; stop once the instance is already late */
+      if (self.jitter_ns + next + r.frame_ns > release + self.deadline_ns) {
+        r.response_ns = self.jitter_ns + next + r.frame_ns - release;
+        return r;
+      }
+      if (next == w) {
+        break;
+      }
+      w = next;
+    }
+
+    uint64_t response = self.jitter_ns + w + r.frame_ns - release;
+    r.response_ns = (response > r.response_ns) ? response : r.response_ns;
+  }
+  r.schedulable = true;
+  return r;
+}
+
+/**
+ * @brief Response time of msgs[m] with priorities given by the IDs.
+ * * Messages with the same ID count as higher priority, which is the
+ * pessimistic choice.
+ */
+constexpr RtaResult response_by_id(const RtaMessage* msgs, size_t n, size_t m,
+                                   uint32_t bitrate) {
+  uint64_t key = priority_key(msgs[m]);
+
+  return response(msgs, n, m, bitrate,
+                  [&](size_t k) { return priority_key(msgs[k]) <= key; });
+}
+
+/**
+ * @brief Audsley's optimal priority assignment.
+ * * Fills order[0..n) with message indices, highest priority first, so
+ * that every message meets its deadline. Levels are filled from the
+ * lowest up, each with the message of lowest current priority that is
+ * schedulable there, so a table that already works keeps its order.
+ * @return false if no priority order meets every deadline
+ */
+template <size_t N>
+constexpr bool assign_priorities(const RtaMessage* msgs, size_t n,
+                                 uint32_t bitrate,
+                                 std::array<size_t, N>& order) {
+  std::array<bool, N> pending{};
+
+  if (n > N) {
+    return false;
+  }
+
+  /* Current priority order (insertion sort by arbitration key) */
+  for (size_t i = 0; i < n; i++) {
+    size_t j = i;
+
+    for (; j > 0 && priority_key(msgs[order[j - 1]]) > priority_key(msgs[i]);
+         j--) {
+      order[j] = order[j - 1];
+    }
+    order[j] = i;
+    pending[i] = true;
+  }
+
+  for (size_t level = n; level-- > 0;) {
+    size_t j = level + 1;
+
+    while (j-- > 0) {
+      size_t c = order[j];
+      RtaResult r = response(msgs, n, c, bitrate,
+                             [&](size_t k) { return pending[k] && k != c; });
+
+      if (r.schedulable) {
+        break;
+      }
+    }
+    if (j > level) {
+      return false;  // Nothing left meets its deadline at this level
+    }
+
+    /* Move the pick down to this level, keeping the rest in order */
+    size_t pick = order[j];
+    for (; j < level; j++) {
+      order[j] = order[j + 1];
+    }
+    order[level] = pick;
+    pending[pick] = false;
+  }
+  return true;
+}
+}  // namespace CanRta
@@ -0,0 +1,153 @@
+/*
+ * src/core/can_timing.hpp
+ * Classic CAN frame length on the wire (with bit stuffing) and arbitration
+ *
+ * A data frame is SOF, arbitration field, control field, data and CRC-15,
+ * all subject to bit stuffing (a complementary bit after five equal bits),
+ * followed by 13 fixed-form bits: CRC delimiter, ACK slot and delimiter,
+ * 7 EOF bits and the 3-bit intermission.
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint16_t, uint32_t, uint64_t
+
+namespace CanTiming {
+/* CRC delimiter + ACK slot + ACK delimiter + EOF + intermission */
+constexpr uint32_t TRAILER_BITS = 13;
+
+/* Unstuffed bits from SOF to the end of the CRC */
+constexpr uint32_t stuffed_region_bits(bool extended, uint8_t dlc) {
+  uint32_t header = extended ? 39 : 19;  // SOF .. DLC
+  return header + 8U * dlc + 15;
+}
+
+/**
+ * @brief Upper bound on the frame length including stuff bits.
+ * * For worst-case response time analysis, e.g. 135 bits for a standard
+ * 8-byte frame (intermission included).
+ */
+constexpr uint32_t max_frame_bits(bool extended, uint8_t dlc) {
+  uint32_t region = stuffed_region_bits(extended, dlc);
+  return region + TRAILER_BITS + (region - 1) / 4;
+}
+
+/**
+ * @brief Frame length without any stuff bits (the best case).
+ */
+constexpr uint32_t min_frame_bits(bool extended, uint8_t dlc) {
+  return stuffed_region_bits(extended, dlc) + TRAILER_BITS;
+}
+
+/* Bit sequence of the stuffed region, MSB first, built up to 128 bits */
+class BitStream {
+ private:
+  uint8_t bits[128] = {};
+  size_t len = 0;
+
+ public:
+  constexpr void put(uint32_t value, int width) {
+    for (int i = width - 1; i >= 0; i--) {
+      bits[len++] = static_cast<uint8_t>((value >> i) & 1U);
+    }
+  }
+
+  constexpr size_t size() const { return len; }
+  constexpr uint8_t operator[](size_t i) const { return bits[i]; }
+};
+
+constexpr uint16_t crc15(const BitStream& s) {
+  uint16_t crc = 0;
+
+  for (size_t i = 0; i < s.size(); i++) {
+    bool next = s[i] ^ ((crc >> 14) & 1U);
+    crc = static_cast<uint16_t>((crc << 1) & 0x7FFF);
+    if (next) {
+      crc ^= 0x4599;
+    }
+  }
+  return crc;
+}
+}  // namespace CanTiming
+
+/**
+ * @brief Exact number of bits a classic CAN frame occupies on the bus,
+ * stuff bits and intermission included.
+ */
+constexpr uint32_t can_frame_bits(const struct can_frame& frame) {
+  using CanTiming::BitStream;
+
+  bool extended = (frame.flags & CAN_FRAME_IDE) != 0;
+  bool remote = (frame.flags & CAN_FRAME_RTR) != 0;
+  uint8_t dlc = (frame.dlc > 8) ? 8 : frame.dlc;
+  uint8_t payload = remote ? 0 : dlc;
+  BitStream s;
+
+  s.put(0, 1);  // SOF
+  if (extended) {
+    s.put(frame.id >> 18, 11);
+    s.put(1, 1);  // SRR
+    s.put(1, 1);  // IDE
+    s.put(frame.id & 0x3FFFF, 18);
+    s.put(remote ? 1 : 0, 1);
+    s.put(0, 2);  // r1, r0
+  } else {
+    s.put(frame.id & 0x7FF, 11);
+    s.put(remote ? 1 : 0, 1);
+    s.put(0, 2);  // IDE, r0
+  }
+  s.put(frame.dlc & 0xF, 4);
+  for (uint8_t i = 0; i < payload; i++) {
+    s.put(frame.data[i], 8);
+  }
+  s.put(CanTiming::crc15(s), 15);
+
+  /* The stuff bit itself counts toward the next run */
+  uint32_t stuff = 0;
+  uint8_t last = s[0];
+  int run = 1;
+
+  for (size_t i = 1; i < s.size(); i++) {
+    if (s[i] == last) {
+      run++;
+    } else {
+      last = s[i];
+      run = 1;
+    }
+    if (run == 5) {
+      stuff++;
+      last ^= 1U;
+      run = 1;
+    }
+  }
+
+  return static_cast<uint32_t>(s.size()) + stuff + CanTiming::TRAILER_BITS;
+}
+
+/**
+ * @brief Bus time for a number of bits, in nanoseconds.
+ */
+constexpr uint64_t can_bits_to_ns(uint32_t bits, uint32_t bitrate) {
+  return (static_cast<uint64_t>(bits) * 1000000000ULL + bitrate - 1) / bitrate;
+}
+
+/**
+ * @brief Arbitration priority: the lower key wins.
+ * * Compares the bits in the order they are sent (base ID, RTR/SRR, IDE,
+ * extended ID, RTR), so a standard frame beats an extended frame with the
+ * same base ID and a data frame beats a remote frame with the same ID.
+ */
+constexpr uint64_t can_arbitration_key(const struct can_frame& frame) {
+  bool extended = (frame.flags & CAN_FRAME_IDE) != 0;
+  uint64_t remote = (frame.flags & CAN_FRAME_RTR) ? 1 : 0;
+
+  if (extended) {
+    return (static_cast<uint64_t>(frame.id >> 18) << 21) | (1ULL << 20) |
+           (1ULL << 19) | (static_cast<uint64_t>(frame.id & 0x3FFFF) << 1) |
+           remote;
+  }
+  return (static_cast<uint64_t>(frame.id & 0x7FF) << 21) | (remote << 20);
+}
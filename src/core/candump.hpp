@@ -0,0 +1,195 @@
+/*
+ * src/core/candump.hpp
+ * Parser and formatter for the Linux can-utils candump log format
+ *
+ *   (1436509052.249713) can0 100#05
+ *   (1436509052.250000) can0 12345678#DEADBEEF   <- 8 hex digits: extended
+ *   (1436509052.250100) can0 100#R               <- remote frame
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+#include <string_view>
+
+struct CandumpRecord {
+  uint64_t timestamp_us;
+  std::string_view iface;  // Points into the parsed line
+  struct can_frame frame;
+};
+
+namespace candump_detail {
+constexpr int hex_value(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+constexpr char hex_digit(uint32_t v) { return "0123456789ABCDEF"[v & 0xF]; }
+}  // namespace candump_detail
+
+/**
+ * @brief Parse one candump line (trailing newline allowed).
+ * * CAN FD lines ("##") and malformed lines are rejected.
+ */
+constexpr bool parse_candump_line(std::string_view line, CandumpRecord& rec) {
+  using candump_detail::hex_value;
+
+  size_t i = 0;
+  uint64_t sec = 0;
+  uint64_t usec = 0;
+  int usec_digits = 0;
+
+  if (line.size() < 4 || line[0] != '(') {
+    return false;
+  }
+
+  /* Timestamp: seconds '.' fraction, fraction scaled to microseconds */
+  for (i = 1; i < line.size() && line[i] >= '0' && line[i] <= '9'; i++) {
+    sec = sec * 10 + (line[i] - '0');
+  }
+  if (i >= line.size() || line[i] != '.') {
+    return false;
+  }
+  for (i++; i < line.size() && line[i] >= '0' && line[i] <= '9'; i++) {
+    if (usec_digits < 6) {
+      usec = usec * 10 + (line[i] - '0');
+      usec_digits++;
+    }
+  }
+  for (; usec_digits < 6; usec_digits++) {
+    usec *= 10;
+  }
+  if (i + 1 >= line.size() || line[i] != ')' || line[i + 1] != ' ') {
+    return false;
+  }
+  i += 2;
+
+  /* Interface name */
+  size_t iface_start = i;
+  while (i < line.size() && line[i] != ' ') {
+    i++;
+  }
+  if (i >= line.size() || i == iface_start) {
+    return false;
+  }
+  rec.iface = line.substr(iface_start, i - iface_start);
+  i++;
+
+  /* Identifier */
+  size_t id_start = i;
+  uint32_t id = 0;
+  while (i < line.size() && hex_value(line[i]) >= 0) {
+    id = (id << 4) | hex_value(line[i]);
+    i++;
+  }
+  size_t id_digits = i - id_start;
+  if (i >= line.size() || line[i] != '#' ||
+      (id_digits != 3 && id_digits != 8)) {
+    return false;
+  }
+  i++;
+
+  rec.frame = {};
+  rec.frame.id = id;
+  if (id_digits == 8) {
+    rec.frame.flags |= CAN_FRAME_IDE;
+  }
+
+  if (i < line.size() && (line[i] == '#')) {
+    return false;  // CAN FD
+  }
+  if (i < line.size() && (line[i] == 'R' || line[i] == 'r')) {
+    rec.frame.flags |= CAN_FRAME_RTR;
+    i++;
+    if (i < line.size() && hex_value(line[i]) >= 0) {
+      rec.frame.dlc = static_cast<uint8_t>(hex_value(line[i]));
+    }
+  } else {
+    uint8_t n = 0;
+    while (i + 1 < line.size() && hex_value(line[i]) >= 0) {
+      int hi = hex_value(line[i]);
+      int lo = hex_value(line[i + 1]);
+      if (lo < 0 || n >= CAN_MAX_DLEN) {
+        return false;
+      }
+      rec.frame.data[n++] = static_cast<uint8_t>((hi << 4) | lo);
+      i += 2;
+    }
+    rec.frame.dlc = n;
+  }
+
+  rec.timestamp_us = sec * 1000000U + usec;
+  return true;
+}
+
+/**
+ * @brief Format a frame as a candump line, including the trailing newline.
+ * * @return Characters written (excluding NUL), 0 if the buffer is too small
+ */
+constexpr size_t format_candump_line(uint64_t timestamp_us,
+                                     std::string_view iface,
+                                     const struct can_frame& frame, char* buf,
+                                     size_t size) {
+  using candump_detail::hex_digit;
+
+  /* "(" + 20 + "." + 6 + ") " + iface + " " + 8 + "#" + 16 + "\n" + NUL */
+  if (size < 57 + iface.size()) {
+    return 0;
+  }
+
+  size_t n = 0;
+  char digits[20] = {};
+  int nd = 0;
+  uint64_t sec = timestamp_us / 1000000U;
+  uint32_t usec = static_cast<uint32_t>(timestamp_us % 1000000U);
+
+  buf[n++] = '(';
+  do {
+    digits[nd++] = static_cast<char>('0' + sec % 10);
+    sec /= 10;
+  } while (sec != 0);
+  while (nd > 0) {
+    buf[n++] = digits[--nd];
+  }
+  buf[n++] = '.';
+  for (uint32_t div = 100000; div != 0; div /= 10) {
+    buf[n++] = static_cast<char>('0' + (usec / div) % 10);
+  }
+  buf[n++] = ')';
+  buf[n++] = ' ';
+  for (char c : iface) {
+    buf[n++] = c;
+  }
+  buf[n++] = ' ';
+
+  int id_digits = (frame.flags & CAN_FRAME_IDE) ? 8 : 3;
+  for (int d = id_digits - 1; d >= 0; d--) {
+    buf[n++] = hex_digit(frame.id >> (4 * d));
+  }
+  buf[n++] = '#';
+
+  if (frame.flags & CAN_FRAME_RTR) {
+    buf[n++] = 'R';
+  } else {
+    uint8_t len = (frame.dlc > CAN_MAX_DLEN) ? CAN_MAX_DLEN : frame.dlc;
+    for (uint8_t b = 0; b < len; b++) {
+      buf[n++] = hex_digit(frame.data[b] >> 4);
+      buf[n++] = hex_digit(frame.data[b]);
+    }
+  }
+
+  buf[n++] = '\n';
+  buf[n] = '\0';
+  return n;
+}
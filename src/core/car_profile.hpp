@@ -0,0 +1,171 @@
+/*
+ * src/core/car_profile.hpp
+ * Per-car TX schedule, gear model, RX filter plan and gear frame layout,
+ * and the double-buffered switch between them
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t, uint64_t
+
+#include "message_spec.hpp"
+#include "signal_codec.hpp"
+
+/* Where the gear signal sits in the gear frame */
+struct GearLayout {
+  uint32_t id;
+  uint8_t dlc;
+  SignalSpec gear;
+};
+
+/**
+ * @brief CarProfile Struct
+ * * Everything that differs between cars, precomputed as constants. Every
+ * profile has the same number of messages and filters, so the TX thread
+ * keeps one scheduler and the filter plans can be diffed slot by slot.
+ */
+struct CarProfile {
+  static constexpr size_t MESSAGES = 2;  // Gear state, diagnostics
+  static constexpr size_t FILTERS = 2;   // Gear echo, diagnostic requests
+
+  const char* name;
+  std::array<MessageSpec, MESSAGES> schedule;
+  GearLayout gear_layout;
+  uint8_t forward_gears;  // Shifting cycles N -> 1..forward_gears -> N
+  std::array<struct can_filter, FILTERS> filters;
+};
+
+/* One side of the double buffer, owned by the TX thread while active */
+struct ProfileTables {
+  const CarProfile* profile;
+  std::array<MessageSpec, CarProfile::MESSAGES> schedule;
+  std::array<struct can_filter, CarProfile::FILTERS> filters;
+};
+
+struct ProfileSwitchStats {
+  uint32_t switches;
+  uint32_t rejected;  // Requests made while another was still pending
+  uint64_t last_latency_ns;
+  uint64_t max_latency_ns;
+};
+
+/**
+ * @brief ProfileSwitch Class
+ * * Two ProfileTables; the owner (the TX thread) reads only the active one.
+ * request() builds the next profile into the inactive side from any thread
+ * and marks it pending; the owner calls apply() between scheduler polls,
+ * which flips the active pointer, so a cycle never mixes two profiles and
+ * no table is rebuilt while it is in use. At most one switch is in flight:
+ * a second request() fails until the first has been applied.
+ */
+class ProfileSwitch {
+ private:
+  enum : uint8_t { IDLE, BUILDING, PENDING };
+
+  std::array<ProfileTables, 2> tables{};
+  std::atomic<const ProfileTables*> active_tables;
+  std::atomic<const CarProfile*> current;
+  std::atomic<const CarProfile*> previous{nullptr};
+  std::atomic<uint8_t> state{IDLE};
+  std::atomic<uint32_t> rejected{0};
+  uint64_t requested_ns = 0;  // Written by the requester before PENDING
+  ProfileSwitchStats owner_stats{};
+
+  static void build(ProfileTables& t, const CarProfile& profile) {
+    t.profile = &profile;
+    t.schedule = profile.schedule;
+    t.filters = profile.filters;
+  }
+
+  ProfileTables& other(const ProfileTables* t) {
+    return (t == &tables[0]) ? tables[1] : tables[0];
+  }
+
+ public:
+  explicit ProfileSwitch(const CarProfile& initial) {
+    build(tables[0], initial);
+    active_tables.store(&tables[0], std::memory_order_relaxed);
+    current.store(&initial, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Stage a switch to profile; any thread.
+   * * @return false if a switch is already pending
+   */
+  bool request(const CarProfile& profile, uint64_t now_ns) {
+    uint8_t expected = IDLE;
+
+    if (!state.compare_exchange_strong(expected, BUILDING,
+                                       std::memory_order_acquire)) {
+      rejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    /* The owner only flips while PENDING, so the inactive side is free */
+    const ProfileTables* active =
+        active_tables.load(std::memory_order_relaxed);
+    build(other(active), profile);
+    requested_ns = now_ns;
+    state.store(PENDING, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Flip to the pending tables; owner only, at a cycle boundary.
+   * * @return The new active tables, or nullptr if nothing was pending
+   */
+  const ProfileTables* apply(uint64_t now_ns) {
+    if (state.load(std::memory_order_acquire) != PENDING) {
+      return nullptr;
+    }
+
+    const ProfileTables* next =
+        &other(active_tables.load(std::memory_order_relaxed));
+    uint64_t latency = now_ns - requested_ns;
+
+    previous.store(current.load(std::memory_order_relaxed),
+                   std::memory_order_release);
+    active_tables.store(next, std::memory_order_release);
+    current.store(next->profile, std::memory_order_release);
+    owner_stats.switches++;
+    owner_stats.last_latency_ns = latency;
+    owner_stats.max_latency_ns = (latency > owner_stats.max_latency_ns)
+                                     ? latency
+                                     : owner_stats.max_latency_ns;
+    state.store(IDLE, std::memory_order_release);
+    return next;
+  }
+
+  /* Owner only: the tables in use, stable until the owner's next apply() */
+  const ProfileTables& active() const {
+    return *active_tables.load(std::memory_order_relaxed);
+  }
+
+  /* Any thread: the profile in effect; profiles are immutable constants */
+  const CarProfile& profile() const {
+    return *current.load(std::memory_order_acquire);
+  }
+
+  /* Any thread: the profile before the last switch, nullptr before any.
+   * Frames sent under it can still be queued right after the switch */
+  const CarProfile* previous_profile() const {
+    return previous.load(std::memory_order_acquire);
+  }
+
+  bool pending() const {
+    return state.load(std::memory_order_acquire) != IDLE;
+  }
+
+  /* Owner only, or a snapshot that may be one switch behind */
+  ProfileSwitchStats stats() const {
+    ProfileSwitchStats s = owner_stats;
+
+    s.rejected = rejected.load(std::memory_order_relaxed);
+    return s;
+  }
+};
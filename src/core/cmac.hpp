@@ -0,0 +1,101 @@
+/*
+ * src/core/cmac.hpp
+ * AES-CMAC (RFC 4493, NIST SP 800-38B)
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t
+
+#include "aes128.hpp"
+
+/**
+ * @brief Cmac Class
+ * * AES-128 CMAC with the key schedule and both subkeys (K1, K2) computed
+ * once in set_key(). A MAC over a message of up to 16 bytes, which covers
+ * every classic CAN frame plus its authentication data, then costs a
+ * single AES block.
+ */
+class Cmac {
+ public:
+  static constexpr size_t MAC_SIZE = Aes128::BLOCK_SIZE;
+
+ private:
+  using Block = std::array<uint8_t, Aes128::BLOCK_SIZE>;
+
+  Aes128 aes;
+  Block k1{};
+  Block k2{};
+
+  /* Doubling in GF(2^128): shift left, fold the carry back in */
+  static constexpr Block dbl(const Block& in) {
+    Block out{};
+    uint8_t carry = 0;
+
+    for (size_t i = in.size(); i-- > 0;) {
+      out[i] = static_cast<uint8_t>((in[i] << 1) | carry);
+      carry = in[i] >> 7;
+    }
+    if (carry != 0) {
+      out[out.size() - 1] ^= 0x87;
+    }
+    return out;
+  }
+
+ public:
+  constexpr Cmac() = default;
+  constexpr explicit Cmac(const uint8_t* key) { set_key(key); }
+
+  constexpr void set_key(const uint8_t* key) {
+    Block l{};
+
+    aes.set_key(key);
+    aes.encrypt(l.data(), l.data());
+    k1 = dbl(l);
+    k2 = dbl(k1);
+  }
+
+  /**
+   * @brief Full 16-byte MAC of msg.
+   */
+  constexpr void compute(const uint8_t* msg, size_t len, uint8_t* mac) const {
+    Block x{};
+
+    for (; len > x.size(); msg += x.size(), len -= x.size()) {
+      for (size_t i = 0; i < x.size(); i++) {
+        x[i] ^= msg[i];
+      }
+      aes.encrypt(x.data(), x.data());
+    }
+
+    /* Last block: complete ones take K1, padded ones 10..0 and K2 */
+    const Block& k = (len == x.size()) ? k1 : k2;
+
+    for (size_t i = 0; i < x.size(); i++) {
+      uint8_t m = (i < len) ? msg[i] : ((i == len) ? 0x80 : 0x00);
+      x[i] ^= static_cast<uint8_t>(m ^ k[i]);
+    }
+    aes.encrypt(x.data(), mac);
+  }
+
+  /**
+   * @brief Compare the first mac_len bytes of the MAC of msg with mac.
+   * * The comparison does not stop at the first differing byte.
+   */
+  constexpr bool verify(const uint8_t* msg, size_t len, const uint8_t* mac,
+                        size_t mac_len) const {
+    Block expected{};
+    uint8_t diff = 0;
+
+    compute(msg, len, expected.data());
+    for (size_t i = 0; i < mac_len && i < expected.size(); i++) {
+      diff |= static_cast<uint8_t>(expected[i] ^ mac[i]);
+    }
+    return diff == 0 && mac_len <= expected.size();
+  }
+
+  const Block& subkey1() const { return k1; }
+  const Block& subkey2() const { return k2; }
+};
@@ -0,0 +1,160 @@
+/*
+ * src/core/crash_ring.hpp
+ * Node state kept in RAM that is not cleared on a warm reset
+ *
+ * The record lives in a no-init section, so it still holds the previous
+ * run's contents after a watchdog or fault reset; a cold boot leaves
+ * garbage that fails validation. Frames are written in place with a
+ * per-entry check word, so an entry torn by the reset is dropped on its
+ * own. Counters and scheduler state are copied in and covered by a CRC
+ * from time to time (seal()); after a reset they are at most one sealing
+ * interval old.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t
+#include <cstring>  // memcpy
+
+#include "crc32.hpp"
+#include "frame_ring.hpp"
+
+/* Copies of the NodeStats counters */
+struct CrashCounters {
+  uint32_t tx_frames;
+  uint32_t tx_errors;
+  uint32_t rx_frames;
+  uint32_t rx_dropped;
+  uint32_t deadline_misses;
+  uint32_t bus_off_count;
+};
+
+/* Where the TX scheduler was */
+struct CrashSchedState {
+  uint32_t uptime_ms;    // Last poll
+  uint32_t next_due_ms;  // Earliest pending release after it
+  uint32_t polls;
+  uint8_t profile;  // Index into Config::CAR_PROFILES
+  uint8_t reserved[3];
+};
+
+struct CrashEntry {
+  TimedFrame frame;
+  uint32_t seq;
+  uint32_t check;
+};
+
+/* What a valid record said about the previous run */
+template <size_t N>
+struct CrashReport {
+  uint32_t warm_resets;  // In a row, this one included
+  CrashCounters counters;
+  CrashSchedState sched;
+  std::array<TimedFrame, N> frames;  // Newest first
+  size_t frame_count;
+};
+
+/**
+ * @brief CrashRecord Struct
+ * * Trivial by design: an object in a no-init section must not have a
+ * constructor that would wipe it at startup. Callers serialize record()
+ * against each other (a spinlock), as for FrameRing.
+ */
+template <size_t N>
+struct CrashRecord {
+  static constexpr uint32_t MAGIC = 0x43524153;  // "CRAS"
+
+  uint32_t magic;        // MAGIC ^ size: a new layout never validates
+  uint32_t warm_resets;  // Since the last cold boot
+  CrashCounters counters;
+  CrashSchedState sched;
+  uint32_t crc;  // Over everything above
+  uint32_t next_seq;
+  std::array<CrashEntry, N> entries;
+
+  static constexpr uint32_t magic_word() {
+    return MAGIC ^ static_cast<uint32_t>(sizeof(CrashRecord));
+  }
+
+  /* Cheap rotate-xor fold; a torn entry fails it */
+  static uint32_t entry_check(const CrashEntry& e) {
+    std::array<uint32_t, sizeof(TimedFrame) / sizeof(uint32_t)> words;
+    uint32_t check = e.seq * 0x9E3779B1U;
+
+    static_assert(sizeof(TimedFrame) % sizeof(uint32_t) == 0);
+    std::memcpy(words.data(), &e.frame, sizeof(TimedFrame));
+    for (size_t i = 0; i < words.size(); i++) {
+      check = ((check << 5) | (check >> 27)) ^ words[i];
+    }
+    return ~check;
+  }
+
+  uint32_t header_crc() const {
+    return crc32_update(0, reinterpret_cast<const uint8_t*>(this),
+                        offsetof(CrashRecord, crc));
+  }
+
+  /**
+   * @brief Validate what the previous run left and start this one.
+   * * @return true if report holds the previous run's state
+   */
+  bool begin(CrashReport<N>& report) {
+    bool valid = magic == magic_word() && crc == header_crc();
+
+    report = {};
+    if (valid) {
+      report.warm_resets = warm_resets + 1;
+      report.counters = counters;
+      report.sched = sched;
+      collect(report);
+    }
+
+    magic = magic_word();
+    warm_resets = valid ? warm_resets + 1 : 0;
+    counters = {};
+    sched = {};
+    next_seq = 0;
+    for (CrashEntry& e : entries) {
+      e = {};  // Check word 0 never matches
+    }
+    crc = header_crc();
+    return valid;
+  }
+
+  void record(const TimedFrame& frame) {
+    CrashEntry& e = entries[next_seq % N];
+
+    e.frame = frame;
+    e.seq = next_seq++;
+    e.check = entry_check(e);
+  }
+
+  void seal(const CrashCounters& now_counters,
+            const CrashSchedState& now_sched) {
+    counters = now_counters;
+    sched = now_sched;
+    crc = header_crc();
+  }
+
+ private:
+  /* Valid entries, newest (highest sequence) first */
+  void collect(CrashReport<N>& report) const {
+    std::array<uint32_t, N> seqs{};
+
+    for (const CrashEntry& e : entries) {
+      if (e.check != entry_check(e)) {
+        continue;
+      }
+
+      size_t i = report.frame_count++;
+      for (; i > 0 && seqs[i - 1] < e.seq; i--) {
+        report.frames[i] = report.frames[i - 1];
+        seqs[i] = seqs[i - 1];
+      }
+      report.frames[i] = e.frame;
+      seqs[i] = e.seq;
+    }
+  }
+};
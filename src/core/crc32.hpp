@@ -0,0 +1,45 @@
+/*
+ * src/core/crc32.hpp
+ * CRC-32 (IEEE 802.3, reflected) with a compile-time table
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t
+
+namespace crc32_detail {
+constexpr std::array<uint32_t, 256> make_table() {
+  std::array<uint32_t, 256> table{};
+
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t c = i;
+    for (int k = 0; k < 8; k++) {
+      c = (c & 1U) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+    }
+    table[i] = c;
+  }
+  return table;
+}
+
+inline constexpr std::array<uint32_t, 256> table = make_table();
+}  // namespace crc32_detail
+
+/**
+ * @brief Update a running CRC-32; start with crc = 0.
+ * * Same result as Zephyr's crc32_ieee_update(), so values computed on the
+ * node and on the host can be compared directly.
+ */
+constexpr uint32_t crc32_update(uint32_t crc, const uint8_t* data,
+                                size_t len) {
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++) {
+    crc = crc32_detail::table[(crc ^ data[i]) & 0xFFU] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+constexpr uint32_t crc32(const uint8_t* data, size_t len) {
+  return crc32_update(0, data, len);
+}
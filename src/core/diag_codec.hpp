@@ -0,0 +1,150 @@
+/*
+ * src/core/diag_codec.hpp
+ * Layout of the periodic node diagnostic frame and the crash report
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstdint>  // uint8_t, uint32_t
+
+#include "app_config.hpp"
+#include "signal_codec.hpp"
+
+/* First payload byte of a frame sent to CAN_DIAG_REQ_MSG_ID */
+enum class DiagCommand : uint8_t {
+  BlackboxFreeze = 0x01,
+  SelectProfile = 0x02,  // data[1]: index into Config::CAR_PROFILES
+  Subscribe = 0x03,      // data[1..2]: ID, [3..4]: mask (big-endian)
+  Unsubscribe = 0x04,    // Same layout as Subscribe
+  CrashReport = 0x05,    // Reply on CAN_CRASH_REPORT_MSG_ID
+};
+
+/* Decoded view of the diagnostic frame; counters saturate at field width */
+struct DiagPayload {
+  uint8_t cpu_load_pct;
+  uint8_t max_queue_depth;
+  uint8_t deadline_misses;
+  uint8_t tx_errors;
+  uint8_t bus_off_count;
+  uint8_t alive_counter;  // Increments every frame, wraps at 16
+  uint32_t uptime_s;
+};
+
+namespace DiagSignals {
+constexpr SignalSpec CPU_LOAD = {.start_bit = 0, .length = 7};
+constexpr SignalSpec MAX_QUEUE_DEPTH = {.start_bit = 7, .length = 6};
+constexpr SignalSpec DEADLINE_MISSES = {.start_bit = 13, .length = 8};
+constexpr SignalSpec TX_ERRORS = {.start_bit = 21, .length = 8};
+constexpr SignalSpec BUS_OFF_COUNT = {.start_bit = 29, .length = 4};
+constexpr SignalSpec ALIVE_COUNTER = {.start_bit = 33, .length = 4};
+constexpr SignalSpec UPTIME = {.start_bit = 37, .length = 24};
+}  // namespace DiagSignals
+
+/* Clamp a counter to the largest value its field can hold */
+constexpr uint64_t saturate(uint32_t value, SignalSpec sig) {
+  return (value > sig.mask()) ? sig.mask() : value;
+}
+
+inline void encode_diag_frame(const DiagPayload& diag,
+                              struct can_frame& frame) {
+  using namespace DiagSignals;
+
+  frame = {};
+  frame.id = Config::CAN_DIAG_MSG_ID;
+  frame.dlc = Config::CAN_DIAG_MSG_DLC;
+
+  pack_signal(frame.data, CPU_LOAD, saturate(diag.cpu_load_pct, CPU_LOAD));
+  pack_signal(frame.data, MAX_QUEUE_DEPTH,
+              saturate(diag.max_queue_depth, MAX_QUEUE_DEPTH));
+  pack_signal(frame.data, DEADLINE_MISSES,
+              saturate(diag.deadline_misses, DEADLINE_MISSES));
+  pack_signal(frame.data, TX_ERRORS, saturate(diag.tx_errors, TX_ERRORS));
+  pack_signal(frame.data, BUS_OFF_COUNT,
+              saturate(diag.bus_off_count, BUS_OFF_COUNT));
+  pack_signal(frame.data, ALIVE_COUNTER, diag.alive_counter);
+  pack_signal(frame.data, UPTIME, saturate(diag.uptime_s, UPTIME));
+}
+
+inline bool decode_diag_frame(const struct can_frame& frame,
+                              DiagPayload& diag) {
+  using namespace DiagSignals;
+
+  if (frame.id != Config::CAN_DIAG_MSG_ID ||
+      frame.dlc < Config::CAN_DIAG_MSG_DLC) {
+    return false;
+  }
+
+  diag.cpu_load_pct = unpack_signal(frame.data, CPU_LOAD);
+  diag.max_queue_depth = unpack_signal(frame.data, MAX_QUEUE_DEPTH);
+  diag.deadline_misses = unpack_signal(frame.data, DEADLINE_MISSES);
+  diag.tx_errors = unpack_signal(frame.data, TX_ERRORS);
+  diag.bus_off_count = unpack_signal(frame.data, BUS_OFF_COUNT);
+  diag.alive_counter = unpack_signal(frame.data, ALIVE_COUNTER);
+  diag.uptime_s = unpack_signal(frame.data, UPTIME);
+  return true;
+}
+
+/* What the retained crash record held at boot; all zero after a cold boot */
+struct CrashReportPayload {
+  uint8_t warm_resets;
+  uint32_t uptime_s;  // When the previous run was last sealed
+  uint8_t profile;
+  uint8_t deadline_misses;
+  uint8_t tx_errors;
+  uint8_t rx_dropped;
+  uint8_t bus_off_count;
+  uint8_t frames;  // Recovered from the frame ring
+};
+
+namespace CrashReportSignals {
+constexpr SignalSpec WARM_RESETS = {.start_bit = 0, .length = 8};
+constexpr SignalSpec UPTIME = {.start_bit = 8, .length = 20};
+constexpr SignalSpec PROFILE = {.start_bit = 28, .length = 4};
+constexpr SignalSpec DEADLINE_MISSES = {.start_bit = 32, .length = 8};
+constexpr SignalSpec TX_ERRORS = {.start_bit = 40, .length = 8};
+constexpr SignalSpec RX_DROPPED = {.start_bit = 48, .length = 8};
+constexpr SignalSpec BUS_OFF_COUNT = {.start_bit = 56, .length = 4};
+constexpr SignalSpec FRAMES = {.start_bit = 60, .length = 4};
+}  // namespace CrashReportSignals
+
+inline void encode_crash_report_frame(const CrashReportPayload& report,
+                                      struct can_frame& frame) {
+  using namespace CrashReportSignals;
+
+  frame = {};
+  frame.id = Config::CAN_CRASH_REPORT_MSG_ID;
+  frame.dlc = 8;
+
+  pack_signal(frame.data, WARM_RESETS, report.warm_resets);
+  pack_signal(frame.data, UPTIME, saturate(report.uptime_s, UPTIME));
+  pack_signal(frame.data, PROFILE, saturate(report.profile, PROFILE));
+  pack_signal(frame.data, DEADLINE_MISSES,
+              saturate(report.deadline_misses, DEADLINE_MISSES));
+  pack_signal(frame.data, TX_ERRORS, saturate(report.tx_errors, TX_ERRORS));
+  pack_signal(frame.data, RX_DROPPED,
+              saturate(report.rx_dropped, RX_DROPPED));
+  pack_signal(frame.data, BUS_OFF_COUNT,
+              saturate(report.bus_off_count, BUS_OFF_COUNT));
+  pack_signal(frame.data, FRAMES, saturate(report.frames, FRAMES));
+}
+
+inline bool decode_crash_report_frame(const struct can_frame& frame,
+                                      CrashReportPayload& report) {
+  using namespace CrashReportSignals;
+
+  if (frame.id != Config::CAN_CRASH_REPORT_MSG_ID || frame.dlc < 8) {
+    return false;
+  }
+
+  report.warm_resets = unpack_signal(frame.data, WARM_RESETS);
+  report.uptime_s = unpack_signal(frame.data, UPTIME);
+  report.profile = unpack_signal(frame.data, PROFILE);
+  report.deadline_misses = unpack_signal(frame.data, DEADLINE_MISSES);
+  report.tx_errors = unpack_signal(frame.data, TX_ERRORS);
+  report.rx_dropped = unpack_signal(frame.data, RX_DROPPED);
+  report.bus_off_count = unpack_signal(frame.data, BUS_OFF_COUNT);
+  report.frames = unpack_signal(frame.data, FRAMES);
+  return true;
+}
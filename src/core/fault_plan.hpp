@@ -0,0 +1,144 @@
+/*
+ * src/core/fault_plan.hpp
+ * Per-frame fault decisions for the fault-injection CAN driver
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint16_t, uint32_t
+
+enum class FaultKind : uint8_t {
+  None = 0,
+  Drop,         // Frame acknowledged but never delivered
+  Delay,        // Delivered arg ms late
+  Duplicate,    // Delivered twice
+  Corrupt,      // Payload bit arg flipped (a corruption that beat the CRC)
+  MailboxFull,  // can_send() fails as if no mailbox freed up in time
+  BusOff,       // Controller goes bus-off for arg ms
+};
+
+constexpr size_t FAULT_KIND_COUNT = 7;
+
+/* Scripted fault: applied to the frame-th TX frame after the script is set */
+struct FaultStep {
+  uint32_t frame;
+  FaultKind kind;
+  uint16_t arg;  // Delay/BusOff: ms; Corrupt: bit index (0xFFFF = random)
+};
+
+struct FaultAction {
+  FaultKind kind;
+  uint32_t arg;
+};
+
+/**
+ * @brief FaultPlan Class
+ * * Decides the fate of each transmitted frame, either from a script or
+ * by independent per-kind probabilities (in permille). The random source
+ * is a seeded xorshift32, so a run with the same seed and traffic injects
+ * the same faults. Scripts take precedence: a scripted frame is never
+ * also hit by a random fault.
+ */
+class FaultPlan {
+ private:
+  std::array<uint16_t, FAULT_KIND_COUNT> permille{};
+  uint32_t rng;
+  const FaultStep* script = nullptr;
+  size_t script_len = 0;
+  size_t script_pos = 0;
+  uint32_t frame_index = 0;
+  uint16_t delay_ms = 10;
+  uint16_t bus_off_ms = 100;
+
+  /* Evaluated in this order; the first kind that fires wins */
+  static constexpr std::array<FaultKind, 6> ROLL_ORDER = {
+      FaultKind::BusOff,  FaultKind::MailboxFull, FaultKind::Drop,
+      FaultKind::Corrupt, FaultKind::Duplicate,   FaultKind::Delay};
+
+  uint32_t bit_for(uint8_t dlc) { return random() % (dlc * 8U); }
+
+ public:
+  constexpr explicit FaultPlan(uint32_t seed = 1)
+      : rng(seed != 0 ? seed : 1) {}
+
+  constexpr uint32_t random() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+  }
+
+  void set_probability(FaultKind kind, uint16_t value) {
+    permille[static_cast<size_t>(kind)] = (value > 1000) ? 1000 : value;
+  }
+
+  uint16_t probability(FaultKind kind) const {
+    return permille[static_cast<size_t>(kind)];
+  }
+
+  void set_delay_ms(uint16_t ms) { delay_ms = ms; }
+  void set_bus_off_ms(uint16_t ms) { bus_off_ms = ms; }
+
+  /**
+   * @brief Replace the script; frame numbering restarts at 0.
+   * * steps must stay valid while the script runs and be sorted by frame.
+   */
+  void set_script(const FaultStep* steps, size_t count) {
+    script = steps;
+    script_len = count;
+    script_pos = 0;
+    frame_index = 0;
+  }
+
+  bool script_done() const { return script_pos >= script_len; }
+
+  /**
+   * @brief Decide the fault for the next TX frame.
+   * * Corrupt on a frame without payload degrades to None.
+   */
+  FaultAction next(uint8_t dlc) {
+    FaultAction action = {FaultKind::None, 0};
+    uint32_t index = frame_index++;
+    bool scripted = false;
+
+    /* Steps for frames already passed (or duplicates) are consumed */
+    while (script_pos < script_len && script[script_pos].frame <= index) {
+      const FaultStep& step = script[script_pos++];
+
+      if (step.frame == index && !scripted) {
+        action = {step.kind, step.arg};
+        scripted = true;
+      }
+    }
+
+    if (!scripted) {
+      for (FaultKind kind : ROLL_ORDER) {
+        uint16_t p = probability(kind);
+
+        if (p != 0 && random() % 1000U < p) {
+          action.kind = kind;
+          break;
+        }
+      }
+      if (action.kind == FaultKind::Delay) {
+        action.arg = delay_ms;
+      } else if (action.kind == FaultKind::BusOff) {
+        action.arg = bus_off_ms;
+      } else if (action.kind == FaultKind::Corrupt) {
+        action.arg = 0xFFFF;
+      }
+    }
+
+    if (action.kind == FaultKind::Corrupt) {
+      if (dlc == 0) {
+        return {FaultKind::None, 0};
+      }
+      if (action.arg >= dlc * 8U) {
+        action.arg = bit_for(dlc);
+      }
+    }
+    return action;
+  }
+};
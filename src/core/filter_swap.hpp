@@ -0,0 +1,63 @@
+/*
+ * src/core/filter_swap.hpp
+ * Make-before-break replacement of a set of RX filters
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+
+inline bool same_filter(const struct can_filter& a,
+                        const struct can_filter& b) {
+  return a.id == b.id && a.mask == b.mask && a.flags == b.flags;
+}
+
+/* Software equivalent of the controller's acceptance test */
+inline bool filter_matches(const struct can_filter& filter,
+                           const struct can_frame& frame) {
+  bool ext = (frame.flags & CAN_FRAME_IDE) != 0;
+
+  return ext == ((filter.flags & CAN_FILTER_IDE) != 0) &&
+         ((frame.id ^ filter.id) & filter.mask) == 0;
+}
+
+/**
+ * @brief Move the controller from filter set old to filter set next.
+ * * Filters in both sets keep their installed ID. The missing ones are
+ * added first (add(filter) returns the filter ID or a negative error),
+ * and only then are the filters next does not need removed (remove(id)),
+ * so every frame wanted by both sets is accepted throughout. A frame that
+ * matches an old and a new filter may be delivered twice in between.
+ * Negative IDs in old_ids mark filters that were never installed. Only
+ * the first 64 old filters can carry over; later ones are re-added.
+ */
+template <typename Add, typename Remove>
+void swap_filters(const struct can_filter* old, const int* old_ids,
+                  size_t old_n, const struct can_filter* next, int* next_ids,
+                  size_t next_n, Add&& add, Remove&& remove) {
+  uint64_t kept = 0;  // Bit j: old[j] carries over
+
+  for (size_t i = 0; i < next_n; i++) {
+    next_ids[i] = -1;
+    for (size_t j = 0; j < old_n && j < 64; j++) {
+      if ((kept & (1ULL << j)) == 0 && old_ids[j] >= 0 &&
+          same_filter(next[i], old[j])) {
+        next_ids[i] = old_ids[j];
+        kept |= 1ULL << j;
+        break;
+      }
+    }
+    if (next_ids[i] < 0) {
+      next_ids[i] = add(next[i]);
+    }
+  }
+
+  for (size_t j = 0; j < old_n; j++) {
+    if ((j >= 64 || (kept & (1ULL << j)) == 0) && old_ids[j] >= 0) {
+      remove(old_ids[j]);
+    }
+  }
+}
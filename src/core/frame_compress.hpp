@@ -0,0 +1,195 @@
+/*
+ * src/core/frame_compress.hpp
+ * Lossless delta compression of TimedFrame sequences
+ *
+ * Each entry starts with a tag byte:
+ *   bits 0..3  DLC
+ *   bit  4     direction (1 = TX)
+ *   bit  5     identifier and flags equal to the previous entry
+ *   bit  6     payload equal to the previous entry (same DLC)
+ * followed by the zigzag varint timestamp delta to the previous entry (the
+ * absolute timestamp for the first one), the varint (id << 2 | IDE | RTR)
+ * unless bit 5 is set, and the payload bytes unless bit 6 is set.
+ * A loopback TX/RX pair of the same frame compresses to about 3 bytes.
+ */
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t
+
+#include "frame_ring.hpp"
+
+namespace FrameCompress {
+constexpr uint8_t TAG_DLC_MASK = 0x0F;
+constexpr uint8_t TAG_TX = 0x10;
+constexpr uint8_t TAG_SAME_ID = 0x20;
+constexpr uint8_t TAG_SAME_DATA = 0x40;
+
+/* Tag + 5-byte timestamp + 5-byte id + 8 data bytes */
+constexpr size_t MAX_ENTRY_SIZE = 19;
+
+constexpr size_t put_varint(uint32_t v, uint8_t* out) {
+  size_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = static_cast<uint8_t>(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = static_cast<uint8_t>(v);
+  return n;
+}
+
+/* @return bytes consumed, 0 if truncated or over-long */
+constexpr size_t get_varint(const uint8_t* in, size_t len, uint32_t& v) {
+  v = 0;
+  for (size_t n = 0; n < len && n < 5; n++) {
+    v |= static_cast<uint32_t>(in[n] & 0x7F) << (7 * n);
+    if ((in[n] & 0x80) == 0) {
+      return n + 1;
+    }
+  }
+  return 0;
+}
+
+constexpr uint32_t zigzag(int32_t v) {
+  return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+constexpr int32_t unzigzag(uint32_t v) {
+  return static_cast<int32_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+constexpr uint32_t id_key(const TimedFrame& f) {
+  return (f.id << 2) | (f.flags & 0x03U);
+}
+
+constexpr bool same_data(const TimedFrame& a, const TimedFrame& b) {
+  if (a.dlc != b.dlc) {
+    return false;
+  }
+  for (uint8_t i = 0; i < a.dlc; i++) {
+    if (a.data[i] != b.data[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace FrameCompress
+
+class FrameEncoder {
+ private:
+  TimedFrame prev{};
+  bool has_prev = false;
+
+ public:
+  /**
+   * @brief Append one entry to out.
+   * * @return Bytes written; 0 (and no state change) if space is too small
+   */
+  size_t encode(const TimedFrame& f, uint8_t* out, size_t space) {
+    using namespace FrameCompress;
+    uint8_t tmp[MAX_ENTRY_SIZE];
+    size_t n = 1;
+    uint8_t tag = f.dlc & TAG_DLC_MASK;
+
+    tag |= (f.dir == FrameDir::Tx) ? TAG_TX : 0;
+
+    if (has_prev) {
+      int32_t delta = static_cast<int32_t>(f.timestamp_us - prev.timestamp_us);
+      n += put_varint(zigzag(delta), &tmp[n]);
+      tag |= (id_key(f) == id_key(prev)) ? TAG_SAME_ID : 0;
+      tag |= same_data(f, prev) ? TAG_SAME_DATA : 0;
+    } else {
+      n += put_varint(f.timestamp_us, &tmp[n]);
+    }
+
+    if (!(tag & TAG_SAME_ID)) {
+      n += put_varint(id_key(f), &tmp[n]);
+    }
+    if (!(tag & TAG_SAME_DATA)) {
+      for (uint8_t i = 0; i < f.dlc; i++) {
+        tmp[n++] = f.data[i];
+      }
+    }
+    tmp[0] = tag;
+
+    if (n > space) {
+      return 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+      out[i] = tmp[i];
+    }
+    prev = f;
+    has_prev = true;
+    return n;
+  }
+};
+
+class FrameDecoder {
+ private:
+  TimedFrame prev{};
+  bool has_prev = false;
+
+ public:
+  /**
+   * @brief Decode one entry.
+   * * @return Bytes consumed; 0 on truncated or corrupt input
+   */
+  size_t decode(const uint8_t* in, size_t len, TimedFrame& f) {
+    using namespace FrameCompress;
+    uint32_t v = 0;
+    size_t n = 1;
+
+    if (len < 1) {
+      return 0;
+    }
+
+    uint8_t tag = in[0];
+    if ((tag & 0x80) || (tag & TAG_DLC_MASK) > 8 ||
+        (!has_prev && (tag & (TAG_SAME_ID | TAG_SAME_DATA)))) {
+      return 0;
+    }
+
+    size_t used = get_varint(&in[n], len - n, v);
+    if (used == 0) {
+      return 0;
+    }
+    n += used;
+
+    f = {};
+    f.dlc = tag & TAG_DLC_MASK;
+    f.dir = (tag & TAG_TX) ? FrameDir::Tx : FrameDir::Rx;
+    f.timestamp_us =
+        has_prev ? prev.timestamp_us + static_cast<uint32_t>(unzigzag(v)) : v;
+
+    if (tag & TAG_SAME_ID) {
+      f.id = prev.id;
+      f.flags = prev.flags;
+    } else {
+      used = get_varint(&in[n], len - n, v);
+      if (used == 0) {
+        return 0;
+      }
+      n += used;
+      f.id = v >> 2;
+      f.flags = v & 0x03U;
+    }
+
+    if (tag & TAG_SAME_DATA) {
+      for (uint8_t i = 0; i < f.dlc; i++) {
+        f.data[i] = prev.data[i];
+      }
+    } else {
+      if (len - n < f.dlc) {
+        return 0;
+      }
+      for (uint8_t i = 0; i < f.dlc; i++) {
+        f.data[i] = in[n++];
+      }
+    }
+
+    prev = f;
+    has_prev = true;
+    return n;
+  }
+};
@@ -0,0 +1,76 @@
+/*
+ * src/core/frame_ring.hpp
+ * Overwriting ring of timestamped CAN frames
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t
+
+enum class FrameDir : uint8_t { Rx = 0, Tx = 1 };
+
+/* Compact copy of a classic CAN frame plus capture metadata (20 bytes) */
+struct TimedFrame {
+  uint32_t timestamp_us;
+  uint32_t id;
+  uint8_t flags;  // CAN_FRAME_IDE / CAN_FRAME_RTR
+  uint8_t dlc;
+  FrameDir dir;
+  uint8_t data[8];
+
+  static TimedFrame from(const struct can_frame& frame, FrameDir dir,
+                         uint32_t timestamp_us) {
+    TimedFrame tf = {.timestamp_us = timestamp_us,
+                     .id = frame.id,
+                     .flags = static_cast<uint8_t>(
+                         frame.flags & (CAN_FRAME_IDE | CAN_FRAME_RTR)),
+                     .dlc = (frame.dlc > 8) ? uint8_t{8} : frame.dlc,
+                     .dir = dir,
+                     .data = {}};
+
+    for (uint8_t i = 0; i < tf.dlc; i++) {
+      tf.data[i] = frame.data[i];
+    }
+    return tf;
+  }
+};
+
+/**
+ * @brief FrameRing Class
+ * * Keeps the most recent N frames; the oldest entry is overwritten when
+ * full. Not synchronized: the owner serializes producers (e.g. with a
+ * spinlock) because TX and RX record from different contexts.
+ */
+template <size_t N>
+class FrameRing {
+ private:
+  std::array<TimedFrame, N> entries{};
+  size_t next = 0;
+  size_t count = 0;
+
+ public:
+  void push(const TimedFrame& frame) {
+    entries[next] = frame;
+    next = (next + 1) % N;
+    count = (count < N) ? count + 1 : N;
+  }
+
+  /**
+   * @brief Access by age: newest(0) is the latest frame.
+   */
+  const TimedFrame& newest(size_t age) const {
+    return entries[(next + N - 1 - age) % N];
+  }
+
+  size_t size() const { return count; }
+  static constexpr size_t capacity() { return N; }
+
+  void clear() {
+    next = 0;
+    count = 0;
+  }
+};
@@ -0,0 +1,27 @@
+/*
+ * src/core/gear.hpp
+ * Gear model shared by the application and the test suites
+ */
+
+#pragma once
+
+#include <cstdint>  // uint8_t
+
+enum class Gear : uint8_t { N = 0, First, Second, Third, Fourth, Fifth, Sixth };
+
+/* Overload prefix increment operator (++g) for cyclic shifting */
+inline Gear& operator++(Gear& g) {
+  using enum Gear;  // C++20 Feature: Reduces verbosity (no need for Gear::N,
+                    // Gear::Sixth)
+
+  // Cyclic Logic: If Sixth, reset to N. Otherwise, increment.
+  g = (g == Sixth) ? N : static_cast<Gear>(static_cast<uint8_t>(g) + 1);
+  return g;
+}
+
+/* Next gear for a gearbox with top forward gears (1..6): N -> 1..top -> N */
+inline Gear next_gear(Gear g, uint8_t top) {
+  uint8_t v = static_cast<uint8_t>(g);
+
+  return (v >= top) ? Gear::N : static_cast<Gear>(v + 1);
+}
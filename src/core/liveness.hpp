@@ -0,0 +1,143 @@
+/*
+ * src/core/liveness.hpp
+ * Heartbeat frame and the peer liveness table
+ *
+ * Heartbeat (CAN_HEARTBEAT_BASE_ID + node, 1 byte, like a CANopen
+ * heartbeat): data[0] = 4-bit alive counter
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t
+
+#include "app_config.hpp"
+
+inline void encode_heartbeat_frame(uint8_t node, uint8_t counter,
+                                   struct can_frame& frame) {
+  frame = {};
+  frame.id = Config::CAN_HEARTBEAT_BASE_ID + node;
+  frame.dlc = Config::CAN_HEARTBEAT_DLC;
+  frame.data[0] = counter & 0x0F;
+}
+
+/**
+ * @brief Decode a heartbeat.
+ * * @return false if the frame is not one
+ */
+inline bool decode_heartbeat_frame(const struct can_frame& frame,
+                                   uint8_t& node) {
+  if ((frame.flags & (CAN_FRAME_IDE | CAN_FRAME_RTR)) != 0 ||
+      (frame.id & Config::CAN_HEARTBEAT_ID_MASK) !=
+          Config::CAN_HEARTBEAT_BASE_ID ||
+      frame.dlc < Config::CAN_HEARTBEAT_DLC) {
+    return false;
+  }
+
+  node = static_cast<uint8_t>(frame.id - Config::CAN_HEARTBEAT_BASE_ID);
+  return true;
+}
+
+/* Called from sweep() when a peer appears (alive) or times out (!alive) */
+using PeerCallback = void (*)(uint8_t peer, bool alive, void* user_data);
+
+/**
+ * @brief PeerTable Class
+ * * Last-seen time of up to MaxPeers nodes, indexed by node ID. note()
+ * is two relaxed stores and may run in the RX callback while sweep()
+ * runs in a thread: the only shared state is the per-peer timestamp and
+ * a "heard since the last sweep" bitmap of 32-bit words (no 64-bit
+ * atomics needed). One periodic sweep() checks every timeout at once,
+ * walking only the set bits of the alive bitmap, and reports each change
+ * through the callback. Detection time is at most timeout_ms plus the
+ * sweep period.
+ */
+template <size_t MaxPeers = 64>
+class PeerTable {
+  static_assert(MaxPeers % 32 == 0, "MaxPeers must be a multiple of 32");
+
+ private:
+  static constexpr size_t WORDS = MaxPeers / 32;
+
+  uint32_t timeout_ms;
+  PeerCallback callback;
+  void* user_data;
+  std::array<std::atomic<uint32_t>, MaxPeers> last_seen{};
+  std::array<std::atomic<uint32_t>, WORDS> heard{};  // Producer side
+  std::array<uint32_t, WORDS> alive{};                // Sweep side
+  uint32_t lost_total = 0;
+
+ public:
+  constexpr PeerTable(uint32_t timeout_ms, PeerCallback cb = nullptr,
+                      void* user_data = nullptr)
+      : timeout_ms(timeout_ms), callback(cb), user_data(user_data) {}
+
+  /**
+   * @brief A heartbeat (or any frame) from peer arrived at now_ms.
+   */
+  void note(uint8_t peer, uint32_t now_ms) {
+    if (peer >= MaxPeers) {
+      return;
+    }
+    last_seen[peer].store(now_ms, std::memory_order_relaxed);
+    heard[peer / 32].fetch_or(1U << (peer % 32), std::memory_order_release);
+  }
+
+  /**
+   * @brief Report new peers and expire silent ones; one caller only.
+   * * @return Number of peers alive after the sweep
+   */
+  size_t sweep(uint32_t now_ms) {
+    size_t count = 0;
+
+    for (size_t w = 0; w < WORDS; w++) {
+      uint32_t fresh = heard[w].exchange(0, std::memory_order_acquire);
+      uint32_t appeared = fresh & ~alive[w];
+      uint32_t check = alive[w] & ~fresh;  // Heard peers are fresh anyway
+
+      alive[w] |= fresh;
+      while (appeared != 0) {
+        uint8_t peer = static_cast<uint8_t>(w * 32 + __builtin_ctz(appeared));
+
+        appeared &= appeared - 1;
+        if (callback != nullptr) {
+          callback(peer, true, user_data);
+        }
+      }
+
+      while (check != 0) {
+        uint32_t bit = check & (~check + 1);
+        uint8_t peer = static_cast<uint8_t>(w * 32 + __builtin_ctz(check));
+        uint32_t age =
+            now_ms - last_seen[peer].load(std::memory_order_relaxed);
+
+        check &= check - 1;
+        if (static_cast<int32_t>(age) > static_cast<int32_t>(timeout_ms)) {
+          alive[w] &= ~bit;
+          lost_total++;
+          if (callback != nullptr) {
+            callback(peer, false, user_data);
+          }
+        }
+      }
+      count += __builtin_popcount(alive[w]);
+    }
+    return count;
+  }
+
+  /* Sweep side only */
+  bool is_alive(uint8_t peer) const {
+    return peer < MaxPeers && (alive[peer / 32] & (1U << (peer % 32))) != 0;
+  }
+
+  uint32_t last_seen_ms(uint8_t peer) const {
+    return last_seen[peer].load(std::memory_order_relaxed);
+  }
+
+  uint32_t lost() const { return lost_total; }
+  static constexpr size_t capacity() { return MaxPeers; }
+};
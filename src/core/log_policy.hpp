@@ -0,0 +1,166 @@
+/*
+ * src/core/log_policy.hpp
+ * Log-rate policy for hot paths: sampling, rate limits and summaries
+ */
+
+#pragma once
+
+#include <cstdint>  // int64_t, uint32_t
+
+#include "token_bucket.hpp"
+
+/**
+ * @brief HotLogSite Class
+ * * Decides whether one call site's event becomes a log line: only every
+ * sample_every-th event is considered, and those draw from a token bucket
+ * (rate_per_s sustained, burst at once). Everything else is counted, not
+ * formatted, so the cost of a suppressed event is a counter update and a
+ * compare no matter how fast events arrive. Not thread-safe; one site per
+ * call site and thread.
+ */
+class HotLogSite {
+ private:
+  uint32_t sample_every;
+  uint32_t until_sample;
+  TokenBucket bucket;
+  uint32_t pending = 0;  // Suppressed since the last admitted line
+  uint32_t total = 0;
+
+ public:
+  constexpr HotLogSite(uint32_t sample_every, uint32_t rate_per_s,
+                       uint32_t burst)
+      : sample_every((sample_every == 0) ? 1 : sample_every),
+        until_sample(1),
+        bucket(rate_per_s, burst) {}
+
+  /**
+   * @brief Account for one event.
+   * * @return true if the caller should log it
+   */
+  bool admit(int64_t now_ms) {
+    if (--until_sample != 0) {
+      pending++;
+      total++;
+      return false;
+    }
+    until_sample = sample_every;
+
+    if (!bucket.try_take(1, now_ms)) {
+      pending++;
+      total++;
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Events suppressed since the previous admitted one; resets.
+   */
+  uint32_t take_suppressed() {
+    uint32_t n = pending;
+    pending = 0;
+    return n;
+  }
+
+  uint32_t suppressed_total() const { return total; }
+};
+
+/* Counts reported for one closed summary window */
+struct EventSummary {
+  uint32_t window_ms;
+  uint32_t events;
+  uint32_t errors;
+  uint32_t suppressed;  // Log lines not printed in the window
+};
+
+/**
+ * @brief EventWindow Class
+ * * Aggregates a hot path into one line per window ("1000 frames in last
+ * 1000 ms, 0 errors") instead of a line per event. note() is two
+ * increments; close() reports a window once it is at least window_ms old.
+ * Windows are aligned to the first event, so summaries come at a steady
+ * cadence while events keep arriving.
+ */
+class EventWindow {
+ private:
+  uint32_t window_ms;
+  int64_t start_ms = -1;
+  uint32_t events = 0;
+  uint32_t errors = 0;
+
+ public:
+  constexpr explicit EventWindow(uint32_t window_ms) : window_ms(window_ms) {}
+
+  void note(int64_t now_ms, bool error = false) {
+    if (start_ms < 0) {
+      start_ms = now_ms;
+    }
+    events++;
+    errors += error ? 1 : 0;
+  }
+
+  /**
+   * @brief Close the window if it has run for window_ms.
+   * * @return true and fills out if a summary is due
+   */
+  bool close(int64_t now_ms, EventSummary& out) {
+    if (window_ms == 0 || start_ms < 0 || now_ms - start_ms < window_ms) {
+      return false;
+    }
+
+    out = {.window_ms = static_cast<uint32_t>(now_ms - start_ms),
+           .events = events,
+           .errors = errors,
+           .suppressed = 0};
+
+    /* Skip whole idle windows rather than reporting empty ones */
+    start_ms += (now_ms - start_ms) / window_ms * window_ms;
+    events = 0;
+    errors = 0;
+    return true;
+  }
+};
+
+/**
+ * @brief HotPathLog Class
+ * * A HotLogSite plus an EventWindow for one hot path. A summary is only
+ * due for windows in which lines were suppressed: while every event is
+ * printed anyway, the summary would add nothing.
+ */
+class HotPathLog {
+ private:
+  HotLogSite site;
+  EventWindow window;
+  uint32_t suppressed_at_open = 0;
+
+ public:
+  constexpr HotPathLog(uint32_t sample_every, uint32_t rate_per_s,
+                       uint32_t burst, uint32_t window_ms)
+      : site(sample_every, rate_per_s, burst), window(window_ms) {}
+
+  /**
+   * @brief Account for one event.
+   * * @return true if the caller should log it
+   */
+  bool event(int64_t now_ms, bool error = false) {
+    window.note(now_ms, error);
+    return site.admit(now_ms);
+  }
+
+  uint32_t take_suppressed() { return site.take_suppressed(); }
+  uint32_t suppressed_total() const { return site.suppressed_total(); }
+
+  /**
+   * @brief Close the current window if it is due and lines were lost.
+   */
+  bool summary(int64_t now_ms, EventSummary& out) {
+    if (!window.close(now_ms, out)) {
+      return false;
+    }
+
+    uint32_t total = site.suppressed_total();
+    out.suppressed = total - suppressed_at_open;
+    suppressed_at_open = total;
+    return out.suppressed != 0;
+  }
+};
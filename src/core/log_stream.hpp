@@ -0,0 +1,191 @@
+/*
+ * src/core/log_stream.hpp
+ * Framing of binary log records over classic CAN frames
+ *
+ * Each frame carries a one-byte header followed by up to 7 payload bytes:
+ *   bits 0..3  sequence number, continuous across records (wraps at 16)
+ *   bit  4     first frame of a record
+ *   bit  5     last frame of a record
+ * A record starts with a fixed little-endian header and continues with the
+ * formatted message text (no terminator; the length is implied by END).
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint16_t, uint32_t
+
+namespace LogStream {
+constexpr uint8_t SEQ_MASK = 0x0F;
+constexpr uint8_t FLAG_START = 0x10;
+constexpr uint8_t FLAG_END = 0x20;
+constexpr size_t PAYLOAD_PER_FRAME = 7;
+constexpr size_t HEADER_SIZE = 10;
+
+constexpr size_t frames_for(size_t record_len) {
+  return (record_len + PAYLOAD_PER_FRAME - 1) / PAYLOAD_PER_FRAME;
+}
+}  // namespace LogStream
+
+struct LogRecordHeader {
+  uint32_t timestamp_ms;
+  uint8_t level;     // Zephyr LOG_LEVEL_* value
+  uint8_t domain;
+  uint16_t source_id;
+  uint16_t dropped;  // Records lost by the sender since the previous one
+};
+
+inline void serialize_log_header(const LogRecordHeader& hdr, uint8_t* out) {
+  out[0] = static_cast<uint8_t>(hdr.timestamp_ms);
+  out[1] = static_cast<uint8_t>(hdr.timestamp_ms >> 8);
+  out[2] = static_cast<uint8_t>(hdr.timestamp_ms >> 16);
+  out[3] = static_cast<uint8_t>(hdr.timestamp_ms >> 24);
+  out[4] = hdr.level;
+  out[5] = hdr.domain;
+  out[6] = static_cast<uint8_t>(hdr.source_id);
+  out[7] = static_cast<uint8_t>(hdr.source_id >> 8);
+  out[8] = static_cast<uint8_t>(hdr.dropped);
+  out[9] = static_cast<uint8_t>(hdr.dropped >> 8);
+}
+
+inline bool parse_log_header(const uint8_t* in, size_t len,
+                             LogRecordHeader& hdr) {
+  if (len < LogStream::HEADER_SIZE) {
+    return false;
+  }
+
+  hdr.timestamp_ms = in[0] | (in[1] << 8) | (in[2] << 16) |
+                     (static_cast<uint32_t>(in[3]) << 24);
+  hdr.level = in[4];
+  hdr.domain = in[5];
+  hdr.source_id = static_cast<uint16_t>(in[6] | (in[7] << 8));
+  hdr.dropped = static_cast<uint16_t>(in[8] | (in[9] << 8));
+  return true;
+}
+
+/**
+ * @brief LogSegmenter Class
+ * * Splits one serialized record into CAN frames. The sequence counter is
+ * owned by the caller so it stays continuous across records.
+ */
+class LogSegmenter {
+ private:
+  const uint8_t* data;
+  size_t len;
+  size_t pos;
+  uint8_t& seq;
+
+ public:
+  LogSegmenter(const uint8_t* record, size_t record_len, uint8_t& sequence)
+      : data(record), len(record_len), pos(0), seq(sequence) {}
+
+  /**
+   * @brief Produce the next frame of the record.
+   * * @return false once every byte has been emitted
+   */
+  bool next(uint32_t can_id, struct can_frame& frame) {
+    if (pos >= len) {
+      return false;
+    }
+
+    size_t chunk = len - pos;
+    if (chunk > LogStream::PAYLOAD_PER_FRAME) {
+      chunk = LogStream::PAYLOAD_PER_FRAME;
+    }
+
+    frame = {};
+    frame.id = can_id;
+    frame.dlc = static_cast<uint8_t>(chunk + 1);
+    frame.data[0] = seq & LogStream::SEQ_MASK;
+    frame.data[0] |= (pos == 0) ? LogStream::FLAG_START : 0;
+    frame.data[0] |= (pos + chunk == len) ? LogStream::FLAG_END : 0;
+    for (size_t i = 0; i < chunk; i++) {
+      frame.data[1 + i] = data[pos + i];
+    }
+
+    pos += chunk;
+    seq = (seq + 1) & LogStream::SEQ_MASK;
+    return true;
+  }
+};
+
+/**
+ * @brief LogReassembler Class
+ * * Rebuilds records from a frame stream. A sequence gap discards the
+ * record in progress and counts it as lost; reception resumes at the next
+ * START frame.
+ */
+template <size_t MaxRecord>
+class LogReassembler {
+ private:
+  std::array<uint8_t, MaxRecord> buf;
+  size_t len = 0;
+  bool active = false;
+  bool synced = false;
+  uint8_t expected_seq = 0;
+  uint32_t lost = 0;
+  uint32_t gaps = 0;
+
+  void discard() {
+    if (active) {
+      lost++;
+    }
+    active = false;
+    len = 0;
+  }
+
+ public:
+  enum class Result { Pending, Complete, Discarded };
+
+  Result feed(const struct can_frame& frame) {
+    if (frame.dlc < 1) {
+      return Result::Discarded;
+    }
+
+    uint8_t hdr = frame.data[0];
+    uint8_t seq = hdr & LogStream::SEQ_MASK;
+    bool gap = synced && (seq != expected_seq);
+
+    synced = true;
+    expected_seq = (seq + 1) & LogStream::SEQ_MASK;
+
+    if (gap) {
+      gaps++;
+      discard();
+    }
+
+    if (hdr & LogStream::FLAG_START) {
+      discard();
+      active = true;
+    } else if (!active) {
+      return gap ? Result::Discarded : Result::Pending;
+    }
+
+    size_t chunk = frame.dlc - 1U;
+    if (len + chunk > MaxRecord) {
+      discard();
+      return Result::Discarded;
+    }
+    for (size_t i = 0; i < chunk; i++) {
+      buf[len++] = frame.data[1 + i];
+    }
+
+    if (hdr & LogStream::FLAG_END) {
+      active = false;
+      return Result::Complete;
+    }
+    return Result::Pending;
+  }
+
+  /* Valid after feed() returned Complete, until the next feed() */
+  const uint8_t* record() const { return buf.data(); }
+  size_t record_len() const { return len; }
+
+  /* Records cut short by a gap; whole records lost between two others
+   * only show up in sequence_gaps() */
+  uint32_t lost_records() const { return lost; }
+  uint32_t sequence_gaps() const { return gaps; }
+};
@@ -0,0 +1,15 @@
+/*
+ * src/core/message_spec.hpp
+ * Static description of a periodic CAN message
+ */
+
+#pragma once
+
+#include <cstdint>  // uint8_t, uint32_t
+
+struct MessageSpec {
+  uint32_t id;
+  uint8_t dlc;
+  uint32_t period_ms;
+  uint32_t deadline_ms;  // Relative to the release time, <= period_ms
+};
@@ -0,0 +1,232 @@
+/*
+ * src/core/nm_sim.hpp
+ * Discrete-event simulation of CanNm sleep/wake across N nodes on one
+ * virtual bus
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+
+#include "can_nm.hpp"
+#include "virtual_bus.hpp"
+
+namespace NmSimConfig {
+/* Same defaults as the CONFIG_APP_CAN_NM_* options */
+constexpr NmTiming TIMING = {.msg_cycle_ms = 200,
+                             .timeout_ms = 1000,
+                             .repeat_message_ms = 1500,
+                             .wait_bus_sleep_ms = 1500};
+constexpr uint32_t SETTLE_MS = 3000;  // Everyone past RepeatMessage
+constexpr uint32_t SLEEP_GAP_MS = 1000;  // Bus-sleep time before the wake-up
+}  // namespace NmSimConfig
+
+/* Outcome of one release-everything, then wake-one-node run */
+struct NmSleepWakeReport {
+  size_t nodes;
+  bool slept;  // Every node reached BusSleep
+  bool woke;   // ... and every node came back to network mode
+  uint64_t last_release_us;
+  uint64_t first_asleep_us;
+  uint64_t all_asleep_us;
+  uint64_t wake_request_us;
+  uint64_t all_awake_us;
+  uint32_t pdus;  // NM PDUs on the bus over the whole run
+
+  /* Last release until the whole bus is asleep */
+  uint64_t sleep_entry_us() const { return all_asleep_us - last_release_us; }
+  /* Spread of the nodes' BusSleep entries */
+  uint64_t sleep_skew_us() const { return all_asleep_us - first_asleep_us; }
+  /* Local wake request until every node is in network mode */
+  uint64_t wake_latency_us() const { return all_awake_us - wake_request_us; }
+};
+
+/**
+ * @brief NmSim Class
+ * * N CanNm instances whose PDUs go through one VirtualBus, in simulated
+ * time (like RigSim). request() and release() act at the current time;
+ * run_until() jumps from event to event (a node timer or the end of a
+ * frame on the wire) and delivers every PDU to the other nodes when it
+ * leaves the bus.
+ */
+template <size_t MaxNodes>
+class NmSim {
+ private:
+  VirtualBus<MaxNodes, 1> bus;
+  std::array<CanNm, MaxNodes> nm;
+  size_t count = 0;
+  uint64_t now_ns = 0;
+  BusTransmission tx{};
+  bool on_wire = false;
+
+  void deliver() {
+    uint8_t src;
+    uint8_t cbv;
+
+    if (decode_nm_frame(tx.frame, src, cbv)) {
+      for (size_t n = 0; n < count; n++) {
+        if (n != tx.node) {
+          nm[n].on_rx(cbv, tx.end_ns / 1000);
+        }
+      }
+    }
+    bus.finish(tx);
+    on_wire = false;
+  }
+
+ public:
+  NmSim(size_t nodes, uint32_t bitrate,
+        NmTiming timing = NmSimConfig::TIMING)
+      : bus(bitrate) {
+    reset(nodes, bitrate, timing);
+  }
+
+  /**
+   * @brief Start over at t = 0 with every node asleep, in place.
+   */
+  void reset(size_t nodes, uint32_t bitrate,
+             NmTiming timing = NmSimConfig::TIMING) {
+    bus.reset();
+    for (size_t n = 0; n < MaxNodes; n++) {
+      bus.set_bitrate(n, bitrate);
+      nm[n] = CanNm(static_cast<uint8_t>(n), timing);
+    }
+    count = (nodes < MaxNodes) ? nodes : MaxNodes;
+    now_ns = 0;
+    on_wire = false;
+  }
+
+  void request(size_t n) { nm[n].network_request(now_us()); }
+  void release(size_t n) { nm[n].network_release(now_us()); }
+
+  /**
+   * @brief Advance to until_us, or to the first event after which done()
+   * returns true.
+   * * @return true if done() stopped the run
+   */
+  template <typename F>
+  bool run_until(uint64_t until_us, F&& done) {
+    const uint64_t until_ns = until_us * 1000;
+
+    while (true) {
+      if (on_wire && tx.end_ns <= now_ns) {
+        deliver();
+      }
+
+      for (size_t n = 0; n < count; n++) {
+        uint8_t cbv;
+        struct can_frame frame;
+
+        if (nm[n].poll(now_us(), cbv)) {
+          encode_nm_frame(static_cast<uint8_t>(n), cbv, frame);
+          bus.enqueue(n, frame, now_ns);  // A PDU still queued is skipped
+        }
+      }
+      if (!on_wire) {
+        on_wire = bus.start_next(now_ns, tx);
+      }
+
+      if (done()) {
+        return true;
+      }
+      if (now_ns >= until_ns) {
+        return false;
+      }
+
+      uint64_t next = until_ns;
+      for (size_t n = 0; n < count; n++) {
+        uint64_t e = nm[n].next_event_us();
+
+        if (e != UINT64_MAX && e * 1000 < next) {
+          next = e * 1000;
+        }
+      }
+      if (on_wire && tx.end_ns < next) {
+        next = tx.end_ns;
+      }
+      now_ns = (next > now_ns) ? next : now_ns + 1000;
+    }
+  }
+
+  void advance(uint64_t until_us) {
+    run_until(until_us, [] { return false; });
+  }
+
+  /**
+   * @brief Whether pred(const CanNm&) holds for every node.
+   */
+  template <typename P>
+  bool all(P&& pred) const {
+    for (size_t n = 0; n < count; n++) {
+      if (!pred(nm[n])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief The standard scenario: every node requests the bus at t = 0
+   * and releases it release_spread_ms after the previous one, starting at
+   * SETTLE_MS; SLEEP_GAP_MS after the bus is asleep, wake_node requests
+   * it again.
+   */
+  NmSleepWakeReport sleep_wake(uint32_t release_spread_ms,
+                               size_t wake_node = 0) {
+    const NmTiming& t = NmSimConfig::TIMING;
+    const uint64_t limit_us =
+        1000ULL * (t.timeout_ms + t.wait_bus_sleep_ms + 2 * t.msg_cycle_ms);
+    auto asleep = [](const CanNm& c) {
+      return c.state() == NmState::BusSleep;
+    };
+    auto awake = [](const CanNm& c) { return c.network_mode(); };
+    NmSleepWakeReport r{};
+
+    r.nodes = count;
+    for (size_t n = 0; n < count; n++) {
+      request(n);
+    }
+    for (size_t n = 0; n < count; n++) {
+      advance(1000ULL * (NmSimConfig::SETTLE_MS + n * release_spread_ms));
+      release(n);
+    }
+    r.last_release_us = now_us();
+
+    r.slept = run_until(r.last_release_us + limit_us,
+                        [&] { return all(asleep); });
+    if (!r.slept) {
+      r.pdus = bus.stats().frames;
+      return r;
+    }
+    r.first_asleep_us = UINT64_MAX;
+    for (size_t n = 0; n < count; n++) {
+      uint64_t since = nm[n].stats().state_since_us;
+
+      r.first_asleep_us = (since < r.first_asleep_us) ? since
+                                                      : r.first_asleep_us;
+      r.all_asleep_us = (since > r.all_asleep_us) ? since : r.all_asleep_us;
+    }
+
+    advance(r.all_asleep_us + 1000ULL * NmSimConfig::SLEEP_GAP_MS);
+    r.wake_request_us = now_us();
+    request(wake_node);
+    r.woke = run_until(r.wake_request_us + limit_us,
+                       [&] { return all(awake); });
+    for (size_t n = 0; n < count && r.woke; n++) {
+      uint64_t since = nm[n].stats().state_since_us;
+
+      r.all_awake_us = (since > r.all_awake_us) ? since : r.all_awake_us;
+    }
+    r.pdus = bus.stats().frames;
+    return r;
+  }
+
+  uint64_t now_us() const { return now_ns / 1000; }
+  size_t size() const { return count; }
+  const CanNm& node(size_t index) const { return nm[index]; }
+  uint32_t pdus() const { return bus.stats().frames; }
+};
@@ -0,0 +1,33 @@
+/*
+ * src/core/node_stats.hpp
+ * Pre-aggregated node health counters
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>  // uint32_t
+
+/**
+ * @brief NodeStats Struct
+ * * Event sites only do a relaxed atomic increment; readers (diagnostics,
+ * shell) take a snapshot whenever they need one. Nothing is derived on the
+ * hot path.
+ */
+struct NodeStats {
+  std::atomic<uint32_t> tx_frames{0};
+  std::atomic<uint32_t> tx_errors{0};
+  std::atomic<uint32_t> rx_frames{0};
+  std::atomic<uint32_t> rx_dropped{0};
+  std::atomic<uint32_t> deadline_misses{0};
+  std::atomic<uint32_t> bus_off_count{0};
+  std::atomic<uint32_t> log_suppressed{0};  // Hot-path log lines dropped
+
+  static void bump(std::atomic<uint32_t>& counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static uint32_t read(const std::atomic<uint32_t>& counter) {
+    return counter.load(std::memory_order_relaxed);
+  }
+};
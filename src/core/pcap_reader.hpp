@@ -0,0 +1,143 @@
+/*
+ * src/core/pcap_reader.hpp
+ * Reader for pcap captures of SocketCAN traffic (tcpdump -i can0 -w ...)
+ *
+ * Global header (24 bytes), then per packet a 16-byte record header and
+ * the captured bytes. With LINKTYPE_CAN_SOCKETCAN the packet is a Linux
+ * struct can_frame whose CAN ID word is big-endian:
+ *
+ *   can_id (4, EFF/RTR/ERR flags in bits 31..29) | len | pad | res | res |
+ *   data[0..8]
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t, uint64_t
+
+namespace Pcap {
+constexpr uint32_t MAGIC_US = 0xA1B2C3D4;
+constexpr uint32_t MAGIC_NS = 0xA1B23C4D;
+constexpr uint32_t LINKTYPE_CAN_SOCKETCAN = 227;
+constexpr size_t GLOBAL_HEADER_SIZE = 24;
+constexpr size_t RECORD_HEADER_SIZE = 16;
+constexpr size_t CAN_HEADER_SIZE = 8;  // can_id, len, pad, res0, res1
+
+constexpr uint32_t CAN_EFF_FLAG = 0x80000000U;
+constexpr uint32_t CAN_RTR_FLAG = 0x40000000U;
+constexpr uint32_t CAN_ERR_FLAG = 0x20000000U;
+
+constexpr uint32_t load_le32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+
+constexpr uint32_t load_be32(const uint8_t* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) |
+         p[3];
+}
+
+constexpr uint32_t swap32(uint32_t v) {
+  return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+}  // namespace Pcap
+
+/**
+ * @brief PcapReader Class
+ * * Walks a SocketCAN pcap capture held in memory (typically mmap()ed),
+ * in either byte order and with micro- or nanosecond timestamps. Error
+ * frames, CAN FD frames and truncated records are skipped and counted;
+ * a truncated last record ends the capture.
+ */
+class PcapReader {
+ private:
+  const uint8_t* data;
+  size_t size;
+  size_t pos = Pcap::GLOBAL_HEADER_SIZE;
+  bool swapped = false;
+  bool nanos = false;
+  bool ok = false;
+  uint32_t skipped_records = 0;
+
+  constexpr uint32_t u32(size_t offset) const {
+    uint32_t v = Pcap::load_le32(data + offset);
+    return swapped ? Pcap::swap32(v) : v;
+  }
+
+ public:
+  constexpr PcapReader(const uint8_t* capture, size_t length)
+      : data(capture), size(length) {
+    if (size < Pcap::GLOBAL_HEADER_SIZE) {
+      return;
+    }
+
+    uint32_t magic = Pcap::load_le32(data);
+    if (magic == Pcap::swap32(Pcap::MAGIC_US) ||
+        magic == Pcap::swap32(Pcap::MAGIC_NS)) {
+      swapped = true;
+      magic = Pcap::swap32(magic);
+    }
+    nanos = (magic == Pcap::MAGIC_NS);
+    ok = (magic == Pcap::MAGIC_US || magic == Pcap::MAGIC_NS) &&
+         (u32(20) & 0x0FFFFFFF) == Pcap::LINKTYPE_CAN_SOCKETCAN;
+  }
+
+  /**
+   * @brief True if the buffer starts with a SocketCAN pcap header.
+   */
+  constexpr bool valid() const { return ok; }
+
+  constexpr bool next(uint64_t& timestamp_us, struct can_frame& frame) {
+    using namespace Pcap;
+
+    while (ok && pos + RECORD_HEADER_SIZE <= size) {
+      uint64_t sec = u32(pos);
+      uint32_t frac = u32(pos + 4);
+      size_t caplen = u32(pos + 8);
+      const uint8_t* pkt = data + pos + RECORD_HEADER_SIZE;
+
+      if (caplen > size - pos - RECORD_HEADER_SIZE) {
+        skipped_records++;
+        pos = size;
+        break;
+      }
+      pos += RECORD_HEADER_SIZE + caplen;
+
+      if (caplen < CAN_HEADER_SIZE) {
+        skipped_records++;
+        continue;
+      }
+
+      uint32_t can_id = load_be32(pkt);
+      uint8_t len = pkt[4];
+      if ((can_id & CAN_ERR_FLAG) != 0 || len > CAN_MAX_DLEN ||
+          caplen < CAN_HEADER_SIZE + len) {
+        skipped_records++;
+        continue;
+      }
+
+      frame = {};
+      if ((can_id & CAN_EFF_FLAG) != 0) {
+        frame.id = can_id & CAN_EXT_ID_MASK;
+        frame.flags |= CAN_FRAME_IDE;
+      } else {
+        frame.id = can_id & CAN_STD_ID_MASK;
+      }
+      if ((can_id & CAN_RTR_FLAG) != 0) {
+        frame.flags |= CAN_FRAME_RTR;
+      }
+      frame.dlc = len;
+      for (uint8_t i = 0; i < len; i++) {
+        frame.data[i] = pkt[CAN_HEADER_SIZE + i];
+      }
+
+      timestamp_us = sec * 1000000ULL + (nanos ? frac / 1000 : frac);
+      return true;
+    }
+    return false;
+  }
+
+  constexpr uint32_t skipped() const { return skipped_records; }
+};
@@ -0,0 +1,243 @@
+/*
+ * src/core/redundancy.hpp
+ * Redundant transmission of critical frames on two buses
+ *
+ * The sender appends a one-byte alive counter to each critical frame and
+ * sends the same frame on every bus in service; the receiver keeps the
+ * first copy of each counter value and drops the rest. The counter is the
+ * outermost layer, after any SecOC authenticator, so a duplicate is
+ * dropped before it could look like a replay. A receiver only commits a
+ * counter once the frame passed its checks, so a forged counter cannot
+ * shadow the genuine frame. An old counter is taken as a restarted sender
+ * only once no counter has been accepted for the restart time: a copy on
+ * a lagging bus follows its first copy sooner, however long its backlog.
+ *
+ * BusFailover takes a bus out of service on an error state change or on
+ * consecutive TX errors, so the TX path stops waiting on a dead
+ * controller, and puts it back once it has behaved for a recovery time.
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t, int64_t
+
+namespace Redundancy {
+constexpr uint8_t ALIVE_BYTES = 1;
+
+/* @return false if the frame is already full */
+inline bool append_alive(struct can_frame& frame, uint8_t alive) {
+  if (frame.dlc >= 8) {
+    return false;
+  }
+  frame.data[frame.dlc++] = alive;
+  return true;
+}
+
+/* @return false if the frame is too short to carry a counter */
+inline bool strip_alive(struct can_frame& frame, uint8_t& alive) {
+  if (frame.dlc < ALIVE_BYTES || frame.dlc > 8) {
+    return false;
+  }
+  alive = frame.data[--frame.dlc];
+  frame.data[frame.dlc] = 0;
+  return true;
+}
+}  // namespace Redundancy
+
+enum class AliveVerdict : uint8_t {
+  New,        // Not seen yet: process, then accept()
+  Duplicate,  // Same counter as the last accepted copy
+  Stale,      // Older than the last accepted copy (the slower bus)
+};
+
+/**
+ * @brief AliveFilter Class
+ * * Receiver-side duplicate filter for one message. Counters up to half
+ * the range ahead of the last accepted one are new; the rest are older
+ * copies. An older counter that comes restart_us or more after the last
+ * accepted one is taken as a restarted sender and is new. The restart
+ * time must be longer than a copy can lag behind the other bus's copy.
+ * * Times are in microseconds.
+ */
+class AliveFilter {
+ public:
+  explicit AliveFilter(int64_t restart_us) : restart_us_(restart_us) {}
+
+  AliveVerdict check(uint8_t alive, int64_t now_us) {
+    if (!synced_) {
+      return AliveVerdict::New;
+    }
+
+    uint8_t ahead = static_cast<uint8_t>(alive - last_);
+
+    if (ahead == 0) {
+      duplicates_++;
+      return AliveVerdict::Duplicate;
+    }
+    if (ahead < 0x80) {
+      return AliveVerdict::New;
+    }
+    if (now_us - accepted_us_ >= restart_us_) {
+      resyncs_++;
+      return AliveVerdict::New;
+    }
+    stale_++;
+    return AliveVerdict::Stale;
+  }
+
+  /* The copy passed every check: later copies of it are duplicates */
+  void accept(uint8_t alive, int64_t now_us) {
+    if (synced_) {
+      uint8_t ahead = static_cast<uint8_t>(alive - last_);
+
+      lost_ += (ahead > 1 && ahead < 0x80) ? ahead - 1U : 0U;
+    }
+    last_ = alive;
+    synced_ = true;
+    accepted_us_ = now_us;
+    accepted_++;
+  }
+
+  uint32_t accepted() const { return accepted_; }
+  uint32_t duplicates() const { return duplicates_; }
+  uint32_t stale() const { return stale_; }
+  uint32_t resyncs() const { return resyncs_; }
+  uint32_t lost() const { return lost_; }  // Counters missing on every bus
+
+ private:
+  int64_t restart_us_;
+  int64_t accepted_us_ = 0;
+  uint8_t last_ = 0;
+  bool synced_ = false;
+  uint32_t accepted_ = 0;
+  uint32_t duplicates_ = 0;
+  uint32_t stale_ = 0;
+  uint32_t resyncs_ = 0;
+  uint32_t lost_ = 0;
+};
+
+/**
+ * @brief BusFailover Class
+ * * Which of N buses carry critical frames. A bus leaves service on an
+ * error-passive or bus-off report, or after fail_after TX errors in a
+ * row; it returns once its last reported state is fine and it has gone
+ * recover_us without a fault, counted from the later of its last TX error
+ * and the state turning fine. The last bus in service never leaves it:
+ * sending on a sick bus beats sending on none.
+ * * Times are in microseconds. Not thread-safe; the caller serializes.
+ */
+template <size_t N = 2>
+class BusFailover {
+  static_assert(N >= 2 && N <= 32);
+
+ public:
+  BusFailover(uint32_t fail_after, int64_t recover_us)
+      : fail_after_(fail_after), recover_us_(recover_us) {}
+
+  /**
+   * @brief Result of one can_send() on bus.
+   * * @return true if bus just left service
+   */
+  bool note_tx(size_t bus, bool ok, int64_t now_us) {
+    Bus& b = buses_[bus];
+
+    if (ok) {
+      b.errors = 0;
+      return false;
+    }
+    if (b.errors++ == 0) {
+      b.first_fault_us = now_us;
+    }
+    b.last_fault_us = now_us;
+    return (b.errors >= fail_after_) ? take_out(bus, now_us) : false;
+  }
+
+  /**
+   * @brief Controller state change.
+   * * state_ok is false for error-passive, bus-off and stopped.
+   * * @return true if bus just left service
+   */
+  bool note_state(size_t bus, bool state_ok, int64_t now_us) {
+    Bus& b = buses_[bus];
+
+    if (state_ok) {
+      if (!b.state_ok) {
+        b.last_fault_us = now_us;  // The quiet time starts now
+      }
+      b.state_ok = true;
+      return false;
+    }
+    b.state_ok = false;
+    if (b.errors == 0) {
+      b.first_fault_us = now_us;
+    }
+    b.last_fault_us = now_us;
+    return take_out(bus, now_us);
+  }
+
+  /**
+   * @brief Return recovered buses to service.
+   * * @return Number of buses that came back
+   */
+  size_t poll(int64_t now_us) {
+    size_t back = 0;
+
+    for (size_t bus = 0; bus < N; bus++) {
+      Bus& b = buses_[bus];
+
+      if ((mask_ & (1U << bus)) == 0 && b.state_ok &&
+          now_us - b.last_fault_us >= recover_us_) {
+        mask_ |= 1U << bus;
+        b.errors = 0;
+        recoveries_++;
+        back++;
+      }
+    }
+    return back;
+  }
+
+  bool in_service(size_t bus) const { return (mask_ & (1U << bus)) != 0; }
+  uint32_t mask() const { return mask_; }
+  uint32_t failovers() const { return failovers_; }
+  uint32_t recoveries() const { return recoveries_; }
+
+  /* First fault to out of service, for the last failover */
+  int64_t last_failover_us() const { return last_failover_us_; }
+  int64_t max_failover_us() const { return max_failover_us_; }
+
+ private:
+  struct Bus {
+    uint32_t errors = 0;  // TX errors in a row
+    bool state_ok = true;
+    int64_t first_fault_us = 0;
+    int64_t last_fault_us = 0;
+  };
+
+  std::array<Bus, N> buses_{};
+  uint32_t fail_after_;
+  int64_t recover_us_;
+  uint32_t mask_ = (N == 32) ? 0xFFFFFFFFU : (1U << N) - 1;
+  uint32_t failovers_ = 0;
+  uint32_t recoveries_ = 0;
+  int64_t last_failover_us_ = 0;
+  int64_t max_failover_us_ = 0;
+
+  bool take_out(size_t bus, int64_t now_us) {
+    uint32_t bit = 1U << bus;
+
+    if ((mask_ & bit) == 0 || mask_ == bit) {
+      return false;  // Already out, or the last one left
+    }
+    mask_ &= ~bit;
+    failovers_++;
+    last_failover_us_ = now_us - buses_[bus].first_fault_us;
+    max_failover_us_ = (last_failover_us_ > max_failover_us_)
+                           ? last_failover_us_
+                           : max_failover_us_;
+    return true;
+  }
+};
@@ -0,0 +1,287 @@
+/*
+ * src/core/rig_sim.hpp
+ * Discrete-event simulation of a whole rig (N nodes) on one virtual bus
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+#include <utility>  // std::index_sequence
+
+#include "message_spec.hpp"
+#include "scheduler.hpp"
+#include "virtual_bus.hpp"
+
+enum class RigNodeKind : uint8_t { Base, Pedals, Wheel };
+
+/* What one kind of node sends and listens to */
+struct RigNodeProfile {
+  const char* name;
+  std::array<MessageSpec, 2> tx;  // IDs are offset by the node index
+  std::array<struct can_filter, 2> rx;
+  uint8_t rx_count;
+};
+
+namespace RigSimConfig {
+constexpr size_t TX_MAILBOXES = 3;
+constexpr uint32_t ID_MASK = 0x7E0;  // Matches a kind's 32 node IDs
+
+constexpr struct can_filter kind_filter(uint32_t id) {
+  return {.id = id, .mask = ID_MASK, .flags = 0};
+}
+
+constexpr std::array<RigNodeProfile, 3> PROFILES = {{
+    {.name = "base",
+     .tx = {{{.id = 0x040, .dlc = 8, .period_ms = 2, .deadline_ms = 2},
+             {.id = 0x6F0, .dlc = 8, .period_ms = 1000, .deadline_ms = 100}}},
+     .rx = {{kind_filter(0x080), kind_filter(0x100)}},
+     .rx_count = 2},
+    {.name = "pedals",
+     .tx = {{{.id = 0x080, .dlc = 6, .period_ms = 2, .deadline_ms = 2},
+             {.id = 0x6F0, .dlc = 8, .period_ms = 1000, .deadline_ms = 100}}},
+     .rx = {{kind_filter(0x040)}},
+     .rx_count = 1},
+    {.name = "wheel",
+     .tx = {{{.id = 0x100, .dlc = 2, .period_ms = 10, .deadline_ms = 10},
+             {.id = 0x6F0, .dlc = 8, .period_ms = 1000, .deadline_ms = 100}}},
+     .rx = {{kind_filter(0x040)}},
+     .rx_count = 1},
+}};
+}  // namespace RigSimConfig
+
+/**
+ * @brief Kind of the node at an index: base, pedals, wheel, base, ...
+ */
+constexpr RigNodeKind rig_node_kind(size_t index) {
+  return static_cast<RigNodeKind>(index % RigSimConfig::PROFILES.size());
+}
+
+constexpr const RigNodeProfile& rig_node_profile(RigNodeKind kind) {
+  return RigSimConfig::PROFILES[static_cast<size_t>(kind)];
+}
+
+struct RigNodeStats {
+  uint32_t sent;
+  uint32_t dropped;  // Released while every TX mailbox was full
+  uint32_t unsent;   // Still in a mailbox when the run ended
+  uint32_t received;
+  uint32_t deadline_misses;  // Late, dropped, or unsent past the deadline
+  uint64_t latency_sum_ns;   // Release to end of frame, sent frames only
+  uint64_t max_latency_ns;   // Dropped and unsent frames count at their age
+  uint64_t first_drop_ns;
+};
+
+struct RigReport {
+  size_t nodes;
+  uint64_t duration_ns;
+  uint64_t busy_ns;
+  uint32_t frames;
+  uint32_t dropped;
+  uint32_t unsent;
+  uint32_t deadline_misses;  // Includes dropped and overdue unsent frames
+  uint64_t max_latency_ns;
+
+  uint32_t load_permille() const {
+    return (duration_ns != 0)
+               ? static_cast<uint32_t>(busy_ns * 1000 / duration_ns)
+               : 0;
+  }
+};
+
+/**
+ * @brief RigSim Class
+ * * Runs N rig nodes against one VirtualBus in simulated time. Every node
+ * releases its message table through its own PeriodicScheduler, the one
+ * the wheel's TX thread uses, puts the frame in one of its TX mailboxes and
+ * counts the frames its filters accept. Time jumps from event to event (a
+ * release or the end of the frame on the wire), so a 10 s run with 32
+ * nodes takes milliseconds and gives the same result every time. All nodes
+ * release at t = 0, the critical instant, so the latencies are worst-case
+ * for the table. A frame that never made it onto the bus, dropped or still
+ * queued at the end, counts at its age then, so an overloaded bus cannot
+ * look faster.
+ */
+template <size_t MaxNodes>
+class RigSim {
+ private:
+  static constexpr size_t MESSAGES = 2;
+  static constexpr size_t MAILBOXES = RigSimConfig::TX_MAILBOXES;
+
+  using Scheduler = PeriodicScheduler<MESSAGES>;
+
+  VirtualBus<MaxNodes, MAILBOXES> bus;
+  size_t count;
+  std::array<Scheduler, MaxNodes> schedulers;
+  std::array<std::array<uint64_t, MAILBOXES>, MaxNodes> deadline_ns{};
+  std::array<uint32_t, MaxNodes> seq{};
+  std::array<RigNodeStats, MaxNodes> stats{};
+
+  static constexpr uint64_t ms_to_ns(int64_t ms) {
+    return static_cast<uint64_t>(ms) * 1000000ULL;
+  }
+
+  template <size_t... I>
+  static std::array<Scheduler, MaxNodes> make_schedulers(
+      std::index_sequence<I...>) {
+    return {{Scheduler(rig_node_profile(rig_node_kind(I)).tx)...}};
+  }
+
+  void note_latency(RigNodeStats& s, uint64_t latency) {
+    if (latency > s.max_latency_ns) {
+      s.max_latency_ns = latency;
+    }
+  }
+
+  void release(size_t n, const MessageSpec& spec, uint64_t now_ns) {
+    struct can_frame frame = {};
+
+    frame.id = spec.id + static_cast<uint32_t>(n);
+    frame.dlc = spec.dlc;
+    for (uint8_t i = 0; i < spec.dlc; i++) {
+      frame.data[i] = static_cast<uint8_t>((seq[n] >> (8 * (i % 4))) + n);
+    }
+    seq[n]++;
+
+    int mb = bus.enqueue(n, frame, now_ns);
+    if (mb < 0) {
+      if (stats[n].dropped++ == 0) {
+        stats[n].first_drop_ns = now_ns;
+      }
+      stats[n].deadline_misses++;
+      return;
+    }
+    deadline_ns[n][mb] = ms_to_ns(spec.deadline_ms);
+  }
+
+  void complete(const BusTransmission& tx) {
+    RigNodeStats& s = stats[tx.node];
+    uint64_t latency = tx.end_ns - tx.queued_ns;
+
+    s.sent++;
+    s.latency_sum_ns += latency;
+    note_latency(s, latency);
+    if (latency > deadline_ns[tx.node][tx.mailbox]) {
+      s.deadline_misses++;
+    }
+
+    for (size_t n = 0; n < count; n++) {
+      if (n == tx.node) {
+        continue;
+      }
+      const RigNodeProfile& profile = rig_node_profile(rig_node_kind(n));
+
+      for (uint8_t i = 0; i < profile.rx_count; i++) {
+        const struct can_filter& f = profile.rx[i];
+
+        if (((tx.frame.id ^ f.id) & f.mask) == 0) {
+          stats[n].received++;
+          break;
+        }
+      }
+    }
+    bus.finish(tx);
+  }
+
+ public:
+  RigSim(size_t nodes, uint32_t bitrate)
+      : bus(bitrate),
+        count((nodes < MaxNodes) ? nodes : MaxNodes),
+        schedulers(make_schedulers(std::make_index_sequence<MaxNodes>())) {}
+
+  /**
+   * @brief Start over with another node count and bitrate, in place.
+   */
+  void reset(size_t nodes, uint32_t bitrate) {
+    bus.reset();
+    for (size_t n = 0; n < MaxNodes; n++) {
+      bus.set_bitrate(n, bitrate);
+    }
+    count = (nodes < MaxNodes) ? nodes : MaxNodes;
+    for (size_t n = 0; n < MaxNodes; n++) {
+      schedulers[n] = Scheduler(rig_node_profile(rig_node_kind(n)).tx);
+    }
+    seq.fill(0);
+    stats.fill({});
+  }
+
+  size_t size() const { return count; }
+
+  /**
+   * @brief Simulate duration_ms of bus time from a cold start.
+   * * Call once per instance or reset(). Frames still queued or on the
+   * wire at the end count at their age then; a dropped frame counts at the
+   * age of the node's first drop.
+   */
+  RigReport run(uint32_t duration_ms) {
+    const uint64_t end_ns = ms_to_ns(duration_ms);
+    BusTransmission tx{};
+    bool on_wire = false;
+    uint64_t now = 0;
+
+    while (now < end_ns) {
+      if (on_wire && tx.end_ns <= now) {
+        complete(tx);
+        on_wire = false;
+      }
+
+      /* Releases fall on whole ms, and time always stops at the next one */
+      uint64_t next = end_ns;
+      for (size_t n = 0; n < count; n++) {
+        schedulers[n].poll(static_cast<int64_t>(now / 1000000ULL),
+                           [&](const MessageSpec& spec) {
+                             release(n, spec, now);
+                           });
+
+        uint64_t due = ms_to_ns(schedulers[n].next_due_ms());
+        next = (due < next) ? due : next;
+      }
+
+      if (!on_wire) {
+        on_wire = bus.start_next(now, tx);
+      }
+      if (on_wire && tx.end_ns < next) {
+        next = tx.end_ns;
+      }
+      now = next;
+    }
+
+    RigReport report{};
+
+    report.nodes = count;
+    report.duration_ns = end_ns;
+    report.busy_ns = bus.stats().busy_ns;
+    report.frames = bus.stats().frames;
+    for (size_t n = 0; n < count; n++) {
+      RigNodeStats& s = stats[n];
+
+      bus.for_each_pending(n, [&](size_t mb, uint64_t queued_ns) {
+        uint64_t age = end_ns - queued_ns;
+
+        s.unsent++;
+        note_latency(s, age);
+        s.deadline_misses += (age > deadline_ns[n][mb]) ? 1 : 0;
+      });
+      if (s.dropped != 0) {
+        note_latency(s, end_ns - s.first_drop_ns);
+      }
+
+      report.dropped += stats[n].dropped;
+      report.unsent += stats[n].unsent;
+      report.deadline_misses += stats[n].deadline_misses;
+      if (stats[n].max_latency_ns > report.max_latency_ns) {
+        report.max_latency_ns = stats[n].max_latency_ns;
+      }
+    }
+    return report;
+  }
+
+  const RigNodeStats& node(size_t index) const { return stats[index]; }
+
+  uint32_t arbitration_losses(size_t index) const {
+    return bus.arbitration_losses(index);
+  }
+};
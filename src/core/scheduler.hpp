@@ -0,0 +1,95 @@
+/*
+ * src/core/scheduler.hpp
+ * Drift-free periodic scheduler for a fixed message table
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // int64_t, uint32_t
+
+#include "message_spec.hpp"
+
+/**
+ * @brief PeriodicScheduler Class
+ * * Tracks the next release time of every message in a fixed table.
+ * Release times advance by whole periods from the start time, so jitter of
+ * the calling thread never accumulates into drift. Every period that was
+ * skipped entirely counts as a miss, and so does the release that is
+ * serviced if it is later than its deadline.
+ */
+template <size_t N>
+class PeriodicScheduler {
+ private:
+  const std::array<MessageSpec, N>* table;
+  std::array<int64_t, N> due_ms;
+  uint32_t misses;
+
+ public:
+  constexpr PeriodicScheduler(const std::array<MessageSpec, N>& messages,
+                              int64_t start_ms = 0)
+      : table(&messages), due_ms{}, misses(0) {
+    for (auto& due : due_ms) {
+      due = start_ms;
+    }
+  }
+
+  /**
+   * @brief Invoke on_due(spec) for every message released at or before now.
+   * * @return Number of messages serviced
+   */
+  template <typename F>
+  size_t poll(int64_t now_ms, F&& on_due) {
+    size_t serviced = 0;
+
+    for (size_t i = 0; i < N; i++) {
+      if (now_ms < due_ms[i]) {
+        continue;
+      }
+
+      const MessageSpec& spec = (*table)[i];
+      int64_t late_ms = now_ms - due_ms[i];
+
+      /* Skip whole periods that are already over, then service the
+       * latest release, which is late_ms % period_ms late */
+      int64_t skipped = late_ms / spec.period_ms;
+      misses += static_cast<uint32_t>(skipped);
+      if (late_ms % spec.period_ms > spec.deadline_ms) {
+        misses++;
+      }
+      due_ms[i] += (skipped + 1) * spec.period_ms;
+
+      on_due(spec);
+      serviced++;
+    }
+
+    return serviced;
+  }
+
+  /**
+   * @brief Earliest upcoming release time (absolute, in ms).
+   */
+  int64_t next_due_ms() const {
+    int64_t next = due_ms[0];
+
+    for (size_t i = 1; i < N; i++) {
+      next = (due_ms[i] < next) ? due_ms[i] : next;
+    }
+    return next;
+  }
+
+  /**
+   * @brief Continue with another table of the same size.
+   * * Every message of the new table is released at start_ms, periods run
+   * from there; deadline misses so far are kept.
+   */
+  void rebind(const std::array<MessageSpec, N>& messages, int64_t start_ms) {
+    table = &messages;
+    for (auto& due : due_ms) {
+      due = start_ms;
+    }
+  }
+
+  uint32_t deadline_misses() const { return misses; }
+};
@@ -0,0 +1,295 @@
+/*
+ * src/core/secoc.hpp
+ * SecOC-style frame authentication: truncated freshness and CMAC
+ *
+ * Secured frame: payload | FV (low SECOC_FRESHNESS_BYTES of the 64-bit
+ * freshness value) | MAC (first SECOC_MAC_BYTES of the CMAC)
+ * MAC input:     data ID (CAN ID, 2 bytes) | payload | full FV (8 bytes),
+ * all big-endian, so a CAN frame's MAC costs one AES block.
+ * Sync frame:    low SECOC_SYNC_FV_BYTES of the full FV | MAC, where the
+ * MAC covers the sync ID and the full FV with an empty payload.
+ * FV request:    SECOC_NONCE_BYTES nonce, not authenticated.
+ * FV answer:     the receiver's FV like a sync frame, with the request's
+ * nonce as the MAC payload, so it only answers that one request.
+ *
+ * A receiver's FV never goes back: a sync frame can only move it forward.
+ * A sender that lost its FV asks a receiver for its FV instead of starting
+ * over, so FVs the receiver has accepted are never valid again.
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint64_t
+
+#include "app_config.hpp"
+#include "cmac.hpp"
+
+namespace secoc_detail {
+constexpr size_t AUTH_BYTES =
+    Config::SECOC_FRESHNESS_BYTES + Config::SECOC_MAC_BYTES;
+constexpr size_t MAX_PAYLOAD = CAN_MAX_DLEN - AUTH_BYTES;
+constexpr uint64_t FV_MASK = (1ULL << (8 * Config::SECOC_FRESHNESS_BYTES)) - 1;
+
+using AuthData = std::array<uint8_t, 2 + MAX_PAYLOAD + 8>;
+
+inline size_t auth_data(uint32_t id, const uint8_t* payload, size_t len,
+                        uint64_t fv, AuthData& out) {
+  size_t n = 0;
+
+  out[n++] = static_cast<uint8_t>(id >> 8);
+  out[n++] = static_cast<uint8_t>(id);
+  for (size_t i = 0; i < len; i++) {
+    out[n++] = payload[i];
+  }
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    out[n++] = static_cast<uint8_t>(fv >> shift);
+  }
+  return n;
+}
+}  // namespace secoc_detail
+
+/* Bytes a secured frame carries on top of its payload */
+constexpr size_t SECOC_AUTH_BYTES = secoc_detail::AUTH_BYTES;
+
+/* A sync frame: the FV in 40 bits (3.5 centuries of 100 Hz frames) */
+constexpr uint8_t SECOC_SYNC_DLC =
+    Config::SECOC_SYNC_FV_BYTES + Config::SECOC_MAC_BYTES;
+static_assert(SECOC_SYNC_DLC <= CAN_MAX_DLEN);
+
+constexpr uint8_t SECOC_NONCE_BYTES = 4;
+
+namespace secoc_detail {
+/* Sync frame or FV answer: FV | MAC over id | payload | FV */
+inline void sign_fv(const Cmac& cmac, uint32_t id, const uint8_t* payload,
+                    size_t len, uint64_t fv, struct can_frame& frame) {
+  AuthData data;
+  std::array<uint8_t, Cmac::MAC_SIZE> mac;
+
+  frame = {};
+  frame.id = id;
+  frame.dlc = SECOC_SYNC_DLC;
+  for (size_t i = 0; i < Config::SECOC_SYNC_FV_BYTES; i++) {
+    frame.data[i] = static_cast<uint8_t>(
+        fv >> (8 * (Config::SECOC_SYNC_FV_BYTES - 1 - i)));
+  }
+
+  size_t n = auth_data(id, payload, len, fv, data);
+  cmac.compute(data.data(), n, mac.data());
+  for (size_t i = 0; i < Config::SECOC_MAC_BYTES; i++) {
+    frame.data[Config::SECOC_SYNC_FV_BYTES + i] = mac[i];
+  }
+}
+
+/* @return false if frame is not a sync or answer signed over payload */
+inline bool signed_fv(const Cmac& cmac, const struct can_frame& frame,
+                      const uint8_t* payload, size_t len, uint64_t& fv) {
+  AuthData data;
+
+  if (frame.dlc < SECOC_SYNC_DLC) {
+    return false;
+  }
+  fv = 0;
+  for (size_t i = 0; i < Config::SECOC_SYNC_FV_BYTES; i++) {
+    fv = (fv << 8) | frame.data[i];
+  }
+
+  size_t n = auth_data(frame.id, payload, len, fv, data);
+  return cmac.verify(data.data(), n, &frame.data[Config::SECOC_SYNC_FV_BYTES],
+                     Config::SECOC_MAC_BYTES);
+}
+
+inline void nonce_bytes(uint32_t nonce, uint8_t* out) {
+  for (size_t i = 0; i < SECOC_NONCE_BYTES; i++) {
+    out[i] = static_cast<uint8_t>(nonce >> (8 * (SECOC_NONCE_BYTES - 1 - i)));
+  }
+}
+}  // namespace secoc_detail
+
+/**
+ * @brief SecOcSender Class
+ * * Freshness counter of one sender. protect() appends the truncated FV
+ * and MAC to a frame that holds only its payload.
+ */
+class SecOcSender {
+ private:
+  uint64_t freshness = 0;
+
+ public:
+  /**
+   * @return false if payload and authenticator do not fit in 8 bytes; the
+   * frame is left as it was and the counter does not advance
+   */
+  bool protect(const Cmac& cmac, struct can_frame& frame) {
+    using namespace secoc_detail;
+    AuthData data;
+    std::array<uint8_t, Cmac::MAC_SIZE> mac;
+
+    if (frame.dlc > MAX_PAYLOAD) {
+      return false;
+    }
+
+    uint64_t fv = ++freshness;
+    size_t len = auth_data(frame.id, frame.data, frame.dlc, fv, data);
+    cmac.compute(data.data(), len, mac.data());
+
+    uint8_t* auth = &frame.data[frame.dlc];
+    for (size_t i = 0; i < Config::SECOC_FRESHNESS_BYTES; i++) {
+      auth[i] = static_cast<uint8_t>(
+          fv >> (8 * (Config::SECOC_FRESHNESS_BYTES - 1 - i)));
+    }
+    for (size_t i = 0; i < Config::SECOC_MAC_BYTES; i++) {
+      auth[Config::SECOC_FRESHNESS_BYTES + i] = mac[i];
+    }
+    frame.dlc += AUTH_BYTES;
+    return true;
+  }
+
+  /**
+   * @brief Continue after fv, e.g. kept across a warm reset or taken from
+   * an FV answer. Never goes back, so no FV is ever used twice.
+   */
+  void restore(uint64_t fv) { freshness = (fv > freshness) ? fv : freshness; }
+
+  /**
+   * @brief Build the sync frame announcing the last FV used.
+   */
+  void sync_frame(const Cmac& cmac, uint32_t id,
+                  struct can_frame& frame) const {
+    secoc_detail::sign_fv(cmac, id, nullptr, 0, freshness, frame);
+  }
+
+  /**
+   * @brief Build a request for a receiver's FV, answered for nonce only.
+   */
+  static void fv_request(uint32_t id, uint32_t nonce,
+                         struct can_frame& frame) {
+    frame = {};
+    frame.id = id;
+    frame.dlc = SECOC_NONCE_BYTES;
+    secoc_detail::nonce_bytes(nonce, frame.data);
+  }
+
+  /**
+   * @brief Check the answer to the request made with nonce.
+   * * @return false if it is forged or answers another request; fv is then
+   * not to be used
+   */
+  static bool fv_answer(const Cmac& cmac, uint32_t nonce,
+                        const struct can_frame& frame, uint64_t& fv) {
+    uint8_t payload[SECOC_NONCE_BYTES];
+
+    secoc_detail::nonce_bytes(nonce, payload);
+    return secoc_detail::signed_fv(cmac, frame, payload, sizeof(payload), fv);
+  }
+
+  uint64_t freshness_value() const { return freshness; }
+};
+
+enum class SecOcVerdict : uint8_t {
+  Ok,
+  TooShort,  // No room for an authenticator
+  BadMac,    // Forged, tampered, replayed or too far out of sync
+  Behind,    // Authentic sync older than the FV: replayed or stale
+};
+
+/**
+ * @brief SecOcReceiver Class
+ * * Last accepted freshness value of one sender. The full FV is rebuilt
+ * from its truncated bits the way AUTOSAR does: larger low bits keep the
+ * upper part, smaller or equal ones carry into it. A replayed frame is
+ * therefore checked against a newer FV and fails the MAC; so does one
+ * arriving after 2^(8 * SECOC_FRESHNESS_BYTES) or more frames were lost,
+ * or after the receiver restarted, until the sender's next sync frame.
+ * sync() only moves the FV forward, so a replayed old sync changes
+ * nothing. A sender that lost its FV asks for it with an FV request.
+ */
+class SecOcReceiver {
+ private:
+  uint64_t last = 0;
+  uint32_t resyncs = 0;
+
+ public:
+  /**
+   * @brief Authenticate frame and strip its authenticator.
+   * * On success frame.dlc is the payload length again, so the usual
+   * decoders apply. A rejected frame is left as it was.
+   */
+  SecOcVerdict verify(const Cmac& cmac, struct can_frame& frame) {
+    using namespace secoc_detail;
+    AuthData data;
+
+    if (frame.dlc < AUTH_BYTES) {
+      return SecOcVerdict::TooShort;
+    }
+
+    size_t payload = frame.dlc - AUTH_BYTES;
+    const uint8_t* auth = &frame.data[payload];
+    uint64_t received = 0;
+
+    for (size_t i = 0; i < Config::SECOC_FRESHNESS_BYTES; i++) {
+      received = (received << 8) | auth[i];
+    }
+
+    uint64_t fv = (last & ~FV_MASK) | received;
+    if (received <= (last & FV_MASK)) {
+      fv += FV_MASK + 1;
+    }
+
+    size_t len = auth_data(frame.id, frame.data, payload, fv, data);
+    if (!cmac.verify(data.data(), len, auth + Config::SECOC_FRESHNESS_BYTES,
+                     Config::SECOC_MAC_BYTES)) {
+      return SecOcVerdict::BadMac;
+    }
+
+    last = fv;
+    for (size_t i = payload; i < frame.dlc; i++) {
+      frame.data[i] = 0;
+    }
+    frame.dlc = static_cast<uint8_t>(payload);
+    return SecOcVerdict::Ok;
+  }
+
+  /**
+   * @brief Move the FV forward to an authentic sync frame.
+   * * @return Ok if the FV now matches the sender's
+   */
+  SecOcVerdict sync(const Cmac& cmac, const struct can_frame& frame) {
+    uint64_t fv;
+
+    if (frame.dlc < SECOC_SYNC_DLC) {
+      return SecOcVerdict::TooShort;
+    }
+    if (!secoc_detail::signed_fv(cmac, frame, nullptr, 0, fv)) {
+      return SecOcVerdict::BadMac;
+    }
+    if (fv < last) {
+      return SecOcVerdict::Behind;
+    }
+
+    resyncs += (fv != last) ? 1 : 0;
+    last = fv;
+    return SecOcVerdict::Ok;
+  }
+
+  /**
+   * @brief Answer an FV request with the last accepted FV.
+   * * @return false if request carries no nonce
+   */
+  bool fv_answer(const Cmac& cmac, uint32_t id,
+                 const struct can_frame& request,
+                 struct can_frame& answer) const {
+    if (request.dlc < SECOC_NONCE_BYTES) {
+      return false;
+    }
+    secoc_detail::sign_fv(cmac, id, request.data, SECOC_NONCE_BYTES, last,
+                          answer);
+    return true;
+  }
+
+  uint64_t freshness_value() const { return last; }
+  uint32_t resync_count() const { return resyncs; }
+};
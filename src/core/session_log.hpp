@@ -0,0 +1,273 @@
+/*
+ * src/core/session_log.hpp
+ * Block format and double buffering of the full-session frame log
+ *
+ * A session file is a sequence of fixed-size blocks. Each block starts
+ * with a 32-byte header followed by FrameCompress entries; the encoder
+ * restarts at every block, so each block decodes on its own and a block
+ * torn by a power cut only loses itself. Bytes after payload_len are
+ * left over from earlier use of the buffer and carry no meaning.
+ *
+ * Timestamps are the 32-bit microsecond uptime of TimedFrame. The header
+ * counts how often it had wrapped at the block's first entry, so a reader
+ * rebuilds 64-bit times across sessions longer than 71 minutes.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint32_t, uint64_t
+#include <cstring>  // memcpy
+
+#include "crc32.hpp"
+#include "frame_compress.hpp"
+#include "frame_ring.hpp"
+
+struct SessionBlockHeader {
+  uint32_t magic;
+  uint32_t block_size;  // Of every block in the file
+  uint32_t sequence;    // 0 for the first block of a session
+  uint32_t time_wraps;  // Timestamp wraps before the first entry
+  uint32_t entry_count;
+  uint32_t payload_len;
+  uint32_t payload_crc;  // CRC-32 of the compressed payload
+  uint32_t header_crc;   // CRC-32 of the fields above
+
+  static constexpr uint32_t MAGIC = 0x31474F4C;  // "LOG1"
+
+  uint32_t compute_crc() const {
+    return crc32(reinterpret_cast<const uint8_t*>(this),
+                 offsetof(SessionBlockHeader, header_crc));
+  }
+
+  bool is_valid() const {
+    return magic == MAGIC && header_crc == compute_crc() &&
+           block_size > sizeof(SessionBlockHeader) &&
+           payload_len <= block_size - sizeof(SessionBlockHeader);
+  }
+};
+static_assert(sizeof(SessionBlockHeader) == 32);
+
+namespace SessionLog {
+/* A backwards step this large is a wrap, anything smaller is reordering */
+constexpr uint32_t WRAP_THRESHOLD = 0x80000000U;
+
+/* Session files are SESnnnnn.LOG: an 8.3 name, so FAT needs no LFN */
+constexpr const char* FILE_NAME_FORMAT = "SES%05u.LOG";
+constexpr size_t FILE_NAME_LEN = 12;
+
+/**
+ * @brief Session index of a file name, as listed by the file system.
+ * * @return false if the name is not a session file
+ */
+constexpr bool parse_file_name(const char* name, uint32_t& index) {
+  constexpr char PREFIX[] = "SES";
+  constexpr char SUFFIX[] = ".LOG";
+
+  index = 0;
+  for (size_t i = 0; i < 3; i++) {
+    if (name[i] != PREFIX[i]) {
+      return false;
+    }
+  }
+  for (size_t i = 3; i < 8; i++) {
+    if (name[i] < '0' || name[i] > '9') {
+      return false;
+    }
+    index = index * 10 + static_cast<uint32_t>(name[i] - '0');
+  }
+  for (size_t i = 0; i < 5; i++) {
+    if (name[8 + i] != SUFFIX[i]) {  // Includes the terminator
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Decode one block, oldest entry first.
+ * * on_frame(frame, timestamp_us) gets the 64-bit session time.
+ * * @return Entries delivered, or -1 if the header or payload is corrupt
+ */
+template <typename F>
+int decode_block(const uint8_t* block, size_t len, F&& on_frame) {
+  SessionBlockHeader hdr;
+
+  if (len < sizeof(hdr)) {
+    return -1;
+  }
+  std::memcpy(&hdr, block, sizeof(hdr));
+  if (!hdr.is_valid() || hdr.block_size > len) {
+    return -1;
+  }
+
+  const uint8_t* payload = block + sizeof(hdr);
+  if (crc32(payload, hdr.payload_len) != hdr.payload_crc) {
+    return -1;
+  }
+
+  FrameDecoder decoder;
+  TimedFrame frame;
+  uint64_t wraps = hdr.time_wraps;
+  uint32_t last = 0;
+  size_t pos = 0;
+
+  for (uint32_t i = 0; i < hdr.entry_count; i++) {
+    size_t used = decoder.decode(&payload[pos], hdr.payload_len - pos, frame);
+
+    if (used == 0) {
+      return -1;
+    }
+    if (i > 0 && frame.timestamp_us < last &&
+        last - frame.timestamp_us >= WRAP_THRESHOLD) {
+      wraps++;
+    }
+    last = frame.timestamp_us;
+    on_frame(frame, (wraps << 32) | frame.timestamp_us);
+    pos += used;
+  }
+  return static_cast<int>(hdr.entry_count);
+}
+}  // namespace SessionLog
+
+/**
+ * @brief SessionBuffers Class
+ * * COUNT block buffers used in turn: the producer compresses frames into
+ * the filling block while the writer drains sealed ones, oldest first.
+ * When every block is sealed and not yet written, frames are dropped and
+ * counted rather than waiting. Not thread-safe: producer calls are
+ * serialized by the caller, and the state changes (append, seal, ready,
+ * release) must not interleave; the writer reads a sealed block without
+ * any lock, since nothing touches it until release().
+ */
+template <size_t BLOCK, size_t COUNT = 2>
+class SessionBuffers {
+  static_assert(COUNT >= 2, "One block fills while another is written");
+  static_assert(BLOCK % 4 == 0, "Blocks are written aligned");
+  static_assert(BLOCK >= sizeof(SessionBlockHeader) +
+                             2 * FrameCompress::MAX_ENTRY_SIZE);
+
+ public:
+  static constexpr size_t PAYLOAD = BLOCK - sizeof(SessionBlockHeader);
+
+  /**
+   * @brief Compress a frame into the filling block.
+   * * Seals the block first if the frame does not fit.
+   * * @return false if the frame was dropped (no free block)
+   */
+  bool append(const TimedFrame& frame) {
+    if (frame.timestamp_us < last_ts_ &&
+        last_ts_ - frame.timestamp_us >= SessionLog::WRAP_THRESHOLD) {
+      wraps_++;
+    }
+    last_ts_ = frame.timestamp_us;
+
+    if (sealed_ == COUNT) {
+      dropped_++;
+      return false;
+    }
+
+    size_t n = encoder_.encode(frame, payload(filling()) + fill_,
+                               PAYLOAD - fill_);
+    if (n == 0) {
+      seal();
+      if (sealed_ == COUNT) {
+        dropped_++;
+        return false;
+      }
+      n = encoder_.encode(frame, payload(filling()), PAYLOAD);
+    }
+
+    if (entries_ == 0) {
+      first_wraps_ = wraps_;
+    }
+    crc_ = crc32_update(crc_, payload(filling()) + fill_, n);
+    fill_ += n;
+    entries_++;
+    return true;
+  }
+
+  /**
+   * @brief Close the filling block early, e.g. before a periodic sync.
+   * * @return false if it was empty (or there is none)
+   */
+  bool seal() {
+    if (sealed_ == COUNT || entries_ == 0) {
+      return false;
+    }
+
+    SessionBlockHeader hdr = {
+        .magic = SessionBlockHeader::MAGIC,
+        .block_size = BLOCK,
+        .sequence = sequence_++,
+        .time_wraps = first_wraps_,
+        .entry_count = entries_,
+        .payload_len = static_cast<uint32_t>(fill_),
+        .payload_crc = crc_,
+        .header_crc = 0,
+    };
+    hdr.header_crc = hdr.compute_crc();
+    std::memcpy(blocks_[filling()].data(), &hdr, sizeof(hdr));
+
+    sealed_++;
+    encoder_ = FrameEncoder{};
+    fill_ = 0;
+    entries_ = 0;
+    crc_ = 0;
+    return true;
+  }
+
+  /* Oldest sealed block, BLOCK bytes, or nullptr */
+  const uint8_t* ready() const {
+    return (sealed_ != 0) ? blocks_[head_].data() : nullptr;
+  }
+
+  /* The writer is done with ready(); its buffer fills again */
+  void release() {
+    if (sealed_ != 0) {
+      head_ = (head_ + 1) % COUNT;
+      sealed_--;
+    }
+  }
+
+  /* Restart at sequence 0, dropping whatever was buffered */
+  void reset() {
+    encoder_ = FrameEncoder{};
+    head_ = 0;
+    sealed_ = 0;
+    fill_ = 0;
+    entries_ = 0;
+    crc_ = 0;
+    sequence_ = 0;
+    wraps_ = 0;
+    first_wraps_ = 0;
+    last_ts_ = 0;
+    dropped_ = 0;
+  }
+
+  size_t sealed() const { return sealed_; }
+  size_t filling_bytes() const { return fill_; }
+  uint32_t blocks_sealed() const { return sequence_; }
+  uint32_t dropped() const { return dropped_; }
+
+ private:
+  alignas(4) std::array<std::array<uint8_t, BLOCK>, COUNT> blocks_{};
+  FrameEncoder encoder_;
+  size_t head_ = 0;    // Oldest sealed block
+  size_t sealed_ = 0;  // Sealed blocks from head_ on; the next one fills
+  size_t fill_ = 0;
+  uint32_t entries_ = 0;
+  uint32_t crc_ = 0;
+  uint32_t sequence_ = 0;
+  uint32_t wraps_ = 0;
+  uint32_t first_wraps_ = 0;
+  uint32_t last_ts_ = 0;
+  uint32_t dropped_ = 0;
+
+  size_t filling() const { return (head_ + sealed_) % COUNT; }
+
+  uint8_t* payload(size_t block) {
+    return blocks_[block].data() + sizeof(SessionBlockHeader);
+  }
+};
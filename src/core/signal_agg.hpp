@@ -0,0 +1,291 @@
+/*
+ * src/core/signal_agg.hpp
+ * Aggregation and downsampling windows for high-rate signals
+ *
+ * A stage turns one sampled signal into min/max/mean/last over tumbling
+ * windows of N samples or T ms and sends only those, one frame per window,
+ * at the rate its consumer needs. Several stages may read the same signal
+ * at different rates. Every sample costs O(1) per stage of its signal:
+ * a compare for min and max, an add to the sum and a store of the last
+ * value. No sample is buffered.
+ *
+ * Aggregate frame (stage.id, 2 bytes per output): the selected outputs in
+ * the order min, max, mean, last, each a little-endian int16_t
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, uint8_t, uint32_t, int64_t, uint64_t
+
+#include "bus_budget.hpp"
+#include "can_timing.hpp"
+
+namespace SignalAgg {
+constexpr uint8_t MIN = 1U << 0;
+constexpr uint8_t MAX = 1U << 1;
+constexpr uint8_t MEAN = 1U << 2;
+constexpr uint8_t LAST = 1U << 3;
+constexpr uint8_t ALL = MIN | MAX | MEAN | LAST;
+
+constexpr uint8_t dlc(uint8_t outputs) {
+  return static_cast<uint8_t>(2 * __builtin_popcount(outputs & ALL));
+}
+}  // namespace SignalAgg
+
+/* A sampled input, e.g. the steering angle read at 1 kHz */
+struct AggSignal {
+  const char* name;
+  uint16_t sample_hz;
+  uint8_t raw_dlc;  // Frame each sample would take if it were sent raw
+};
+
+/* What one consumer gets of one signal */
+struct AggStage {
+  const char* consumer;
+  uint8_t signal;      // Index into the signal table
+  uint32_t id;         // Standard ID of the aggregate frame
+  uint8_t outputs;     // SignalAgg::MIN | MAX | MEAN | LAST
+  uint16_t samples;    // Window of N samples, or
+  uint16_t window_ms;  // of T ms of sample time (samples == 0)
+};
+
+struct AggResult {
+  int16_t min;
+  int16_t max;
+  int16_t mean;  // Rounded to nearest
+  int16_t last;
+  uint32_t count;  // Samples in the window
+};
+
+/**
+ * @brief AggWindow Class
+ * * Running min/max/sum/last of one window.
+ */
+class AggWindow {
+ public:
+  void add(int16_t v) {
+    min_ = (v < min_) ? v : min_;
+    max_ = (v > max_) ? v : max_;
+    sum_ += v;
+    last_ = v;
+    count_++;
+  }
+
+  uint32_t count() const { return count_; }
+
+  /* Result of the window so far, and start the next one (count() > 0) */
+  AggResult take() {
+    int64_t half = count_ / 2;
+    int64_t mean = (sum_ >= 0) ? (sum_ + half) / count_
+                               : (sum_ - half) / count_;
+    AggResult r = {.min = min_,
+                   .max = max_,
+                   .mean = static_cast<int16_t>(mean),
+                   .last = last_,
+                   .count = count_};
+
+    *this = AggWindow{};
+    return r;
+  }
+
+ private:
+  int64_t sum_ = 0;
+  uint32_t count_ = 0;
+  int16_t min_ = INT16_MAX;
+  int16_t max_ = INT16_MIN;
+  int16_t last_ = 0;
+};
+
+inline void encode_agg_frame(const AggStage& stage, const AggResult& r,
+                             struct can_frame& frame) {
+  const int16_t values[] = {r.min, r.max, r.mean, r.last};
+  uint8_t n = 0;
+
+  frame = {};
+  frame.id = stage.id;
+  for (size_t i = 0; i < 4; i++) {
+    if ((stage.outputs & (1U << i)) != 0) {
+      frame.data[n++] = static_cast<uint8_t>(values[i]);
+      frame.data[n++] = static_cast<uint8_t>(values[i] >> 8);
+    }
+  }
+  frame.dlc = n;
+}
+
+/**
+ * @brief Decode an aggregate frame of stage; outputs it does not carry
+ * are left alone.
+ * * @return false if the frame is not one
+ */
+inline bool decode_agg_frame(const AggStage& stage,
+                             const struct can_frame& frame, AggResult& r) {
+  int16_t* values[] = {&r.min, &r.max, &r.mean, &r.last};
+  uint8_t n = 0;
+
+  if ((frame.flags & (CAN_FRAME_IDE | CAN_FRAME_RTR)) != 0 ||
+      frame.id != stage.id || frame.dlc != SignalAgg::dlc(stage.outputs)) {
+    return false;
+  }
+  for (size_t i = 0; i < 4; i++) {
+    if ((stage.outputs & (1U << i)) != 0) {
+      *values[i] =
+          static_cast<int16_t>(frame.data[n] | (frame.data[n + 1] << 8));
+      n += 2;
+    }
+  }
+  return true;
+}
+
+namespace SignalAgg {
+/**
+ * @brief The stage table is usable with the signal table.
+ * * Every stage reads an existing signal, has one to four outputs and
+ * exactly one of samples and window_ms set.
+ */
+template <size_t S, size_t N>
+constexpr bool valid(const std::array<AggSignal, S>& signals,
+                     const std::array<AggStage, N>& stages) {
+  for (const AggSignal& sig : signals) {
+    if (sig.sample_hz == 0 || sig.raw_dlc > CAN_MAX_DLEN) {
+      return false;
+    }
+  }
+  for (const AggStage& stage : stages) {
+    if (stage.signal >= S || (stage.outputs & ALL) == 0 ||
+        (stage.outputs & ~ALL) != 0 ||
+        (stage.samples == 0) == (stage.window_ms == 0) || stage.id > 0x7FF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Load of a stage's aggregate frames, in ppm (see
+ * core/bus_budget.hpp).
+ */
+constexpr uint64_t stage_load_ppm(const AggStage& stage,
+                                  const AggSignal& signal, uint32_t bitrate) {
+  if (stage.samples == 0) {
+    return BusBudget::frame_load_ppm(false, dlc(stage.outputs),
+                                     stage.window_ms, bitrate);
+  }
+
+  uint64_t bits = CanTiming::max_frame_bits(false, dlc(stage.outputs));
+  uint64_t per_s = uint64_t{stage.samples} * bitrate;
+
+  return (bits * signal.sample_hz * BusBudget::PPM + per_s - 1) / per_s;
+}
+
+/* Load of every stage */
+template <size_t S, size_t N>
+constexpr uint64_t stages_load_ppm(const std::array<AggSignal, S>& signals,
+                                   const std::array<AggStage, N>& stages,
+                                   uint32_t bitrate) {
+  uint64_t ppm = 0;
+
+  for (const AggStage& stage : stages) {
+    ppm += stage_load_ppm(stage, signals[stage.signal], bitrate);
+  }
+  return ppm;
+}
+
+/* Load of sending every sample of every signal instead, once each */
+template <size_t S>
+constexpr uint64_t raw_load_ppm(const std::array<AggSignal, S>& signals,
+                                uint32_t bitrate) {
+  uint64_t ppm = 0;
+
+  for (const AggSignal& sig : signals) {
+    ppm += BusBudget::rate_load_ppm(false, sig.raw_dlc, sig.sample_hz,
+                                    bitrate);
+  }
+  return ppm;
+}
+}  // namespace SignalAgg
+
+/**
+ * @brief SignalAggregator Class
+ * * Windows of every stage of a constant table. feed() visits only the
+ * stages of the sampled signal (a chain built once in the constructor)
+ * and calls emit(stage_index, result) for each window it closes.
+ * * An N-sample window closes with its N-th sample. A T ms window covers
+ * [start, start + T) of the timestamps passed to feed(), with start on a
+ * multiple of T from the first sample so windows do not drift; it closes
+ * with the first sample at or after its end, so its frame is late by at
+ * most one sample period. Windows without samples send nothing.
+ * * Not thread-safe: feed every signal from one thread.
+ */
+template <size_t S, size_t N>
+class SignalAggregator {
+  static_assert(N < 0xFF, "Stage indices are 8 bits");
+
+ public:
+  constexpr SignalAggregator(const std::array<AggSignal, S>& signals,
+                             const std::array<AggStage, N>& stages)
+      : signals_(signals), stages_(stages) {
+    first_.fill(END);
+    for (size_t i = N; i-- > 0;) {
+      next_[i] = first_[stages[i].signal];
+      first_[stages[i].signal] = static_cast<uint8_t>(i);
+    }
+  }
+
+  template <typename Emit>
+  void feed(size_t signal, int16_t value, uint32_t now_ms, Emit&& emit) {
+    samples_++;
+    for (uint8_t i = first_[signal]; i != END; i = next_[i]) {
+      const AggStage& stage = stages_[i];
+      State& s = state_[i];
+
+      if (stage.samples == 0) {
+        uint32_t elapsed = now_ms - s.start_ms;
+
+        if (!s.started) {
+          s.start_ms = now_ms;
+          s.started = true;
+        } else if (elapsed >= stage.window_ms) {
+          if (s.window.count() != 0) {
+            s.windows++;
+            emit(static_cast<size_t>(i), s.window.take());
+          }
+          s.start_ms += elapsed / stage.window_ms * stage.window_ms;
+        }
+      }
+
+      s.window.add(value);
+      if (stage.samples != 0 && s.window.count() >= stage.samples) {
+        s.windows++;
+        emit(static_cast<size_t>(i), s.window.take());
+      }
+    }
+  }
+
+  const AggStage& stage(size_t i) const { return stages_[i]; }
+  const AggSignal& signal_of(size_t i) const {
+    return signals_[stages_[i].signal];
+  }
+  uint32_t windows(size_t i) const { return state_[i].windows; }
+  uint64_t samples() const { return samples_; }  // Over all signals
+
+ private:
+  static constexpr uint8_t END = 0xFF;
+
+  struct State {
+    AggWindow window;
+    uint32_t start_ms = 0;
+    bool started = false;
+    uint32_t windows = 0;  // Closed and emitted
+  };
+
+  const std::array<AggSignal, S>& signals_;
+  const std::array<AggStage, N>& stages_;
+  std::array<uint8_t, S> first_{};  // First stage of each signal
+  std::array<uint8_t, N> next_{};   // Next stage of the same signal
+  std::array<State, N> state_{};
+  uint64_t samples_ = 0;
+};
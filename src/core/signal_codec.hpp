@@ -0,0 +1,64 @@
+/*
+ * src/core/signal_codec.hpp
+ * Bit-level packing of signals into CAN payloads (Intel byte order)
+ */
+
+#pragma once
+
+#include <cstdint>  // uint8_t, uint64_t
+
+/**
+ * @brief Location of a signal inside an 8-byte CAN payload.
+ * * Uses the DBC little-endian ("Intel") convention: start_bit is the
+ * position of the least significant bit, counted from bit 0 of data[0].
+ */
+struct SignalSpec {
+  uint8_t start_bit;
+  uint8_t length;  // 1..64, start_bit + length <= 64
+
+  constexpr uint64_t mask() const {
+    return (length >= 64) ? ~0ULL : (1ULL << length) - 1;
+  }
+};
+
+/* The byte loops below compile to a single load/store on little-endian
+ * targets while staying usable in constant expressions. */
+constexpr uint64_t load_le64(const uint8_t* data) {
+  uint64_t v = 0;
+  for (int i = 7; i >= 0; i--) {
+    v = (v << 8) | data[i];
+  }
+  return v;
+}
+
+constexpr void store_le64(uint8_t* data, uint64_t v) {
+  for (int i = 0; i < 8; i++) {
+    data[i] = static_cast<uint8_t>(v >> (8 * i));
+  }
+}
+
+/**
+ * @brief Write a raw signal value into the payload.
+ * * Bits outside the signal are preserved; excess value bits are dropped.
+ */
+constexpr void pack_signal(uint8_t* data, SignalSpec sig, uint64_t raw) {
+  uint64_t payload = load_le64(data);
+  uint64_t field = sig.mask() << sig.start_bit;
+
+  payload = (payload & ~field) | ((raw << sig.start_bit) & field);
+  store_le64(data, payload);
+}
+
+constexpr uint64_t unpack_signal(const uint8_t* data, SignalSpec sig) {
+  return (load_le64(data) >> sig.start_bit) & sig.mask();
+}
+
+/**
+ * @brief Read a two's complement signal, sign-extended to 64 bits.
+ */
+constexpr int64_t unpack_signed(const uint8_t* data, SignalSpec sig) {
+  uint64_t raw = unpack_signal(data, sig);
+  uint64_t sign = 1ULL << (sig.length - 1);
+
+  return static_cast<int64_t>((raw ^ sign) - sign);
+}
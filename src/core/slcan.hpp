@@ -0,0 +1,542 @@
+/*
+ * src/core/slcan.hpp
+ * SLCAN (Lawicel) bridge protocol: frame encoding, command parsing and the
+ * channel state of a CAN-to-serial adapter
+ *
+ * ASCII frames, as slcand, python-can and SavvyCAN read them, one per
+ * carriage-return-terminated line:
+ *
+ *   t1002030A\r            standard ID 0x100, 2 bytes 03 0A
+ *   T1234567810A\r         extended ID 0x12345678, 1 byte 0A
+ *   r1000\r  R123456780\r  remote frames (ID and DLC only)
+ *   t1002030A1F40\r        with timestamps on ("Z1"): ms, 0000..EA5F
+ *
+ * Compact binary frames, for links too slow for ASCII at full bus rate:
+ *
+ *   0xAA | flags:DLC | ID (2 or 4 bytes, LE) | data | ms (2 bytes, LE) | sum
+ *
+ * flags:DLC is bit 7 extended, bit 6 remote and bits 3..0 the DLC. The ms
+ * counter wraps at 65536, and sum is the low byte of the sum of every byte
+ * after the sync. An 8-byte standard frame takes 15 bytes instead of 26.
+ *
+ * Commands from the PC are always ASCII: O (open), L (open listen-only),
+ * C (close), Sn (bitrate), Zn (timestamps), V, N, F and t/T/r/R to send a
+ * frame. The reply is CR on success and BEL on error; a frame sent
+ * gets "z\r" (standard) or "Z\r" (extended).
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint16_t, uint32_t, uint64_t
+#include <string_view>
+
+#include "can_timing.hpp"
+#include "candump.hpp"
+
+namespace Slcan {
+enum class Format : uint8_t { Ascii, Binary };
+
+constexpr char OK = '\r';
+constexpr char ERROR = '\a';
+constexpr uint8_t SYNC = 0xAA;
+constexpr uint32_t TIMESTAMP_WRAP_MS = 60000;
+
+/* Longest ASCII frame ("T" + 8 + 1 + 16 + 4 + CR) and binary frame */
+constexpr size_t MAX_ASCII_BYTES = 31;
+constexpr size_t MAX_BINARY_BYTES = 17;
+constexpr size_t MAX_FRAME_BYTES = MAX_ASCII_BYTES;
+
+/* Longest command line without its CR ("T" + 8 + 1 + 16) */
+constexpr size_t MAX_LINE = 26;
+constexpr size_t MAX_REPLY = 8;
+
+/* Status flags ("F"), Lawicel bit assignment */
+constexpr uint8_t FLAG_RX_FULL = 1U << 0;  // Frames to the PC were dropped
+constexpr uint8_t FLAG_TX_FULL = 1U << 1;
+constexpr uint8_t FLAG_ERROR_WARNING = 1U << 2;
+constexpr uint8_t FLAG_OVERRUN = 1U << 3;
+constexpr uint8_t FLAG_ERROR_PASSIVE = 1U << 5;
+constexpr uint8_t FLAG_BUS_ERROR = 1U << 7;  // Bus-off
+
+/* "S0".."S8" */
+constexpr std::array<uint32_t, 9> BITRATES = {
+    10000, 20000, 50000, 100000, 125000, 250000, 500000, 800000, 1000000};
+
+/**
+ * @brief Bytes of one frame on the serial link.
+ */
+constexpr size_t frame_bytes(Format format, bool extended, bool remote,
+                             uint8_t dlc, bool timestamp) {
+  size_t data = remote ? 0 : dlc;
+
+  if (format == Format::Binary) {
+    return 1 + 1 + (extended ? 4 : 2) + data + 2 + 1;
+  }
+  return 1 + (extended ? 8 : 3) + 1 + 2 * data + (timestamp ? 4 : 0) + 1;
+}
+
+/**
+ * @brief Most frames a second the bus can carry: back to back, without
+ * stuff bits.
+ */
+constexpr uint32_t bus_frames_per_s(uint32_t bitrate, bool extended,
+                                    uint8_t dlc) {
+  return bitrate / CanTiming::min_frame_bits(extended, dlc);
+}
+
+/**
+ * @brief UART baud (8N1: 10 bits a byte) that forwards a bus at bitrate
+ * loaded to 100% with the frames that need the most link bytes per bus
+ * bit.
+ * * In ASCII these are 8-byte extended frames; in binary, empty standard
+ * ones, whose fixed bytes weigh most against their short time on the bus.
+ */
+constexpr uint64_t full_rate_baud(Format format, bool timestamp,
+                                  uint32_t bitrate) {
+  uint64_t worst = 0;
+
+  for (bool ext : {false, true}) {
+    for (uint8_t dlc = 0; dlc <= CAN_MAX_DLEN; dlc++) {
+      uint64_t bytes = frame_bytes(format, ext, false, dlc, timestamp);
+      uint64_t bits = CanTiming::min_frame_bits(ext, dlc);
+      uint64_t baud = (bytes * 10 * bitrate + bits - 1) / bits;
+
+      worst = (baud > worst) ? baud : worst;
+    }
+  }
+  return worst;
+}
+
+/**
+ * @brief Encode a frame as an ASCII line, CR included.
+ * * @param out At least MAX_ASCII_BYTES
+ * * @return Bytes written
+ */
+constexpr size_t encode_ascii(const struct can_frame& frame, bool timestamp,
+                              uint32_t ms, char* out) {
+  using candump_detail::hex_digit;
+
+  bool ext = (frame.flags & CAN_FRAME_IDE) != 0;
+  bool rtr = (frame.flags & CAN_FRAME_RTR) != 0;
+  uint8_t dlc = (frame.dlc > CAN_MAX_DLEN) ? CAN_MAX_DLEN : frame.dlc;
+  size_t n = 0;
+
+  out[n++] = rtr ? (ext ? 'R' : 'r') : (ext ? 'T' : 't');
+  for (int shift = ext ? 28 : 8; shift >= 0; shift -= 4) {
+    out[n++] = hex_digit(frame.id >> shift);
+  }
+  out[n++] = static_cast<char>('0' + dlc);
+  if (!rtr) {
+    for (uint8_t i = 0; i < dlc; i++) {
+      out[n++] = hex_digit(frame.data[i] >> 4);
+      out[n++] = hex_digit(frame.data[i]);
+    }
+  }
+  if (timestamp) {
+    ms %= TIMESTAMP_WRAP_MS;
+    for (int shift = 12; shift >= 0; shift -= 4) {
+      out[n++] = hex_digit(ms >> shift);
+    }
+  }
+  out[n++] = OK;
+  return n;
+}
+
+/**
+ * @brief Encode a frame in the compact binary format.
+ * * @param out At least MAX_BINARY_BYTES
+ * * @return Bytes written
+ */
+constexpr size_t encode_binary(const struct can_frame& frame, uint32_t ms,
+                               uint8_t* out) {
+  bool ext = (frame.flags & CAN_FRAME_IDE) != 0;
+  bool rtr = (frame.flags & CAN_FRAME_RTR) != 0;
+  uint8_t dlc = (frame.dlc > CAN_MAX_DLEN) ? CAN_MAX_DLEN : frame.dlc;
+  uint8_t sum = 0;
+  size_t n = 0;
+
+  out[n++] = SYNC;
+  out[n++] = static_cast<uint8_t>((ext ? 0x80 : 0) | (rtr ? 0x40 : 0) | dlc);
+  for (int i = 0; i < (ext ? 4 : 2); i++) {
+    out[n++] = static_cast<uint8_t>(frame.id >> (8 * i));
+  }
+  if (!rtr) {
+    for (uint8_t i = 0; i < dlc; i++) {
+      out[n++] = frame.data[i];
+    }
+  }
+  out[n++] = static_cast<uint8_t>(ms);
+  out[n++] = static_cast<uint8_t>(ms >> 8);
+  for (size_t i = 1; i < n; i++) {
+    sum = static_cast<uint8_t>(sum + out[i]);
+  }
+  out[n++] = sum;
+  return n;
+}
+
+/**
+ * @brief Parse a t/T/r/R line (without its CR) into a frame.
+ * * The ID must have exactly 3 or 8 digits and fit in 11 or 29 bits, and
+ * the data as many bytes as the DLC says. A timestamp is not accepted.
+ */
+constexpr bool parse_frame(std::string_view line, struct can_frame& frame) {
+  using candump_detail::hex_value;
+
+  if (line.empty()) {
+    return false;
+  }
+
+  char type = line[0];
+  bool ext = (type == 'T' || type == 'R');
+  bool rtr = (type == 'r' || type == 'R');
+  size_t id_digits = ext ? 8 : 3;
+  uint32_t id = 0;
+
+  if (type != 't' && type != 'T' && type != 'r' && type != 'R') {
+    return false;
+  }
+  if (line.size() < 1 + id_digits + 1) {
+    return false;
+  }
+  for (size_t i = 1; i <= id_digits; i++) {
+    int v = hex_value(line[i]);
+
+    if (v < 0) {
+      return false;
+    }
+    id = (id << 4) | static_cast<uint32_t>(v);
+  }
+  if (id > (ext ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK)) {
+    return false;
+  }
+
+  int dlc = hex_value(line[1 + id_digits]);
+  size_t data_start = 2 + id_digits;
+
+  if (dlc < 0 || dlc > static_cast<int>(CAN_MAX_DLEN) ||
+      line.size() != data_start + (rtr ? 0 : 2 * static_cast<size_t>(dlc))) {
+    return false;
+  }
+
+  frame = {};
+  frame.id = id;
+  frame.dlc = static_cast<uint8_t>(dlc);
+  frame.flags = static_cast<uint8_t>((ext ? CAN_FRAME_IDE : 0) |
+                                     (rtr ? CAN_FRAME_RTR : 0));
+  if (!rtr) {
+    for (int i = 0; i < dlc; i++) {
+      int hi = hex_value(line[data_start + 2 * i]);
+      int lo = hex_value(line[data_start + 2 * i + 1]);
+
+      if (hi < 0 || lo < 0) {
+        return false;
+      }
+      frame.data[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+  }
+  return true;
+}
+}  // namespace Slcan
+
+enum class SlcanCmd : uint8_t {
+  None,  // Empty line
+  Open,
+  ListenOnly,
+  Close,
+  Bitrate,
+  Timestamps,
+  Version,
+  Serial,
+  Status,
+  Transmit,
+  Invalid,
+};
+
+struct SlcanCommand {
+  SlcanCmd kind;
+  uint32_t arg;  // Bitrate in bit/s, timestamps on (1) or off (0)
+  struct can_frame frame;  // Transmit
+};
+
+/**
+ * @brief Parse one command line (without its CR).
+ */
+constexpr SlcanCommand parse_slcan_command(std::string_view line) {
+  SlcanCommand cmd = {.kind = SlcanCmd::Invalid, .arg = 0, .frame = {}};
+
+  if (line.empty()) {
+    cmd.kind = SlcanCmd::None;
+    return cmd;
+  }
+
+  char c = line[0];
+  std::string_view arg = line.substr(1);
+
+  switch (c) {
+    case 'O':
+      cmd.kind = arg.empty() ? SlcanCmd::Open : SlcanCmd::Invalid;
+      break;
+    case 'L':
+      cmd.kind = arg.empty() ? SlcanCmd::ListenOnly : SlcanCmd::Invalid;
+      break;
+    case 'C':
+      cmd.kind = arg.empty() ? SlcanCmd::Close : SlcanCmd::Invalid;
+      break;
+    case 'V':
+      cmd.kind = arg.empty() ? SlcanCmd::Version : SlcanCmd::Invalid;
+      break;
+    case 'N':
+      cmd.kind = arg.empty() ? SlcanCmd::Serial : SlcanCmd::Invalid;
+      break;
+    case 'F':
+      cmd.kind = arg.empty() ? SlcanCmd::Status : SlcanCmd::Invalid;
+      break;
+    case 'S':
+      if (arg.size() == 1 && arg[0] >= '0' &&
+          static_cast<size_t>(arg[0] - '0') < Slcan::BITRATES.size()) {
+        cmd.kind = SlcanCmd::Bitrate;
+        cmd.arg = Slcan::BITRATES[arg[0] - '0'];
+      }
+      break;
+    case 'Z':
+      if (arg == "0" || arg == "1") {
+        cmd.kind = SlcanCmd::Timestamps;
+        cmd.arg = static_cast<uint32_t>(arg[0] - '0');
+      }
+      break;
+    case 't':
+    case 'T':
+    case 'r':
+    case 'R':
+      if (Slcan::parse_frame(line, cmd.frame)) {
+        cmd.kind = SlcanCmd::Transmit;
+      }
+      break;
+    default:
+      break;
+  }
+  return cmd;
+}
+
+/**
+ * @brief SlcanParser Class
+ * * Splits the byte stream from the PC into command lines. LF is ignored,
+ * so CRLF from a terminal works; a line longer than Slcan::MAX_LINE is
+ * rejected as a whole when its CR arrives.
+ */
+class SlcanParser {
+ public:
+  /* true when c completed a command, which is then in cmd */
+  constexpr bool feed(char c, SlcanCommand& cmd) {
+    if (c == '\r') {
+      cmd = parse_slcan_command(std::string_view(line_.data(), len_));
+      if (overflow_) {
+        cmd.kind = SlcanCmd::Invalid;
+      }
+      len_ = 0;
+      overflow_ = false;
+      return true;
+    }
+    if (c == '\n') {
+      return false;
+    }
+    if (len_ == line_.size()) {
+      overflow_ = true;
+    } else {
+      line_[len_++] = c;
+    }
+    return false;
+  }
+
+ private:
+  std::array<char, Slcan::MAX_LINE> line_{};
+  size_t len_ = 0;
+  bool overflow_ = false;
+};
+
+/**
+ * @brief SlcanSession Class
+ * * Channel state of the bridge and the reply to each command, as a
+ * Lawicel adapter gives them. The bitrate belongs to the node, so "Sn"
+ * only succeeds for the bitrate the bus already runs at. "C" is always
+ * acknowledged so tools can reset the channel whatever its state.
+ * * Not thread-safe: handle every command from one thread.
+ */
+class SlcanSession {
+ public:
+  constexpr SlcanSession(uint32_t bitrate, uint16_t serial)
+      : bitrate_(bitrate), serial_(serial) {}
+
+  bool is_open() const { return open_; }
+  bool listen_only() const { return listen_only_; }
+  bool timestamps() const { return timestamps_; }
+
+  /**
+   * @brief Carry out a command and write its reply.
+   * * send(frame) puts a frame on the bus and returns true if the
+   * controller took it; flags are the current "F" status flags.
+   * * @param reply At least Slcan::MAX_REPLY
+   * * @return Reply length, 0 for none
+   */
+  template <typename Send>
+  size_t handle(const SlcanCommand& cmd, uint8_t flags, Send&& send,
+                char* reply) {
+    using candump_detail::hex_digit;
+
+    bool ok = false;
+    size_t n = 0;
+
+    switch (cmd.kind) {
+      case SlcanCmd::None:
+        return 0;
+      case SlcanCmd::Open:
+      case SlcanCmd::ListenOnly:
+        ok = !open_;
+        if (ok) {
+          open_ = true;
+          listen_only_ = (cmd.kind == SlcanCmd::ListenOnly);
+        }
+        break;
+      case SlcanCmd::Close:
+        ok = true;
+        open_ = false;
+        listen_only_ = false;
+        break;
+      case SlcanCmd::Bitrate:
+        ok = !open_ && cmd.arg == bitrate_;
+        break;
+      case SlcanCmd::Timestamps:
+        ok = !open_;
+        if (ok) {
+          timestamps_ = (cmd.arg != 0);
+        }
+        break;
+      case SlcanCmd::Version:
+        for (char c : {'V', '0', '1', '0', '1'}) {
+          reply[n++] = c;
+        }
+        break;
+      case SlcanCmd::Serial:
+        reply[n++] = 'N';
+        for (int shift = 12; shift >= 0; shift -= 4) {
+          reply[n++] = hex_digit(serial_ >> shift);
+        }
+        break;
+      case SlcanCmd::Status:
+        if (!open_) {
+          break;
+        }
+        reply[n++] = 'F';
+        reply[n++] = hex_digit(flags >> 4);
+        reply[n++] = hex_digit(flags);
+        break;
+      case SlcanCmd::Transmit:
+        if (open_ && !listen_only_ && send(cmd.frame)) {
+          reply[n++] =
+              ((cmd.frame.flags & CAN_FRAME_IDE) != 0) ? 'Z' : 'z';
+        }
+        break;
+      case SlcanCmd::Invalid:
+        break;
+    }
+
+    if (n > 0) {
+      reply[n++] = Slcan::OK;
+    } else {
+      reply[n++] = ok ? Slcan::OK : Slcan::ERROR;
+    }
+    return n;
+  }
+
+ private:
+  uint32_t bitrate_;
+  uint16_t serial_;
+  bool open_ = false;
+  bool listen_only_ = false;
+  bool timestamps_ = false;
+};
+
+/**
+ * @brief SlcanBinaryDecoder Class
+ * * PC-side reader of the compact binary stream. It finds the sync byte,
+ * checks the header and the sum, and after a bad record looks for the next
+ * sync from the byte after the rejected one, so it resynchronises within
+ * one record after joining mid-stream or losing bytes.
+ */
+class SlcanBinaryDecoder {
+ public:
+  /* true when b completed a frame, which is then in frame and ms */
+  bool feed(uint8_t b, struct can_frame& frame, uint16_t& ms) {
+    buf_[len_++] = b;
+
+    while (len_ > 0) {
+      if (buf_[0] != Slcan::SYNC) {
+        drop(1);
+        continue;
+      }
+      if (len_ < 2) {
+        return false;
+      }
+
+      uint8_t header = buf_[1];
+      if ((header & 0x30) != 0 || (header & 0x0F) > CAN_MAX_DLEN) {
+        errors_++;
+        drop(1);
+        continue;
+      }
+
+      bool ext = (header & 0x80) != 0;
+      bool rtr = (header & 0x40) != 0;
+      uint8_t dlc = header & 0x0F;
+      size_t size = Slcan::frame_bytes(Slcan::Format::Binary, ext, rtr, dlc,
+                                       true);
+      if (len_ < size) {
+        return false;
+      }
+
+      uint8_t sum = 0;
+      for (size_t i = 1; i + 1 < size; i++) {
+        sum = static_cast<uint8_t>(sum + buf_[i]);
+      }
+      if (sum != buf_[size - 1]) {
+        errors_++;
+        drop(1);
+        continue;
+      }
+
+      size_t n = 2;
+      frame = {};
+      frame.flags = static_cast<uint8_t>((ext ? CAN_FRAME_IDE : 0) |
+                                         (rtr ? CAN_FRAME_RTR : 0));
+      frame.dlc = dlc;
+      for (int i = 0; i < (ext ? 4 : 2); i++) {
+        frame.id |= static_cast<uint32_t>(buf_[n++]) << (8 * i);
+      }
+      for (uint8_t i = 0; !rtr && i < dlc; i++) {
+        frame.data[i] = buf_[n++];
+      }
+      ms = static_cast<uint16_t>(buf_[n] | (buf_[n + 1] << 8));
+      drop(size);
+      return true;
+    }
+    return false;
+  }
+
+  uint32_t errors() const { return errors_; }  // Records rejected
+
+ private:
+  void drop(size_t n) {
+    for (size_t i = n; i < len_; i++) {
+      buf_[i - n] = buf_[i];
+    }
+    len_ -= n;
+  }
+
+  std::array<uint8_t, Slcan::MAX_BINARY_BYTES> buf_{};
+  size_t len_ = 0;
+  uint32_t errors_ = 0;
+};
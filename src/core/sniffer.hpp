@@ -0,0 +1,126 @@
+/*
+ * src/core/sniffer.hpp
+ * Software ID filter and traffic counters for a promiscuous receiver
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
+
+#include "can_timing.hpp"
+
+/**
+ * @brief IdBitmap Class
+ * * One bit per 11-bit standard ID (2048 bits, 256 bytes). test() is a
+ * single word load, so it can run in the driver's RX callback while a
+ * thread flips bits; each update is atomic per ID.
+ */
+class IdBitmap {
+ public:
+  static constexpr size_t IDS = CAN_STD_ID_MASK + 1;
+
+ private:
+  std::array<std::atomic<uint32_t>, IDS / 32> words{};
+
+ public:
+  bool test(uint32_t id) const {
+    return id < IDS &&
+           (words[id >> 5].load(std::memory_order_relaxed) &
+            (1U << (id & 31))) != 0;
+  }
+
+  /* Sets or clears IDs first..last inclusive; false if out of range */
+  bool set(uint32_t first, uint32_t last, bool on = true) {
+    if (first > last || last >= IDS) {
+      return false;
+    }
+    for (uint32_t id = first; id <= last; id++) {
+      if (on) {
+        words[id >> 5].fetch_or(1U << (id & 31), std::memory_order_relaxed);
+      } else {
+        words[id >> 5].fetch_and(~(1U << (id & 31)),
+                                 std::memory_order_relaxed);
+      }
+    }
+    return true;
+  }
+
+  bool clear(uint32_t first, uint32_t last) {
+    return set(first, last, false);
+  }
+
+  size_t count() const {
+    size_t n = 0;
+
+    for (const auto& w : words) {
+      n += __builtin_popcount(w.load(std::memory_order_relaxed));
+    }
+    return n;
+  }
+};
+
+/* Cumulative, wrap-around counters; take differences for rates */
+struct SnifferStats {
+  std::atomic<uint32_t> seen{0};
+  std::atomic<uint32_t> accepted{0};
+  std::atomic<uint32_t> extended{0};
+  std::atomic<uint32_t> bits{0};  // Unstuffed length, a lower bound
+};
+
+/**
+ * @brief Sniffer Class
+ * * Filtering for a controller that accepts every frame (listen-only
+ * mode with a catch-all hardware filter). on_frame() costs a few
+ * relaxed atomics and one bitmap lookup whatever the filter contents,
+ * so the callback keeps up with a fully loaded bus. Extended frames are
+ * counted and pass only with accept_extended().
+ */
+class Sniffer {
+ private:
+  IdBitmap std_ids;
+  std::atomic<bool> extended_ids{false};
+  SnifferStats counters;
+
+  static void bump(std::atomic<uint32_t>& c, uint32_t n = 1) {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+ public:
+  /**
+   * @brief Count a received frame and decide whether to capture it.
+   * * One caller at a time (the driver's RX callback).
+   */
+  bool on_frame(const struct can_frame& frame) {
+    bool ext = (frame.flags & CAN_FRAME_IDE) != 0;
+
+    bump(counters.seen);
+    bump(counters.bits, CanTiming::min_frame_bits(ext, frame.dlc));
+    if (ext) {
+      bump(counters.extended);
+    }
+    if (ext ? !extended_ids.load(std::memory_order_relaxed)
+            : !std_ids.test(frame.id)) {
+      return false;
+    }
+    bump(counters.accepted);
+    return true;
+  }
+
+  IdBitmap& ids() { return std_ids; }
+  const IdBitmap& ids() const { return std_ids; }
+
+  void accept_extended(bool on) {
+    extended_ids.store(on, std::memory_order_relaxed);
+  }
+
+  bool extended_accepted() const {
+    return extended_ids.load(std::memory_order_relaxed);
+  }
+
+  const SnifferStats& stats() const { return counters; }
+};
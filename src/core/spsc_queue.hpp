@@ -0,0 +1,79 @@
+/*
+ * src/core/spsc_queue.hpp
+ * Lock-free single-producer/single-consumer ring buffer
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>  // size_t
+
+/**
+ * @brief SpscQueue Class
+ * * Fixed-capacity FIFO that is safe for one producer (e.g. an ISR or driver
+ * callback) and one consumer thread without locks. N must be a power of two
+ * so the indices can wrap freely. Storage is static; nothing is allocated.
+ */
+template <typename T, size_t N>
+class SpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+ private:
+  std::array<T, N> slots;
+  std::atomic<size_t> head{0};  // Next slot to read (consumer owned)
+  std::atomic<size_t> tail{0};  // Next slot to write (producer owned)
+  std::atomic<size_t> peak{0};  // Highest fill level seen by the producer
+
+ public:
+  /**
+   * @brief Append an element (producer side).
+   * * @return false if the queue is full; the element is not stored
+   */
+  bool push(const T& item) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t used = t - head.load(std::memory_order_acquire);
+
+    if (used == N) {
+      return false;
+    }
+
+    slots[t & (N - 1)] = item;
+    tail.store(t + 1, std::memory_order_release);
+
+    if (used + 1 > peak.load(std::memory_order_relaxed)) {
+      peak.store(used + 1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Remove the oldest element (consumer side).
+   * * @return false if the queue is empty
+   */
+  bool pop(T& item) {
+    size_t h = head.load(std::memory_order_relaxed);
+
+    if (h == tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    item = slots[h & (N - 1)];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t size() const {
+    return tail.load(std::memory_order_acquire) -
+           head.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t capacity() { return N; }
+
+  /**
+   * @brief Highest number of queued elements since the last reset.
+   */
+  size_t high_watermark() const { return peak.load(std::memory_order_relaxed); }
+
+  void reset_high_watermark() { peak.store(size(), std::memory_order_relaxed); }
+};
@@ -0,0 +1,123 @@
+/*
+ * src/core/subscriptions.hpp
+ * Runtime RX subscriptions: filters plus per-subscription monitoring
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
+
+#include "filter_swap.hpp"
+
+/* Frame timing of one subscription, in the RX thread's clock */
+struct SubscriptionStats {
+  uint32_t frames;
+  uint32_t last_ms;
+  uint32_t min_gap_ms;
+  uint32_t max_gap_ms;
+};
+
+/**
+ * @brief SubscriptionTable Class
+ * * The software side of up to N RX subscriptions: the filter of each,
+ * the controller filter ID it is installed under and its statistics.
+ * One thread owns the table; a change is made on a copy, the controller
+ * filters are swapped make-before-break (swap_filters()), and the copy
+ * then replaces the table in one assignment, so a frame is always
+ * dispatched against a complete table.
+ */
+template <size_t N>
+class SubscriptionTable {
+ private:
+  std::array<struct can_filter, N> filters{};
+  std::array<int, N> ids{};
+  std::array<SubscriptionStats, N> counters{};
+  size_t count = 0;
+
+  int find(const struct can_filter& filter) const {
+    for (size_t i = 0; i < count; i++) {
+      if (same_filter(filters[i], filter)) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+ public:
+  /**
+   * @return false if already subscribed or the table is full
+   */
+  bool add(const struct can_filter& filter) {
+    if (count == N || find(filter) >= 0) {
+      return false;
+    }
+    filters[count] = filter;
+    ids[count] = -1;
+    counters[count] = {};
+    count++;
+    return true;
+  }
+
+  /**
+   * @return false if there is no such subscription
+   */
+  bool remove(const struct can_filter& filter) {
+    int i = find(filter);
+
+    if (i < 0) {
+      return false;
+    }
+    for (size_t j = i; j + 1 < count; j++) {
+      filters[j] = filters[j + 1];
+      ids[j] = ids[j + 1];
+      counters[j] = counters[j + 1];
+    }
+    count--;
+    return true;
+  }
+
+  /**
+   * @brief Install this table's filters in place of those of current.
+   */
+  template <typename Add, typename Remove>
+  void swap_from(const SubscriptionTable& current, Add&& add,
+                 Remove&& remove) {
+    swap_filters(current.filters.data(), current.ids.data(), current.count,
+                 filters.data(), ids.data(), count, add, remove);
+  }
+
+  /**
+   * @brief Index of the first subscription that accepts frame, or -1.
+   */
+  int match(const struct can_frame& frame) const {
+    for (size_t i = 0; i < count; i++) {
+      if (ids[i] >= 0 && filter_matches(filters[i], frame)) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+  void note(size_t i, uint32_t now_ms) {
+    SubscriptionStats& s = counters[i];
+
+    if (s.frames != 0) {
+      uint32_t gap = now_ms - s.last_ms;
+
+      s.min_gap_ms = (s.frames == 1 || gap < s.min_gap_ms) ? gap : s.min_gap_ms;
+      s.max_gap_ms = (gap > s.max_gap_ms) ? gap : s.max_gap_ms;
+    }
+    s.frames++;
+    s.last_ms = now_ms;
+  }
+
+  size_t size() const { return count; }
+  static constexpr size_t capacity() { return N; }
+  const struct can_filter& filter(size_t i) const { return filters[i]; }
+  int filter_id(size_t i) const { return ids[i]; }
+  const SubscriptionStats& stats(size_t i) const { return counters[i]; }
+};
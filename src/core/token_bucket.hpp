@@ -0,0 +1,62 @@
+/*
+ * src/core/token_bucket.hpp
+ * Token bucket rate limiter with millisecond refill
+ */
+
+#pragma once
+
+#include <cstdint>  // int64_t, uint32_t, uint64_t
+
+/**
+ * @brief TokenBucket Class
+ * * Allows bursts of up to `burst` tokens and a sustained rate of
+ * `rate_per_s` tokens per second. Tokens are kept in thousandths so slow
+ * rates still refill smoothly with a millisecond clock. Not thread-safe;
+ * give each call site or producer its own bucket.
+ */
+class TokenBucket {
+ private:
+  uint64_t milli_tokens;
+  uint64_t capacity;
+  uint32_t rate;
+  int64_t last_ms;
+
+  void refill(int64_t now_ms) {
+    if (now_ms <= last_ms) {
+      return;
+    }
+
+    uint64_t added = static_cast<uint64_t>(now_ms - last_ms) * rate;
+    milli_tokens =
+        (milli_tokens + added > capacity) ? capacity : milli_tokens + added;
+    last_ms = now_ms;
+  }
+
+ public:
+  constexpr TokenBucket(uint32_t rate_per_s, uint32_t burst,
+                        int64_t now_ms = 0)
+      : milli_tokens(uint64_t{burst} * 1000U),
+        capacity(uint64_t{burst} * 1000U),
+        rate(rate_per_s),
+        last_ms(now_ms) {}
+
+  /**
+   * @brief Take n tokens if available.
+   * * @return false (and take nothing) if fewer than n tokens are available
+   */
+  bool try_take(uint32_t n, int64_t now_ms) {
+    refill(now_ms);
+
+    uint64_t needed = uint64_t{n} * 1000U;
+    if (milli_tokens < needed) {
+      return false;
+    }
+    milli_tokens -= needed;
+    return true;
+  }
+
+  uint32_t available(int64_t now_ms) {
+    refill(now_ms);
+    return static_cast<uint32_t>(milli_tokens / 1000U);
+  }
+};
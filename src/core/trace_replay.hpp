@@ -0,0 +1,116 @@
+/*
+ * src/core/trace_replay.hpp
+ * candump trace iteration and replay pacing
+ */
+
+#pragma once
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+#include <string_view>
+
+#include "candump.hpp"
+
+/**
+ * @brief CandumpReader Class
+ * * Walks a candump log held in memory, one frame per call. Lines that do
+ * not parse (comments, CAN FD, truncation) are skipped and counted.
+ */
+class CandumpReader {
+ private:
+  std::string_view text;
+  size_t pos = 0;
+  uint32_t skipped_lines = 0;
+
+ public:
+  constexpr explicit CandumpReader(std::string_view trace) : text(trace) {}
+
+  constexpr bool next(CandumpRecord& rec) {
+    while (pos < text.size()) {
+      size_t end = text.find('\n', pos);
+      if (end == std::string_view::npos) {
+        end = text.size();
+      }
+
+      std::string_view line = text.substr(pos, end - pos);
+      pos = end + 1;
+
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+      if (line.empty()) {
+        continue;
+      }
+      if (parse_candump_line(line, rec)) {
+        return true;
+      }
+      skipped_lines++;
+    }
+    return false;
+  }
+
+  constexpr void rewind() {
+    pos = 0;
+    skipped_lines = 0;
+  }
+
+  constexpr uint32_t skipped() const { return skipped_lines; }
+};
+
+/**
+ * @brief ReplayPacer Class
+ * * Maps trace timestamps to wall-clock release times. speed is an integer
+ * time-compression factor (1 = original timing, 10 = ten times faster);
+ * 0 releases every frame immediately. Timestamps that step backwards are
+ * treated as simultaneous with the previous frame, so one bad line cannot
+ * stall the replay.
+ */
+class ReplayPacer {
+ private:
+  uint32_t speed;
+  uint64_t wall_start_us;
+  uint64_t trace_start_us = 0;
+  uint64_t last_trace_us = 0;
+  bool started = false;
+  uint64_t max_lag_us = 0;
+
+ public:
+  constexpr ReplayPacer(uint32_t speed, uint64_t wall_start_us)
+      : speed(speed), wall_start_us(wall_start_us) {}
+
+  /**
+   * @brief Wall-clock time (us) at which a frame should be injected.
+   */
+  constexpr uint64_t due_us(uint64_t trace_us) {
+    if (!started) {
+      trace_start_us = trace_us;
+      last_trace_us = trace_us;
+      started = true;
+    }
+    if (trace_us > last_trace_us) {
+      last_trace_us = trace_us;
+    }
+    if (speed == 0) {
+      return wall_start_us;
+    }
+    return wall_start_us + (last_trace_us - trace_start_us) / speed;
+  }
+
+  /**
+   * @brief Record how late a frame was actually injected.
+   */
+  constexpr void note_injected(uint64_t due, uint64_t now_us) {
+    if (speed != 0 && now_us > due && now_us - due > max_lag_us) {
+      max_lag_us = now_us - due;
+    }
+  }
+
+  constexpr uint64_t max_lag() const { return max_lag_us; }
+
+  /**
+   * @brief Trace time covered so far.
+   */
+  constexpr uint64_t trace_span_us() const {
+    return last_trace_us - trace_start_us;
+  }
+};
@@ -0,0 +1,270 @@
+/*
+ * src/core/trace_stats.hpp
+ * One-pass statistics over a bus capture: per-ID timing and histograms of
+ * this node's signals
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+
+#include "app_config.hpp"
+#include "diag_codec.hpp"
+#include "signal_codec.hpp"
+
+/* A signal the analyzer decodes wherever its frame appears */
+struct TraceSignal {
+  const char* name;
+  uint32_t id;  // Standard ID
+  SignalSpec spec;
+};
+
+namespace TraceSignals {
+/* Signals defined for this node; new signals only need a line here */
+constexpr std::array<TraceSignal, 8> NODE = {{
+    {"gear", Config::CAN_GEAR_MSG_ID, {.start_bit = 0, .length = 8}},
+    {"cpu_load", Config::CAN_DIAG_MSG_ID, DiagSignals::CPU_LOAD},
+    {"max_queue", Config::CAN_DIAG_MSG_ID, DiagSignals::MAX_QUEUE_DEPTH},
+    {"deadline_miss", Config::CAN_DIAG_MSG_ID, DiagSignals::DEADLINE_MISSES},
+    {"tx_errors", Config::CAN_DIAG_MSG_ID, DiagSignals::TX_ERRORS},
+    {"bus_off", Config::CAN_DIAG_MSG_ID, DiagSignals::BUS_OFF_COUNT},
+    {"alive", Config::CAN_DIAG_MSG_ID, DiagSignals::ALIVE_COUNTER},
+    {"uptime_s", Config::CAN_DIAG_MSG_ID, DiagSignals::UPTIME},
+}};
+}  // namespace TraceSignals
+
+/* Arrival statistics of one identifier */
+struct IdTiming {
+  uint32_t key;  // ID, bit 31 set for extended IDs
+  uint32_t count;
+  uint64_t first_us;
+  uint64_t last_us;
+  uint64_t min_gap_us;
+  uint64_t max_gap_us;
+  uint32_t reordered;  // Timestamp earlier than the previous frame's
+
+  constexpr uint64_t mean_gap_us() const {
+    return (count > 1) ? (last_us - first_us) / (count - 1) : 0;
+  }
+};
+
+/**
+ * @brief SignalHistogram Class
+ * * 256 equal-width bins over the signal's raw range: signals of up to 8
+ * bits get one bin per value, wider signals are shifted down to fit.
+ */
+class SignalHistogram {
+ public:
+  static constexpr size_t BINS = 256;
+
+ private:
+  std::array<uint64_t, BINS> counts{};
+  uint8_t shift = 0;
+  uint64_t samples = 0;
+  uint64_t lo = UINT64_MAX;
+  uint64_t hi = 0;
+
+ public:
+  constexpr SignalHistogram() = default;
+  constexpr explicit SignalHistogram(SignalSpec spec)
+      : shift((spec.length > 8) ? spec.length - 8 : 0) {}
+
+  constexpr void add(uint64_t raw) {
+    counts[raw >> shift]++;
+    samples++;
+    lo = (raw < lo) ? raw : lo;
+    hi = (raw > hi) ? raw : hi;
+  }
+
+  constexpr uint64_t bin(size_t i) const { return counts[i]; }
+  /* Smallest raw value that falls into bin i */
+  constexpr uint64_t bin_start(size_t i) const {
+    return static_cast<uint64_t>(i) << shift;
+  }
+  constexpr uint64_t count() const { return samples; }
+  constexpr uint64_t min() const { return lo; }
+  constexpr uint64_t max() const { return hi; }
+};
+
+/**
+ * @brief TraceAnalyzer Class
+ * * Feed every frame of a capture once, in order. Per-ID timing goes into
+ * an open-addressed table of IdCapacity entries (a power of two; IDs
+ * beyond that are counted as overflow). Signal decoding is batched:
+ * frames are copied into structure-of-arrays buffers, and each signal is
+ * extracted from a whole batch with branch-free shift/mask/compare loops
+ * that the compiler vectorizes, before the matching values are binned.
+ */
+template <size_t IdCapacity = 4096, size_t BatchSize = 1024>
+class TraceAnalyzer {
+  static_assert((IdCapacity & (IdCapacity - 1)) == 0,
+                "IdCapacity must be a power of two");
+
+ private:
+  static constexpr size_t SIGNALS = TraceSignals::NODE.size();
+  static constexpr uint32_t EXT_BIT = 0x80000000U;
+  static constexpr uint32_t EMPTY = 0xFFFFFFFFU;
+
+  std::array<IdTiming, IdCapacity> ids;
+  size_t id_count = 0;
+  uint64_t id_overflow = 0;
+  uint64_t total = 0;
+
+  /* Pending batch, structure of arrays */
+  std::array<uint32_t, BatchSize> batch_key;
+  std::array<uint8_t, BatchSize> batch_len;
+  std::array<uint64_t, BatchSize> batch_payload;
+  size_t batch_size = 0;
+
+  /* Scratch for one signal over one batch */
+  std::array<uint64_t, BatchSize> values;
+  std::array<uint8_t, BatchSize> hits;
+
+  std::array<SignalHistogram, SIGNALS> histograms;
+
+  static constexpr uint32_t key_of(const struct can_frame& frame) {
+    return ((frame.flags & CAN_FRAME_IDE) != 0) ? (frame.id | EXT_BIT)
+                                                : frame.id;
+  }
+
+  IdTiming* lookup(uint32_t key) {
+    size_t i = (key * 2654435761U) & (IdCapacity - 1);
+
+    for (size_t probe = 0; probe < IdCapacity; probe++) {
+      IdTiming& slot = ids[i];
+
+      if (slot.key == key) {
+        return &slot;
+      }
+      if (slot.key == EMPTY) {
+        if (id_count + 1 > IdCapacity * 3 / 4) {
+          return nullptr;  // Keep probe chains short
+        }
+        slot.key = key;
+        id_count++;
+        return &slot;
+      }
+      i = (i + 1) & (IdCapacity - 1);
+    }
+    return nullptr;
+  }
+
+  void decode_batch() {
+    for (size_t s = 0; s < SIGNALS; s++) {
+      const TraceSignal& sig = TraceSignals::NODE[s];
+      const uint8_t start = sig.spec.start_bit;
+      const uint64_t mask = sig.spec.mask();
+      const uint8_t need = (sig.spec.start_bit + sig.spec.length + 7) / 8;
+      size_t any = 0;
+
+      for (size_t i = 0; i < batch_size; i++) {
+        values[i] = (batch_payload[i] >> start) & mask;
+      }
+      for (size_t i = 0; i < batch_size; i++) {
+        hits[i] = (batch_key[i] == sig.id) & (batch_len[i] >= need);
+        any += hits[i];
+      }
+      if (any == 0) {
+        continue;
+      }
+      for (size_t i = 0; i < batch_size; i++) {
+        if (hits[i]) {
+          histograms[s].add(values[i]);
+        }
+      }
+    }
+    batch_size = 0;
+  }
+
+ public:
+  TraceAnalyzer() {
+    for (IdTiming& t : ids) {
+      t = {};
+      t.key = EMPTY;
+    }
+    for (size_t s = 0; s < SIGNALS; s++) {
+      histograms[s] = SignalHistogram(TraceSignals::NODE[s].spec);
+    }
+  }
+
+  void add(uint64_t timestamp_us, const struct can_frame& frame) {
+    uint32_t key = key_of(frame);
+    IdTiming* t = lookup(key);
+
+    total++;
+    if (t == nullptr) {
+      id_overflow++;
+    } else if (t->count++ == 0) {
+      t->first_us = timestamp_us;
+      t->last_us = timestamp_us;
+      t->min_gap_us = UINT64_MAX;
+    } else if (timestamp_us < t->last_us) {
+      t->reordered++;
+    } else {
+      uint64_t gap = timestamp_us - t->last_us;
+
+      t->min_gap_us = (gap < t->min_gap_us) ? gap : t->min_gap_us;
+      t->max_gap_us = (gap > t->max_gap_us) ? gap : t->max_gap_us;
+      t->last_us = timestamp_us;
+    }
+
+    /* Remote frames carry no signals */
+    batch_key[batch_size] = key;
+    batch_len[batch_size] =
+        ((frame.flags & CAN_FRAME_RTR) != 0) ? 0 : frame.dlc;
+    batch_payload[batch_size] = load_le64(frame.data);
+    if (++batch_size == BatchSize) {
+      decode_batch();
+    }
+  }
+
+  /**
+   * @brief Decode the partial last batch; call once after the last frame.
+   */
+  void finish() {
+    if (batch_size != 0) {
+      decode_batch();
+    }
+  }
+
+  uint64_t frames() const { return total; }
+  size_t distinct_ids() const { return id_count; }
+  uint64_t overflow() const { return id_overflow; }
+
+  /**
+   * @brief Call on_id(const IdTiming&) for every identifier seen (in
+   * table order, not sorted).
+   */
+  template <typename F>
+  void for_each_id(F&& on_id) const {
+    for (const IdTiming& t : ids) {
+      if (t.key != EMPTY) {
+        on_id(t);
+      }
+    }
+  }
+
+  const IdTiming* timing(uint32_t id, bool extended = false) const {
+    uint32_t key = extended ? (id | EXT_BIT) : id;
+    size_t i = (key * 2654435761U) & (IdCapacity - 1);
+
+    for (size_t probe = 0; probe < IdCapacity; probe++) {
+      if (ids[i].key == key) {
+        return &ids[i];
+      }
+      if (ids[i].key == EMPTY) {
+        return nullptr;
+      }
+      i = (i + 1) & (IdCapacity - 1);
+    }
+    return nullptr;
+  }
+
+  const SignalHistogram& histogram(size_t signal) const {
+    return histograms[signal];
+  }
+};
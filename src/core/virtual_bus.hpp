@@ -0,0 +1,221 @@
+/*
+ * src/core/virtual_bus.hpp
+ * Time model of a shared classic CAN bus with ID-based arbitration
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <array>
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+
+#include "can_timing.hpp"
+
+struct BusTransmission {
+  size_t node;
+  size_t mailbox;
+  struct can_frame frame;
+  uint64_t queued_ns;  // When the frame entered its mailbox
+  uint64_t start_ns;   // SOF on the bus
+  uint64_t end_ns;     // End of intermission: the bus is free again
+};
+
+struct VirtualBusStats {
+  uint32_t frames;
+  uint64_t busy_ns;
+  uint64_t max_latency_ns;  // Queued to end of frame
+};
+
+/**
+ * @brief VirtualBus Class
+ * * Nodes put frames in TX mailboxes. Whenever the bus is idle, all
+ * pending mailboxes arbitrate and the lowest arbitration key wins; frames
+ * queued while another frame is on the wire wait for the next round, as
+ * on a real bus. Each node's frames take can_frame_bits() at that node's
+ * bitrate. The model holds no clock: callers pass the current time, so
+ * the same class runs in real time (virtual bus driver) and in
+ * discrete-event simulation. Not synchronized.
+ */
+template <size_t Nodes, size_t Mailboxes>
+class VirtualBus {
+ private:
+  struct Mailbox {
+    struct can_frame frame;
+    uint64_t key;
+    uint64_t queued_ns;
+    bool used;
+  };
+
+  std::array<std::array<Mailbox, Mailboxes>, Nodes> mailboxes{};
+  std::array<uint32_t, Nodes> bitrates{};
+  std::array<uint32_t, Nodes> lost{};
+  uint64_t free_at_ns = 0;
+  bool busy = false;
+  size_t wire_node = 0;  // Owner of the frame on the wire while busy
+  size_t wire_mb = 0;
+  VirtualBusStats totals{};
+
+ public:
+  constexpr explicit VirtualBus(uint32_t bitrate) { bitrates.fill(bitrate); }
+
+  /**
+   * @brief Empty every mailbox and clear the statistics; bitrates stay.
+   */
+  void reset() {
+    for (auto& node : mailboxes) {
+      node.fill({});
+    }
+    lost.fill(0);
+    free_at_ns = 0;
+    busy = false;
+    totals = {};
+  }
+
+  void set_bitrate(size_t node, uint32_t bitrate) { bitrates[node] = bitrate; }
+  uint32_t bitrate(size_t node) const { return bitrates[node]; }
+
+  /**
+   * @brief Place a frame in a free mailbox of node.
+   * * @return Mailbox index, or -1 if all of the node's mailboxes are full
+   */
+  int enqueue(size_t node, const struct can_frame& frame, uint64_t now_ns) {
+    for (size_t i = 0; i < Mailboxes; i++) {
+      Mailbox& mb = mailboxes[node][i];
+
+      if (!mb.used) {
+        mb = {.frame = frame,
+              .key = can_arbitration_key(frame),
+              .queued_ns = now_ns,
+              .used = true};
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Drop every pending frame of a node (controller stopped).
+   * * on_abort(mailbox) is called for each dropped frame. A frame already
+   * on the wire is not affected.
+   */
+  template <typename F>
+  void abort(size_t node, F&& on_abort) {
+    for (size_t i = 0; i < Mailboxes; i++) {
+      Mailbox& mb = mailboxes[node][i];
+
+      if (mb.used && !(busy && node == wire_node && i == wire_mb)) {
+        mb.used = false;
+        on_abort(i);
+      }
+    }
+  }
+
+  void abort(size_t node) {
+    abort(node, [](size_t) {});
+  }
+
+  size_t pending(size_t node) const {
+    size_t n = 0;
+    for (const Mailbox& mb : mailboxes[node]) {
+      n += mb.used ? 1 : 0;
+    }
+    return n;
+  }
+
+  /**
+   * @brief Call fn(mailbox, queued_ns) for every frame of node not yet
+   * finished, including one on the wire.
+   */
+  template <typename F>
+  void for_each_pending(size_t node, F&& fn) const {
+    for (size_t i = 0; i < Mailboxes; i++) {
+      const Mailbox& mb = mailboxes[node][i];
+
+      if (mb.used) {
+        fn(i, mb.queued_ns);
+      }
+    }
+  }
+
+  bool is_busy() const { return busy; }
+
+  /**
+   * @brief Run arbitration if the bus is idle.
+   * * On success the winner's mailbox stays occupied until finish(); the
+   * frame starts at now_ns or when the previous frame ended, whichever
+   * is later.
+   */
+  bool start_next(uint64_t now_ns, BusTransmission& tx) {
+    size_t best_node = Nodes;
+    size_t best_mb = 0;
+    uint64_t best_key = UINT64_MAX;
+
+    if (busy) {
+      return false;
+    }
+
+    for (size_t n = 0; n < Nodes; n++) {
+      for (size_t i = 0; i < Mailboxes; i++) {
+        const Mailbox& mb = mailboxes[n][i];
+
+        if (mb.used && mb.key < best_key) {
+          best_key = mb.key;
+          best_node = n;
+          best_mb = i;
+        }
+      }
+    }
+    if (best_node == Nodes) {
+      return false;
+    }
+
+    /* Every other node with a pending frame lost this round */
+    for (size_t n = 0; n < Nodes; n++) {
+      if (n != best_node && pending(n) != 0) {
+        lost[n]++;
+      }
+    }
+
+    const Mailbox& win = mailboxes[best_node][best_mb];
+    uint64_t start = (now_ns > free_at_ns) ? now_ns : free_at_ns;
+
+    tx = {.node = best_node,
+          .mailbox = best_mb,
+          .frame = win.frame,
+          .queued_ns = win.queued_ns,
+          .start_ns = start,
+          .end_ns = start + can_bits_to_ns(can_frame_bits(win.frame),
+                                           bitrates[best_node])};
+    mailboxes[best_node][best_mb].key = UINT64_MAX;  // Out of arbitration
+    wire_node = best_node;
+    wire_mb = best_mb;
+    busy = true;
+    return true;
+  }
+
+  /**
+   * @brief The frame from start_next() has left the bus.
+   */
+  void finish(const BusTransmission& tx) {
+    uint64_t latency = tx.end_ns - tx.queued_ns;
+
+    mailboxes[tx.node][tx.mailbox].used = false;
+    free_at_ns = tx.end_ns;
+    busy = false;
+
+    totals.frames++;
+    totals.busy_ns += tx.end_ns - tx.start_ns;
+    if (latency > totals.max_latency_ns) {
+      totals.max_latency_ns = latency;
+    }
+  }
+
+  /**
+   * @brief Arbitration rounds a node took part in and lost.
+   */
+  uint32_t arbitration_losses(size_t node) const { return lost[node]; }
+
+  const VirtualBusStats& stats() const { return totals; }
+};
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Retained crash ring (CONFIG_APP_CRASH_RING)
+ *
+ * The record sits in the no-init section, which a warm reset leaves
+ * alone. At boot, before any thread runs, whatever the previous run left
+ * is validated and kept as the report; a timer then re-seals counters and
+ * scheduler state every CONFIG_APP_CRASH_RING_SEAL_MS. Nothing is ever
+ * written to flash.
+ */
+
+#include "crash_ring.hpp"
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/spinlock.h>
+
+#if defined(CONFIG_HWINFO)
+#include <zephyr/drivers/hwinfo.h>
+#endif
+
+#include <cstring>
+#include <type_traits>
+
+#include "app_config.hpp"
+#include "blackbox.hpp"
+#include "core/candump.hpp"
+#include "core/crash_ring.hpp"
+#include "core/diag_codec.hpp"
+#include "diagnostics.hpp"
+#include "session_log.hpp"
+#include "slcan.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+const struct device* const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
+
+using Record = CrashRecord<CONFIG_APP_CRASH_RING_FRAMES>;
+using Report = CrashReport<CONFIG_APP_CRASH_RING_FRAMES>;
+
+static_assert(std::is_trivial_v<Record>,
+              "A constructor would wipe the record at startup");
+
+__noinit Record record;
+Report previous;  // Read-only after boot
+bool have_previous;
+struct k_spinlock lock;
+CrashSchedState sched;  // TX thread; the timer's read may be torn
+
+uint32_t now_us() {
+  return static_cast<uint32_t>(k_ticks_to_us_floor64(k_uptime_ticks()));
+}
+
+void seal(struct k_timer* timer) {
+  CrashCounters counters = {
+      .tx_frames = NodeStats::read(node_stats.tx_frames),
+      .tx_errors = NodeStats::read(node_stats.tx_errors),
+      .rx_frames = NodeStats::read(node_stats.rx_frames),
+      .rx_dropped = NodeStats::read(node_stats.rx_dropped),
+      .deadline_misses = NodeStats::read(node_stats.deadline_misses),
+      .bus_off_count = NodeStats::read(node_stats.bus_off_count),
+  };
+  k_spinlock_key_t key = k_spin_lock(&lock);
+
+  record.seal(counters, sched);
+  k_spin_unlock(&lock, key);
+}
+
+K_TIMER_DEFINE(seal_timer, seal, NULL);
+
+void report_tx_done(const struct device* dev, int error, void* user_data) {
+  NodeStats::bump(error == 0 ? node_stats.tx_frames : node_stats.tx_errors);
+}
+
+int crash_ring_boot() {
+  have_previous = record.begin(previous);
+
+  if (have_previous) {
+    LOG_WRN("Warm reset #%u: last sealed at %u ms (profile %u, %u polls), "
+            "%u frames recovered",
+            previous.warm_resets, previous.sched.uptime_ms,
+            previous.sched.profile, previous.sched.polls,
+            static_cast<uint32_t>(previous.frame_count));
+    LOG_WRN("Before reset: tx %u (%u errors), rx %u (%u dropped), "
+            "%u deadline misses, %u bus-off",
+            previous.counters.tx_frames, previous.counters.tx_errors,
+            previous.counters.rx_frames, previous.counters.rx_dropped,
+            previous.counters.deadline_misses,
+            previous.counters.bus_off_count);
+  } else {
+    LOG_INF("Cold boot: no retained crash record");
+  }
+
+#if defined(CONFIG_HWINFO)
+  uint32_t cause;
+  if (hwinfo_get_reset_cause(&cause) == 0) {
+    LOG_INF("Reset cause 0x%08x", cause);
+    hwinfo_clear_reset_cause();
+  }
+#endif
+
+  k_timer_start(&seal_timer, K_MSEC(CONFIG_APP_CRASH_RING_SEAL_MS),
+                K_MSEC(CONFIG_APP_CRASH_RING_SEAL_MS));
+  return 0;
+}
+}  // namespace
+
+/* Before the static threads start, so no frame is recorded earlier */
+SYS_INIT(crash_ring_boot, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+void crash_ring_record(const struct can_frame& frame, FrameDir dir) {
+  TimedFrame entry = TimedFrame::from(frame, dir, now_us());
+  k_spinlock_key_t key = k_spin_lock(&lock);
+
+  record.record(entry);
+  k_spin_unlock(&lock, key);
+}
+
+void crash_ring_note_schedule(uint8_t profile, int64_t now_ms,
+                              int64_t next_due_ms) {
+  sched.uptime_ms = static_cast<uint32_t>(now_ms);
+  sched.next_due_ms = static_cast<uint32_t>(next_due_ms);
+  sched.polls++;
+  sched.profile = profile;
+}
+
+int crash_ring_send_report() {
+  CrashReportPayload payload = {};
+  struct can_frame frame;
+
+  if (have_previous) {
+    const CrashCounters& c = previous.counters;
+
+    payload = {
+        .warm_resets = static_cast<uint8_t>(
+            saturate(previous.warm_resets, CrashReportSignals::WARM_RESETS)),
+        .uptime_s = previous.sched.uptime_ms / 1000,
+        .profile = previous.sched.profile,
+        .deadline_misses = static_cast<uint8_t>(saturate(
+            c.deadline_misses, CrashReportSignals::DEADLINE_MISSES)),
+        .tx_errors = static_cast<uint8_t>(
+            saturate(c.tx_errors, CrashReportSignals::TX_ERRORS)),
+        .rx_dropped = static_cast<uint8_t>(
+            saturate(c.rx_dropped, CrashReportSignals::RX_DROPPED)),
+        .bus_off_count = static_cast<uint8_t>(
+            saturate(c.bus_off_count, CrashReportSignals::BUS_OFF_COUNT)),
+        .frames = static_cast<uint8_t>(
+            saturate(static_cast<uint32_t>(previous.frame_count),
+                     CrashReportSignals::FRAMES)),
+    };
+  }
+  encode_crash_report_frame(payload, frame);
+
+  /* With a callback the RX thread that asked does not wait for the bus */
+  int ret = can_send(can_dev, &frame, K_NO_WAIT, report_tx_done, NULL);
+  if (ret != 0) {
+    NodeStats::bump(node_stats.tx_errors);
+  } else {
+    blackbox_record(frame, FrameDir::Tx);
+    crash_ring_record(frame, FrameDir::Tx);
+    session_log_record(frame, FrameDir::Tx);
+    slcan_record_tx(can_dev, frame);
+  }
+  return ret;
+}
+
+#if defined(CONFIG_SHELL)
+namespace {
+int cmd_show(const struct shell* sh, size_t argc, char** argv) {
+  char line[80];
+
+  if (!have_previous) {
+    shell_print(sh, "No retained record at boot (cold boot)");
+    return 0;
+  }
+
+  shell_print(sh, "warm reset #%u, last sealed at %u ms, next due %u ms",
+              previous.warm_resets, previous.sched.uptime_ms,
+              previous.sched.next_due_ms);
+  shell_print(sh, "profile %u, %u polls, %u deadline misses",
+              previous.sched.profile, previous.sched.polls,
+              previous.counters.deadline_misses);
+  shell_print(sh, "tx %u (%u errors), rx %u (%u dropped), %u bus-off",
+              previous.counters.tx_frames, previous.counters.tx_errors,
+              previous.counters.rx_frames, previous.counters.rx_dropped,
+              previous.counters.bus_off_count);
+
+  /* Newest first, as candump lines for the host tools */
+  for (size_t i = 0; i < previous.frame_count; i++) {
+    const TimedFrame& tf = previous.frames[i];
+    struct can_frame frame = {};
+
+    frame.id = tf.id;
+    frame.flags = tf.flags;
+    frame.dlc = tf.dlc;
+    memcpy(frame.data, tf.data, sizeof(tf.data));
+    if (format_candump_line(tf.timestamp_us,
+                            (tf.dir == FrameDir::Tx) ? "tx" : "rx", frame,
+                            line, sizeof(line)) != 0) {
+      shell_fprintf(sh, SHELL_NORMAL, "%s", line);
+    }
+  }
+  return 0;
+}
+
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  shell_print(sh, "%u frames recorded this run, %u-frame ring, sealed "
+              "every %u ms, %zu bytes retained",
+              record.next_seq, CONFIG_APP_CRASH_RING_FRAMES,
+              CONFIG_APP_CRASH_RING_SEAL_MS, sizeof(record));
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    crash_cmds,
+    SHELL_CMD(show, NULL, "What the previous run left before resetting",
+              cmd_show),
+    SHELL_CMD(status, NULL, "Retained ring of this run", cmd_status),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(crash, &crash_cmds, "Retained crash ring", NULL);
+#endif /* CONFIG_SHELL */
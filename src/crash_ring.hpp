@@ -0,0 +1,42 @@
+/*
+ * src/crash_ring.hpp
+ * Recent frames, counters and scheduler state that survive a warm reset
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstdint>  // int64_t, uint8_t
+
+#include "core/frame_ring.hpp"
+
+#if defined(CONFIG_APP_CRASH_RING)
+
+/**
+ * @brief Copy a frame into the retained ring.
+ * * Safe from ISR and driver callbacks: a short spinlock, a 28-byte copy
+ * and a check word. No flash is written.
+ */
+void crash_ring_record(const struct can_frame& frame, FrameDir dir);
+
+/**
+ * @brief TX thread: where the scheduler is, sealed with the counters.
+ */
+void crash_ring_note_schedule(uint8_t profile, int64_t now_ms,
+                              int64_t next_due_ms);
+
+/**
+ * @brief Send what the retained record held at boot on
+ * CAN_CRASH_REPORT_MSG_ID, without blocking.
+ * * @return 0 if queued, otherwise the can_send() error code
+ */
+int crash_ring_send_report();
+
+#else
+
+inline void crash_ring_record(const struct can_frame&, FrameDir) {}
+inline void crash_ring_note_schedule(uint8_t, int64_t, int64_t) {}
+inline int crash_ring_send_report() { return -ENOTSUP; }
+
+#endif /* CONFIG_APP_CRASH_RING */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Periodic diagnostic frame built from pre-aggregated node counters
+ */
+
+#include "diagnostics.hpp"
+
+#include <zephyr/kernel.h>
+
+#include "blackbox.hpp"
+#include "crash_ring.hpp"
+#include "rx_handler.hpp"
+#include "session_log.hpp"
+#include "slcan.hpp"
+
+NodeStats node_stats;
+
+namespace {
+uint8_t alive_counter;
+
+/* Busy percentage since the previous call, from the kernel usage stats */
+uint8_t cpu_load_percent() {
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+  static uint64_t last_busy;
+  static uint64_t last_total;
+  k_thread_runtime_stats_t rt;
+
+  if (k_thread_runtime_stats_all_get(&rt) != 0) {
+    return 0;
+  }
+
+  /* execution_cycles includes idle time, total_cycles does not */
+  uint64_t busy = rt.total_cycles - last_busy;
+  uint64_t total = rt.execution_cycles - last_total;
+
+  last_busy = rt.total_cycles;
+  last_total = rt.execution_cycles;
+  return (total != 0) ? static_cast<uint8_t>((busy * 100U) / total) : 0;
+#else
+  return 0;
+#endif
+}
+
+void diag_tx_done(const struct device* dev, int error, void* user_data) {
+  NodeStats::bump(error == 0 ? node_stats.tx_frames : node_stats.tx_errors);
+}
+}  // namespace
+
+DiagPayload diag_collect() {
+  return DiagPayload{
+      .cpu_load_pct = cpu_load_percent(),
+      .max_queue_depth = static_cast<uint8_t>(rx_queue_high_watermark()),
+      .deadline_misses = static_cast<uint8_t>(
+          saturate(NodeStats::read(node_stats.deadline_misses),
+                   DiagSignals::DEADLINE_MISSES)),
+      .tx_errors = static_cast<uint8_t>(saturate(
+          NodeStats::read(node_stats.tx_errors), DiagSignals::TX_ERRORS)),
+      .bus_off_count = static_cast<uint8_t>(
+          saturate(NodeStats::read(node_stats.bus_off_count),
+                   DiagSignals::BUS_OFF_COUNT)),
+      .alive_counter = static_cast<uint8_t>(alive_counter++ & 0x0F),
+      .uptime_s = static_cast<uint32_t>(k_uptime_get() / 1000),
+  };
+}
+
+int diag_send(const struct device* dev) {
+  struct can_frame frame;
+
+  encode_diag_frame(diag_collect(), frame);
+
+  /* Never wait for a mailbox: diagnostics must not delay control traffic */
+  int ret = can_send(dev, &frame, K_NO_WAIT, diag_tx_done, NULL);
+  if (ret != 0) {
+    NodeStats::bump(node_stats.tx_errors);
+  } else {
+    blackbox_record(frame, FrameDir::Tx);
+    crash_ring_record(frame, FrameDir::Tx);
+    session_log_record(frame, FrameDir::Tx);
+    slcan_record_tx(dev, frame);
+  }
+  return ret;
+}
+
+void diag_state_change_callback(const struct device* dev, enum can_state state,
+                                struct can_bus_err_cnt err_cnt,
+                                void* user_data) {
+  if (state == CAN_STATE_BUS_OFF) {
+    NodeStats::bump(node_stats.bus_off_count);
+  }
+}
@@ -0,0 +1,34 @@
+/*
+ * src/diagnostics.hpp
+ * Node health counters and the periodic diagnostic frame
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include "core/diag_codec.hpp"
+#include "core/node_stats.hpp"
+
+/* Node-wide health counters, bumped at the event sites */
+extern NodeStats node_stats;
+
+/**
+ * @brief Snapshot the health counters into a diagnostic payload.
+ * * Only reads pre-aggregated values; CPU load is the busy share of the
+ * cycles elapsed since the previous call.
+ */
+DiagPayload diag_collect();
+
+/**
+ * @brief Build the diagnostic frame and queue it without blocking.
+ * * @return 0 if queued, otherwise the can_send() error code
+ */
+int diag_send(const struct device* dev);
+
+/**
+ * @brief CAN state change callback; counts bus-off events.
+ */
+void diag_state_change_callback(const struct device* dev, enum can_state state,
+                                struct can_bus_err_cnt err_cnt,
+                                void* user_data);
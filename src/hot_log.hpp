@@ -0,0 +1,45 @@
+/*
+ * src/hot_log.hpp
+ * Rate-limited logging for per-frame paths (CONFIG_APP_HOT_LOG_*)
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "core/log_policy.hpp"
+#include "diagnostics.hpp"
+
+/**
+ * @brief Hot-path log state with the Kconfig policy.
+ */
+constexpr HotPathLog make_hot_path_log() {
+  return HotPathLog(CONFIG_APP_HOT_LOG_SAMPLE_N, CONFIG_APP_HOT_LOG_RATE,
+                    CONFIG_APP_HOT_LOG_BURST, CONFIG_APP_HOT_LOG_SUMMARY_MS);
+}
+
+/*
+ * Log through a HotPathLog: the line is formatted only if the policy admits
+ * the event, and then carries the number of lines suppressed before it.
+ * Suppressed lines are also counted in node_stats.log_suppressed.
+ */
+#define HOT_LOG_(log_macro, hot, now_ms, error, fmt, ...)                 \
+  do {                                                                    \
+    if ((hot).event((now_ms), (error))) {                                 \
+      uint32_t hot_log_skipped_ = (hot).take_suppressed();               \
+      if (hot_log_skipped_ != 0) {                                        \
+        log_macro(fmt " (+%u suppressed)", ##__VA_ARGS__,                 \
+                  hot_log_skipped_);                                      \
+      } else {                                                            \
+        log_macro(fmt, ##__VA_ARGS__);                                    \
+      }                                                                   \
+    } else {                                                              \
+      NodeStats::bump(node_stats.log_suppressed);                         \
+    }                                                                     \
+  } while (0)
+
+#define HOT_LOG_INF(hot, now_ms, fmt, ...) \
+  HOT_LOG_(LOG_INF, hot, now_ms, false, fmt, ##__VA_ARGS__)
+#define HOT_LOG_ERR(hot, now_ms, fmt, ...) \
+  HOT_LOG_(LOG_ERR, hot, now_ms, true, fmt, ##__VA_ARGS__)
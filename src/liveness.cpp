@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Heartbeat and peer liveness supervision (CONFIG_APP_LIVENESS)
+ *
+ * One thread sends this node's heartbeat and sweeps the peer table;
+ * heartbeats from peers only stamp the table in the RX callback.
+ */
+
+#include "liveness.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+#include <array>
+
+#include "app_config.hpp"
+#include "diagnostics.hpp"
+#include "network_mgmt.hpp"
+#include "slcan.hpp"
+#include "sniffer.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+constexpr uint8_t NODE_ID = CONFIG_APP_NODE_ID;
+constexpr uint32_t HEARTBEAT_MS = CONFIG_APP_LIVENESS_HEARTBEAT_MS;
+constexpr uint32_t SWEEP_MS = CONFIG_APP_LIVENESS_SWEEP_MS;
+
+struct Listener {
+  PeerCallback cb;
+  void* user_data;
+};
+
+const struct device* hb_dev;
+std::array<Listener, Config::LIVENESS_MAX_LISTENERS> listeners{};
+size_t listener_count;
+K_MUTEX_DEFINE(listener_lock);
+
+void on_peer_change(uint8_t peer, bool alive, void* user_data) {
+  if (alive) {
+    LOG_INF("Peer 0x%02x up", peer);
+  } else {
+    LOG_WRN("Peer 0x%02x lost", peer);
+  }
+
+  k_mutex_lock(&listener_lock, K_FOREVER);
+  for (size_t i = 0; i < listener_count; i++) {
+    listeners[i].cb(peer, alive, listeners[i].user_data);
+  }
+  k_mutex_unlock(&listener_lock);
+}
+
+PeerTable<> peers(CONFIG_APP_LIVENESS_TIMEOUT_MS, on_peer_change);
+
+void heartbeat_rx_callback(const struct device* dev, struct can_frame* frame,
+                           void* user_data) {
+  uint8_t node;
+
+  /* Our own heartbeat comes back in loopback mode */
+  if (decode_heartbeat_frame(*frame, node) && node != NODE_ID) {
+    peers.note(node, k_uptime_get_32());
+  }
+}
+
+void liveness_thread_entry(void* arg1, void* arg2, void* arg3) {
+  int64_t next_sweep = k_uptime_get();
+  int64_t next_heartbeat = next_sweep;
+  uint8_t counter = 0;
+
+  while (1) {
+    int64_t now = k_uptime_get();
+
+    /* A sleeping bus stays quiet; peers then time out as they should */
+    if (now >= next_heartbeat) {
+      struct can_frame frame;
+
+      if (nm_network_mode() && !sniffer_listening()) {
+        encode_heartbeat_frame(NODE_ID, counter++, frame);
+        if (can_send(hb_dev, &frame, K_NO_WAIT, NULL, NULL) != 0) {
+          NodeStats::bump(node_stats.tx_errors);
+        } else {
+          slcan_record_tx(hb_dev, frame);
+        }
+      }
+      next_heartbeat += ((now - next_heartbeat) / HEARTBEAT_MS + 1) *
+                        HEARTBEAT_MS;
+    }
+
+    if (now >= next_sweep) {
+      peers.sweep(static_cast<uint32_t>(now));
+      next_sweep += ((now - next_sweep) / SWEEP_MS + 1) * SWEEP_MS;
+    }
+
+    k_sleep(K_TIMEOUT_ABS_MS((next_sweep < next_heartbeat) ? next_sweep
+                                                            : next_heartbeat));
+  }
+}
+}  // namespace
+
+/* Started by liveness_init() once the controller is up */
+K_THREAD_DEFINE(liveness_tid, Config::LIVENESS_THREAD_STACK_SIZE,
+                liveness_thread_entry, NULL, NULL, NULL,
+                Config::LIVENESS_THREAD_PRIORITY, 0, K_TICKS_FOREVER);
+
+void liveness_init(const struct device* dev) {
+  const struct can_filter filter = {.id = Config::CAN_HEARTBEAT_BASE_ID,
+                                    .mask = Config::CAN_HEARTBEAT_ID_MASK,
+                                    .flags = 0};
+
+  hb_dev = dev;
+  if (can_add_rx_filter(dev, heartbeat_rx_callback, NULL, &filter) < 0) {
+    LOG_ERR("Heartbeat filter not added; peers will not be seen");
+  }
+  k_thread_start(liveness_tid);
+}
+
+int liveness_add_listener(PeerCallback cb, void* user_data) {
+  int ret = 0;
+
+  k_mutex_lock(&listener_lock, K_FOREVER);
+  if (listener_count == listeners.size()) {
+    ret = -ENOSPC;
+  } else {
+    listeners[listener_count++] = {.cb = cb, .user_data = user_data};
+  }
+  k_mutex_unlock(&listener_lock);
+  return ret;
+}
+
+#if defined(CONFIG_SHELL)
+namespace {
+int cmd_peers(const struct shell* sh, size_t argc, char** argv) {
+  /* The alive bitmap belongs to the sweep; this is a snapshot */
+  uint32_t now = k_uptime_get_32();
+  size_t n = 0;
+
+  for (size_t p = 0; p < peers.capacity(); p++) {
+    uint8_t peer = static_cast<uint8_t>(p);
+
+    if (peers.is_alive(peer)) {
+      shell_print(sh, "0x%02x seen %u ms ago", peer,
+                  now - peers.last_seen_ms(peer));
+      n++;
+    }
+  }
+  shell_print(sh, "%zu peers alive, %u lost since boot", n, peers.lost());
+  return 0;
+}
+}  // namespace
+
+SHELL_CMD_REGISTER(peers, NULL, "Peers heard on the bus", cmd_peers);
+#endif /* CONFIG_SHELL */
@@ -0,0 +1,33 @@
+/*
+ * src/liveness.hpp
+ * Heartbeat and peer liveness supervision
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#if defined(CONFIG_APP_LIVENESS)
+
+#include "core/liveness.hpp"
+
+/**
+ * @brief Install the heartbeat filter and start the heartbeat/sweep
+ * thread.
+ */
+void liveness_init(const struct device* dev);
+
+/**
+ * @brief Be told when a peer appears or times out.
+ * * The callback runs in the liveness thread, right after the sweep that
+ * noticed the change; keep it short.
+ * * @return 0, or -ENOSPC once Config::LIVENESS_MAX_LISTENERS are
+ * registered
+ */
+int liveness_add_listener(PeerCallback cb, void* user_data);
+
+#else
+
+inline void liveness_init(const struct device*) {}
+
+#endif /* CONFIG_APP_LIVENESS */
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Log backend that streams binary log records over CAN
+ */
+
+#include "log_backend_can.hpp"
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/cbprintf.h>
+
+#include "core/log_stream.hpp"
+#include "core/token_bucket.hpp"
+#include "network_mgmt.hpp"
+#include "slcan.hpp"
+#include "sniffer.hpp"
+
+namespace {
+const struct device* const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
+
+constexpr size_t MAX_RECORD = CONFIG_APP_LOG_CAN_MAX_RECORD;
+
+/* Only touched from the log processing context */
+uint8_t record[MAX_RECORD];
+size_t record_len;
+uint8_t tx_seq;
+uint16_t pending_dropped;
+bool panic_mode;
+TokenBucket bucket(CONFIG_APP_LOG_CAN_RATE, CONFIG_APP_LOG_CAN_BURST);
+
+atomic_t dropped_total;
+
+void count_drop(uint32_t n) {
+  atomic_add(&dropped_total, n);
+  pending_dropped = (pending_dropped + n > UINT16_MAX)
+                        ? UINT16_MAX
+                        : static_cast<uint16_t>(pending_dropped + n);
+}
+
+/* cbprintf sink: append to the record, silently truncating */
+int record_out(int c, void* ctx) {
+  if (record_len < MAX_RECORD) {
+    record[record_len++] = static_cast<uint8_t>(c);
+  }
+  return c;
+}
+
+void append_text(const char* str) {
+  while (*str != '\0') {
+    record_out(*str++, NULL);
+  }
+}
+
+void tx_done(const struct device* dev, int error, void* user_data) {}
+
+void send_record() {
+  uint32_t frames = LogStream::frames_for(record_len);
+  struct can_frame frame;
+
+  /* Logs must not keep a sleeping bus busy, nor leave a sniffer */
+  if (!nm_network_mode() || sniffer_listening() ||
+      !bucket.try_take(frames, k_uptime_get())) {
+    count_drop(1);
+    return;
+  }
+
+  LogSegmenter segmenter(record, record_len, tx_seq);
+  while (segmenter.next(CONFIG_APP_LOG_CAN_MSG_ID, frame)) {
+    /* Never wait for a mailbox; a partial record is discarded by the
+     * receiver through the sequence gap it leaves behind. */
+    if (can_send(can_dev, &frame, K_NO_WAIT, tx_done, NULL) != 0) {
+      count_drop(1);
+      return;
+    }
+    slcan_record_tx(can_dev, frame);
+  }
+  pending_dropped = 0;
+}
+
+void process(const struct log_backend* const backend,
+             union log_msg_generic* msg) {
+  if (panic_mode) {
+    /* Interrupts may be locked; the CAN driver cannot be used any more */
+    count_drop(1);
+    return;
+  }
+
+  struct log_msg* log = &msg->log;
+  const void* source = log_msg_get_source(log);
+  uint8_t domain_id = log_msg_get_domain(log);
+  int16_t source_id = -1;
+
+  if (source != NULL) {
+    source_id =
+        IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING)
+            ? log_dynamic_source_id((struct log_source_dynamic_data*)source)
+            : log_const_source_id((const struct log_source_const_data*)source);
+  }
+
+  LogRecordHeader hdr = {
+      .timestamp_ms = static_cast<uint32_t>(
+          log_output_timestamp_to_us(log_msg_get_timestamp(log)) / 1000U),
+      .level = log_msg_get_level(log),
+      .domain = domain_id,
+      .source_id = static_cast<uint16_t>(source_id),
+      .dropped = pending_dropped,
+  };
+
+  serialize_log_header(hdr, record);
+  record_len = LogStream::HEADER_SIZE;
+
+  if (source_id >= 0) {
+    append_text(log_source_name_get(domain_id, source_id));
+    append_text(": ");
+  }
+
+  size_t plen;
+  uint8_t* package = log_msg_get_package(log, &plen);
+  if (plen != 0) {
+    cbpprintf(record_out, NULL, package);
+  }
+
+  send_record();
+}
+
+void dropped(const struct log_backend* const backend, uint32_t cnt) {
+  count_drop(cnt);
+}
+
+void panic(const struct log_backend* const backend) { panic_mode = true; }
+
+void init(const struct log_backend* const backend) {}
+
+const struct log_backend_api log_backend_can_api = {
+    .process = process,
+    .dropped = dropped,
+    .panic = panic,
+    .init = init,
+};
+}  // namespace
+
+LOG_BACKEND_DEFINE(log_backend_can, log_backend_can_api, true);
+
+uint32_t log_backend_can_dropped() { return atomic_get(&dropped_total); }
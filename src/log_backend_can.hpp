@@ -0,0 +1,15 @@
+/*
+ * src/log_backend_can.hpp
+ * Binary log stream over CAN (CONFIG_APP_LOG_BACKEND_CAN)
+ */
+
+#pragma once
+
+#include <cstdint>  // uint32_t
+
+/**
+ * @brief Log records dropped by the CAN backend since boot.
+ * * Counts rate-limit drops, busy TX mailboxes and messages the logging
+ * core reported as dropped before they reached the backend.
+ */
+uint32_t log_backend_can_dropped();
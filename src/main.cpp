@@ -7,120 +7,106 @@
 
 #include <zephyr/drivers/can.h>
 #include <zephyr/kernel.h>
-#include <zephyr/logging/log.h>
-
-#include <cstdint>  // uint8_t, uint32_t
 
 #include "app_config.hpp"
-
-/* Register Log Module */
-LOG_MODULE_REGISTER(sim_racing_node, LOG_LEVEL_INF);
-
-enum class Gear : uint8_t { N = 0, First, Second, Third, Fourth, Fifth, Sixth };
-
-/* Overload prefix increment operator (++g) for cyclic shifting */
-Gear& operator++(Gear& g) {
-  using enum Gear;  // C++20 Feature: Reduces verbosity (no need for Gear::N,
-                    // Gear::Sixth)
-
-  // Cyclic Logic: If Sixth, reset to N. Otherwise, increment.
-  g = (g == Sixth) ? N : static_cast<Gear>(static_cast<uint8_t>(g) + 1);
-  return g;
-}
-
-/**
- * @brief SimWheel Class
- * * Encapsulates the CAN hardware abstraction and gear shifting logic.
- * Implements RAII pattern to ensure device readiness and configuration upon
- * instantiation.
- */
-class SimWheel {
- private:
-  const struct device* dev;
-  Gear current_gear;
-
- public:
-  /**
-   * @brief Construct a new Sim Wheel object
-   * * @param can_device Pointer to the Zephyr CAN device structure
-   */
-  SimWheel(const struct device* can_device)
-      : dev(can_device), current_gear(Gear::N) {
-    if (!device_is_ready(dev)) {
-      LOG_ERR("CAN device not ready");
-      return;
-    }
-
-    /* * Configure Loopback Mode.
-     * This allows the node to receive its own messages, simulating a full bus
-     * environment without requiring an external physical transceiver.
-     */
-    int ret = can_set_mode(dev, CAN_MODE_LOOPBACK);
-    if (ret != 0) {
-      LOG_ERR("Failed to set CAN mode: %d", ret);
-    }
-
-    ret = can_start(dev);
-    if (ret != 0) {
-      LOG_ERR("Failed to start CAN controller: %d", ret);
-    }
-
-    LOG_INF("SimWheel initialized successfully (Virtual Loopback Mode)");
-  }
-
-  /**
-   * @brief Simulates a gear shift operation and transmits the state via CAN.
-   * Cycles through gears N(0) -> 1..6 -> N(0).
-   */
-  void shift_gear() {
-    struct can_frame frame = {0};
-
-    /* Update Gear Logic using overloaded operator */
-    ++current_gear;
-
-    /* Prepare CAN Frame */
-    frame.id = Config::CAN_GEAR_MSG_ID;
-    frame.dlc = Config::CAN_MSG_DLC;
-    // Explicit cast required for type safety (Enum Class -> uint8_t)
-    frame.data[0] = static_cast<uint8_t>(current_gear);
-
-    /* Transmit Frame (Non-blocking with timeout) */
-    int ret = can_send(dev, &frame, Config::TX_TIMEOUT, NULL, NULL);
-
-    if (ret == 0) {
-      // Cast for logging display
-      LOG_INF("[TX] Gear Shifted -> %d", static_cast<uint8_t>(current_gear));
-    } else {
-      LOG_ERR("CAN Send Failed (Error: %d)", ret);
-    }
-  }
-};
+#include "blackbox.hpp"
+#include "bus_budget.hpp"
+#include "car_profiles.hpp"
+#include "core/scheduler.hpp"
+#include "crash_ring.hpp"
+#include "diagnostics.hpp"
+#include "liveness.hpp"
+#include "network_mgmt.hpp"
+#include "redundancy.hpp"
+#include "rx_handler.hpp"
+#include "secoc.hpp"
+#include "signal_agg.hpp"
+#include "slcan.hpp"
+#include "sim_wheel.hpp"
+#include "sniffer.hpp"
+#include "subscriptions.hpp"
 
 /* Retrieve the CAN device from DeviceTree (Virtual or Physical) */
 const struct device* const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
 
+/* Bus overload is a build error, not something to find on track */
+static_assert(BusBudget::BITRATE > 0,
+              "zephyr,canbus has no bitrate in the devicetree");
+static_assert(BusBudget::node_ppm() <= BusBudget::LIMIT_PPM,
+              "Worst-case TX load exceeds CONFIG_APP_BUS_LOAD_LIMIT_PERCENT "
+              "of the zephyr,canbus bitrate");
+
 /**
  * @brief TX Thread Entry Point
  * * Runs the main application logic. The SimWheel object is allocated
  * on the stack to prevent memory fragmentation (No-Heap policy).
+ * Messages are released by the scheduler at absolute times, so the time
+ * spent sending does not stretch the period. A car profile switch is
+ * applied between two polls: the scheduler moves to the new table and
+ * releases all of its messages at once, so TX never pauses. While the
+ * network sleeps (CanNm) nothing is sent; on wake-up the schedule restarts
+ * from the wake time. Nothing is sent either while the node only listens.
  */
 void tx_thread_entry(void* arg1, void* arg2, void* arg3) {
   SimWheel myWheel(can_dev);
+  const ProfileTables* tables = &car_profile_tables();
+  PeriodicScheduler scheduler(tables->schedule, k_uptime_get());
+
+  myWheel.set_profile(*tables->profile);
+
+  /* NM PDUs, heartbeats, aggregates and frames injected from a PC need
+   * the controller that SimWheel started */
+  nm_init(can_dev);
+  liveness_init(can_dev);
+  signal_agg_init(can_dev);
+  sniffer_init(can_dev);
+  slcan_init(can_dev);
 
   while (1) {
-    myWheel.shift_gear();
-    k_sleep(Config::GEAR_SHIFT_INTERVAL);
+    if (!nm_network_mode()) {
+      nm_wait_network();
+      scheduler.rebind(tables->schedule, k_uptime_get());
+    }
+    scheduler.poll(k_uptime_get(), [&](const MessageSpec& msg) {
+      if (sniffer_listening()) {
+        return;  // A listen-only controller must not transmit
+      }
+      if (msg.id == tables->profile->gear_layout.id) {
+        myWheel.shift_gear();
+      } else if (msg.id == Config::CAN_DIAG_MSG_ID) {
+        diag_send(redundancy_tx_device(can_dev));
+      }
+    });
+    node_stats.deadline_misses.store(scheduler.deadline_misses(),
+                                     std::memory_order_relaxed);
+    crash_ring_note_schedule(
+        static_cast<uint8_t>(tables->profile - Config::CAR_PROFILES.data()),
+        k_uptime_get(), scheduler.next_due_ms());
+    blackbox_note_deadline_misses(scheduler.deadline_misses());
+
+    const ProfileTables* next = car_profile_apply(can_dev);
+    if (next != nullptr) {
+      tables = next;
+      myWheel.set_profile(*tables->profile);
+      scheduler.rebind(tables->schedule, k_uptime_get());
+      continue;
+    }
+    car_profile_wait(scheduler.next_due_ms());
   }
 }
 
 /**
- * @brief CAN RX Callback
- * * Interrupt context callback for processing received CAN frames.
+ * @brief CAN State Change Callback
+ * * Feeds the bus-off counter and the redundancy failover (both buses),
+ * and freezes the black box on bus-off.
  */
-void can_rx_callback(const struct device* dev, struct can_frame* frame,
-                     void* user_data) {
-  if (frame->id == Config::CAN_GEAR_MSG_ID) {
-    LOG_INF(">>> [RX] Base Unit received Gear: %d", frame->data[0]);
+void can_state_callback(const struct device* dev, enum can_state state,
+                        struct can_bus_err_cnt err_cnt, void* user_data) {
+  diag_state_change_callback(dev, state, err_cnt, user_data);
+  redundancy_note_state(dev, state);
+
+  if (state == CAN_STATE_BUS_OFF) {
+    blackbox_trigger(BlackboxTrigger::BusOff);
   }
 }
 
@@ -129,11 +115,19 @@ K_THREAD_DEFINE(tx_tid, Config::TX_THREAD_STACK_SIZE, tx_thread_entry, NULL,
                 NULL, NULL, Config::TX_THREAD_PRIORITY, 0, 0);
 
 int main(void) {
-  /* Configure RX Filter to accept specific IDs */
-  struct can_filter filter = {.id = Config::CAN_GEAR_MSG_ID,
-                              .mask = CAN_STD_ID_MASK};
+  /* RX filters of the default car profile (gear echo, diagnostic
+   * requests); switches replace them from the TX thread */
+  car_profiles_init(can_dev);
+  subscriptions_init(can_dev);
 
-  can_add_rx_filter(can_dev, &can_rx_callback, NULL, &filter);
+  /* TX freshness from before a warm reset, sync frames from the sender */
+  secoc_init(can_dev);
+
+  /* Bus-off accounting for diagnostics and the black box */
+  can_set_state_change_callback(can_dev, can_state_callback, NULL);
+
+  /* Second controller for gear frames, same callback */
+  redundancy_init(can_dev, can_state_callback);
 
   return 0;
-}
\ No newline at end of file
+}
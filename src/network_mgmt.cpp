@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * CanNm network management (CONFIG_APP_CAN_NM)
+ *
+ * One thread owns the core/can_nm.hpp state machine. NM PDUs from other
+ * nodes reach it through a queue filled by the RX filter callback; local
+ * requests and releases through an atomic flag. The TX thread only reads
+ * the published network-mode event.
+ */
+
+#include "network_mgmt.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+#include <atomic>
+
+#include "app_config.hpp"
+#include "core/spsc_queue.hpp"
+#include "diagnostics.hpp"
+#include "slcan.hpp"
+#include "sniffer.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+constexpr uint8_t NODE_ID = CONFIG_APP_NODE_ID;
+constexpr uint32_t EVT_NETWORK = BIT(0);
+
+const struct device* nm_dev;
+CanNm nm(NODE_ID, {.msg_cycle_ms = CONFIG_APP_CAN_NM_MSG_CYCLE_MS,
+                   .timeout_ms = CONFIG_APP_CAN_NM_TIMEOUT_MS,
+                   .repeat_message_ms = CONFIG_APP_CAN_NM_REPEAT_MESSAGE_MS,
+                   .wait_bus_sleep_ms = CONFIG_APP_CAN_NM_WAIT_BUS_SLEEP_MS});
+
+SpscQueue<uint8_t, 16> rx_cbv;  // Control bits of received NM PDUs
+std::atomic<bool> demand{true};
+std::atomic<uint8_t> published{static_cast<uint8_t>(NmState::BusSleep)};
+uint64_t released_at_us;  // NM thread only
+
+K_SEM_DEFINE(nm_sem, 0, 1);
+K_EVENT_DEFINE(nm_events);
+
+uint64_t now_us() { return k_ticks_to_us_floor64(k_uptime_ticks()); }
+
+void nm_rx_callback(const struct device* dev, struct can_frame* frame,
+                    void* user_data) {
+  uint8_t node;
+  uint8_t cbv;
+
+  /* Our own PDUs come back in loopback mode */
+  if (!decode_nm_frame(*frame, node, cbv) || node == NODE_ID) {
+    return;
+  }
+  if (rx_cbv.push(cbv)) {
+    k_sem_give(&nm_sem);
+  }
+}
+
+void publish(uint64_t now) {
+  NmState prev = static_cast<NmState>(published.load());
+  NmState st = nm.state();
+
+  if (st == prev) {
+    return;
+  }
+  published.store(static_cast<uint8_t>(st));
+
+  if (CanNm::in_network_mode(st)) {
+    k_event_post(&nm_events, EVT_NETWORK);
+  } else {
+    k_event_clear(&nm_events, EVT_NETWORK);
+  }
+
+  if (st == NmState::BusSleep && !demand.load()) {
+    LOG_INF("NM %s -> %s, %u ms after release", nm_state_name(prev),
+            nm_state_name(st),
+            static_cast<uint32_t>((now - released_at_us) / 1000));
+  } else {
+    LOG_INF("NM %s -> %s", nm_state_name(prev), nm_state_name(st));
+  }
+}
+
+void nm_thread_entry(void* arg1, void* arg2, void* arg3) {
+  while (1) {
+    uint64_t now = now_us();
+    uint8_t cbv;
+
+    bool want = demand.load();
+    if (want && !nm.network_requested()) {
+      nm.network_request(now);
+    } else if (!want && nm.network_requested()) {
+      released_at_us = now;
+      nm.network_release(now);
+    }
+
+    while (rx_cbv.pop(cbv)) {
+      nm.on_rx(cbv, now);
+    }
+
+    /* A listening node takes no part in the vote: peers may sleep */
+    if (nm.poll(now, cbv) && !sniffer_listening()) {
+      struct can_frame frame;
+
+      encode_nm_frame(NODE_ID, cbv, frame);
+      if (can_send(nm_dev, &frame, K_NO_WAIT, NULL, NULL) != 0) {
+        NodeStats::bump(node_stats.tx_errors);
+      } else {
+        slcan_record_tx(nm_dev, frame);
+      }
+    }
+    publish(now);
+
+    uint64_t next = nm.next_event_us();
+    k_sem_take(&nm_sem, (next == UINT64_MAX) ? K_FOREVER
+                                               : K_TIMEOUT_ABS_US(next));
+  }
+}
+}  // namespace
+
+/* Started by nm_init() once the controller is up */
+K_THREAD_DEFINE(nm_tid, Config::NM_THREAD_STACK_SIZE, nm_thread_entry, NULL,
+                NULL, NULL, Config::NM_THREAD_PRIORITY, 0, K_TICKS_FOREVER);
+
+void nm_init(const struct device* dev) {
+  const struct can_filter filter = {.id = Config::CAN_NM_BASE_ID,
+                                    .mask = Config::CAN_NM_ID_MASK,
+                                    .flags = 0};
+
+  nm_dev = dev;
+  if (can_add_rx_filter(dev, nm_rx_callback, NULL, &filter) < 0) {
+    LOG_ERR("NM PDU filter not added; remote wake-up disabled");
+  }
+  k_thread_start(nm_tid);
+}
+
+void nm_request() {
+  demand.store(true);
+  k_sem_give(&nm_sem);
+}
+
+void nm_release() {
+  demand.store(false);
+  k_sem_give(&nm_sem);
+}
+
+bool nm_network_mode() {
+  return CanNm::in_network_mode(static_cast<NmState>(published.load()));
+}
+
+void nm_wait_network() {
+  k_event_wait(&nm_events, EVT_NETWORK, false, K_FOREVER);
+}
+
+NmState nm_state() { return static_cast<NmState>(published.load()); }
+
+#if defined(CONFIG_SHELL)
+namespace {
+int cmd_request(const struct shell* sh, size_t argc, char** argv) {
+  nm_request();
+  return 0;
+}
+
+int cmd_release(const struct shell* sh, size_t argc, char** argv) {
+  nm_release();
+  return 0;
+}
+
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  /* Counters are owned by the NM thread; a torn read only skews output */
+  const NmStats& s = nm.stats();
+
+  shell_print(sh, "node 0x%02x %s, %s locally", NODE_ID,
+              nm_state_name(nm_state()),
+              demand.load() ? "requested" : "released");
+  shell_print(sh, "pdus sent %u received %u, sleeps %u, wakeups %u",
+              s.pdus_sent, s.pdus_received, s.sleeps, s.wakeups);
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    nm_cmds,
+    SHELL_CMD(request, NULL, "Keep the bus awake (wakes it if asleep)",
+              cmd_request),
+    SHELL_CMD(release, NULL, "Let the bus sleep once all nodes agree",
+              cmd_release),
+    SHELL_CMD(status, NULL, "NM state and counters", cmd_status),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(nm, &nm_cmds, "CanNm network management", NULL);
+#endif /* CONFIG_SHELL */
@@ -0,0 +1,51 @@
+/*
+ * src/network_mgmt.hpp
+ * CanNm network management: coordinated bus sleep and wake-up
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#if defined(CONFIG_APP_CAN_NM)
+
+#include "core/can_nm.hpp"
+
+/**
+ * @brief Install the NM PDU filter and start the NM thread.
+ * * The node requests the network at boot, so it comes up awake and
+ * wakes any sleeping peers.
+ */
+void nm_init(const struct device* dev);
+
+/**
+ * @brief This node needs the bus (again); wakes the network if asleep.
+ */
+void nm_request();
+
+/**
+ * @brief This node no longer needs the bus. The bus sleeps once every
+ * node has released it.
+ */
+void nm_release();
+
+/**
+ * @brief Whether application frames may be sent (RepeatMessage,
+ * NormalOperation or ReadySleep).
+ */
+bool nm_network_mode();
+
+/**
+ * @brief Block until the network is up again; returns at once if it is.
+ */
+void nm_wait_network();
+
+NmState nm_state();
+
+#else
+
+inline void nm_init(const struct device*) {}
+inline bool nm_network_mode() { return true; }
+inline void nm_wait_network() {}
+
+#endif /* CONFIG_APP_CAN_NM */
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Redundant gear frames (CONFIG_APP_CAN_REDUNDANCY)
+ *
+ * Gear frames carry an alive counter and go out on zephyr,canbus and on
+ * simrig,canbus-redundant. Either bus alone keeps the shifter working:
+ * the receiver keeps the first copy of each counter. A bus that reports
+ * error-passive or bus-off, or keeps failing to send, leaves service at
+ * once and the node runs single-bus until it has recovered.
+ */
+
+#include "redundancy.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/spinlock.h>
+
+#include "rx_handler.hpp"
+#include "sim_wheel.hpp"
+
+#if defined(CONFIG_APP_SECOC)
+#include "core/secoc.hpp"
+#endif
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+constexpr bool profiles_fit() {
+  for (const CarProfile& car : Config::CAR_PROFILES) {
+    size_t dlc = car.gear_layout.dlc + Redundancy::ALIVE_BYTES;
+#if defined(CONFIG_APP_SECOC)
+    dlc += SECOC_AUTH_BYTES;
+#endif
+    if (dlc > CAN_MAX_DLEN) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(profiles_fit(),
+              "A gear frame leaves no room for the alive counter");
+
+const struct device* const redundant_dev =
+    DEVICE_DT_GET(DT_CHOSEN(simrig_canbus_redundant));
+
+constexpr size_t PRIMARY = 0;
+constexpr size_t REDUNDANT = 1;
+constexpr int64_t RESTART_US =
+    int64_t{CONFIG_APP_CAN_REDUNDANCY_RESTART_MS} * 1000;
+
+atomic_t started;  // Until redundancy_init(), gear frames use primary only
+struct k_spinlock lock;  // failover: TX thread and state callbacks
+BusFailover<2> failover(CONFIG_APP_CAN_REDUNDANCY_FAIL_AFTER,
+                        int64_t{CONFIG_APP_CAN_REDUNDANCY_RECOVER_MS} * 1000);
+uint32_t tx_frames[2];  // TX thread
+uint32_t tx_errors[2];
+uint8_t tx_alive;
+AliveFilter rx_alive(RESTART_US);  // RX thread
+
+int64_t now_us() { return k_ticks_to_us_floor64(k_uptime_ticks()); }
+
+size_t bus_of(const struct device* dev) {
+  return (dev == redundant_dev) ? REDUNDANT : PRIMARY;
+}
+
+void log_failover(size_t bus) {
+  LOG_WRN("CAN bus %u out of service after %u us, single-bus",
+          static_cast<uint32_t>(bus),
+          static_cast<uint32_t>(failover.last_failover_us()));
+}
+
+/* Every profile's gear frame and diagnostic requests, so the wheel stays
+ * reachable on either bus; requests are served from one of them */
+int add_rx_filters() {
+  for (size_t i = 0; i < Config::CAR_PROFILES.size(); i++) {
+    uint32_t id = Config::CAR_PROFILES[i].gear_layout.id;
+    bool seen = false;
+
+    for (size_t j = 0; j < i; j++) {
+      seen |= Config::CAR_PROFILES[j].gear_layout.id == id;
+    }
+    if (seen) {
+      continue;
+    }
+
+    struct can_filter filter = Config::std_filter(id);
+    int ret = can_add_rx_filter(redundant_dev, can_rx_redundant_callback, NULL,
+                                &filter);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  struct can_filter diag = Config::std_filter(Config::CAN_DIAG_REQ_MSG_ID);
+  int ret = can_add_rx_filter(redundant_dev, can_rx_redundant_callback, NULL,
+                              &diag);
+  return (ret < 0) ? ret : 0;
+}
+}  // namespace
+
+int redundancy_init(const struct device* primary,
+                    can_state_change_callback_t state_cb) {
+  if (!device_is_ready(redundant_dev)) {
+    LOG_ERR("Redundant CAN device not ready");
+    return -ENODEV;
+  }
+
+  int ret = can_set_mode(redundant_dev, BOOT_CAN_MODE);
+  if (ret == 0) {
+    ret = can_start(redundant_dev);
+  }
+  if (ret == 0) {
+    ret = add_rx_filters();
+  }
+  if (ret != 0) {
+    LOG_ERR("Redundant CAN bus not started (%d)", ret);
+    return ret;
+  }
+
+  can_set_state_change_callback(redundant_dev, state_cb, NULL);
+  atomic_set(&started, 1);
+  LOG_INF("Gear frames on %s and %s", primary->name, redundant_dev->name);
+  return 0;
+}
+
+int redundancy_send(const struct device* primary, struct can_frame& frame) {
+  if (!Redundancy::append_alive(frame, tx_alive)) {
+    return -EMSGSIZE;
+  }
+  tx_alive++;
+
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  size_t back = failover.poll(now_us());
+  uint32_t mask = failover.mask();
+  k_spin_unlock(&lock, key);
+
+  if (!atomic_get(&started)) {
+    mask = BIT(PRIMARY);
+  }
+
+  if (back != 0) {
+    LOG_INF("CAN redundancy restored (buses 0x%x)", mask);
+  }
+
+  /* Waiting on one bus must not delay the copy on the other */
+  k_timeout_t timeout = (mask == BIT_MASK(2)) ? K_NO_WAIT : Config::TX_TIMEOUT;
+  int result = -ENETDOWN;
+
+  for (size_t bus = 0; bus < 2; bus++) {
+    if ((mask & BIT(bus)) == 0) {
+      continue;
+    }
+
+    const struct device* dev = (bus == PRIMARY) ? primary : redundant_dev;
+    int ret = can_send(dev, &frame, timeout, NULL, NULL);
+
+    key = k_spin_lock(&lock);
+    bool out = failover.note_tx(bus, ret == 0, now_us());
+    k_spin_unlock(&lock, key);
+
+    if (ret == 0) {
+      tx_frames[bus]++;
+      result = 0;
+    } else {
+      tx_errors[bus]++;
+      result = (result == 0) ? 0 : ret;
+    }
+    if (out) {
+      log_failover(bus);
+    }
+  }
+  return result;
+}
+
+void redundancy_note_state(const struct device* dev, enum can_state state) {
+  bool ok = state == CAN_STATE_ERROR_ACTIVE || state == CAN_STATE_ERROR_WARNING;
+  size_t bus = bus_of(dev);
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  bool out = failover.note_state(bus, ok, now_us());
+  k_spin_unlock(&lock, key);
+
+  if (out) {
+    log_failover(bus);
+  }
+}
+
+bool redundancy_unwrap(struct can_frame& frame, uint8_t& alive) {
+  return Redundancy::strip_alive(frame, alive) &&
+         rx_alive.check(alive, now_us()) == AliveVerdict::New;
+}
+
+void redundancy_accept(uint8_t alive) { rx_alive.accept(alive, now_us()); }
+
+const struct device* redundancy_tx_device(const struct device* primary) {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  bool primary_ok = failover.in_service(PRIMARY);
+  k_spin_unlock(&lock, key);
+
+  return primary_ok ? primary : redundant_dev;
+}
+
+bool redundancy_serves(bool redundant) {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  bool primary_ok = failover.in_service(PRIMARY);
+  k_spin_unlock(&lock, key);
+
+  return primary_ok != redundant;
+}
+
+RedundancyStatus redundancy_status() {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  RedundancyStatus st = {
+      .in_service = failover.mask(),
+      .failovers = failover.failovers(),
+      .recoveries = failover.recoveries(),
+      .last_failover_us = static_cast<uint32_t>(failover.last_failover_us()),
+      .max_failover_us = static_cast<uint32_t>(failover.max_failover_us()),
+      .tx_frames = {tx_frames[PRIMARY], tx_frames[REDUNDANT]},
+      .tx_errors = {tx_errors[PRIMARY], tx_errors[REDUNDANT]},
+      .rx_accepted = rx_alive.accepted(),
+      .rx_duplicates = rx_alive.duplicates(),
+      .rx_stale = rx_alive.stale(),
+      .rx_lost = rx_alive.lost(),
+  };
+  k_spin_unlock(&lock, key);
+  return st;
+}
+
+#if defined(CONFIG_SHELL)
+namespace {
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  RedundancyStatus st = redundancy_status();
+
+  for (size_t bus = 0; bus < 2; bus++) {
+    shell_print(sh, "bus %u (%s): %s, tx %u, errors %u",
+                static_cast<uint32_t>(bus),
+                (bus == PRIMARY) ? "zephyr,canbus" : redundant_dev->name,
+                (st.in_service & BIT(bus)) ? "in service" : "OUT",
+                st.tx_frames[bus], st.tx_errors[bus]);
+  }
+  shell_print(sh, "failovers %u (last %u us, max %u us), recoveries %u",
+              st.failovers, st.last_failover_us, st.max_failover_us,
+              st.recoveries);
+  shell_print(sh, "rx accepted %u, duplicates %u, stale %u, lost %u",
+              st.rx_accepted, st.rx_duplicates, st.rx_stale, st.rx_lost);
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    redund_cmds,
+    SHELL_CMD(status, NULL, "Buses in service, failovers, RX dedup",
+              cmd_status),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(redund, &redund_cmds, "Redundant gear frames", NULL);
+#endif /* CONFIG_SHELL */
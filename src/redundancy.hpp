@@ -0,0 +1,101 @@
+/*
+ * src/redundancy.hpp
+ * Gear frames on two CAN controllers with receiver dedup and failover
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstdint>  // uint8_t, uint32_t
+
+#include "app_config.hpp"
+#include "core/redundancy.hpp"
+
+struct RedundancyStatus {
+  uint32_t in_service;  // Bit 0: zephyr,canbus, bit 1: the redundant bus
+  uint32_t failovers;
+  uint32_t recoveries;
+  uint32_t last_failover_us;  // First fault to single-bus operation
+  uint32_t max_failover_us;
+  uint32_t tx_frames[2];
+  uint32_t tx_errors[2];
+  uint32_t rx_accepted;
+  uint32_t rx_duplicates;
+  uint32_t rx_stale;
+  uint32_t rx_lost;  // Counters that arrived on neither bus
+};
+
+#if defined(CONFIG_APP_CAN_REDUNDANCY)
+
+/**
+ * @brief Start the redundant controller (simrig,canbus-redundant).
+ * * Same mode as primary, the critical RX filters on it, and state_cb as
+ * its state change callback; the application's callback for both buses
+ * must forward to redundancy_note_state().
+ */
+int redundancy_init(const struct device* primary,
+                    can_state_change_callback_t state_cb);
+
+/**
+ * @brief Append the alive counter and send a critical frame on every bus
+ * in service.
+ * * TX thread only. With both buses in service neither send waits, so a
+ * dead controller cannot hold up the other; with one, it waits up to
+ * Config::TX_TIMEOUT as a plain can_send() would.
+ * * @return 0 if at least one bus took the frame, -EMSGSIZE if there is
+ * no room for the counter, otherwise the last can_send() error
+ */
+int redundancy_send(const struct device* primary, struct can_frame& frame);
+
+/**
+ * @brief Feed a controller state change; safe from ISR.
+ */
+void redundancy_note_state(const struct device* dev, enum can_state state);
+
+/**
+ * @brief Strip the alive counter of a received critical frame.
+ * * RX thread only.
+ * * @return false if the frame is a copy already seen on the other bus
+ */
+bool redundancy_unwrap(struct can_frame& frame, uint8_t& alive);
+
+/**
+ * @brief The unwrapped frame passed its checks; drop later copies.
+ */
+void redundancy_accept(uint8_t alive);
+
+/**
+ * @brief Controller for non-critical frames: primary while it is in
+ * service, otherwise the redundant one.
+ */
+const struct device* redundancy_tx_device(const struct device* primary);
+
+/**
+ * @brief Whether requests received on this bus are served.
+ * * Diagnostic requests arrive on both buses; only the copy from the bus
+ * redundancy_tx_device() picks runs, so a command runs once.
+ */
+bool redundancy_serves(bool redundant);
+
+RedundancyStatus redundancy_status();
+
+#else
+
+inline int redundancy_init(const struct device*, can_state_change_callback_t) {
+  return 0;
+}
+inline int redundancy_send(const struct device* primary,
+                           struct can_frame& frame) {
+  return can_send(primary, &frame, Config::TX_TIMEOUT, NULL, NULL);
+}
+inline void redundancy_note_state(const struct device*, enum can_state) {}
+inline bool redundancy_unwrap(struct can_frame&, uint8_t&) { return true; }
+inline void redundancy_accept(uint8_t) {}
+inline const struct device* redundancy_tx_device(
+    const struct device* primary) {
+  return primary;
+}
+inline bool redundancy_serves(bool redundant) { return !redundant; }
+
+#endif /* CONFIG_APP_CAN_REDUNDANCY */
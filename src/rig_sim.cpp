@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Multi-node rig simulation shell command (CONFIG_APP_RIG_SIM)
+ *
+ * Runs core/rig_sim.hpp inside the image: up to CONFIG_APP_RIG_SIM_MAX_NODES
+ * base, pedal and wheel nodes on one simulated bus, in simulated time, so
+ * the result does not depend on the host's scheduling.
+ */
+
+#include <zephyr/shell/shell.h>
+
+#include <cstdlib>
+
+#include "core/nm_sim.hpp"
+#include "core/rig_sim.hpp"
+
+namespace {
+constexpr size_t MAX_NODES = CONFIG_APP_RIG_SIM_MAX_NODES;
+constexpr uint32_t DEFAULT_BITRATE = 500000;
+constexpr uint32_t RUN_MS = 1000;
+
+/* Several KB, too large for the shell stack; reset() reuses it in place */
+RigSim<MAX_NODES> sim(0, DEFAULT_BITRATE);
+NmSim<MAX_NODES> nm_sim(0, DEFAULT_BITRATE);
+
+uint32_t us(uint64_t ns) { return static_cast<uint32_t>(ns / 1000); }
+
+bool parse_args(const struct shell* sh, size_t argc, char** argv,
+                size_t& nodes, uint32_t& bitrate) {
+  nodes = (argc > 1) ? strtoul(argv[1], NULL, 0) : MAX_NODES;
+  bitrate = (argc > 2) ? strtoul(argv[2], NULL, 0) : DEFAULT_BITRATE;
+
+  if (nodes == 0 || nodes > MAX_NODES || bitrate == 0) {
+    shell_error(sh, "1..%zu nodes, bitrate > 0", MAX_NODES);
+    return false;
+  }
+  return true;
+}
+
+int cmd_run(const struct shell* sh, size_t argc, char** argv) {
+  size_t nodes;
+  uint32_t bitrate;
+
+  if (!parse_args(sh, argc, argv, nodes, bitrate)) {
+    return -EINVAL;
+  }
+
+  sim.reset(nodes, bitrate);
+  RigReport r = sim.run(RUN_MS);
+
+  shell_print(sh, "%zu nodes at %u bit/s: load %u.%u %%, %u frames",
+              nodes, bitrate, r.load_permille() / 10, r.load_permille() % 10,
+              r.frames);
+  for (size_t n = 0; n < sim.size(); n++) {
+    const RigNodeStats& s = sim.node(n);
+    uint64_t mean = (s.sent != 0) ? s.latency_sum_ns / s.sent : 0;
+
+    shell_print(sh, "%2zu %-6s sent %4u drop %4u unsent %u miss %4u mean "
+                "%5u us max %7u us",
+                n, rig_node_profile(rig_node_kind(n)).name, s.sent,
+                s.dropped, s.unsent, s.deadline_misses, us(mean),
+                us(s.max_latency_ns));
+  }
+  return 0;
+}
+
+int cmd_sweep(const struct shell* sh, size_t argc, char** argv) {
+  size_t nodes;
+  uint32_t bitrate;
+
+  if (!parse_args(sh, argc, argv, nodes, bitrate)) {
+    return -EINVAL;
+  }
+
+  shell_print(sh, "nodes load_%%   max_us  miss  drop unsent");
+  for (size_t n = 1; n <= nodes; n++) {
+    sim.reset(n, bitrate);
+    RigReport r = sim.run(RUN_MS);
+
+    shell_print(sh, "%5zu %4u.%u %8u %5u %5u %6u", n,
+                r.load_permille() / 10, r.load_permille() % 10,
+                us(r.max_latency_ns), r.deadline_misses, r.dropped,
+                r.unsent);
+  }
+  return 0;
+}
+
+int cmd_nm(const struct shell* sh, size_t argc, char** argv) {
+  constexpr uint32_t RELEASE_SPREAD_MS = 100;
+  size_t nodes;
+  uint32_t bitrate;
+
+  if (!parse_args(sh, argc, argv, nodes, bitrate)) {
+    return -EINVAL;
+  }
+
+  shell_print(sh, "nodes sleep_ms skew_us wake_us pdus");
+  for (size_t n = 1; n <= nodes; n++) {
+    nm_sim.reset(n, bitrate);
+    NmSleepWakeReport r = nm_sim.sleep_wake(RELEASE_SPREAD_MS, n - 1);
+
+    if (!r.slept || !r.woke) {
+      shell_print(sh, "%5zu %s", n, r.slept ? "did not wake" : "no sleep");
+      continue;
+    }
+    shell_print(sh, "%5zu %8u %7u %7u %4u", n,
+                static_cast<uint32_t>(r.sleep_entry_us() / 1000),
+                static_cast<uint32_t>(r.sleep_skew_us()),
+                static_cast<uint32_t>(r.wake_latency_us()), r.pdus);
+  }
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    rig_cmds,
+    SHELL_CMD_ARG(run, NULL, "Per-node latency: run [nodes] [bitrate]",
+                  cmd_run, 1, 2),
+    SHELL_CMD_ARG(sweep, NULL, "Load/latency for 1..nodes: sweep [nodes] "
+                  "[bitrate]",
+                  cmd_sweep, 1, 2),
+    SHELL_CMD_ARG(nm, NULL, "CanNm sleep entry and wake-up latency for "
+                  "1..nodes: nm [nodes] [bitrate]",
+                  cmd_nm, 1, 2),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(rig, &rig_cmds, "Simulate N rig nodes on one bus", NULL);
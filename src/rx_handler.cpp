@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * RX path: the driver callback enqueues, a thread decodes and logs
+ */
+
+#include "rx_handler.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "app_config.hpp"
+#include "blackbox.hpp"
+#include "car_profiles.hpp"
+#include "core/diag_codec.hpp"
+#include "core/gear_codec.hpp"
+#include "core/spsc_queue.hpp"
+#include "crash_ring.hpp"
+#include "diagnostics.hpp"
+#include "hot_log.hpp"
+#include "redundancy.hpp"
+#include "secoc.hpp"
+#include "session_log.hpp"
+#include "sniffer.hpp"
+#include "subscriptions.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+using RxQueue = SpscQueue<struct can_frame, Config::RX_QUEUE_DEPTH>;
+
+/* One queue per controller: each has a single producer, its callback */
+RxQueue rx_queue;
+#if defined(CONFIG_APP_CAN_REDUNDANCY)
+RxQueue redundant_queue;
+#endif
+K_SEM_DEFINE(rx_sem, 0, 1);
+
+/* Per-frame logging, only ever touched by the RX thread */
+HotPathLog rx_log = make_hot_path_log();
+uint32_t rx_dropped_at_summary;
+
+void handle_diag_request(const struct can_frame& frame) {
+  if (frame.dlc < 1) {
+    return;
+  }
+
+  switch (static_cast<DiagCommand>(frame.data[0])) {
+    case DiagCommand::BlackboxFreeze:
+      blackbox_trigger(BlackboxTrigger::DiagnosticRequest);
+      break;
+    case DiagCommand::SelectProfile: {
+      int ret = (frame.dlc < 2) ? -EINVAL : car_profile_request(frame.data[1]);
+
+      if (ret != 0) {
+        LOG_WRN("Profile select rejected (%d)", ret);
+      }
+      break;
+    }
+    case DiagCommand::Subscribe:
+    case DiagCommand::Unsubscribe: {
+      bool add = frame.data[0] == static_cast<uint8_t>(DiagCommand::Subscribe);
+      uint32_t mask = uint32_t{frame.data[3]} << 8 | frame.data[4];
+      struct can_filter filter = {
+          .id = uint32_t{frame.data[1]} << 8 | frame.data[2],
+          .mask = (frame.dlc < 5) ? CAN_STD_ID_MASK : mask,
+          .flags = 0};
+      int ret = (frame.dlc < 3 || filter.id > CAN_STD_ID_MASK ||
+                 filter.mask > CAN_STD_ID_MASK)
+                    ? -EINVAL
+                    : subscription_request(filter, add);
+
+      if (ret != 0) {
+        LOG_WRN("Subscription request rejected (%d)", ret);
+      }
+      break;
+    }
+    case DiagCommand::CrashReport: {
+      int ret = sniffer_listening() ? -EACCES : crash_ring_send_report();
+
+      if (ret != 0) {
+        LOG_WRN("Crash report not sent (%d)", ret);
+      }
+      break;
+    }
+    default:
+      LOG_WRN("Unknown diagnostic command 0x%02x", frame.data[0]);
+      break;
+  }
+}
+
+/* Gear frames of the previous profile may still be queued after a switch */
+bool is_gear_frame(const struct can_frame& frame, const CarProfile& current,
+                   const CarProfile* previous) {
+  return frame.id == current.gear_layout.id ||
+         (previous != nullptr && frame.id == previous->gear_layout.id);
+}
+
+void process_frame(struct can_frame& frame, bool redundant) {
+  const CarProfile* previous = car_profile_previous();
+  const CarProfile& current = car_profile_current();
+  Gear gear;
+  uint8_t alive;
+
+  if (frame.id == Config::CAN_DIAG_REQ_MSG_ID) {
+    /* Sent on both buses: run the command once */
+    if (redundancy_serves(redundant)) {
+      handle_diag_request(frame);
+    }
+  } else if (frame.id == Config::CAN_SECOC_SYNC_MSG_ID) {
+    secoc_sync(frame);
+  } else if (frame.id == Config::CAN_SECOC_FV_REQ_MSG_ID) {
+    secoc_fv_request(frame);
+  } else if (frame.id == Config::CAN_SECOC_FV_ANSWER_MSG_ID) {
+    secoc_fv_answer(frame);
+  } else if (is_gear_frame(frame, current, previous) &&
+             redundancy_unwrap(frame, alive) && secoc_verify(frame) &&
+             decode_gear_frame(frame, current, previous, gear)) {
+    redundancy_accept(alive);
+    HOT_LOG_INF(rx_log, k_uptime_get(), ">>> [RX] Base Unit received Gear: %d",
+                static_cast<uint8_t>(gear));
+  }
+}
+
+void log_rx_summary() {
+  EventSummary summary;
+
+  if (!rx_log.summary(k_uptime_get(), summary)) {
+    return;
+  }
+
+  /* Queue drops happen in the driver callback, count them per window */
+  uint32_t dropped = NodeStats::read(node_stats.rx_dropped);
+  LOG_INF("[RX] %u gear frames in last %u ms, %u dropped (%u lines "
+          "suppressed)",
+          summary.events, summary.window_ms, dropped - rx_dropped_at_summary,
+          summary.suppressed);
+  rx_dropped_at_summary = dropped;
+}
+
+void enqueue(RxQueue& queue, const struct can_frame& frame) {
+  blackbox_record(frame, FrameDir::Rx);
+  crash_ring_record(frame, FrameDir::Rx);
+  session_log_record(frame, FrameDir::Rx);
+
+  if (!queue.push(frame)) {
+    NodeStats::bump(node_stats.rx_dropped);
+    return;
+  }
+  NodeStats::bump(node_stats.rx_frames);
+  k_sem_give(&rx_sem);
+}
+
+/* Alternate between the buses so their copies keep roughly arrival order */
+void drain_queues() {
+  struct can_frame frame;
+  bool more = true;
+
+  while (more) {
+    more = false;
+    if (rx_queue.pop(frame)) {
+      process_frame(frame, false);
+      more = true;
+    }
+#if defined(CONFIG_APP_CAN_REDUNDANCY)
+    if (redundant_queue.pop(frame)) {
+      process_frame(frame, true);
+      more = true;
+    }
+#endif
+  }
+}
+}  // namespace
+
+void can_rx_callback(const struct device* dev, struct can_frame* frame,
+                     void* user_data) {
+  enqueue(rx_queue, *frame);
+}
+
+#if defined(CONFIG_APP_CAN_REDUNDANCY)
+void can_rx_redundant_callback(const struct device* dev,
+                               struct can_frame* frame, void* user_data) {
+  enqueue(redundant_queue, *frame);
+}
+#endif
+
+void rx_process_frame(struct can_frame& frame) { process_frame(frame, false); }
+
+size_t rx_queue_high_watermark() {
+#if defined(CONFIG_APP_CAN_REDUNDANCY)
+  return MAX(rx_queue.high_watermark(), redundant_queue.high_watermark());
+#else
+  return rx_queue.high_watermark();
+#endif
+}
+
+void rx_thread_wake() { k_sem_give(&rx_sem); }
+
+/**
+ * @brief RX Thread Entry Point
+ * * Drains the RX queues so logging never runs in the driver callback.
+ */
+void rx_thread_entry(void* arg1, void* arg2, void* arg3) {
+  while (1) {
+    k_sem_take(&rx_sem, K_FOREVER);
+    subscriptions_apply();
+    drain_queues();
+    subscriptions_drain();
+    log_rx_summary();
+  }
+}
+
+K_THREAD_DEFINE(rx_tid, Config::RX_THREAD_STACK_SIZE, rx_thread_entry, NULL,
+                NULL, NULL, Config::RX_THREAD_PRIORITY, 0, 0);
@@ -0,0 +1,44 @@
+/*
+ * src/rx_handler.hpp
+ * Base unit side of the bus: RX callback and deferred frame processing
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstddef>  // size_t
+
+/**
+ * @brief CAN RX Callback
+ * * Interrupt context callback for received CAN frames. Only queues the
+ * frame; decoding and logging happen in the RX thread.
+ */
+void can_rx_callback(const struct device* dev, struct can_frame* frame,
+                     void* user_data);
+
+/**
+ * @brief CAN RX Callback for the redundant controller
+ * * Same as can_rx_callback() with a queue of its own, since the two
+ * controllers' callbacks may run at the same time.
+ */
+void can_rx_redundant_callback(const struct device* dev,
+                               struct can_frame* frame, void* user_data);
+
+/**
+ * @brief Decode and log one frame the way the RX thread does.
+ * * For benchmarks: the caller must run while the RX thread is idle, since
+ * the per-frame log state belongs to that thread.
+ */
+void rx_process_frame(struct can_frame& frame);
+
+/**
+ * @brief Highest RX queue fill level since boot, over both controllers.
+ */
+size_t rx_queue_high_watermark();
+
+/**
+ * @brief Wake the RX thread to apply subscription changes or drain the
+ * subscribed frames. Safe from the driver callback.
+ */
+void rx_thread_wake();
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authenticated gear frames (CONFIG_APP_SECOC)
+ *
+ * The key comes from Kconfig, so its AES key schedule and CMAC subkeys
+ * are expanded by the compiler and no cycles are spent on them at run
+ * time. Each gear frame then costs one AES block to protect or verify.
+ *
+ * The TX freshness value is kept in no-init RAM, so a warm reset neither
+ * reuses FVs nor throws the receivers out of sync. A sync frame with the
+ * full FV brings back receivers that restarted or lost too many frames;
+ * it never moves a receiver back. After a cold boot the sender asks for
+ * the receiver's FV with a fresh nonce and continues after it.
+ */
+
+#include "secoc.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/linker/section_tags.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/random/random.h>
+#include <zephyr/shell/shell.h>
+
+#include <array>
+#include <atomic>
+
+#include "app_config.hpp"
+#include "blackbox.hpp"
+#include "crash_ring.hpp"
+#include "diagnostics.hpp"
+#include "hot_log.hpp"
+#include "rx_handler.hpp"
+#include "session_log.hpp"
+#include "slcan.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+constexpr uint8_t hex_nibble(char c) {
+  return (c >= '0' && c <= '9')   ? c - '0'
+         : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+         : (c >= 'A' && c <= 'F') ? c - 'A' + 10
+                                  : 0xFF;
+}
+
+constexpr bool valid_key(const char* hex) {
+  for (size_t i = 0; i < 2 * Aes128::KEY_SIZE; i++) {
+    if (hex_nibble(hex[i]) == 0xFF) {
+      return false;
+    }
+  }
+  return hex[2 * Aes128::KEY_SIZE] == '\0';
+}
+
+constexpr std::array<uint8_t, Aes128::KEY_SIZE> parse_key(const char* hex) {
+  std::array<uint8_t, Aes128::KEY_SIZE> key{};
+
+  for (size_t i = 0; i < key.size(); i++) {
+    key[i] = static_cast<uint8_t>((hex_nibble(hex[2 * i]) << 4) |
+                                  hex_nibble(hex[2 * i + 1]));
+  }
+  return key;
+}
+
+static_assert(valid_key(CONFIG_APP_SECOC_KEY),
+              "CONFIG_APP_SECOC_KEY must be 32 hex digits");
+
+constexpr bool profiles_fit() {
+  for (const CarProfile& car : Config::CAR_PROFILES) {
+    if (car.gear_layout.dlc + SECOC_AUTH_BYTES > CAN_MAX_DLEN) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(profiles_fit(),
+              "A gear frame leaves no room for the SecOC authenticator");
+
+constexpr std::array<uint8_t, Aes128::KEY_SIZE> KEY =
+    parse_key(CONFIG_APP_SECOC_KEY);
+constinit const Cmac cmac(KEY.data());
+
+SecOcSender sender;      // TX thread
+SecOcReceiver receiver;  // RX thread
+const struct device* secoc_dev;  // FV answers
+
+/* Last FV used, with a check word; garbage after a cold boot */
+struct RetainedFreshness {
+  static constexpr uint64_t MAGIC = 0x5345434F46564331;  // "SECOFVC1"
+
+  uint64_t fv;
+  uint64_t check;
+
+  bool is_valid() const { return check == (fv ^ MAGIC); }
+};
+
+__noinit RetainedFreshness retained;
+int64_t last_sync_ms = -CONFIG_APP_SECOC_SYNC_MS;  // TX thread
+
+/* Cold boot: the nonce of the pending FV request (TX thread), and the FV
+ * from its answer (RX thread), which the TX thread takes up */
+std::atomic<bool> anchored{false};
+std::atomic<uint32_t> request_nonce{0};
+std::atomic<uint64_t> answered_fv{0};
+std::atomic<bool> answered{false};
+
+/* Owned by the TX and RX thread respectively; the shell only reads */
+uint32_t protected_frames;
+uint32_t verified_frames;
+uint32_t rejected_frames;
+uint32_t syncs_sent;
+uint32_t syncs_ignored;
+uint32_t fv_requests;
+uint32_t fv_answers;
+
+void sync_tx_done(const struct device* dev, int error, void* user_data) {
+  NodeStats::bump(error == 0 ? node_stats.tx_frames : node_stats.tx_errors);
+}
+
+HotPathLog reject_log = make_hot_path_log();
+
+int send_frame(const struct device* dev, const struct can_frame& frame) {
+  int ret = can_send(dev, &frame, K_NO_WAIT, sync_tx_done, NULL);
+
+  if (ret != 0) {
+    NodeStats::bump(node_stats.tx_errors);
+    return ret;
+  }
+  blackbox_record(frame, FrameDir::Tx);
+  crash_ring_record(frame, FrameDir::Tx);
+  session_log_record(frame, FrameDir::Tx);
+  slcan_record_tx(dev, frame);
+  return 0;
+}
+
+int add_filter(const struct device* dev, uint32_t id) {
+  struct can_filter filter = Config::std_filter(id);
+  int ret = can_add_rx_filter(dev, can_rx_callback, NULL, &filter);
+
+  if (ret < 0) {
+    LOG_ERR("SecOC filter 0x%03x not added (%d)", id, ret);
+    return ret;
+  }
+  return 0;
+}
+}  // namespace
+
+int secoc_init(const struct device* dev) {
+  secoc_dev = dev;
+  if (retained.is_valid()) {
+    sender.restore(retained.fv);
+    anchored = true;
+    LOG_INF("SecOC: TX freshness continues after %llu",
+            static_cast<unsigned long long>(retained.fv));
+  } else {
+    LOG_INF("SecOC: TX freshness lost, asking the receiver");
+  }
+
+  int ret = add_filter(dev, Config::CAN_SECOC_SYNC_MSG_ID);
+  if (ret == 0) {
+    ret = add_filter(dev, Config::CAN_SECOC_FV_REQ_MSG_ID);
+  }
+  if (ret == 0) {
+    ret = add_filter(dev, Config::CAN_SECOC_FV_ANSWER_MSG_ID);
+  }
+  return ret;
+}
+
+int secoc_protect(struct can_frame& frame) {
+  if (answered.exchange(false)) {
+    sender.restore(answered_fv.load());
+  }
+  if (!sender.protect(cmac, frame)) {
+    return -EMSGSIZE;
+  }
+
+  /* Before the frame goes out, so a reset never reuses its FV */
+  uint64_t fv = sender.freshness_value();
+  retained.fv = fv;
+  retained.check = fv ^ RetainedFreshness::MAGIC;
+  protected_frames++;
+  return 0;
+}
+
+void secoc_send_sync(const struct device* dev, int64_t now_ms) {
+  struct can_frame frame;
+
+  /* Until answered, every gear frame is followed by a new request */
+  if (!anchored) {
+    uint32_t nonce = sys_rand32_get();
+
+    request_nonce = nonce;
+    SecOcSender::fv_request(Config::CAN_SECOC_FV_REQ_MSG_ID, nonce, frame);
+    fv_requests += (send_frame(dev, frame) == 0) ? 1 : 0;
+    return;
+  }
+
+  if (now_ms - last_sync_ms < CONFIG_APP_SECOC_SYNC_MS) {
+    return;
+  }
+  last_sync_ms = now_ms;
+  sender.sync_frame(cmac, Config::CAN_SECOC_SYNC_MSG_ID, frame);
+  syncs_sent += (send_frame(dev, frame) == 0) ? 1 : 0;
+}
+
+void secoc_sync(const struct can_frame& frame) {
+  uint64_t before = receiver.freshness_value();
+  SecOcVerdict verdict = receiver.sync(cmac, frame);
+
+  if (verdict != SecOcVerdict::Ok) {
+    syncs_ignored++;
+    HOT_LOG_ERR(reject_log, k_uptime_get(), "[SecOC] sync ignored (%s)",
+                (verdict == SecOcVerdict::Behind) ? "behind" : "bad MAC");
+    return;
+  }
+  if (receiver.freshness_value() != before) {
+    LOG_WRN("SecOC: RX freshness %llu -> %llu",
+            static_cast<unsigned long long>(before),
+            static_cast<unsigned long long>(receiver.freshness_value()));
+  }
+}
+
+void secoc_fv_request(const struct can_frame& frame) {
+  struct can_frame answer;
+
+  if (secoc_dev != nullptr &&
+      receiver.fv_answer(cmac, Config::CAN_SECOC_FV_ANSWER_MSG_ID, frame,
+                         answer) &&
+      send_frame(secoc_dev, answer) == 0) {
+    fv_answers++;
+  }
+}
+
+void secoc_fv_answer(const struct can_frame& frame) {
+  uint64_t fv;
+
+  if (anchored || !SecOcSender::fv_answer(cmac, request_nonce, frame, fv)) {
+    return;  // Not asked, or an answer to another request
+  }
+  answered_fv = fv;
+  answered = true;
+  anchored = true;
+  LOG_WRN("SecOC: TX freshness continues after the receiver's %llu",
+          static_cast<unsigned long long>(fv));
+}
+
+bool secoc_verify(struct can_frame& frame) {
+  SecOcVerdict verdict = receiver.verify(cmac, frame);
+
+  if (verdict == SecOcVerdict::Ok) {
+    verified_frames++;
+    return true;
+  }
+
+  rejected_frames++;
+  HOT_LOG_ERR(reject_log, k_uptime_get(), "[SecOC] 0x%03x rejected (%s)",
+              frame.id,
+              (verdict == SecOcVerdict::TooShort) ? "no MAC" : "bad MAC");
+  return false;
+}
+
+#if defined(CONFIG_SHELL)
+namespace {
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  shell_print(sh, "%u-bit FV, %u-bit MAC", 8 * Config::SECOC_FRESHNESS_BYTES,
+              8 * Config::SECOC_MAC_BYTES);
+  shell_print(sh, "tx FV %llu%s, %u protected, %u syncs sent, "
+              "%u FV requests",
+              static_cast<unsigned long long>(sender.freshness_value()),
+              anchored ? "" : " (lost)", protected_frames, syncs_sent,
+              fv_requests);
+  shell_print(sh, "rx FV %llu, %u verified, %u rejected, %u resyncs, "
+              "%u syncs ignored, %u FV answers",
+              static_cast<unsigned long long>(receiver.freshness_value()),
+              verified_frames, rejected_frames, receiver.resync_count(),
+              syncs_ignored, fv_answers);
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    secoc_cmds,
+    SHELL_CMD(status, NULL, "Freshness values and counters", cmd_status),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(secoc, &secoc_cmds, "Authenticated gear frames", NULL);
+#endif /* CONFIG_SHELL */
@@ -0,0 +1,71 @@
+/*
+ * src/secoc.hpp
+ * Authenticated gear frames (truncated AES-CMAC and freshness)
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#if defined(CONFIG_APP_SECOC)
+
+#include <cstdint>  // int64_t
+
+#include "core/secoc.hpp"
+
+/**
+ * @brief Take up the freshness value from before a warm reset and listen
+ * for sync frames and FV requests and answers on dev.
+ */
+int secoc_init(const struct device* dev);
+
+/**
+ * @brief Append freshness and MAC to an outgoing gear frame.
+ * * TX thread only.
+ * * @return 0, or -EMSGSIZE if the payload leaves no room for them
+ */
+int secoc_protect(struct can_frame& frame);
+
+/**
+ * @brief Authenticate an incoming gear frame and strip its authenticator.
+ * * RX thread only. Rejections are counted and logged (rate-limited).
+ * * @return false if the frame must be dropped
+ */
+bool secoc_verify(struct can_frame& frame);
+
+/**
+ * @brief Send the full freshness value on CAN_SECOC_SYNC_MSG_ID, at most
+ * every CONFIG_APP_SECOC_SYNC_MS; after a cold boot, until answered, an
+ * FV request with a new nonce instead.
+ * * TX thread only, after a gear frame went out. Never waits for a mailbox.
+ */
+void secoc_send_sync(const struct device* dev, int64_t now_ms);
+
+/**
+ * @brief Re-anchor the receiver to a sync frame; RX thread only.
+ */
+void secoc_sync(const struct can_frame& frame);
+
+/**
+ * @brief Answer an FV request with the receiver's FV on the device given
+ * to secoc_init(); RX thread only.
+ */
+void secoc_fv_request(const struct can_frame& frame);
+
+/**
+ * @brief Continue the TX freshness after the answer to our FV request;
+ * RX thread only. Answers to other requests are ignored.
+ */
+void secoc_fv_answer(const struct can_frame& frame);
+
+#else
+
+inline int secoc_init(const struct device*) { return 0; }
+inline int secoc_protect(struct can_frame&) { return 0; }
+inline bool secoc_verify(struct can_frame&) { return true; }
+inline void secoc_send_sync(const struct device*, int64_t) {}
+inline void secoc_sync(const struct can_frame&) {}
+inline void secoc_fv_request(const struct can_frame&) {}
+inline void secoc_fv_answer(const struct can_frame&) {}
+
+#endif /* CONFIG_APP_SECOC */
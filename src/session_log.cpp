@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Session logger (CONFIG_APP_SESSION_LOG)
+ *
+ * TX/RX paths compress each frame into the filling RAM block. A full block
+ * is sealed and a lowest-priority writer thread appends it to the session
+ * file with one block-sized, aligned fs_write while the paths fill the
+ * next one. Every CONFIG_APP_SESSION_LOG_SYNC_MS the writer also seals the
+ * partial block and calls fs_sync, so a power cut loses at most that much.
+ */
+
+#include "session_log.hpp"
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+
+#if defined(CONFIG_FAT_FILESYSTEM_ELM)
+#include <ff.h>
+#endif
+
+#include <cstdio>
+
+#include "app_config.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+constexpr size_t BLOCK_SIZE = CONFIG_APP_SESSION_LOG_BLOCK_SIZE;
+constexpr char MOUNT_POINT[] = CONFIG_APP_SESSION_LOG_MOUNT_POINT;
+
+static_assert(BLOCK_SIZE % 512 == 0, "Writes must cover whole sectors");
+
+SessionBuffers<BLOCK_SIZE, CONFIG_APP_SESSION_LOG_BUFFERS> buffers;
+struct k_spinlock lock;
+bool active;              // Guarded by lock
+SessionLogStatus status;  // Guarded by lock, except the buffer fields
+
+K_SEM_DEFINE(writer_sem, 0, 1);
+
+enum Request { REQ_START, REQ_STOP };
+atomic_t requests;
+
+/* Writer thread state */
+struct fs_file_t file;
+bool file_open;
+int64_t last_sync_ms;
+
+uint32_t now_us() {
+  return static_cast<uint32_t>(k_ticks_to_us_floor64(k_uptime_ticks()));
+}
+
+uint32_t elapsed_us(uint32_t start_cycles) {
+  return k_cyc_to_us_floor32(k_cycle_get_32() - start_cycles);
+}
+
+int mount() {
+#if defined(CONFIG_FAT_FILESYSTEM_ELM)
+  static FATFS fat_fs;
+  static struct fs_mount_t mp;
+
+  mp.type = FS_FATFS;
+  mp.mnt_point = MOUNT_POINT;
+  mp.fs_data = &fat_fs;
+
+  int ret = fs_mount(&mp);
+  return (ret == -EBUSY) ? 0 : ret;  // Already mounted
+#else
+  /* Other file systems are mounted from the devicetree fstab */
+  struct fs_statvfs st;
+
+  return fs_statvfs(MOUNT_POINT, &st);
+#endif
+}
+
+/* One past the highest session file on the volume */
+uint32_t next_session() {
+  static struct fs_dirent entry;
+  struct fs_dir_t dir;
+  uint32_t next = 0;
+
+  fs_dir_t_init(&dir);
+  if (fs_opendir(&dir, MOUNT_POINT) != 0) {
+    return 0;
+  }
+  while (fs_readdir(&dir, &entry) == 0 && entry.name[0] != '\0') {
+    uint32_t index;
+
+    if (entry.type == FS_DIR_ENTRY_FILE &&
+        SessionLog::parse_file_name(entry.name, index) && index >= next) {
+      next = index + 1;
+    }
+  }
+  fs_closedir(&dir);
+  return next;
+}
+
+void open_session() {
+  char path[sizeof(MOUNT_POINT) + 1 + SessionLog::FILE_NAME_LEN];
+  uint32_t session = next_session();
+  int len = snprintf(path, sizeof(path), "%s/", MOUNT_POINT);
+
+  snprintf(&path[len], sizeof(path) - len, SessionLog::FILE_NAME_FORMAT,
+           session);
+
+  fs_file_t_init(&file);
+  int ret = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE);
+  if (ret != 0) {
+    LOG_ERR("Session log %s not opened (%d)", path, ret);
+    return;
+  }
+  file_open = true;
+  last_sync_ms = k_uptime_get();
+
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  buffers.reset();
+  status = {.mounted = true, .open = true, .session = session};
+  active = true;
+  k_spin_unlock(&lock, key);
+
+  LOG_INF("Session log: %s", path);
+}
+
+void mark_closed() {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  status.open = false;
+  k_spin_unlock(&lock, key);
+}
+
+const uint8_t* next_block() {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  const uint8_t* block = buffers.ready();
+
+  k_spin_unlock(&lock, key);
+  return block;
+}
+
+/* Append every sealed block; a failed write ends the session */
+void write_ready() {
+  const uint8_t* block;
+
+  while ((block = next_block()) != nullptr) {
+    uint32_t start = k_cycle_get_32();
+    ssize_t written = fs_write(&file, block, BLOCK_SIZE);
+    uint32_t us = elapsed_us(start);
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    buffers.release();
+    if (written == static_cast<ssize_t>(BLOCK_SIZE)) {
+      status.blocks_written++;
+      status.bytes_written += BLOCK_SIZE;
+      status.write_us += us;
+      status.max_write_us = MAX(status.max_write_us, us);
+    } else {
+      status.write_errors++;
+      active = false;
+    }
+    k_spin_unlock(&lock, key);
+
+    if (written != static_cast<ssize_t>(BLOCK_SIZE)) {
+      LOG_ERR("Session log write failed (%d), closing",
+              static_cast<int>(written));
+      fs_close(&file);
+      file_open = false;
+      mark_closed();
+      return;
+    }
+  }
+}
+
+void close_session() {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  active = false;
+  buffers.seal();
+  k_spin_unlock(&lock, key);
+
+  write_ready();
+  if (file_open) {  // Unless a failed write closed it
+    fs_close(&file);
+    file_open = false;
+    mark_closed();
+  }
+
+  SessionLogStatus st = session_log_status();
+  LOG_INF("Session log %u closed: %u frames, %u dropped, %u blocks",
+          st.session, st.frames, st.dropped, st.blocks_written);
+}
+
+void sync_session() {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  buffers.seal();  // A partial block, so the sync covers every frame
+  k_spin_unlock(&lock, key);
+
+  write_ready();
+  if (!file_open) {
+    return;
+  }
+
+  uint32_t start = k_cycle_get_32();
+  int ret = fs_sync(&file);
+  uint32_t us = elapsed_us(start);
+
+  key = k_spin_lock(&lock);
+  if (ret == 0) {
+    status.syncs++;
+    status.max_sync_us = MAX(status.max_sync_us, us);
+  } else {
+    status.write_errors++;
+  }
+  k_spin_unlock(&lock, key);
+  last_sync_ms = k_uptime_get();
+}
+
+void session_log_thread_entry(void* arg1, void* arg2, void* arg3) {
+  int ret = mount();
+
+  if (ret != 0) {
+    LOG_ERR("Session log: %s not mounted (%d)", MOUNT_POINT, ret);
+    return;
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  status.mounted = true;
+  k_spin_unlock(&lock, key);
+
+  if (IS_ENABLED(CONFIG_APP_SESSION_LOG_AUTOSTART)) {
+    atomic_set_bit(&requests, REQ_START);
+  }
+
+  while (1) {
+    k_sem_take(&writer_sem, K_MSEC(CONFIG_APP_SESSION_LOG_SYNC_MS));
+
+    if (atomic_test_and_clear_bit(&requests, REQ_STOP) && file_open) {
+      close_session();
+    }
+    if (atomic_test_and_clear_bit(&requests, REQ_START) && !file_open) {
+      open_session();
+    }
+    if (!file_open) {
+      continue;
+    }
+
+    write_ready();
+    if (file_open &&
+        k_uptime_get() - last_sync_ms >= CONFIG_APP_SESSION_LOG_SYNC_MS) {
+      sync_session();
+    }
+  }
+}
+}  // namespace
+
+K_THREAD_DEFINE(session_log_tid, Config::SESSION_LOG_THREAD_STACK_SIZE,
+                session_log_thread_entry, NULL, NULL, NULL,
+                Config::SESSION_LOG_THREAD_PRIORITY, 0, 0);
+
+void session_log_record(const struct can_frame& frame, FrameDir dir) {
+  TimedFrame entry = TimedFrame::from(frame, dir, now_us());
+  k_spinlock_key_t key = k_spin_lock(&lock);
+
+  if (!active) {
+    k_spin_unlock(&lock, key);
+    return;
+  }
+
+  size_t sealed = buffers.sealed();
+  if (buffers.append(entry)) {
+    status.frames++;
+  }
+  bool wake = buffers.sealed() != sealed;
+  k_spin_unlock(&lock, key);
+
+  if (wake) {
+    k_sem_give(&writer_sem);
+  }
+}
+
+void session_log_start() {
+  atomic_set_bit(&requests, REQ_START);
+  k_sem_give(&writer_sem);
+}
+
+void session_log_stop() {
+  atomic_set_bit(&requests, REQ_STOP);
+  k_sem_give(&writer_sem);
+}
+
+SessionLogStatus session_log_status() {
+  k_spinlock_key_t key = k_spin_lock(&lock);
+  SessionLogStatus st = status;
+
+  st.active = active;
+  st.dropped = buffers.dropped();
+  st.buffered = buffers.sealed();
+  k_spin_unlock(&lock, key);
+  return st;
+}
+
+#if defined(CONFIG_SHELL)
+namespace {
+int cmd_start(const struct shell* sh, size_t argc, char** argv) {
+  session_log_start();
+  return 0;
+}
+
+int cmd_stop(const struct shell* sh, size_t argc, char** argv) {
+  session_log_stop();
+  return 0;
+}
+
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  SessionLogStatus st = session_log_status();
+  uint64_t kib_s =
+      (st.write_us != 0) ? st.bytes_written * 1000000 / 1024 / st.write_us
+                         : 0;
+
+  shell_print(sh, "mounted %d, active %d, open %d, session %u, %u buffered",
+              st.mounted, st.active, st.open, st.session,
+              static_cast<uint32_t>(st.buffered));
+  shell_print(sh, "frames %u, dropped %u, blocks %u, write errors %u",
+              st.frames, st.dropped, st.blocks_written, st.write_errors);
+  shell_print(sh, "write %u KiB/s, max write %u us, %u syncs (max %u us)",
+              static_cast<uint32_t>(kib_s), st.max_write_us, st.syncs,
+              st.max_sync_us);
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    slog_cmds, SHELL_CMD(start, NULL, "Start a new session file", cmd_start),
+    SHELL_CMD(stop, NULL, "Write out and close the session", cmd_stop),
+    SHELL_CMD(status, NULL, "Counters and write throughput", cmd_status),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(slog, &slog_cmds, "Session log", NULL);
+#endif /* CONFIG_SHELL */
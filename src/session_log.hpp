@@ -0,0 +1,60 @@
+/*
+ * src/session_log.hpp
+ * Full-session frame log to a file system (e.g. an SD card)
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+
+#include "core/frame_ring.hpp"
+#include "core/session_log.hpp"
+
+struct SessionLogStatus {
+  bool mounted;
+  bool active;       // Frames are being logged
+  bool open;         // The session file is open (until written out)
+  uint32_t session;  // Index in the file name of the current/last session
+  uint32_t frames;   // Logged this session
+  uint32_t dropped;  // Every buffer full: the writer fell behind
+  uint32_t blocks_written;
+  uint64_t bytes_written;
+  uint64_t write_us;  // Time spent in fs_write, for the throughput
+  uint32_t max_write_us;
+  uint32_t max_sync_us;
+  uint32_t syncs;
+  uint32_t write_errors;
+  size_t buffered;  // Sealed blocks waiting for the writer
+};
+
+#if defined(CONFIG_APP_SESSION_LOG)
+
+/**
+ * @brief Compress a frame into the session log's filling buffer.
+ * * Safe from ISR and driver callbacks: a short spinlock and one
+ * FrameCompress entry (at most 19 bytes). Never waits for the file system;
+ * if the writer falls behind, the frame is counted as dropped.
+ */
+void session_log_record(const struct can_frame& frame, FrameDir dir);
+
+/**
+ * @brief Open a new session file and start logging.
+ * * The writer thread opens the file; returns before it is open.
+ */
+void session_log_start();
+
+/**
+ * @brief Stop logging, write what is buffered and close the file.
+ */
+void session_log_stop();
+
+SessionLogStatus session_log_status();
+
+#else
+
+inline void session_log_record(const struct can_frame&, FrameDir) {}
+
+#endif /* CONFIG_APP_SESSION_LOG */
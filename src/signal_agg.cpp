@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Signal aggregation stages (CONFIG_APP_SIGNAL_AGG)
+ *
+ * Samples go through the windows of Config::AGG_STAGES; only a closed
+ * window becomes a frame, at the rate its consumer asked for. The feed
+ * times the aggregation itself so "agg status" can show the CPU cost per
+ * sample next to the bus load it saves.
+ */
+
+#include "signal_agg.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+#include <array>
+#include <cstdio>
+
+#include "bus_budget.hpp"
+#include "diagnostics.hpp"
+#include "network_mgmt.hpp"
+#include "slcan.hpp"
+#include "sniffer.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+constexpr size_t SIGNALS = Config::AGG_SIGNALS.size();
+constexpr size_t STAGES = Config::AGG_STAGES.size();
+
+/* Every sample sent raw vs. the aggregates, at the devicetree bitrate */
+constexpr uint64_t RAW_PPM =
+    (BusBudget::BITRATE > 0)
+        ? SignalAgg::raw_load_ppm(Config::AGG_SIGNALS, BusBudget::BITRATE)
+        : 0;
+constexpr uint64_t AGG_PPM =
+    (BusBudget::BITRATE > 0)
+        ? SignalAgg::stages_load_ppm(Config::AGG_SIGNALS, Config::AGG_STAGES,
+                                     BusBudget::BITRATE)
+        : 0;
+
+struct StageCounters {
+  uint32_t sent;
+  uint32_t held;  // Closed while the bus slept or the node only listened
+  uint32_t errors;
+};
+
+struct Closed {
+  size_t stage;
+  AggResult result;
+};
+
+const struct device* agg_dev;
+SignalAggregator<SIGNALS, STAGES> aggregator(Config::AGG_SIGNALS,
+                                             Config::AGG_STAGES);
+
+/* Owned by the feeding thread; the shell only reads */
+std::array<StageCounters, STAGES> counters;
+uint64_t feed_cycles;
+uint32_t max_feed_cycles;
+
+void agg_tx_done(const struct device* dev, int error, void* user_data) {
+  NodeStats::bump(error == 0 ? node_stats.tx_frames : node_stats.tx_errors);
+}
+
+void send(size_t stage, const AggResult& result) {
+  StageCounters& c = counters[stage];
+  struct can_frame frame;
+
+  if (!nm_network_mode() || sniffer_listening()) {
+    c.held++;
+    return;
+  }
+
+  encode_agg_frame(Config::AGG_STAGES[stage], result, frame);
+  /* A NULL callback would make can_send() wait for the frame to go out */
+  if (can_send(agg_dev, &frame, K_NO_WAIT, agg_tx_done, NULL) == 0) {
+    c.sent++;
+    slcan_record_tx(agg_dev, frame);
+  } else {
+    c.errors++;
+    NodeStats::bump(node_stats.tx_errors);
+  }
+}
+
+#if defined(CONFIG_APP_SIGNAL_AGG_SIM)
+constexpr uint32_t TICK_HZ = 1000;
+
+constexpr bool rates_fit() {
+  for (const AggSignal& sig : Config::AGG_SIGNALS) {
+    if (sig.sample_hz > TICK_HZ || TICK_HZ % sig.sample_hz != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(rates_fit(), "Simulated signals need a rate dividing 1 kHz");
+
+/* lo at t = 0, hi at half the period */
+int32_t triangle(uint32_t t_ms, uint32_t period_ms, int32_t lo, int32_t hi) {
+  uint32_t phase = t_ms % period_ms;
+  uint32_t half = period_ms / 2;
+  int32_t pos = static_cast<int32_t>((phase < half) ? phase
+                                                    : period_ms - phase);
+
+  return lo + (hi - lo) * pos / static_cast<int32_t>(half);
+}
+
+/* A lap in miniature: steering sweeps lock to lock every 4 s; every 3 s
+ * the driver brakes for 1 s and works the clutch for the first 600 ms */
+int16_t simulate(size_t signal, uint32_t t_ms, uint32_t& noise) {
+  noise = noise * 1664525U + 1013904223U;
+  int32_t jitter = static_cast<int32_t>((noise >> 24) % 9) - 4;
+  uint32_t lap_ms = t_ms % 3000;
+  int32_t v = 0;
+
+  switch (signal) {
+    case Config::AGG_STEERING:
+      v = triangle(t_ms, 4000, -900, 900) + jitter;
+      break;
+    case Config::AGG_CLUTCH:
+      v = (lap_ms < 600) ? triangle(lap_ms, 600, 0, 1000) : 0;
+      break;
+    case Config::AGG_LOAD_CELL:
+      v = ((lap_ms < 1000) ? 800 : 0) + jitter;
+      break;
+    default:
+      break;
+  }
+  return static_cast<int16_t>(v);
+}
+
+void sim_thread_entry(void* arg1, void* arg2, void* arg3) {
+  int64_t next = k_uptime_get();
+  uint32_t noise = 1;
+
+  for (uint32_t tick = 0;; tick++) {
+    for (size_t i = 0; i < SIGNALS; i++) {
+      if (tick % (TICK_HZ / Config::AGG_SIGNALS[i].sample_hz) == 0) {
+        signal_agg_feed(i, simulate(i, tick, noise));
+      }
+    }
+    next += 1000 / TICK_HZ;
+    k_sleep(K_TIMEOUT_ABS_MS(next));
+  }
+}
+
+/* Started by signal_agg_init() once the controller is up */
+K_THREAD_DEFINE(signal_agg_tid, Config::SIGNAL_AGG_THREAD_STACK_SIZE,
+                sim_thread_entry, NULL, NULL, NULL,
+                Config::SIGNAL_AGG_THREAD_PRIORITY, 0, K_TICKS_FOREVER);
+#endif /* CONFIG_APP_SIGNAL_AGG_SIM */
+}  // namespace
+
+void signal_agg_init(const struct device* dev) {
+  agg_dev = dev;
+  LOG_INF("%u signal aggregates, %u.%02u %% of the bus instead of %u.%02u %%",
+          static_cast<uint32_t>(STAGES),
+          static_cast<uint32_t>(AGG_PPM / 10000),
+          static_cast<uint32_t>(AGG_PPM % 10000 / 100),
+          static_cast<uint32_t>(RAW_PPM / 10000),
+          static_cast<uint32_t>(RAW_PPM % 10000 / 100));
+#if defined(CONFIG_APP_SIGNAL_AGG_SIM)
+  k_thread_start(signal_agg_tid);
+#endif
+}
+
+void signal_agg_feed(size_t signal, int16_t value) {
+  std::array<Closed, STAGES> closed;
+  size_t n = 0;
+  uint32_t now_ms = k_uptime_get_32();
+
+  if (signal >= SIGNALS) {
+    return;
+  }
+
+  /* Only the aggregation is timed, not the sends */
+  uint32_t start = k_cycle_get_32();
+  aggregator.feed(signal, value, now_ms,
+                  [&](size_t stage, const AggResult& result) {
+                    closed[n++] = {.stage = stage, .result = result};
+                  });
+  uint32_t cycles = k_cycle_get_32() - start;
+
+  feed_cycles += cycles;
+  max_feed_cycles = MAX(max_feed_cycles, cycles);
+
+  for (size_t i = 0; i < n; i++) {
+    send(closed[i].stage, closed[i].result);
+  }
+}
+
+#if defined(CONFIG_SHELL)
+namespace {
+void format_outputs(uint8_t outputs, char* buf, size_t size) {
+  static constexpr const char* NAMES[] = {"min", "max", "mean", "last"};
+  size_t len = 0;
+
+  buf[0] = '\0';
+  for (size_t i = 0; i < 4; i++) {
+    if ((outputs & (1U << i)) != 0 && len < size) {
+      len += static_cast<size_t>(snprintf(&buf[len], size - len, "%s%s",
+                                          (len > 0) ? "," : "", NAMES[i]));
+    }
+  }
+}
+
+void print_percent(const struct shell* sh, const char* label, uint64_t ppm) {
+  shell_print(sh, "  %-10s %u.%02u %%", label,
+              static_cast<uint32_t>(ppm / 10000),
+              static_cast<uint32_t>(ppm % 10000 / 100));
+}
+
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  uint64_t samples = aggregator.samples();
+
+  for (size_t i = 0; i < STAGES; i++) {
+    const AggStage& stage = aggregator.stage(i);
+    const AggSignal& signal = aggregator.signal_of(i);
+    /* Nominal frames per 10 s */
+    uint32_t rate_x10 = (stage.samples != 0)
+                            ? signal.sample_hz * 10U / stage.samples
+                            : 10000U / stage.window_ms;
+    char outputs[24];
+    char window[16];
+
+    format_outputs(stage.outputs, outputs, sizeof(outputs));
+    if (stage.samples != 0) {
+      snprintf(window, sizeof(window), "%u samples", stage.samples);
+    } else {
+      snprintf(window, sizeof(window), "%u ms", stage.window_ms);
+    }
+    shell_print(sh, "0x%03x %-6s %-9s %-17s %-10s %u.%u Hz: sent %u, "
+                "held %u, errors %u",
+                stage.id, stage.consumer, signal.name, outputs, window,
+                rate_x10 / 10, rate_x10 % 10, counters[i].sent,
+                counters[i].held, counters[i].errors);
+  }
+
+  shell_print(sh, "%llu samples, %llu ns per sample (max %llu ns)",
+              static_cast<unsigned long long>(samples),
+              static_cast<unsigned long long>(
+                  (samples != 0) ? k_cyc_to_ns_floor64(feed_cycles) / samples
+                                 : 0),
+              static_cast<unsigned long long>(
+                  k_cyc_to_ns_floor64(max_feed_cycles)));
+  shell_print(sh, "Bus load at %u kbit/s (worst case):",
+              BusBudget::BITRATE / 1000);
+  print_percent(sh, "raw", RAW_PPM);
+  print_percent(sh, "aggregated", AGG_PPM);
+  print_percent(sh, "saved", (RAW_PPM > AGG_PPM) ? RAW_PPM - AGG_PPM : 0);
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    agg_cmds,
+    SHELL_CMD(status, NULL, "Stages, CPU per sample, bus load saved",
+              cmd_status),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(agg, &agg_cmds, "Signal aggregation stages", NULL);
+#endif /* CONFIG_SHELL */
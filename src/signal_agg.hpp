@@ -0,0 +1,35 @@
+/*
+ * src/signal_agg.hpp
+ * Aggregates of high-rate signals at each consumer's rate
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t
+
+#include "app_config.hpp"
+
+#if defined(CONFIG_APP_SIGNAL_AGG)
+
+/**
+ * @brief Set the controller for aggregate frames and start sampling.
+ * * Without CONFIG_APP_SIGNAL_AGG_SIM nothing is sampled until the sensor
+ * code calls signal_agg_feed().
+ */
+void signal_agg_init(const struct device* dev);
+
+/**
+ * @brief One sample of Config::AGG_SIGNALS[signal].
+ * * Call from one thread only, at the signal's sample_hz. Closes the
+ * windows that are due and sends their frames without waiting.
+ */
+void signal_agg_feed(size_t signal, int16_t value);
+
+#else
+
+inline void signal_agg_init(const struct device*) {}
+
+#endif /* CONFIG_APP_SIGNAL_AGG */
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * SimWheel implementation (CAN setup and gear shifting)
+ */
+
+#include "sim_wheel.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "app_config.hpp"
+#include "blackbox.hpp"
+#include "core/gear_codec.hpp"
+#include "crash_ring.hpp"
+#include "diagnostics.hpp"
+#include "hot_log.hpp"
+#include "redundancy.hpp"
+#include "secoc.hpp"
+#include "session_log.hpp"
+#include "slcan.hpp"
+
+/* Register Log Module */
+LOG_MODULE_REGISTER(sim_racing_node, LOG_LEVEL_INF);
+
+namespace {
+/* Every shift would otherwise be a log line; see hot_log.hpp */
+HotPathLog tx_log = make_hot_path_log();
+
+const char* mode_label(can_mode_t mode) {
+  switch (mode) {
+    case CAN_MODE_LOOPBACK:
+      return "Virtual Loopback";
+    case CAN_MODE_LISTENONLY:
+      return "Listen-only";
+    default:
+      return "Normal";
+  }
+}
+}  // namespace
+
+SimWheel::SimWheel(const struct device* can_device, can_mode_t mode)
+    : dev(can_device),
+      current_gear(Gear::N),
+      ready(false),
+      profile(&Config::CAR_PROFILES[Config::DEFAULT_CAR_PROFILE]) {
+  if (!device_is_ready(dev)) {
+    LOG_ERR("CAN device not ready");
+    return;
+  }
+
+  /* * Configure the controller mode (loopback by default).
+   * Loopback allows the node to receive its own messages, simulating a full
+   * bus environment without requiring an external physical transceiver.
+   * Listen-only turns the node into a passive sniffer (sniffer.hpp).
+   */
+  int ret = can_set_mode(dev, mode);
+  if (ret != 0) {
+    LOG_ERR("Failed to set CAN mode: %d", ret);
+    return;
+  }
+
+  ret = can_start(dev);
+  if (ret != 0) {
+    LOG_ERR("Failed to start CAN controller: %d", ret);
+    return;
+  }
+
+  ready = true;
+  LOG_INF("SimWheel initialized successfully (%s Mode)", mode_label(mode));
+}
+
+int SimWheel::shift_gear() {
+  struct can_frame frame;
+
+  if (!ready) {
+    return -ENODEV;
+  }
+
+  /* Update Gear Logic using the car's gearbox */
+  current_gear = next_gear(current_gear, profile->forward_gears);
+
+  /* Prepare CAN Frame */
+  encode_gear_frame(current_gear, profile->gear_layout, frame);
+
+  /* Append freshness and MAC when gear frames are authenticated */
+  int ret = secoc_protect(frame);
+
+  /* Transmit Frame (Non-blocking with timeout), on both buses when gear
+   * frames are redundant */
+  if (ret == 0) {
+    ret = redundancy_send(dev, frame);
+  }
+
+  int64_t now_ms = k_uptime_get();
+  EventSummary summary;
+
+  if (ret == 0) {
+    NodeStats::bump(node_stats.tx_frames);
+    blackbox_record(frame, FrameDir::Tx);
+    crash_ring_record(frame, FrameDir::Tx);
+    session_log_record(frame, FrameDir::Tx);
+    slcan_record_tx(dev, frame);
+    secoc_send_sync(dev, now_ms);
+    // Cast for logging display
+    HOT_LOG_INF(tx_log, now_ms, "[TX] Gear Shifted -> %d",
+                static_cast<uint8_t>(current_gear));
+  } else {
+    NodeStats::bump(node_stats.tx_errors);
+    HOT_LOG_ERR(tx_log, now_ms, "CAN Send Failed (Error: %d)", ret);
+  }
+
+  if (tx_log.summary(now_ms, summary)) {
+    LOG_INF("[TX] %u shifts in last %u ms, %u errors (%u lines suppressed)",
+            summary.events, summary.window_ms, summary.errors,
+            summary.suppressed);
+  }
+
+  return ret;
+}
@@ -0,0 +1,61 @@
+/*
+ * src/sim_wheel.hpp
+ * SimWheel class: CAN hardware abstraction and gear shifting logic
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include "core/car_profile.hpp"
+#include "core/gear.hpp"
+
+/* Controller mode at boot (CONFIG_APP_CAN_MODE_*) */
+constexpr can_mode_t BOOT_CAN_MODE =
+    IS_ENABLED(CONFIG_APP_CAN_MODE_NORMAL)        ? CAN_MODE_NORMAL
+    : IS_ENABLED(CONFIG_APP_CAN_MODE_LISTEN_ONLY) ? CAN_MODE_LISTENONLY
+                                                  : CAN_MODE_LOOPBACK;
+
+/**
+ * @brief SimWheel Class
+ * * Encapsulates the CAN hardware abstraction and gear shifting logic.
+ * Implements RAII pattern to ensure device readiness and configuration upon
+ * instantiation.
+ */
+class SimWheel {
+ private:
+  const struct device* dev;
+  Gear current_gear;
+  bool ready;
+  const CarProfile* profile;
+
+ public:
+  /**
+   * @brief Construct a new Sim Wheel object
+   * * @param can_device Pointer to the Zephyr CAN device structure
+   * @param mode Controller mode, CONFIG_APP_CAN_MODE_* by default
+   */
+  SimWheel(const struct device* can_device, can_mode_t mode = BOOT_CAN_MODE);
+
+  /**
+   * @brief Simulates a gear shift operation and transmits the state via CAN.
+   * Cycles through gears N(0) -> 1..forward_gears -> N(0) of the current
+   * car profile (1..6 by default).
+   * * @return 0 on success, -ENODEV if the controller never came up,
+   * -EMSGSIZE if the authenticated frame would not fit, or the can_send()
+   * error code.
+   */
+  int shift_gear();
+
+  /**
+   * @brief Use car's gear model and frame layout from the next shift on.
+   */
+  void set_profile(const CarProfile& car) { profile = &car; }
+
+  /**
+   * @brief Whether the CAN controller was configured and started.
+   */
+  bool is_ready() const { return ready; }
+
+  Gear gear() const { return current_gear; }
+};
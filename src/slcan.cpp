@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * SLCAN bridge (CONFIG_APP_SLCAN)
+ *
+ * While a PC tool has the channel open, two catch-all filters (standard
+ * and extended IDs) take every frame on the bus, and the TX paths hand in
+ * the node's own frames. Each frame is encoded straight into a byte ring.
+ * The UART async API sends the contiguous part of the ring with one
+ * uart_tx (DMA where the driver has it) and the next part from the TX-done
+ * callback, so a busy bus costs a callback per chunk, not per byte. Bytes
+ * from the PC land in two alternating RX buffers and go through a second
+ * ring to the bridge thread, which parses the commands, sends injected
+ * frames and queues the replies.
+ */
+
+#include "slcan.hpp"
+
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include <atomic>
+#include <cstring>
+
+#include "app_config.hpp"
+#include "bus_budget.hpp"
+#include "network_mgmt.hpp"
+#include "sniffer.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+#define SLCAN_UART DT_CHOSEN(simrig_slcan_uart)
+
+namespace {
+constexpr size_t TX_BUF_SIZE = CONFIG_APP_SLCAN_TX_BUF_SIZE;
+constexpr size_t RX_CHUNK = CONFIG_APP_SLCAN_RX_CHUNK;
+constexpr int32_t RX_IDLE_US = 1000;  // Partial RX buffers go up after this
+constexpr int64_t RATE_WINDOW_MS = 1000;
+
+/* 0 for links without a baud rate, e.g. a pty */
+constexpr uint32_t LINK_BAUD = DT_PROP_OR(SLCAN_UART, current_speed, 0);
+
+static_assert(TX_BUF_SIZE >= 2 * Slcan::MAX_FRAME_BYTES,
+              "The TX buffer must hold a frame while another is sent");
+
+constexpr struct can_filter CATCH_ALL[] = {
+    {.id = 0, .mask = 0, .flags = 0},
+    {.id = 0, .mask = 0, .flags = CAN_FILTER_IDE},
+};
+
+const struct device* const uart_dev = DEVICE_DT_GET(SLCAN_UART);
+const struct device* can_dev;
+
+RING_BUF_DECLARE(tx_ring, TX_BUF_SIZE);
+RING_BUF_DECLARE(rx_ring, CONFIG_APP_SLCAN_RX_BUF_SIZE);
+uint8_t rx_bufs[2][RX_CHUNK];
+size_t next_rx_buf;  // UART callback only
+
+struct k_spinlock tx_lock;  // tx_ring, tx_busy, status
+struct k_spinlock rx_lock;  // rx_ring, rx_overruns
+bool tx_busy;               // A uart_tx is in flight on a claimed chunk
+SlcanStatus status;
+uint32_t window_frames;  // Forwarded in the current rate window
+uint32_t rx_overruns;
+
+/* Published by the bridge thread for the frame paths */
+std::atomic<bool> forwarding{false};
+std::atomic<bool> stamped{false};
+std::atomic<bool> listen_only{false};
+std::atomic<Slcan::Format> link_format{IS_ENABLED(CONFIG_APP_SLCAN_BINARY)
+                                           ? Slcan::Format::Binary
+                                           : Slcan::Format::Ascii};
+std::atomic<bool> rx_restart{false};
+
+K_SEM_DEFINE(rx_sem, 0, 1);
+
+/* Bridge thread state */
+SlcanParser parser;
+SlcanSession session(BusBudget::BITRATE, CONFIG_APP_NODE_ID);
+int filter_ids[ARRAY_SIZE(CATCH_ALL)] = {-1, -1};
+uint32_t dropped_seen;  // Dropped count at the last "F"
+
+/* Send the next contiguous chunk of the ring unless one is in flight */
+void kick_tx() {
+  uint8_t* data;
+  k_spinlock_key_t key = k_spin_lock(&tx_lock);
+
+  if (tx_busy) {
+    k_spin_unlock(&tx_lock, key);
+    return;
+  }
+
+  uint32_t len = ring_buf_get_claim(&tx_ring, &data, TX_BUF_SIZE);
+  if (len == 0) {
+    k_spin_unlock(&tx_lock, key);
+    return;
+  }
+  tx_busy = true;
+  k_spin_unlock(&tx_lock, key);
+
+  /* Outside the lock: a driver may report TX_DONE from inside uart_tx */
+  if (uart_tx(uart_dev, data, len, SYS_FOREVER_US) != 0) {
+    key = k_spin_lock(&tx_lock);
+    (void)ring_buf_get_finish(&tx_ring, 0);
+    tx_busy = false;
+    status.uart_errors++;
+    k_spin_unlock(&tx_lock, key);
+  }
+}
+
+/* Whole records only: a frame that does not fit is dropped, not cut */
+void enqueue(const uint8_t* data, size_t len, bool frame) {
+  k_spinlock_key_t key = k_spin_lock(&tx_lock);
+
+  if (ring_buf_space_get(&tx_ring) < len) {
+    status.dropped += frame ? 1 : 0;
+    k_spin_unlock(&tx_lock, key);
+    return;
+  }
+  (void)ring_buf_put(&tx_ring, data, len);
+  if (frame) {
+    status.forwarded++;
+    window_frames++;
+  }
+  status.max_buffered = MAX(status.max_buffered, ring_buf_size_get(&tx_ring));
+  k_spin_unlock(&tx_lock, key);
+
+  kick_tx();
+}
+
+void forward(const struct can_frame& frame) {
+  uint8_t buf[Slcan::MAX_FRAME_BYTES];
+  uint32_t ms = k_uptime_get_32();
+  size_t len;
+
+  if (link_format.load(std::memory_order_relaxed) == Slcan::Format::Binary) {
+    len = Slcan::encode_binary(frame, ms, buf);
+  } else {
+    len = Slcan::encode_ascii(frame, stamped.load(std::memory_order_relaxed),
+                              ms, reinterpret_cast<char*>(buf));
+  }
+  enqueue(buf, len, true);
+}
+
+void bus_rx_callback(const struct device* dev, struct can_frame* frame,
+                     void* user_data) {
+  if (forwarding.load(std::memory_order_relaxed)) {
+    forward(*frame);
+  }
+}
+
+int start_rx() {
+  next_rx_buf = 1;
+  return uart_rx_enable(uart_dev, rx_bufs[0], RX_CHUNK, RX_IDLE_US);
+}
+
+void uart_callback(const struct device* dev, struct uart_event* evt,
+                   void* user_data) {
+  switch (evt->type) {
+    case UART_TX_DONE:
+    case UART_TX_ABORTED: {
+      k_spinlock_key_t key = k_spin_lock(&tx_lock);
+
+      (void)ring_buf_get_finish(&tx_ring, evt->data.tx.len);
+      status.tx_bytes += evt->data.tx.len;
+      status.uart_errors += (evt->type == UART_TX_ABORTED) ? 1 : 0;
+      tx_busy = false;
+      k_spin_unlock(&tx_lock, key);
+
+      kick_tx();
+      break;
+    }
+    case UART_RX_RDY: {
+      k_spinlock_key_t key = k_spin_lock(&rx_lock);
+      uint32_t put = ring_buf_put(
+          &rx_ring, &evt->data.rx.buf[evt->data.rx.offset], evt->data.rx.len);
+
+      rx_overruns += evt->data.rx.len - put;
+      k_spin_unlock(&rx_lock, key);
+      k_sem_give(&rx_sem);
+      break;
+    }
+    case UART_RX_BUF_REQUEST:
+      (void)uart_rx_buf_rsp(dev, rx_bufs[next_rx_buf], RX_CHUNK);
+      next_rx_buf ^= 1;
+      break;
+    case UART_RX_STOPPED: {
+      k_spinlock_key_t key = k_spin_lock(&tx_lock);
+
+      status.uart_errors++;
+      k_spin_unlock(&tx_lock, key);
+      break;
+    }
+    case UART_RX_DISABLED:
+      /* After an error or a line break; the thread enables it again */
+      rx_restart.store(true);
+      k_sem_give(&rx_sem);
+      break;
+    default:
+      break;
+  }
+}
+
+void install_catch_all() {
+  for (size_t i = 0; i < ARRAY_SIZE(CATCH_ALL); i++) {
+    if (filter_ids[i] < 0) {
+      filter_ids[i] =
+          can_add_rx_filter(can_dev, bus_rx_callback, NULL, &CATCH_ALL[i]);
+      if (filter_ids[i] < 0) {
+        LOG_ERR("SLCAN filter not added (%d)", filter_ids[i]);
+      }
+    }
+  }
+}
+
+void remove_catch_all() {
+  for (int& id : filter_ids) {
+    if (id >= 0) {
+      can_remove_rx_filter(can_dev, id);
+      id = -1;
+    }
+  }
+}
+
+/* "F": dropped frames since the last read, and the controller state */
+uint8_t status_flags() {
+  enum can_state state = CAN_STATE_ERROR_ACTIVE;
+  uint8_t flags = 0;
+  k_spinlock_key_t key = k_spin_lock(&tx_lock);
+  uint32_t dropped = status.dropped;
+
+  k_spin_unlock(&tx_lock, key);
+
+  if (dropped != dropped_seen) {
+    flags |= Slcan::FLAG_RX_FULL | Slcan::FLAG_OVERRUN;
+    dropped_seen = dropped;
+  }
+  (void)can_get_state(can_dev, &state, NULL);
+  if (state == CAN_STATE_ERROR_WARNING) {
+    flags |= Slcan::FLAG_ERROR_WARNING;
+  } else if (state == CAN_STATE_ERROR_PASSIVE) {
+    flags |= Slcan::FLAG_ERROR_PASSIVE;
+  } else if (state == CAN_STATE_BUS_OFF) {
+    flags |= Slcan::FLAG_BUS_ERROR;
+  }
+  return flags;
+}
+
+/* A frame from the PC, on the node's own terms: not while the network
+ * sleeps or the controller only listens */
+bool inject(const struct can_frame& frame) {
+  int ret = -EPERM;
+
+  if (nm_network_mode() && !sniffer_listening()) {
+    ret = can_send(can_dev, &frame, Config::TX_TIMEOUT, NULL, NULL);
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&tx_lock);
+  if (ret == 0) {
+    status.injected++;
+  } else {
+    status.inject_errors++;
+  }
+  k_spin_unlock(&tx_lock, key);
+  return ret == 0;
+}
+
+void handle(const SlcanCommand& cmd) {
+  char reply[Slcan::MAX_REPLY];
+  bool was_open = session.is_open();
+  uint8_t flags = (cmd.kind == SlcanCmd::Status) ? status_flags() : 0;
+  size_t len = session.handle(cmd, flags, inject, reply);
+
+  /* Nothing after the reply to "C"; nothing before the reply to "O" */
+  if (was_open && !session.is_open()) {
+    forwarding.store(false);
+    remove_catch_all();
+  }
+  stamped.store(session.timestamps());
+  listen_only.store(session.listen_only());
+  enqueue(reinterpret_cast<const uint8_t*>(reply), len, false);
+  if (!was_open && session.is_open()) {
+    install_catch_all();
+    forwarding.store(true);
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&tx_lock);
+  status.commands += (cmd.kind != SlcanCmd::None) ? 1 : 0;
+  k_spin_unlock(&tx_lock, key);
+}
+
+uint32_t take_rx(uint8_t* buf, uint32_t size) {
+  k_spinlock_key_t key = k_spin_lock(&rx_lock);
+  uint32_t n = ring_buf_get(&rx_ring, buf, size);
+
+  k_spin_unlock(&rx_lock, key);
+  return n;
+}
+
+void roll_rate_window(int64_t elapsed_ms) {
+  k_spinlock_key_t key = k_spin_lock(&tx_lock);
+
+  status.frames_per_s =
+      static_cast<uint32_t>(uint64_t{window_frames} * 1000 / elapsed_ms);
+  status.peak_frames_per_s =
+      MAX(status.peak_frames_per_s, status.frames_per_s);
+  window_frames = 0;
+  k_spin_unlock(&tx_lock, key);
+}
+
+void slcan_thread_entry(void* arg1, void* arg2, void* arg3) {
+  int64_t window_start = k_uptime_get();
+
+  while (1) {
+    uint8_t chunk[32];
+    uint32_t n;
+    SlcanCommand cmd;
+
+    k_sem_take(&rx_sem, K_TIMEOUT_ABS_MS(window_start + RATE_WINDOW_MS));
+
+    if (rx_restart.exchange(false) && start_rx() != 0) {
+      LOG_ERR("SLCAN UART RX not restarted");
+    }
+    while ((n = take_rx(chunk, sizeof(chunk))) > 0) {
+      for (uint32_t i = 0; i < n; i++) {
+        if (parser.feed(static_cast<char>(chunk[i]), cmd)) {
+          handle(cmd);
+        }
+      }
+    }
+
+    int64_t now = k_uptime_get();
+    if (now - window_start >= RATE_WINDOW_MS) {
+      roll_rate_window(now - window_start);
+      window_start = now;
+    }
+  }
+}
+
+/* Started by slcan_init() once the controller is up */
+K_THREAD_DEFINE(slcan_tid, Config::SLCAN_THREAD_STACK_SIZE,
+                slcan_thread_entry, NULL, NULL, NULL,
+                Config::SLCAN_THREAD_PRIORITY, 0, K_TICKS_FOREVER);
+
+const char* format_name(Slcan::Format format) {
+  return (format == Slcan::Format::Binary) ? "binary" : "ASCII";
+}
+}  // namespace
+
+int slcan_init(const struct device* dev) {
+  can_dev = dev;
+
+  if (!device_is_ready(uart_dev)) {
+    LOG_ERR("SLCAN UART %s not ready", uart_dev->name);
+    return -ENODEV;
+  }
+
+  int ret = uart_callback_set(uart_dev, uart_callback, NULL);
+  if (ret != 0) {
+    LOG_ERR("SLCAN UART %s has no async API (%d)", uart_dev->name, ret);
+    return ret;
+  }
+  ret = start_rx();
+  if (ret != 0) {
+    LOG_ERR("SLCAN UART RX not enabled (%d)", ret);
+    return ret;
+  }
+
+  Slcan::Format format = link_format.load();
+  uint64_t need = Slcan::full_rate_baud(format, false, BusBudget::BITRATE);
+
+  LOG_INF("SLCAN bridge on %s (%s), %u kbit/s bus needs %u baud at full "
+          "load",
+          uart_dev->name, format_name(format), BusBudget::BITRATE / 1000,
+          static_cast<uint32_t>(need));
+  if (LINK_BAUD != 0 && LINK_BAUD < need) {
+    LOG_WRN("SLCAN link at %u baud drops frames above %u%% bus load",
+            LINK_BAUD,
+            static_cast<uint32_t>(uint64_t{LINK_BAUD} * 100 / need));
+  }
+
+  k_thread_start(slcan_tid);
+  return 0;
+}
+
+void slcan_record_tx(const struct device* dev, const struct can_frame& frame) {
+  if (dev != can_dev || !forwarding.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  /* A looped-back frame reaches the catch-all filters by itself */
+  if ((can_get_mode(dev) & CAN_MODE_LOOPBACK) != 0) {
+    return;
+  }
+  forward(frame);
+}
+
+void slcan_set_format(Slcan::Format format) { link_format.store(format); }
+
+SlcanStatus slcan_status() {
+  k_spinlock_key_t key = k_spin_lock(&tx_lock);
+  SlcanStatus st = status;
+  k_spin_unlock(&tx_lock, key);
+
+  key = k_spin_lock(&rx_lock);
+  st.rx_overruns = rx_overruns;
+  k_spin_unlock(&rx_lock, key);
+
+  st.open = forwarding.load();
+  st.listen_only = listen_only.load();
+  st.timestamps = stamped.load();
+  st.format = link_format.load();
+  return st;
+}
+
+#if defined(CONFIG_SHELL)
+namespace {
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  SlcanStatus st = slcan_status();
+
+  shell_print(sh, "%s: %s%s, %s frames, timestamps %s", uart_dev->name,
+              st.open ? "open" : "closed",
+              st.listen_only ? " (listen-only)" : "", format_name(st.format),
+              st.timestamps ? "on" : "off");
+  shell_print(sh, "to PC: %u frames, %u dropped, %llu bytes, max %u "
+              "buffered of %u",
+              st.forwarded, st.dropped,
+              static_cast<unsigned long long>(st.tx_bytes), st.max_buffered,
+              static_cast<uint32_t>(TX_BUF_SIZE));
+  shell_print(sh, "rate: %u frames/s (peak %u)", st.frames_per_s,
+              st.peak_frames_per_s);
+  shell_print(sh, "from PC: %u commands, %u injected, %u refused, "
+              "%u bytes overrun, %u UART errors",
+              st.commands, st.injected, st.inject_errors, st.rx_overruns,
+              st.uart_errors);
+  shell_print(sh, "full load at %u kbit/s needs %u baud ASCII, %u binary "
+              "(link: %u)",
+              BusBudget::BITRATE / 1000,
+              static_cast<uint32_t>(Slcan::full_rate_baud(
+                  Slcan::Format::Ascii, st.timestamps, BusBudget::BITRATE)),
+              static_cast<uint32_t>(Slcan::full_rate_baud(
+                  Slcan::Format::Binary, true, BusBudget::BITRATE)),
+              LINK_BAUD);
+  return 0;
+}
+
+int cmd_format(const struct shell* sh, size_t argc, char** argv) {
+  if (strcmp(argv[1], "ascii") == 0) {
+    slcan_set_format(Slcan::Format::Ascii);
+  } else if (strcmp(argv[1], "binary") == 0) {
+    slcan_set_format(Slcan::Format::Binary);
+  } else {
+    shell_error(sh, "Usage: slcan format ascii|binary");
+    return -EINVAL;
+  }
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    slcan_cmds,
+    SHELL_CMD(status, NULL, "Channel, frames to/from the PC, rate",
+              cmd_status),
+    SHELL_CMD_ARG(format, NULL, "ascii|binary: frames to the PC", cmd_format,
+                  2, 0),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(slcan, &slcan_cmds, "SLCAN bridge to a PC", NULL);
+#endif /* CONFIG_SHELL */
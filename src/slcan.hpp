@@ -0,0 +1,63 @@
+/*
+ * src/slcan.hpp
+ * SLCAN (Lawicel) bridge to a PC over a second UART
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#include <cstdint>  // uint32_t, uint64_t
+
+#include "core/slcan.hpp"
+
+struct SlcanStatus {
+  bool open;
+  bool listen_only;
+  bool timestamps;
+  Slcan::Format format;
+  uint32_t forwarded;    // Frames queued for the PC
+  uint32_t dropped;      // TX buffer full: the link fell behind
+  uint32_t injected;     // Frames from the PC the controller took
+  uint32_t inject_errors;
+  uint32_t commands;
+  uint32_t rx_overruns;  // Bytes from the PC lost before parsing
+  uint32_t uart_errors;
+  uint64_t tx_bytes;     // Handed to the UART
+  uint32_t frames_per_s;  // Forwarded in the last full second
+  uint32_t peak_frames_per_s;
+  uint32_t max_buffered;  // Bytes waiting for the UART, high watermark
+};
+
+#if defined(CONFIG_APP_SLCAN)
+
+/**
+ * @brief Start the bridge on the simrig,slcan-uart UART for the controller
+ * dev.
+ * * The channel starts closed; a PC tool opens it with "O" (or "L").
+ */
+int slcan_init(const struct device* dev);
+
+/**
+ * @brief Forward a frame this node sent on dev to the PC.
+ * * Received frames reach the bridge through its own catch-all filters;
+ * this covers the node's own frames, which the controller only echoes to
+ * those filters in loopback mode (then this does nothing). Safe from ISR
+ * and driver callbacks: encodes into the TX ring under a spinlock and
+ * never waits for the UART.
+ */
+void slcan_record_tx(const struct device* dev, const struct can_frame& frame);
+
+/**
+ * @brief Format of the frames to the PC; commands stay ASCII.
+ */
+void slcan_set_format(Slcan::Format format);
+
+SlcanStatus slcan_status();
+
+#else
+
+inline int slcan_init(const struct device*) { return 0; }
+inline void slcan_record_tx(const struct device*, const struct can_frame&) {}
+
+#endif /* CONFIG_APP_SLCAN */
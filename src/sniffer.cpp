@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Listen-only sniffer (CONFIG_APP_SNIFFER)
+ *
+ * In listen-only mode two catch-all filters (standard and extended IDs)
+ * hand every frame to the sniffer callback, which counts it and checks
+ * the software ID bitmap (core/sniffer.hpp). Selected frames go to the
+ * black box; nothing else runs per frame, so there is no queue to
+ * overrun however busy the bus is.
+ */
+
+#include "sniffer.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "app_config.hpp"
+#include "blackbox.hpp"
+#include "bus_budget.hpp"
+#include "session_log.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+constexpr struct can_filter CATCH_ALL[] = {
+    {.id = 0, .mask = 0, .flags = 0},
+    {.id = 0, .mask = 0, .flags = CAN_FILTER_IDE},
+};
+
+const struct device* sniff_dev;
+Sniffer sniffer;
+std::atomic<bool> listening{false};
+int filter_ids[ARRAY_SIZE(CATCH_ALL)] = {-1, -1};
+K_MUTEX_DEFINE(mode_lock);
+
+void sniff_rx_callback(const struct device* dev, struct can_frame* frame,
+                       void* user_data) {
+  if (sniffer.on_frame(*frame)) {
+    blackbox_record(*frame, FrameDir::Rx);
+    session_log_record(*frame, FrameDir::Rx);
+  }
+}
+
+void install_catch_all() {
+  for (size_t i = 0; i < ARRAY_SIZE(CATCH_ALL); i++) {
+    if (filter_ids[i] < 0) {
+      filter_ids[i] =
+          can_add_rx_filter(sniff_dev, sniff_rx_callback, NULL, &CATCH_ALL[i]);
+      if (filter_ids[i] < 0) {
+        LOG_ERR("Sniffer filter not added (%d)", filter_ids[i]);
+      }
+    }
+  }
+}
+
+void remove_catch_all() {
+  for (int& id : filter_ids) {
+    if (id >= 0) {
+      can_remove_rx_filter(sniff_dev, id);
+      id = -1;
+    }
+  }
+}
+}  // namespace
+
+void sniffer_init(const struct device* dev) {
+  sniff_dev = dev;
+
+  /* Promiscuous until narrowed with "sniff del" */
+  sniffer.ids().set(0, CAN_STD_ID_MASK);
+  sniffer.accept_extended(true);
+
+  if ((can_get_mode(dev) & CAN_MODE_LISTENONLY) != 0) {
+    install_catch_all();
+    listening.store(true);
+  }
+}
+
+int sniffer_set_mode(can_mode_t mode) {
+  if (sniff_dev == nullptr) {
+    return -ENODEV;
+  }
+
+  k_mutex_lock(&mode_lock, K_FOREVER);
+  can_mode_t old = can_get_mode(sniff_dev);
+
+  /* Quiet the TX paths before the controller goes listen-only */
+  if ((mode & CAN_MODE_LISTENONLY) != 0) {
+    listening.store(true);
+  }
+
+  (void)can_stop(sniff_dev);
+  int ret = can_set_mode(sniff_dev, mode);
+  if (ret != 0) {
+    mode = old;
+    (void)can_set_mode(sniff_dev, old);
+  }
+
+  if ((mode & CAN_MODE_LISTENONLY) != 0) {
+    install_catch_all();
+  } else {
+    remove_catch_all();
+  }
+
+  int start = can_start(sniff_dev);
+  listening.store((mode & CAN_MODE_LISTENONLY) != 0);
+  k_mutex_unlock(&mode_lock);
+
+  if (start != 0) {
+    LOG_ERR("Failed to restart CAN controller: %d", start);
+  }
+  return (ret != 0) ? ret : start;
+}
+
+bool sniffer_listening() { return listening.load(); }
+
+#if defined(CONFIG_SHELL)
+namespace {
+struct ModeName {
+  const char* name;
+  can_mode_t mode;
+};
+
+constexpr ModeName MODES[] = {{"loopback", CAN_MODE_LOOPBACK},
+                              {"normal", CAN_MODE_NORMAL},
+                              {"listen", CAN_MODE_LISTENONLY}};
+
+const char* mode_name(can_mode_t mode) {
+  for (const ModeName& m : MODES) {
+    if (m.mode == mode) {
+      return m.name;
+    }
+  }
+  return "other";
+}
+
+int cmd_mode(const struct shell* sh, size_t argc, char** argv) {
+  if (argc < 2) {
+    shell_print(sh, "%s", sniff_dev ? mode_name(can_get_mode(sniff_dev))
+                                    : "not started");
+    return 0;
+  }
+
+  for (const ModeName& m : MODES) {
+    if (strcmp(argv[1], m.name) == 0) {
+      int ret = sniffer_set_mode(m.mode);
+
+      if (ret != 0) {
+        shell_error(sh, "Mode %s not set (%d)", m.name, ret);
+      }
+      return ret;
+    }
+  }
+  shell_error(sh, "Unknown mode %s (loopback|normal|listen)", argv[1]);
+  return -EINVAL;
+}
+
+int update_ids(const struct shell* sh, size_t argc, char** argv, bool on) {
+  uint32_t first = strtoul(argv[1], NULL, 0);
+  uint32_t last = (argc > 2) ? strtoul(argv[2], NULL, 0) : first;
+
+  if (!sniffer.ids().set(first, last, on)) {
+    shell_error(sh, "IDs 0x000..0x7FF, first <= last");
+    return -EINVAL;
+  }
+  shell_print(sh, "%zu IDs selected", sniffer.ids().count());
+  return 0;
+}
+
+int cmd_add(const struct shell* sh, size_t argc, char** argv) {
+  return update_ids(sh, argc, argv, true);
+}
+
+int cmd_del(const struct shell* sh, size_t argc, char** argv) {
+  return update_ids(sh, argc, argv, false);
+}
+
+int cmd_ext(const struct shell* sh, size_t argc, char** argv) {
+  sniffer.accept_extended(strcmp(argv[1], "on") == 0);
+  return 0;
+}
+
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  /* Rates are over the time since the previous "sniff status" */
+  static uint32_t last_seen, last_accepted, last_bits;
+  static int64_t last_ms = k_uptime_get();
+  const SnifferStats& s = sniffer.stats();
+  uint32_t seen = s.seen.load();
+  uint32_t accepted = s.accepted.load();
+  uint32_t bits = s.bits.load();
+  int64_t now = k_uptime_get();
+  uint64_t window_bits = uint64_t{BusBudget::BITRATE} * (now - last_ms);
+  uint32_t load_permille =
+      (window_bits == 0)
+          ? 0
+          : static_cast<uint32_t>(uint64_t{bits - last_bits} * 1000000 /
+                                  window_bits);
+
+  shell_print(sh, "%s, %zu standard IDs selected, extended %s",
+              listening.load() ? "listening" : "not listening",
+              sniffer.ids().count(),
+              sniffer.extended_accepted() ? "on" : "off");
+  shell_print(sh, "%u frames seen (%u extended), %u captured", seen,
+              s.extended.load(), accepted);
+  shell_print(sh, "last %u ms: %u seen, %u captured, bus load >= %u.%u%%",
+              static_cast<uint32_t>(now - last_ms), seen - last_seen,
+              accepted - last_accepted, load_permille / 10,
+              load_permille % 10);
+
+  last_seen = seen;
+  last_accepted = accepted;
+  last_bits = bits;
+  last_ms = now;
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    sniff_cmds,
+    SHELL_CMD_ARG(mode, NULL, "Show or set mode: loopback|normal|listen",
+                  cmd_mode, 1, 1),
+    SHELL_CMD_ARG(add, NULL, "Capture standard IDs: <id> [<last id>]",
+                  cmd_add, 2, 1),
+    SHELL_CMD_ARG(del, NULL, "Stop capturing IDs: <id> [<last id>]", cmd_del,
+                  2, 1),
+    SHELL_CMD_ARG(ext, NULL, "Capture extended IDs: on|off", cmd_ext, 2, 0),
+    SHELL_CMD(status, NULL, "Filter and traffic counters", cmd_status),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(sniff, &sniff_cmds, "Listen-only sniffer", NULL);
+#endif /* CONFIG_SHELL */
@@ -0,0 +1,38 @@
+/*
+ * src/sniffer.hpp
+ * Runtime controller mode and the listen-only sniffer
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#if defined(CONFIG_APP_SNIFFER)
+
+#include "core/sniffer.hpp"
+
+/**
+ * @brief Start sniffing if the controller came up listen-only.
+ * * Call once SimWheel has configured and started the controller.
+ */
+void sniffer_init(const struct device* dev);
+
+/**
+ * @brief Stop the controller, switch its mode and start it again.
+ * * Entering CAN_MODE_LISTENONLY installs the catch-all filters, leaving it
+ * removes them. Frames on the bus during the switch are missed.
+ * * @return 0, or the error of can_set_mode() (the old mode is restored)
+ */
+int sniffer_set_mode(can_mode_t mode);
+
+/**
+ * @brief Whether the controller is listen-only; nothing may be sent.
+ */
+bool sniffer_listening();
+
+#else
+
+inline void sniffer_init(const struct device*) {}
+inline bool sniffer_listening() { return false; }
+
+#endif /* CONFIG_APP_SNIFFER */
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Runtime RX subscriptions (CONFIG_APP_RX_SUBSCRIPTIONS)
+ *
+ * The shell and the diagnostic command queue requests; the RX thread,
+ * which owns the dispatch table, applies them between two frames. New
+ * controller filters are installed before old ones are removed, so a change
+ * never opens a window in which wanted frames are refused.
+ *
+ * Subscribed frames are only monitored. They have their own callback and
+ * queue, so a busy subscription cannot crowd gear frames out of the RX
+ * queue, and a frame that also matches the gear filter is not processed
+ * twice.
+ */
+
+#include "subscriptions.hpp"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+#include <atomic>
+#include <cstdlib>
+
+#include "app_config.hpp"
+#include "core/spsc_queue.hpp"
+#include "hot_log.hpp"
+#include "rx_handler.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+using Table = SubscriptionTable<CONFIG_APP_RX_SUBSCRIPTIONS_MAX>;
+
+struct Request {
+  struct can_filter filter;
+  bool add;
+};
+
+/* Result of the last applied batch, for "sub status" */
+struct ChangeStats {
+  uint32_t changes;
+  uint32_t last_us;
+  uint32_t last_dropped;  // Subscription queue drops while it was applied
+};
+
+const struct device* sub_dev;
+Table table;  // RX thread only
+Table next;   // Scratch copy, RX thread only
+ChangeStats change_stats;
+K_MSGQ_DEFINE(requests, sizeof(Request), 8, 4);
+
+/* Filled by sub_rx_callback, drained by the RX thread */
+SpscQueue<struct can_frame, Config::SUB_QUEUE_DEPTH> sub_queue;
+std::atomic<uint32_t> sub_dropped{0};
+
+HotPathLog sub_log = make_hot_path_log();
+
+void sub_rx_callback(const struct device* dev, struct can_frame* frame,
+                     void* user_data) {
+  if (!sub_queue.push(*frame)) {
+    sub_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  rx_thread_wake();
+}
+}  // namespace
+
+void subscriptions_init(const struct device* dev) { sub_dev = dev; }
+
+int subscription_request(const struct can_filter& filter, bool add) {
+  Request req = {.filter = filter, .add = add};
+
+  if (k_msgq_put(&requests, &req, K_NO_WAIT) != 0) {
+    return -EAGAIN;
+  }
+  rx_thread_wake();
+  return 0;
+}
+
+void subscriptions_apply() {
+  Request req;
+
+  if (k_msgq_num_used_get(&requests) == 0 || sub_dev == nullptr) {
+    return;
+  }
+
+  uint32_t start = k_cycle_get_32();
+  uint32_t dropped = sub_dropped.load(std::memory_order_relaxed);
+
+  next = table;
+  while (k_msgq_get(&requests, &req, K_NO_WAIT) == 0) {
+    bool ok = req.add ? next.add(req.filter) : next.remove(req.filter);
+
+    if (!ok) {
+      LOG_WRN("Subscription 0x%03x/0x%03x not %s", req.filter.id,
+              req.filter.mask, req.add ? "added (full or present)"
+                                       : "removed (unknown)");
+    }
+  }
+
+  next.swap_from(
+      table,
+      [](const struct can_filter& f) {
+        int id = can_add_rx_filter(sub_dev, &sub_rx_callback, NULL, &f);
+
+        if (id < 0) {
+          LOG_ERR("Subscription 0x%03x: RX filter not added (%d)", f.id, id);
+        }
+        return id;
+      },
+      [](int id) { can_remove_rx_filter(sub_dev, id); });
+  table = next;
+
+  change_stats.changes++;
+  change_stats.last_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+  change_stats.last_dropped =
+      sub_dropped.load(std::memory_order_relaxed) - dropped;
+}
+
+void subscriptions_drain() {
+  struct can_frame frame;
+
+  while (sub_queue.pop(frame)) {
+    int i = table.match(frame);
+
+    if (i < 0) {
+      continue;  // Filter removed while the frame was queued
+    }
+
+    uint32_t now = k_uptime_get_32();
+    table.note(i, now);
+    HOT_LOG_INF(sub_log, now, "[SUB] 0x%03x [%u] %02x %02x %02x %02x ...",
+                frame.id, frame.dlc, frame.data[0], frame.data[1],
+                frame.data[2], frame.data[3]);
+  }
+}
+
+#if defined(CONFIG_SHELL)
+namespace {
+bool parse_filter(const struct shell* sh, size_t argc, char** argv,
+                  struct can_filter& filter) {
+  filter = {.id = static_cast<uint32_t>(strtoul(argv[1], NULL, 0)),
+            .mask = (argc > 2) ? static_cast<uint32_t>(
+                                     strtoul(argv[2], NULL, 0))
+                               : CAN_STD_ID_MASK,
+            .flags = 0};
+
+  if (filter.id > CAN_STD_ID_MASK || filter.mask > CAN_STD_ID_MASK) {
+    shell_error(sh, "Standard IDs and masks only (0x000..0x7FF)");
+    return false;
+  }
+  return true;
+}
+
+int request(const struct shell* sh, size_t argc, char** argv, bool add) {
+  struct can_filter filter;
+
+  if (!parse_filter(sh, argc, argv, filter)) {
+    return -EINVAL;
+  }
+
+  int ret = subscription_request(filter, add);
+  if (ret != 0) {
+    shell_error(sh, "Request not queued (%d)", ret);
+  }
+  return ret;
+}
+
+int cmd_add(const struct shell* sh, size_t argc, char** argv) {
+  return request(sh, argc, argv, true);
+}
+
+int cmd_del(const struct shell* sh, size_t argc, char** argv) {
+  return request(sh, argc, argv, false);
+}
+
+int cmd_list(const struct shell* sh, size_t argc, char** argv) {
+  /* Owned by the RX thread; a torn read only skews the output */
+  for (size_t i = 0; i < table.size(); i++) {
+    const struct can_filter& f = table.filter(i);
+    const SubscriptionStats& s = table.stats(i);
+
+    shell_print(sh, "0x%03x/0x%03x filter %d: %u frames, gap %u..%u ms", f.id,
+                f.mask, table.filter_id(i), s.frames, s.min_gap_ms,
+                s.max_gap_ms);
+  }
+  shell_print(sh, "%zu of %zu subscriptions", table.size(),
+              table.capacity());
+  return 0;
+}
+
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  shell_print(sh, "%u changes, last took %u us with %u frames dropped",
+              change_stats.changes, change_stats.last_us,
+              change_stats.last_dropped);
+  shell_print(sh, "%u frames dropped in total, queue peak %zu of %zu",
+              sub_dropped.load(std::memory_order_relaxed),
+              sub_queue.high_watermark(), Config::SUB_QUEUE_DEPTH);
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    sub_cmds,
+    SHELL_CMD_ARG(add, NULL, "Subscribe: add <id> [<mask>]", cmd_add, 2, 1),
+    SHELL_CMD_ARG(del, NULL, "Unsubscribe: del <id> [<mask>]", cmd_del, 2, 1),
+    SHELL_CMD(list, NULL, "Subscriptions and their frame timing", cmd_list),
+    SHELL_CMD(status, NULL, "Cost and frame loss of the last change",
+              cmd_status),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(sub, &sub_cmds, "Runtime RX subscriptions", NULL);
+#endif /* CONFIG_SHELL */
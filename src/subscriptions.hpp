@@ -0,0 +1,44 @@
+/*
+ * src/subscriptions.hpp
+ * RX subscriptions added and removed at run time
+ */
+
+#pragma once
+
+#include <zephyr/drivers/can.h>
+
+#if defined(CONFIG_APP_RX_SUBSCRIPTIONS)
+
+#include "core/subscriptions.hpp"
+
+void subscriptions_init(const struct device* dev);
+
+/**
+ * @brief Ask the RX thread to subscribe to (or drop) filter.
+ * * Any thread. The RX thread applies queued requests before it drains
+ * the next frames.
+ * * @return 0, or -EAGAIN if too many requests are pending
+ */
+int subscription_request(const struct can_filter& filter, bool add);
+
+/**
+ * @brief Apply pending requests: controller filters make-before-break,
+ * then the dispatch table in one step. RX thread only.
+ */
+void subscriptions_apply();
+
+/**
+ * @brief Count and log the queued subscribed frames. RX thread only.
+ */
+void subscriptions_drain();
+
+#else
+
+inline void subscriptions_init(const struct device*) {}
+inline int subscription_request(const struct can_filter&, bool) {
+  return -ENOTSUP;
+}
+inline void subscriptions_apply() {}
+inline void subscriptions_drain() {}
+
+#endif /* CONFIG_APP_RX_SUBSCRIPTIONS */
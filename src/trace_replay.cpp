@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Trace replay engine (CONFIG_APP_TRACE_REPLAY)
+ *
+ * The trace named by CONFIG_APP_TRACE_REPLAY_FILE is embedded at build
+ * time, so the same image replays the same session on native_sim, QEMU or
+ * a board without a file system.
+ */
+
+#include "trace_replay.hpp"
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+
+#include <cstdlib>
+#include <string_view>
+
+#include "app_config.hpp"
+#include "core/trace_replay.hpp"
+#include "diagnostics.hpp"
+#include "rx_handler.hpp"
+
+LOG_MODULE_DECLARE(sim_racing_node);
+
+namespace {
+const struct device* const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
+
+const char trace_data[] = {
+#include "replay_trace.inc"
+};
+
+atomic_t running;
+ReplayReport last_report;
+uint32_t requested_speed;
+
+K_SEM_DEFINE(start_sem, 0, 1);
+
+uint64_t now_us() { return k_ticks_to_us_floor64(k_uptime_ticks()); }
+
+void inject(struct can_frame& frame) {
+  /*
+   * Same context as a driver callback: with interrupts locked the replay
+   * cannot interleave with a real RX callback, so the RX queue keeps a
+   * single producer.
+   */
+  unsigned int key = irq_lock();
+
+  can_rx_callback(can_dev, &frame, NULL);
+  irq_unlock(key);
+}
+
+void replay_thread_entry(void* arg1, void* arg2, void* arg3) {
+  ReplayReport report;
+
+  while (1) {
+    k_sem_take(&start_sem, K_FOREVER);
+
+    if (trace_replay_run(requested_speed, report) == 0) {
+      LOG_INF("Replay x%u: %u frames in %u ms, %u dropped", report.speed,
+              report.injected, static_cast<uint32_t>(report.elapsed_us / 1000),
+              report.dropped);
+    }
+  }
+}
+}  // namespace
+
+K_THREAD_DEFINE(replay_tid, Config::REPLAY_THREAD_STACK_SIZE,
+                replay_thread_entry, NULL, NULL, NULL,
+                Config::REPLAY_THREAD_PRIORITY, 0, 0);
+
+int trace_replay_run(uint32_t speed, ReplayReport& report) {
+  if (!atomic_cas(&running, 0, 1)) {
+    return -EBUSY;
+  }
+
+  CandumpReader reader(std::string_view(trace_data, sizeof(trace_data)));
+  uint32_t dropped_before = NodeStats::read(node_stats.rx_dropped);
+  uint64_t start = now_us();
+  ReplayPacer pacer(speed, start);
+  CandumpRecord rec;
+
+  report = {};
+  report.speed = speed;
+
+  while (reader.next(rec)) {
+    uint64_t due = pacer.due_us(rec.timestamp_us);
+
+    if (due > now_us()) {
+      k_sleep(K_TIMEOUT_ABS_TICKS(k_us_to_ticks_ceil64(due)));
+    }
+    inject(rec.frame);
+    pacer.note_injected(due, now_us());
+    report.injected++;
+  }
+
+  report.elapsed_us = now_us() - start;
+  report.skipped_lines = reader.skipped();
+  report.dropped = NodeStats::read(node_stats.rx_dropped) - dropped_before;
+  report.trace_span_us = pacer.trace_span_us();
+  report.max_lag_us = pacer.max_lag();
+  last_report = report;
+
+  atomic_clear(&running);
+  return 0;
+}
+
+int trace_replay_start(uint32_t speed) {
+  if (atomic_get(&running) != 0) {
+    return -EBUSY;
+  }
+  requested_speed = speed;
+  k_sem_give(&start_sem);
+  return 0;
+}
+
+ReplayReport trace_replay_last_report() { return last_report; }
+
+#if defined(CONFIG_SHELL)
+namespace {
+int cmd_start(const struct shell* sh, size_t argc, char** argv) {
+  uint32_t speed = 1;
+
+  if (argc > 1) {
+    speed = (std::string_view(argv[1]) == "max")
+                ? REPLAY_MAX_SPEED
+                : static_cast<uint32_t>(strtoul(argv[1], NULL, 0));
+  }
+
+  int ret = trace_replay_start(speed);
+  if (ret != 0) {
+    shell_error(sh, "Replay already running");
+  }
+  return ret;
+}
+
+int cmd_status(const struct shell* sh, size_t argc, char** argv) {
+  ReplayReport r = trace_replay_last_report();
+  uint32_t elapsed_ms = static_cast<uint32_t>(r.elapsed_us / 1000);
+  uint32_t rate = (r.elapsed_us != 0)
+                      ? static_cast<uint32_t>(r.injected * 1000000ULL /
+                                              r.elapsed_us)
+                      : 0;
+
+  shell_print(sh, "running %d, trace %u bytes", atomic_get(&running) != 0,
+              static_cast<uint32_t>(sizeof(trace_data)));
+  shell_print(sh, "last: speed %u, %u frames (%u lines skipped) in %u ms",
+              r.speed, r.injected, r.skipped_lines, elapsed_ms);
+  shell_print(sh, "      %u frames/s, %u dropped, max lag %u us", rate,
+              r.dropped, static_cast<uint32_t>(r.max_lag_us));
+  return 0;
+}
+}  // namespace
+
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    replay_cmds,
+    SHELL_CMD_ARG(start, NULL, "Replay the trace: start [1|2|10|...|max]",
+                  cmd_start, 1, 1),
+    SHELL_CMD(status, NULL, "Throughput and drops of the last replay",
+              cmd_status),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(replay, &replay_cmds, "Trace replay into the RX path",
+                   NULL);
+#endif /* CONFIG_SHELL */
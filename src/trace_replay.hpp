@@ -0,0 +1,43 @@
+/*
+ * src/trace_replay.hpp
+ * Replays a recorded candump session into the RX path
+ * (CONFIG_APP_TRACE_REPLAY)
+ */
+
+#pragma once
+
+#include <cstdint>  // uint32_t, uint64_t
+
+/* Speed factor that injects frames back to back */
+constexpr uint32_t REPLAY_MAX_SPEED = 0;
+
+struct ReplayReport {
+  uint32_t speed;         // 1 = original timing, REPLAY_MAX_SPEED = max
+  uint32_t injected;      // Frames handed to the RX callback
+  uint32_t skipped_lines; // Trace lines that did not parse
+  uint32_t dropped;       // RX queue overflows during the run
+  uint64_t trace_span_us; // Time covered by the trace
+  uint64_t elapsed_us;    // Wall time the replay took
+  uint64_t max_lag_us;    // Worst lateness against the paced schedule
+};
+
+/**
+ * @brief Replay the embedded trace in the calling thread.
+ * * Frames enter through can_rx_callback(), so they take exactly the path
+ * of frames from the driver. Run from a thread with a lower priority than
+ * the RX thread to measure processing rather than queue overflow.
+ * * @param speed Time-compression factor, or REPLAY_MAX_SPEED
+ * @return 0 on success, -EBUSY if a replay is already running
+ */
+int trace_replay_run(uint32_t speed, ReplayReport& report);
+
+/**
+ * @brief Start a replay in the background replay thread.
+ * * @return 0 if started, -EBUSY if a replay is already running
+ */
+int trace_replay_start(uint32_t speed);
+
+/**
+ * @brief Report of the last completed replay (all zero before the first).
+ */
+ReplayReport trace_replay_last_report();
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Cycle benchmarks for the CAN hot paths of the sim racing node.
+ *
+ * Output is one CSV line per benchmark so CI can diff runs:
+ *   BENCH_BEGIN,<board>,<clock_hz>
+ *   BENCH,<name>,<iterations>,<total_cycles>,<avg_cycles>,<min>,<max>
+ *   BENCH_END
+ * min/max are per-sample values, where a sample is BATCH operations for the
+ * pure-logic benchmarks and a single operation for the driver benchmarks.
+ */
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include <cstdint>
+
+#include "core/gear_codec.hpp"
+#include "core/secoc.hpp"
+#include "diagnostics.hpp"
+#include "rx_handler.hpp"
+#include "sim_wheel.hpp"
+
+#if defined(CONFIG_ARCH_POSIX)
+/* native_sim time only advances when the CPU idles, so use the host clock */
+#include <native_rtc.h>
+#endif
+
+namespace {
+
+constexpr uint32_t LOGIC_ITERATIONS = 100000;
+constexpr uint32_t BATCH = 100;
+constexpr uint32_t DRIVER_ITERATIONS = 1000;
+
+const struct device* const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
+
+K_SEM_DEFINE(rx_sem, 0, 1);
+volatile uint64_t rx_stamp;
+
+/**
+ * @brief Timestamp in benchmark cycles.
+ * * Hardware cycles on real targets and QEMU, host nanoseconds on native_sim.
+ */
+inline uint64_t bench_now() {
+#if defined(CONFIG_ARCH_POSIX)
+  uint32_t nsec;
+  uint64_t sec;
+
+  native_rtc_gettime(RTC_CLOCK_REAL, &nsec, &sec);
+  return sec * 1000000000ULL + nsec;
+#elif defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+  return k_cycle_get_64();
+#else
+  return k_cycle_get_32();
+#endif
+}
+
+/* Wrap-safe difference of two bench_now() values */
+inline uint64_t bench_elapsed(uint64_t start, uint64_t stop) {
+#if defined(CONFIG_ARCH_POSIX) || defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+  return stop - start;
+#else
+  return static_cast<uint32_t>(stop - start);
+#endif
+}
+
+inline uint64_t bench_clock_hz() {
+#if defined(CONFIG_ARCH_POSIX)
+  return 1000000000ULL;
+#else
+  return sys_clock_hw_cycles_per_sec();
+#endif
+}
+
+/* Accumulates samples and prints a single result line */
+struct BenchResult {
+  const char* name;
+  uint32_t iterations = 0;
+  uint64_t total = 0;
+  uint64_t min = UINT64_MAX;
+  uint64_t max = 0;
+
+  void add(uint64_t cycles, uint32_t ops) {
+    iterations += ops;
+    total += cycles;
+    uint64_t per_op = cycles / ops;
+    min = (per_op < min) ? per_op : min;
+    max = (per_op > max) ? per_op : max;
+  }
+
+  void print() const {
+    using ull = unsigned long long;
+    ull avg = (iterations != 0) ? total / iterations : 0;
+
+    printk("BENCH,%s,%u,%llu,%llu,%llu,%llu\n", name, iterations, ull(total),
+           avg, ull(min), ull(max));
+  }
+};
+
+void bench_gear_increment() {
+  BenchResult res{"gear_increment"};
+  Gear gear = Gear::N;
+
+  for (uint32_t i = 0; i < LOGIC_ITERATIONS; i += BATCH) {
+    uint64_t start = bench_now();
+    for (uint32_t j = 0; j < BATCH; j++) {
+      ++gear;
+      /* Keep the compiler from folding the loop into a constant */
+      __asm__ volatile("" : "+r"(gear));
+    }
+    res.add(bench_elapsed(start, bench_now()), BATCH);
+  }
+
+  res.print();
+}
+
+void bench_frame_encode() {
+  BenchResult res{"frame_encode"};
+  struct can_frame frame;
+  Gear gear = Gear::First;
+
+  for (uint32_t i = 0; i < LOGIC_ITERATIONS; i += BATCH) {
+    uint64_t start = bench_now();
+    for (uint32_t j = 0; j < BATCH; j++) {
+      encode_gear_frame(gear, frame);
+      __asm__ volatile("" : : "g"(&frame) : "memory");
+    }
+    res.add(bench_elapsed(start, bench_now()), BATCH);
+  }
+
+  res.print();
+}
+
+/* RFC 4493 test key */
+constexpr uint8_t BENCH_KEY[Aes128::KEY_SIZE] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+
+void bench_aes_block() {
+  BenchResult res{"aes128_block"};
+  Aes128 aes(BENCH_KEY);
+  uint8_t block[Aes128::BLOCK_SIZE] = {};
+
+  for (uint32_t i = 0; i < LOGIC_ITERATIONS; i += BATCH) {
+    uint64_t start = bench_now();
+    for (uint32_t j = 0; j < BATCH; j++) {
+      aes.encrypt(block, block);
+      __asm__ volatile("" : : "g"(block) : "memory");
+    }
+    res.add(bench_elapsed(start, bench_now()), BATCH);
+  }
+
+  res.print();
+}
+
+/* Receiver side only: each frame is protected outside the timed region */
+void bench_secoc_verify() {
+  BenchResult res{"secoc_verify"};
+  Cmac cmac(BENCH_KEY);
+  SecOcSender tx;
+  SecOcReceiver rx;
+  struct can_frame frame;
+
+  for (uint32_t i = 0; i < DRIVER_ITERATIONS; i++) {
+    encode_gear_frame(Gear::Fourth, frame);
+    tx.protect(cmac, frame);
+
+    uint64_t start = bench_now();
+    SecOcVerdict verdict = rx.verify(cmac, frame);
+    uint64_t stop = bench_now();
+
+    if (verdict != SecOcVerdict::Ok) {
+      printk("BENCH_ERROR,secoc_verify,%d\n", static_cast<int>(verdict));
+      return;
+    }
+    res.add(bench_elapsed(start, stop), 1);
+  }
+
+  res.print();
+}
+
+void bench_can_send() {
+  BenchResult res{"can_send_loopback"};
+  struct can_frame frame;
+
+  encode_gear_frame(Gear::First, frame);
+
+  for (uint32_t i = 0; i < DRIVER_ITERATIONS; i++) {
+    uint64_t start = bench_now();
+    int ret = can_send(can_dev, &frame, Config::TX_TIMEOUT, NULL, NULL);
+    uint64_t stop = bench_now();
+
+    if (ret != 0) {
+      printk("BENCH_ERROR,can_send,%d\n", ret);
+      return;
+    }
+    res.add(bench_elapsed(start, stop), 1);
+  }
+
+  res.print();
+}
+
+/* Driver callback only: recorders, queue push and RX thread wake-up. The
+ * RX thread drains the queue between samples, so every push succeeds */
+void bench_rx_enqueue() {
+  BenchResult res{"rx_enqueue"};
+  struct can_frame frame;
+  uint32_t dropped = NodeStats::read(node_stats.rx_dropped);
+
+  encode_gear_frame(Gear::Second, frame);
+
+  for (uint32_t i = 0; i < DRIVER_ITERATIONS; i++) {
+    uint64_t start = bench_now();
+    can_rx_callback(can_dev, &frame, NULL);
+    res.add(bench_elapsed(start, bench_now()), 1);
+    k_sleep(K_MSEC(1));
+  }
+
+  if (NodeStats::read(node_stats.rx_dropped) != dropped) {
+    printk("BENCH_ERROR,rx_enqueue,%d\n", -ENOBUFS);
+    return;
+  }
+  res.print();
+}
+
+/* RX thread side: decode, verify and log of one gear frame */
+void bench_rx_process() {
+  BenchResult res{"rx_process"};
+  struct can_frame frame;
+
+  for (uint32_t i = 0; i < DRIVER_ITERATIONS; i++) {
+    encode_gear_frame(Gear::Second, frame);
+
+    uint64_t start = bench_now();
+    rx_process_frame(frame);
+    res.add(bench_elapsed(start, bench_now()), 1);
+  }
+
+  res.print();
+}
+
+void round_trip_rx(const struct device* dev, struct can_frame* frame,
+                   void* user_data) {
+  rx_stamp = bench_now();
+  k_sem_give(&rx_sem);
+}
+
+void bench_round_trip() {
+  BenchResult res{"loopback_round_trip"};
+  struct can_frame frame;
+  struct can_filter filter = {.id = Config::CAN_GEAR_MSG_ID,
+                              .mask = CAN_STD_ID_MASK};
+
+  int filter_id = can_add_rx_filter(can_dev, round_trip_rx, NULL, &filter);
+  if (filter_id < 0) {
+    printk("BENCH_ERROR,can_add_rx_filter,%d\n", filter_id);
+    return;
+  }
+
+  encode_gear_frame(Gear::Third, frame);
+
+  for (uint32_t i = 0; i < DRIVER_ITERATIONS; i++) {
+    uint64_t start = bench_now();
+    int ret = can_send(can_dev, &frame, Config::TX_TIMEOUT, NULL, NULL);
+
+    if (ret == 0) {
+      ret = k_sem_take(&rx_sem, Config::TX_TIMEOUT);  // -EAGAIN: frame lost
+    }
+    if (ret != 0) {
+      printk("BENCH_ERROR,round_trip,%d\n", ret);
+      break;
+    }
+    res.add(bench_elapsed(start, rx_stamp), 1);
+  }
+
+  can_remove_rx_filter(can_dev, filter_id);
+  res.print();
+}
+
+}  // namespace
+
+int main(void) {
+  /* The constructor puts the controller in loopback mode and starts it */
+  SimWheel wheel(can_dev);
+
+  /* Let the log thread drain the init message before measuring */
+  k_sleep(K_MSEC(100));
+
+  printk("BENCH_BEGIN,%s,%llu\n", CONFIG_BOARD,
+         static_cast<unsigned long long>(bench_clock_hz()));
+  bench_gear_increment();
+  bench_frame_encode();
+  bench_aes_block();
+  bench_secoc_verify();
+  bench_can_send();
+  bench_rx_enqueue();
+  bench_rx_process();
+  bench_round_trip();
+  printk("BENCH_END\n");
+
+  return 0;
+}
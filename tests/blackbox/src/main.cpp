@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Black-box recorder tests on the native_sim flash simulator.
+ */
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/ztest.h>
+
+#include <cstdint>
+
+#include "blackbox.hpp"
+
+namespace {
+
+constexpr size_t MAX_CAPTURE = CONFIG_APP_BLACKBOX_RING_SIZE;
+
+struct Capture {
+  TimedFrame frames[MAX_CAPTURE];
+  size_t count;
+};
+
+Capture capture;
+
+void collect(const TimedFrame& frame, void* user_data) {
+  Capture* cap = static_cast<Capture*>(user_data);
+
+  if (cap->count < MAX_CAPTURE) {
+    cap->frames[cap->count] = frame;
+  }
+  cap->count++;
+}
+
+void record_frames(uint32_t first_id, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    struct can_frame frame = {};
+
+    frame.id = first_id + i;
+    frame.dlc = 2;
+    frame.data[0] = i;
+    frame.data[1] = 0xA5;
+    blackbox_record(frame, (i % 2 == 0) ? FrameDir::Tx : FrameDir::Rx);
+  }
+}
+
+/* Trigger and wait for the writer thread to finish the commit */
+void commit(BlackboxTrigger reason) {
+  uint32_t before = blackbox_status().commits;
+
+  blackbox_trigger(reason);
+  for (int i = 0; i < 100; i++) {
+    BlackboxStatus st = blackbox_status();
+
+    if (st.commits > before && !st.frozen) {
+      return;
+    }
+    zassert_equal(st.commit_errors, 0, "Flash commit failed");
+    k_sleep(K_MSEC(10));
+  }
+  ztest_test_fail();
+}
+
+int read_latest(BlackboxHeader& hdr) {
+  capture.count = 0;
+  return blackbox_read_latest(hdr, collect, &capture);
+}
+
+}  // namespace
+
+ZTEST(blackbox, test_snapshot_newest_first) {
+  BlackboxHeader hdr;
+
+  record_frames(0x200, 10);
+  commit(BlackboxTrigger::Manual);
+
+  int ret = read_latest(hdr);
+  zassert_true(ret >= 10, "Expected at least 10 frames, got %d", ret);
+  zassert_equal(capture.count, static_cast<size_t>(ret));
+  zassert_equal(hdr.trigger, static_cast<uint32_t>(BlackboxTrigger::Manual));
+  zassert_equal(hdr.sequence, 0, "First snapshot on a blank area");
+
+  for (uint8_t age = 0; age < 10; age++) {
+    const TimedFrame& f = capture.frames[age];
+    uint8_t index = 9 - age;
+
+    zassert_equal(f.id, 0x200U + index, "Frame %u out of order", age);
+    zassert_equal(f.dlc, 2);
+    zassert_equal(f.data[0], index);
+    zassert_equal(f.data[1], 0xA5);
+    zassert_equal(f.dir, (index % 2 == 0) ? FrameDir::Tx : FrameDir::Rx);
+    if (age > 0) {
+      zassert_true(f.timestamp_us <= capture.frames[age - 1].timestamp_us,
+                   "Timestamps must not increase towards older frames");
+    }
+  }
+}
+
+ZTEST(blackbox, test_slots_rotate) {
+  BlackboxStatus st = blackbox_status();
+  size_t slots = st.slot_count;
+
+  zassert_true(slots >= 2, "Test partition needs at least two slots");
+  zassert_equal(st.next_slot, 0);
+
+  for (size_t i = 0; i < slots + 1; i++) {
+    record_frames(0x300, 1);
+    commit(BlackboxTrigger::DeadlineMissBurst);
+
+    st = blackbox_status();
+    zassert_equal(st.next_slot, (i + 1) % slots);
+    zassert_equal(st.next_sequence, i + 1);
+  }
+
+  BlackboxHeader hdr;
+  zassert_true(read_latest(hdr) > 0);
+  zassert_equal(hdr.sequence, slots, "Latest must win over the wrapped slot");
+}
+
+ZTEST(blackbox, test_remount_finds_latest) {
+  for (int i = 0; i < 3; i++) {
+    record_frames(0x400, 4);
+    commit(BlackboxTrigger::BusOff);
+  }
+
+  BlackboxStatus before = blackbox_status();
+
+  /* Same scan as after a reboot */
+  zassert_ok(blackbox_mount());
+
+  BlackboxStatus after = blackbox_status();
+  zassert_equal(after.next_slot, before.next_slot);
+  zassert_equal(after.next_sequence, before.next_sequence);
+
+  BlackboxHeader hdr;
+  zassert_true(read_latest(hdr) > 0);
+  zassert_equal(hdr.sequence, 2);
+  zassert_equal(hdr.trigger, static_cast<uint32_t>(BlackboxTrigger::BusOff));
+}
+
+ZTEST(blackbox, test_lost_slot_falls_back) {
+  const struct flash_area* fa;
+
+  record_frames(0x500, 4);
+  commit(BlackboxTrigger::DiagnosticRequest);
+  record_frames(0x600, 4);
+  commit(BlackboxTrigger::Manual);
+
+  /* Power lost before the latest header landed: the slot reads as erased */
+  zassert_ok(flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa));
+  zassert_ok(flash_area_erase(fa, CONFIG_APP_BLACKBOX_SLOT_SIZE,
+                              CONFIG_APP_BLACKBOX_SLOT_SIZE));
+  flash_area_close(fa);
+  zassert_ok(blackbox_mount());
+
+  BlackboxHeader hdr;
+  zassert_true(read_latest(hdr) > 0);
+  zassert_equal(hdr.sequence, 0);
+  zassert_equal(hdr.trigger,
+                static_cast<uint32_t>(BlackboxTrigger::DiagnosticRequest));
+  zassert_equal(capture.frames[0].id, 0x503, "Newest frame of snapshot 0");
+  zassert_equal(blackbox_status().next_slot, 1, "Lost slot is reused next");
+}
+
+static void* blackbox_setup(void) {
+  /* The writer thread mounts at boot */
+  for (int i = 0; i < 100 && !blackbox_status().mounted; i++) {
+    k_sleep(K_MSEC(10));
+  }
+  zassert_true(blackbox_status().mounted, "Black box did not mount");
+  return NULL;
+}
+
+static void blackbox_before(void* fixture) {
+  const struct flash_area* fa;
+
+  /* The simulated flash persists between runs, so start each test blank */
+  zassert_ok(flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa));
+  zassert_ok(flash_area_erase(fa, 0, fa->fa_size));
+  flash_area_close(fa);
+  zassert_ok(blackbox_mount());
+}
+
+ZTEST_SUITE(blackbox, NULL, blackbox_setup, blackbox_before, NULL, NULL);
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Fault-injection CAN controller tests: every fault kind by script, bus-off
+ * recovery and reproducible probabilistic faults.
+ */
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <cstdint>
+
+#include "can_fault.hpp"
+
+namespace {
+
+constexpr uint32_t TEST_ID = 0x123;
+constexpr k_timeout_t RX_TIMEOUT = K_MSEC(100);
+
+struct RxRecord {
+  const struct device* dev;
+  struct can_frame frame;
+  int64_t uptime_ms;
+};
+
+const struct device* const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
+
+K_MSGQ_DEFINE(rx_msgq, sizeof(RxRecord), 32, 4);
+K_MSGQ_DEFINE(state_msgq, sizeof(enum can_state), 8, 4);
+K_SEM_DEFINE(tx_done, 0, 8);
+
+void capture_rx(const struct device* dev, struct can_frame* frame,
+                void* user_data) {
+  RxRecord rec = {.dev = dev, .frame = *frame, .uptime_ms = k_uptime_get()};
+
+  (void)k_msgq_put(&rx_msgq, &rec, K_NO_WAIT);
+}
+
+void capture_state(const struct device* dev, enum can_state state,
+                   struct can_bus_err_cnt err_cnt, void* user_data) {
+  (void)k_msgq_put(&state_msgq, &state, K_NO_WAIT);
+}
+
+void capture_tx(const struct device* dev, int error, void* user_data) {
+  k_sem_give(&tx_done);
+}
+
+/* Without a callback, can_send() waits until the frame is done */
+int send_seq(uint8_t seq, can_tx_callback_t callback = NULL) {
+  struct can_frame frame = {};
+
+  frame.id = TEST_ID;
+  frame.dlc = 2;
+  frame.data[0] = seq;
+  frame.data[1] = 0x5A;
+  return can_send(can_dev, &frame, K_MSEC(100), callback, NULL);
+}
+
+uint8_t recv_seq() {
+  RxRecord rec;
+
+  zassert_ok(k_msgq_get(&rx_msgq, &rec, RX_TIMEOUT), "Frame missing");
+  zassert_equal(rec.dev, can_dev, "RX must report the fault controller");
+  return rec.frame.data[0];
+}
+
+void assert_rx_empty() {
+  RxRecord rec;
+
+  zassert_not_equal(k_msgq_get(&rx_msgq, &rec, K_MSEC(20)), 0,
+                    "Unexpected frame");
+}
+
+}  // namespace
+
+ZTEST(can_fault, test_passthrough) {
+  for (uint8_t i = 0; i < 5; i++) {
+    zassert_ok(send_seq(i));
+  }
+  for (uint8_t i = 0; i < 5; i++) {
+    zassert_equal(recv_seq(), i);
+  }
+  assert_rx_empty();
+  zassert_equal(can_fault_stats(can_dev).frames, 5);
+}
+
+ZTEST(can_fault, test_script_drop) {
+  static const FaultStep script[] = {{.frame = 1, .kind = FaultKind::Drop}};
+
+  zassert_ok(can_fault_set_script(can_dev, script, ARRAY_SIZE(script)));
+  for (uint8_t i = 0; i < 3; i++) {
+    zassert_ok(send_seq(i), "A dropped frame still looks sent");
+  }
+
+  zassert_equal(recv_seq(), 0);
+  zassert_equal(recv_seq(), 2);
+  assert_rx_empty();
+  zassert_equal(can_fault_stats(can_dev).injected[static_cast<size_t>(
+                    FaultKind::Drop)],
+                1);
+}
+
+ZTEST(can_fault, test_script_duplicate) {
+  static const FaultStep script[] = {
+      {.frame = 0, .kind = FaultKind::Duplicate}};
+
+  zassert_ok(can_fault_set_script(can_dev, script, ARRAY_SIZE(script)));
+  zassert_ok(send_seq(7));
+
+  zassert_equal(recv_seq(), 7);
+  zassert_equal(recv_seq(), 7);
+  assert_rx_empty();
+}
+
+ZTEST(can_fault, test_script_corrupt) {
+  static const FaultStep script[] = {
+      {.frame = 0, .kind = FaultKind::Corrupt, .arg = 11}};
+  RxRecord rec;
+
+  zassert_ok(can_fault_set_script(can_dev, script, ARRAY_SIZE(script)));
+  zassert_ok(send_seq(1));
+
+  zassert_ok(k_msgq_get(&rx_msgq, &rec, RX_TIMEOUT));
+  zassert_equal(rec.frame.data[0], 1);
+  zassert_equal(rec.frame.data[1], 0x5A ^ BIT(3), "Bit 11 must be flipped");
+}
+
+ZTEST(can_fault, test_script_delay) {
+  static const FaultStep script[] = {
+      {.frame = 0, .kind = FaultKind::Delay, .arg = 50}};
+  RxRecord rec;
+
+  zassert_ok(can_fault_set_script(can_dev, script, ARRAY_SIZE(script)));
+  k_sem_reset(&tx_done);
+  int64_t start = k_uptime_get();
+
+  /* A blocking send would stall for the whole delay */
+  zassert_ok(send_seq(0, capture_tx));
+  zassert_ok(send_seq(1, capture_tx));
+
+  /* The undelayed frame overtakes the delayed one */
+  zassert_equal(recv_seq(), 1);
+  zassert_ok(k_msgq_get(&rx_msgq, &rec, RX_TIMEOUT));
+  zassert_equal(rec.frame.data[0], 0);
+  zassert_true(rec.uptime_ms - start >= 50, "Delivered after %lld ms",
+               rec.uptime_ms - start);
+  zassert_ok(k_sem_take(&tx_done, RX_TIMEOUT));
+  zassert_ok(k_sem_take(&tx_done, RX_TIMEOUT));
+}
+
+ZTEST(can_fault, test_script_mailbox_full) {
+  static const FaultStep script[] = {
+      {.frame = 0, .kind = FaultKind::MailboxFull}};
+
+  zassert_ok(can_fault_set_script(can_dev, script, ARRAY_SIZE(script)));
+  zassert_equal(send_seq(0), -EAGAIN);
+  zassert_ok(send_seq(1), "Only the scripted frame fails");
+
+  zassert_equal(recv_seq(), 1);
+  assert_rx_empty();
+}
+
+ZTEST(can_fault, test_bus_off_and_recovery) {
+  static const FaultStep script[] = {
+      {.frame = 1, .kind = FaultKind::BusOff, .arg = 50}};
+  enum can_state state;
+
+  zassert_ok(can_fault_set_script(can_dev, script, ARRAY_SIZE(script)));
+  zassert_ok(send_seq(0));
+  zassert_equal(send_seq(1), -ENETUNREACH);
+
+  zassert_ok(k_msgq_get(&state_msgq, &state, K_NO_WAIT));
+  zassert_equal(state, CAN_STATE_BUS_OFF);
+  zassert_ok(can_get_state(can_dev, &state, NULL));
+  zassert_equal(state, CAN_STATE_BUS_OFF);
+  zassert_equal(send_seq(2), -ENETUNREACH, "No TX while bus-off");
+
+  zassert_ok(k_msgq_get(&state_msgq, &state, K_MSEC(200)));
+  zassert_equal(state, CAN_STATE_ERROR_ACTIVE);
+  zassert_ok(send_seq(3));
+
+  zassert_equal(recv_seq(), 0);
+  zassert_equal(recv_seq(), 3);
+}
+
+ZTEST(can_fault, test_probability_is_reproducible) {
+  constexpr int FRAMES = 200;
+  uint8_t seen[2][FRAMES / 8] = {};
+  int received[2] = {};
+  RxRecord rec;
+
+  for (int run = 0; run < 2; run++) {
+    zassert_ok(can_fault_reset(can_dev, 42));
+    zassert_ok(can_fault_set_probability(can_dev, FaultKind::Drop, 300));
+
+    for (int i = 0; i < FRAMES; i++) {
+      zassert_ok(send_seq(static_cast<uint8_t>(i)));
+      if (k_msgq_get(&rx_msgq, &rec, K_MSEC(5)) == 0) {
+        seen[run][i / 8] |= BIT(i % 8);
+        received[run]++;
+      }
+    }
+  }
+
+  TC_PRINT("delivered %d of %d with 30%% drop\n", received[0], FRAMES);
+  zassert_mem_equal(seen[0], seen[1], sizeof(seen[0]),
+                    "Same seed must drop the same frames");
+  zassert_within(received[0], FRAMES * 7 / 10, FRAMES / 10);
+}
+
+static void* can_fault_setup(void) {
+  struct can_filter filter = {.id = TEST_ID, .mask = CAN_STD_ID_MASK};
+
+  zassert_true(device_is_ready(can_dev));
+  zassert_ok(can_set_mode(can_dev, CAN_MODE_LOOPBACK));
+  zassert_ok(can_start(can_dev));
+  zassert_true(can_add_rx_filter(can_dev, capture_rx, NULL, &filter) >= 0);
+  can_set_state_change_callback(can_dev, capture_state, NULL);
+  return NULL;
+}
+
+static void can_fault_before(void* fixture) {
+  zassert_ok(can_fault_reset(can_dev, 1));
+  k_msgq_purge(&rx_msgq);
+  k_msgq_purge(&state_msgq);
+}
+
+ZTEST_SUITE(can_fault, NULL, can_fault_setup, can_fault_before, NULL, NULL);
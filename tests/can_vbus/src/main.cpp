@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Virtual CAN bus tests: frame timing, arbitration between nodes, bus
+ * saturation, loopback vs normal vs listen-only mode and TX mailbox
+ * exhaustion.
+ */
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <cstdint>
+
+#include "can_vbus.hpp"
+#include "core/can_timing.hpp"
+
+namespace {
+
+constexpr uint32_t BITRATE = 500000;
+constexpr k_timeout_t RX_TIMEOUT = K_MSEC(100);
+/* One tick plus scheduling jitter on native_sim */
+constexpr int64_t TIMING_SLACK_NS = 30000;
+
+struct RxRecord {
+  const struct device* dev;
+  struct can_frame frame;
+  int64_t ticks;
+};
+
+const struct device* const node0 = DEVICE_DT_GET(DT_NODELABEL(can_vbus0));
+const struct device* const node1 = DEVICE_DT_GET(DT_NODELABEL(can_vbus1));
+const struct device* const node2 = DEVICE_DT_GET(DT_NODELABEL(can_vbus2));
+const struct device* const all_nodes[] = {node0, node1, node2};
+
+K_MSGQ_DEFINE(rx_msgq, sizeof(RxRecord), 64, 4);
+K_SEM_DEFINE(tx_done, 0, 64);
+K_MSGQ_DEFINE(tx_err_msgq, sizeof(int), 8, 4);
+
+void capture_rx(const struct device* dev, struct can_frame* frame,
+                void* user_data) {
+  RxRecord rec = {.dev = dev, .frame = *frame, .ticks = k_uptime_ticks()};
+
+  (void)k_msgq_put(&rx_msgq, &rec, K_NO_WAIT);
+}
+
+void capture_tx(const struct device* dev, int error, void* user_data) {
+  if (error != 0) {
+    (void)k_msgq_put(&tx_err_msgq, &error, K_NO_WAIT);
+  }
+  k_sem_give(&tx_done);
+}
+
+struct can_frame make_frame(uint32_t id, uint8_t dlc, uint8_t fill) {
+  struct can_frame frame = {};
+
+  frame.id = id;
+  frame.dlc = dlc;
+  for (uint8_t i = 0; i < dlc; i++) {
+    frame.data[i] = static_cast<uint8_t>(fill + i);
+  }
+  return frame;
+}
+
+int send_async(const struct device* dev, const struct can_frame& frame) {
+  return can_send(dev, &frame, K_NO_WAIT, capture_tx, NULL);
+}
+
+/* Next frame heard by dev, skipping other nodes' copies */
+RxRecord recv_on(const struct device* dev) {
+  RxRecord rec;
+
+  do {
+    zassert_ok(k_msgq_get(&rx_msgq, &rec, RX_TIMEOUT), "Frame missing");
+  } while (rec.dev != dev);
+  return rec;
+}
+
+/* The test thread is cooperative, so the bus thread only picks up a queued
+ * frame once we wait. One tick is far shorter than any frame time, so the
+ * frame is still on the wire afterwards. */
+void wait_on_wire() { k_sleep(K_TICKS(1)); }
+
+int64_t frame_ns(const struct can_frame& frame) {
+  return static_cast<int64_t>(
+      can_bits_to_ns(can_frame_bits(frame), BITRATE));
+}
+
+}  // namespace
+
+ZTEST(can_vbus, test_frame_time) {
+  struct can_frame frame = make_frame(0x100, 8, 0x10);
+  int64_t start = k_uptime_ticks();
+
+  /* Blocking send returns once the frame has left the bus */
+  zassert_ok(can_send(node1, &frame, K_MSEC(100), NULL, NULL));
+  int64_t elapsed = k_ticks_to_ns_floor64(k_uptime_ticks() - start);
+
+  TC_PRINT("%u bits took %lld ns\n", can_frame_bits(frame), elapsed);
+  zassert_within(elapsed, frame_ns(frame), TIMING_SLACK_NS);
+
+  RxRecord rec = recv_on(node0);
+  zassert_equal(rec.frame.id, 0x100);
+  zassert_mem_equal(rec.frame.data, frame.data, 8);
+}
+
+ZTEST(can_vbus, test_arbitration_order) {
+  uint32_t losses = can_vbus_arbitration_losses(node1);
+
+  /* The blocker occupies the bus while both contenders queue up */
+  zassert_ok(send_async(node1, make_frame(0x700, 8, 0)));
+  wait_on_wire();
+  zassert_ok(send_async(node1, make_frame(0x300, 1, 0)));
+  zassert_ok(send_async(node2, make_frame(0x100, 1, 0)));
+
+  zassert_equal(recv_on(node0).frame.id, 0x700);
+  zassert_equal(recv_on(node0).frame.id, 0x100, "Lowest ID must win");
+  zassert_equal(recv_on(node0).frame.id, 0x300);
+  zassert_true(can_vbus_arbitration_losses(node1) > losses);
+}
+
+ZTEST(can_vbus, test_saturated_throughput) {
+  constexpr int PER_NODE = 10;
+  VirtualBusStats before = can_vbus_stats();
+  int64_t expected = 0;
+  int64_t first = 0;
+  int64_t last = 0;
+
+  for (int i = 0; i < PER_NODE; i++) {
+    struct can_frame a = make_frame(0x200 + i, 8, i);
+    struct can_frame b = make_frame(0x400 + i, 4, i);
+
+    zassert_ok(can_send(node1, &a, K_FOREVER, capture_tx, NULL));
+    zassert_ok(can_send(node2, &b, K_FOREVER, capture_tx, NULL));
+    expected += frame_ns(a) + frame_ns(b);
+  }
+
+  for (int i = 0; i < 2 * PER_NODE; i++) {
+    RxRecord rec = recv_on(node0);
+
+    if (i == 0) {
+      first = rec.ticks;
+    }
+    last = rec.ticks;
+  }
+
+  /* The model's busy time is exact; back-to-back frames leave no gaps */
+  VirtualBusStats after = can_vbus_stats();
+  zassert_equal(after.frames - before.frames, 2 * PER_NODE);
+  zassert_equal(static_cast<int64_t>(after.busy_ns - before.busy_ns),
+                expected);
+
+  /* Wall time from the first to the last delivery spans all but one */
+  int64_t wall = k_ticks_to_ns_floor64(last - first);
+  TC_PRINT("busy %lld ns, wall %lld ns\n", expected, wall);
+  zassert_true(wall < expected, "Frames must not be delivered early");
+  zassert_true(wall > expected / 2, "Bus time not modelled");
+}
+
+ZTEST(can_vbus, test_loopback_vs_normal) {
+  struct can_frame frame = make_frame(0x321, 2, 0);
+  RxRecord rec;
+
+  /* Normal mode: other nodes hear the frame, the sender does not */
+  zassert_ok(can_send(node0, &frame, K_MSEC(100), NULL, NULL));
+  zassert_ok(k_msgq_get(&rx_msgq, &rec, RX_TIMEOUT));
+  zassert_not_equal(rec.dev, node0);
+  zassert_ok(k_msgq_get(&rx_msgq, &rec, RX_TIMEOUT));
+  zassert_not_equal(rec.dev, node0);
+  zassert_not_equal(k_msgq_get(&rx_msgq, &rec, K_MSEC(5)), 0,
+                    "Sender must not hear itself");
+
+  zassert_ok(can_stop(node0));
+  zassert_ok(can_set_mode(node0, CAN_MODE_LOOPBACK));
+  zassert_ok(can_start(node0));
+
+  frame.id = 0x322;
+  zassert_ok(can_send(node0, &frame, K_MSEC(100), NULL, NULL));
+  rec = recv_on(node0);
+  zassert_equal(rec.frame.id, 0x322, "Loopback must hear its own frame");
+}
+
+ZTEST(can_vbus, test_listen_only) {
+  struct can_frame frame = make_frame(0x323, 1, 0);
+
+  zassert_ok(can_stop(node2));
+  zassert_ok(can_set_mode(node2, CAN_MODE_LISTENONLY));
+  zassert_ok(can_start(node2));
+
+  /* Hears the others, cannot transmit itself */
+  zassert_ok(can_send(node0, &frame, K_MSEC(100), NULL, NULL));
+  zassert_equal(recv_on(node2).frame.id, 0x323);
+  zassert_equal(can_send(node2, &frame, K_MSEC(100), NULL, NULL), -EIO);
+}
+
+ZTEST(can_vbus, test_mailbox_full) {
+  int sent = 0;
+  int err;
+
+  /* Nothing goes on the wire before we wait, and a frame on the wire
+   * keeps its mailbox until it is done: every mailbox is taken */
+  for (int i = 0; i < CONFIG_APP_CAN_VBUS_TX_MAILBOXES; i++) {
+    zassert_ok(send_async(node1, make_frame(0x500 + i, 8, 0)));
+    sent++;
+  }
+  zassert_equal(send_async(node1, make_frame(0x5FF, 8, 0)), -EAGAIN);
+  zassert_ok(send_async(node2, make_frame(0x600, 8, 0)),
+             "Other nodes have their own mailboxes");
+  sent++;
+
+  for (int i = 0; i < sent; i++) {
+    zassert_ok(k_sem_take(&tx_done, RX_TIMEOUT));
+  }
+  zassert_ok(send_async(node1, make_frame(0x5FF, 8, 0)));
+  zassert_ok(k_sem_take(&tx_done, RX_TIMEOUT));
+  zassert_not_equal(k_msgq_get(&tx_err_msgq, &err, K_NO_WAIT), 0);
+}
+
+ZTEST(can_vbus, test_stop_aborts_pending) {
+  int err;
+
+  zassert_ok(send_async(node1, make_frame(0x700, 8, 0)));
+  wait_on_wire();
+  zassert_ok(send_async(node1, make_frame(0x701, 8, 0)));
+  zassert_ok(can_stop(node1));
+
+  /* The frame on the wire completes, the queued one is aborted */
+  zassert_ok(k_msgq_get(&tx_err_msgq, &err, RX_TIMEOUT));
+  zassert_equal(err, -ENETDOWN);
+  zassert_ok(k_sem_take(&tx_done, RX_TIMEOUT));
+  zassert_ok(k_sem_take(&tx_done, RX_TIMEOUT));
+  zassert_equal(recv_on(node0).frame.id, 0x700);
+  zassert_equal(send_async(node1, make_frame(0x702, 8, 0)), -ENETDOWN);
+}
+
+static void* can_vbus_setup(void) {
+  struct can_filter filter = {.id = 0, .mask = 0};
+
+  for (const struct device* dev : all_nodes) {
+    zassert_true(device_is_ready(dev));
+    zassert_true(can_add_rx_filter(dev, capture_rx, NULL, &filter) >= 0);
+  }
+  return NULL;
+}
+
+static void can_vbus_before(void* fixture) {
+  for (const struct device* dev : all_nodes) {
+    (void)can_stop(dev);
+    zassert_ok(can_set_mode(dev, CAN_MODE_NORMAL));
+    zassert_ok(can_start(dev));
+  }
+  k_msgq_purge(&rx_msgq);
+  k_msgq_purge(&tx_err_msgq);
+  k_sem_reset(&tx_done);
+}
+
+ZTEST_SUITE(can_vbus, NULL, can_vbus_setup, can_vbus_before, NULL, NULL);
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Redundant gear frames on two loopback controllers: receiver dedup, RX
+ * on both controllers at once, and failover to the second bus when the
+ * primary (behind the fault-injection controller) goes bus-off or stops
+ * taking frames.
+ */
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <cstdint>
+
+#include "can_fault.hpp"
+#include "car_profiles.hpp"
+#include "diagnostics.hpp"
+#include "redundancy.hpp"
+#include "sim_wheel.hpp"
+
+namespace {
+
+constexpr uint32_t SHIFT_PERIOD_MS = 10;
+constexpr uint32_t BUS_OFF_MS = 100;
+constexpr uint32_t FAIL_AFTER = CONFIG_APP_CAN_REDUNDANCY_FAIL_AFTER;
+constexpr uint32_t RECOVER_MS = CONFIG_APP_CAN_REDUNDANCY_RECOVER_MS;
+constexpr size_t MAX_CAPTURE = 256;
+constexpr uint32_t BURST_SHIFTS = 200;
+constexpr uint32_t SHIFTS_PER_DRAIN = Config::RX_QUEUE_DEPTH / 2;
+
+struct Capture {
+  uint8_t alive[MAX_CAPTURE];
+  uint32_t cycles[MAX_CAPTURE];
+  size_t count[2];  // Per bus
+  size_t total;
+};
+
+const struct device* const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
+const struct device* const redundant_dev =
+    DEVICE_DT_GET(DT_CHOSEN(simrig_canbus_redundant));
+
+struct k_spinlock capture_lock;
+Capture capture;
+SimWheel* wheel;
+
+/* Both buses, in arrival order; the alive counter is the last byte */
+void capture_rx(const struct device* dev, struct can_frame* frame,
+                void* user_data) {
+  k_spinlock_key_t key = k_spin_lock(&capture_lock);
+
+  if (capture.total < MAX_CAPTURE) {
+    capture.alive[capture.total] = frame->data[frame->dlc - 1];
+    capture.cycles[capture.total] = k_cycle_get_32();
+    capture.total++;
+  }
+  capture.count[(dev == redundant_dev) ? 1 : 0]++;
+  k_spin_unlock(&capture_lock, key);
+}
+
+void state_changed(const struct device* dev, enum can_state state,
+                   struct can_bus_err_cnt err_cnt, void* user_data) {
+  redundancy_note_state(dev, state);
+}
+
+/* Largest gap between first copies of consecutive counters (us) */
+uint32_t max_rx_gap_us() {
+  uint32_t max_gap = 0;
+  size_t prev = 0;
+
+  for (size_t i = 1; i < capture.total; i++) {
+    if (capture.alive[i] == capture.alive[prev]) {
+      continue;  // The copy from the other bus
+    }
+    uint32_t gap =
+        k_cyc_to_us_floor32(capture.cycles[i] - capture.cycles[prev]);
+
+    max_gap = MAX(max_gap, gap);
+    prev = i;
+  }
+  return max_gap;
+}
+
+void shift_for(uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    zassert_ok(wheel->shift_gear(), "Shift %u not sent", i);
+    k_sleep(K_MSEC(SHIFT_PERIOD_MS));
+  }
+}
+
+/* The RX thread has taken every frame sent so far */
+void settle() { k_sleep(K_MSEC(20)); }
+
+}  // namespace
+
+ZTEST(redundancy, test_copies_on_both_buses_deduplicated) {
+  RedundancyStatus before = redundancy_status();
+
+  shift_for(20);
+  settle();
+
+  RedundancyStatus st = redundancy_status();
+
+  zassert_equal(st.in_service, BIT_MASK(2));
+  zassert_equal(capture.count[0], 20);
+  zassert_equal(capture.count[1], 20);
+  zassert_equal(st.rx_accepted - before.rx_accepted, 20, "One per shift");
+  zassert_equal(st.rx_duplicates - before.rx_duplicates, 20,
+                "The second copy of every shift");
+  zassert_equal(st.rx_lost, before.rx_lost);
+}
+
+/* Back-to-back shifts: each loopback controller delivers from its own
+ * thread, so the two RX callbacks run at the same time. Every copy must
+ * reach the RX thread intact, one per bus.
+ */
+ZTEST(redundancy, test_rx_on_both_buses_at_once) {
+  RedundancyStatus before = redundancy_status();
+  uint32_t frames = NodeStats::read(node_stats.rx_frames);
+  uint32_t dropped = NodeStats::read(node_stats.rx_dropped);
+
+  for (uint32_t i = 0; i < BURST_SHIFTS; i++) {
+    zassert_ok(wheel->shift_gear(), "Shift %u not sent", i);
+    if ((i + 1) % SHIFTS_PER_DRAIN == 0) {
+      k_sleep(K_MSEC(2));  // Let the RX thread drain, no queue overflow
+    }
+  }
+  settle();
+
+  RedundancyStatus st = redundancy_status();
+
+  zassert_equal(NodeStats::read(node_stats.rx_dropped), dropped);
+  zassert_equal(NodeStats::read(node_stats.rx_frames) - frames,
+                2 * BURST_SHIFTS, "Not one copy per bus");
+  zassert_equal(st.rx_accepted - before.rx_accepted, BURST_SHIFTS);
+  zassert_equal(st.rx_duplicates + st.rx_stale - before.rx_duplicates -
+                    before.rx_stale,
+                BURST_SHIFTS, "Second copies not recognised");
+  zassert_equal(st.rx_lost, before.rx_lost, "Corrupted or lost counters");
+}
+
+/* Bus-off on the primary: out of service on the state change, no shift
+ * lost, back once it has been error-active for RECOVER_MS. Prints
+ *   REDUNDANCY,bus_off,<failover us>,<max RX gap us>
+ */
+ZTEST(redundancy, test_bus_off_fails_over) {
+  RedundancyStatus before = redundancy_status();
+
+  shift_for(5);
+  zassert_ok(can_fault_bus_off(can_dev, BUS_OFF_MS));
+
+  RedundancyStatus st = redundancy_status();
+
+  zassert_equal(st.in_service, BIT(1), "Primary still in service");
+  zassert_equal(st.failovers, before.failovers + 1);
+  zassert_equal(st.last_failover_us, 0, "State change acts at once");
+
+  shift_for(20);
+  settle();
+  st = redundancy_status();
+  zassert_equal(st.rx_accepted - before.rx_accepted, 25);
+  zassert_equal(st.rx_lost, before.rx_lost, "Shifts lost in the failover");
+  zassert_equal(st.tx_errors[0], before.tx_errors[0],
+                "Nothing sent on the bus-off controller");
+
+  uint32_t gap_us = max_rx_gap_us();
+  printk("REDUNDANCY,bus_off,%u,%u\n", st.last_failover_us, gap_us);
+  zassert_true(gap_us < 2 * SHIFT_PERIOD_MS * 1000, "RX gap %u us", gap_us);
+
+  k_sleep(K_MSEC(BUS_OFF_MS + RECOVER_MS));
+  shift_for(1);
+  st = redundancy_status();
+  zassert_equal(st.in_service, BIT_MASK(2), "Primary not back");
+  zassert_equal(st.recoveries, before.recoveries + 1);
+}
+
+/* A primary that stops taking frames without changing state leaves
+ * service after FAIL_AFTER errors in a row, one per shift.
+ * Prints REDUNDANCY,tx_errors,<failover us>,<max RX gap us>
+ */
+ZTEST(redundancy, test_tx_errors_fail_over) {
+  RedundancyStatus before = redundancy_status();
+
+  zassert_ok(can_fault_set_probability(can_dev, FaultKind::MailboxFull, 1000));
+  for (uint32_t i = 1; i < FAIL_AFTER; i++) {
+    shift_for(1);
+    zassert_equal(redundancy_status().in_service, BIT_MASK(2),
+                  "Out after %u errors", i);
+  }
+  shift_for(10);
+  settle();
+
+  RedundancyStatus st = redundancy_status();
+
+  zassert_equal(st.in_service, BIT(1));
+  zassert_equal(st.failovers, before.failovers + 1);
+  zassert_equal(st.tx_errors[0] - before.tx_errors[0], FAIL_AFTER,
+                "Sent on the primary after it left service");
+  zassert_equal(st.rx_lost, before.rx_lost);
+
+  uint32_t gap_us = max_rx_gap_us();
+  printk("REDUNDANCY,tx_errors,%u,%u\n", st.last_failover_us, gap_us);
+  zassert_true(st.last_failover_us >=
+               (FAIL_AFTER - 1) * SHIFT_PERIOD_MS * 1000);
+
+  zassert_ok(can_fault_reset(can_dev, 1));
+  k_sleep(K_MSEC(RECOVER_MS));
+  shift_for(1);
+  zassert_equal(redundancy_status().in_service, BIT_MASK(2));
+}
+
+static void* redundancy_setup(void) {
+  /* The controller can only be started once, so share one instance */
+  static SimWheel shared_wheel(can_dev);
+  struct can_filter filter = Config::std_filter(Config::CAN_GEAR_MSG_ID);
+
+  zassert_true(shared_wheel.is_ready(), "SimWheel failed to start");
+  can_set_state_change_callback(can_dev, state_changed, NULL);
+  zassert_ok(redundancy_init(can_dev, state_changed));
+
+  /* The node's own RX path on the primary, as main() sets it up */
+  car_profiles_init(can_dev);
+  zassert_true(can_add_rx_filter(can_dev, capture_rx, NULL, &filter) >= 0);
+  zassert_true(can_add_rx_filter(redundant_dev, capture_rx, NULL, &filter) >=
+               0);
+
+  wheel = &shared_wheel;
+  return NULL;
+}
+
+static void redundancy_before(void* fixture) {
+  k_spinlock_key_t key = k_spin_lock(&capture_lock);
+
+  capture = {};
+  k_spin_unlock(&capture_lock, key);
+  zassert_ok(can_fault_reset(can_dev, 1));
+}
+
+ZTEST_SUITE(redundancy, NULL, redundancy_setup, redundancy_before, NULL,
+            NULL);
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Session logger tests on a FAT-formatted RAM disk of native_sim.
+ */
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "session_log.hpp"
+
+namespace {
+
+constexpr size_t BLOCK_SIZE = CONFIG_APP_SESSION_LOG_BLOCK_SIZE;
+constexpr size_t MAX_CAPTURE = 20000;
+
+struct Capture {
+  uint32_t ids[MAX_CAPTURE];
+  size_t count;
+  size_t blocks;
+  bool ordered;  // Timestamps never went backwards
+  uint64_t last_us;
+};
+
+Capture capture;
+uint8_t block[BLOCK_SIZE] __aligned(4);
+
+void record_frames(uint32_t first, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    struct can_frame frame = {};
+    uint32_t n = first + i;
+
+    frame.id = 0x100 + (n % 0x80);
+    frame.dlc = 8;
+    frame.data[0] = static_cast<uint8_t>(n);
+    frame.data[1] = static_cast<uint8_t>(n >> 8);
+    frame.data[2] = static_cast<uint8_t>(n >> 16);
+    session_log_record(frame, (n % 2 == 0) ? FrameDir::Tx : FrameDir::Rx);
+  }
+}
+
+template <typename F>
+bool wait_for(F&& done) {
+  for (int i = 0; i < 200; i++) {
+    if (done(session_log_status())) {
+      return true;
+    }
+    k_sleep(K_MSEC(10));
+  }
+  return false;
+}
+
+/* Close the current session and open the next one */
+void restart() {
+  uint32_t session = session_log_status().session;
+
+  session_log_stop();
+  zassert_true(wait_for([](const SessionLogStatus& st) { return !st.open; }),
+               "Session not closed");
+  session_log_start();
+  zassert_true(wait_for([&](const SessionLogStatus& st) {
+                 return st.open && st.session == session + 1;
+               }),
+               "Next session not opened");
+}
+
+/* Stop and decode the whole session file */
+SessionLogStatus finish_and_read() {
+  char path[32];
+  struct fs_file_t file;
+
+  session_log_stop();
+  zassert_true(wait_for([](const SessionLogStatus& st) { return !st.open; }),
+               "Session not closed");
+
+  SessionLogStatus st = session_log_status();
+  snprintf(path, sizeof(path), "%s/", CONFIG_APP_SESSION_LOG_MOUNT_POINT);
+  snprintf(&path[strlen(path)], sizeof(path) - strlen(path),
+           SessionLog::FILE_NAME_FORMAT, st.session);
+
+  capture = {.ordered = true};
+  fs_file_t_init(&file);
+  zassert_ok(fs_open(&file, path, FS_O_READ), "No file %s", path);
+
+  while (fs_read(&file, block, sizeof(block)) == sizeof(block)) {
+    int n = SessionLog::decode_block(
+        block, sizeof(block), [](const TimedFrame& f, uint64_t ts_us) {
+          if (capture.count < MAX_CAPTURE) {
+            capture.ids[capture.count] = f.data[0] | (f.data[1] << 8) |
+                                         (f.data[2] << 16);
+          }
+          capture.ordered &= ts_us >= capture.last_us;
+          capture.last_us = ts_us;
+          capture.count++;
+        });
+
+    zassert_true(n > 0, "Block %u does not decode",
+                 static_cast<uint32_t>(capture.blocks));
+    capture.blocks++;
+  }
+  fs_close(&file);
+  return st;
+}
+
+}  // namespace
+
+ZTEST(session_log, test_frames_round_trip) {
+  record_frames(0, 1000);
+  SessionLogStatus st = finish_and_read();
+
+  zassert_equal(st.frames, 1000);
+  zassert_equal(st.dropped, 0);
+  zassert_equal(st.write_errors, 0);
+  zassert_equal(capture.count, 1000);
+  zassert_equal(capture.blocks, st.blocks_written);
+  zassert_true(capture.ordered);
+  for (uint32_t i = 0; i < 1000; i++) {
+    zassert_equal(capture.ids[i], i, "Frame %u out of order", i);
+  }
+}
+
+ZTEST(session_log, test_new_file_per_session) {
+  struct fs_dirent entry;
+  char path[32];
+  uint32_t first = session_log_status().session;
+
+  record_frames(0, 10);
+  restart();
+  record_frames(0, 10);
+  SessionLogStatus st = finish_and_read();
+
+  zassert_equal(st.session, first + 1);
+  zassert_equal(capture.count, 10, "Only this session's frames");
+
+  snprintf(path, sizeof(path), "%s/", CONFIG_APP_SESSION_LOG_MOUNT_POINT);
+  snprintf(&path[strlen(path)], sizeof(path) - strlen(path),
+           SessionLog::FILE_NAME_FORMAT, first);
+  zassert_ok(fs_stat(path, &entry));
+  zassert_equal(entry.size, BLOCK_SIZE, "10 frames fit in one block");
+}
+
+/* A saturated 1 Mbit/s bus (about 8000 frames/s) for two seconds: the
+ * writer keeps up, so nothing is dropped. Prints
+ *   SESSION_LOG,<frames>,<blocks>,<bytes/frame>,<KiB/s>,<max write us>,
+ *   <max sync us>
+ * The RAM disk takes no simulated time, so the timings only mean
+ * something when the test runs on the target with its SD card */
+ZTEST(session_log, test_keeps_up_with_full_bus) {
+  uint32_t n = 0;
+
+  for (int ms = 0; ms < 2000; ms += 2) {
+    record_frames(n, 16);
+    n += 16;
+    k_sleep(K_MSEC(2));
+  }
+  SessionLogStatus st = finish_and_read();
+
+  zassert_equal(st.dropped, 0, "Writer fell behind");
+  zassert_equal(st.write_errors, 0);
+  zassert_equal(capture.count, n);
+  zassert_true(st.syncs > 0, "Periodic syncs");
+
+  uint64_t kib_s = (st.write_us != 0)
+                       ? st.bytes_written * 1000000 / 1024 / st.write_us
+                       : 0;
+  printk("SESSION_LOG,%u,%u,%u,%llu,%u,%u\n", n, st.blocks_written,
+         static_cast<uint32_t>(st.bytes_written / n),
+         static_cast<unsigned long long>(kib_s), st.max_write_us,
+         st.max_sync_us);
+}
+
+static void* session_log_setup(void) {
+  zassert_true(wait_for([](const SessionLogStatus& st) { return st.open; }),
+               "Session log did not start at boot");
+  return NULL;
+}
+
+static void session_log_before(void* fixture) {
+  if (!session_log_status().open) {
+    session_log_start();
+  } else {
+    restart();
+  }
+  zassert_true(wait_for([](const SessionLogStatus& st) { return st.active; }),
+               "Session not active");
+}
+
+ZTEST_SUITE(session_log, NULL, session_log_setup, session_log_before, NULL,
+            NULL);
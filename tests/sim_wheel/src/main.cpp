@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Functional and timing tests for SimWheel on the virtual CAN loopback bus.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/can.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <cstdint>
+
+#include "core/gear_codec.hpp"
+#include "sim_wheel.hpp"
+
+namespace {
+
+/* Shortened shift period so the timing test finishes in about a second */
+constexpr uint32_t TEST_PERIOD_MS = 20;
+constexpr uint32_t TEST_CYCLES = 50;
+/* Allowed deviation of each RX interval from the nominal period */
+constexpr uint32_t PERIOD_TOLERANCE_US = 2000;
+
+struct RxRecord {
+  struct can_frame frame;
+  uint32_t cycles;
+};
+
+const struct device* const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
+
+K_MSGQ_DEFINE(rx_msgq, sizeof(RxRecord), TEST_CYCLES, 4);
+atomic_t rx_overruns;
+int rx_filter_id = -1;
+
+SimWheel* wheel;
+
+void capture_rx(const struct device* dev, struct can_frame* frame,
+                void* user_data) {
+  RxRecord rec = {.frame = *frame, .cycles = k_cycle_get_32()};
+
+  if (k_msgq_put(&rx_msgq, &rec, K_NO_WAIT) != 0) {
+    atomic_inc(&rx_overruns);
+  }
+}
+
+/* A device whose init fails, so device_is_ready() reports false */
+int not_ready_init(const struct device* dev) { return -EIO; }
+
+}  // namespace
+
+DEVICE_DEFINE(not_ready_can, "not_ready_can", not_ready_init, NULL, NULL, NULL,
+              POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);
+
+/* ---------------------------------------------------------------------- */
+/* Gear model                                                             */
+/* ---------------------------------------------------------------------- */
+
+ZTEST(gear, test_increment_sequence) {
+  Gear gear = Gear::N;
+
+  for (uint8_t expected = 1; expected <= 6; expected++) {
+    ++gear;
+    zassert_equal(static_cast<uint8_t>(gear), expected);
+  }
+}
+
+ZTEST(gear, test_sixth_wraps_to_neutral) {
+  Gear gear = Gear::Sixth;
+
+  zassert_equal(++gear, Gear::N, "Sixth must wrap to N");
+  zassert_equal(++gear, Gear::First, "N must advance to First");
+}
+
+ZTEST(gear, test_full_cycle_is_identity) {
+  for (uint8_t start = 0; start <= 6; start++) {
+    Gear gear = static_cast<Gear>(start);
+
+    for (int i = 0; i < 7; i++) {
+      ++gear;
+    }
+    zassert_equal(static_cast<uint8_t>(gear), start);
+  }
+}
+
+ZTEST(gear, test_encode_gear_frame) {
+  struct can_frame frame;
+
+  frame.data[1] = 0xAA;
+  encode_gear_frame(Gear::Fourth, frame);
+
+  zassert_equal(frame.id, Config::CAN_GEAR_MSG_ID);
+  zassert_equal(frame.dlc, Config::CAN_MSG_DLC);
+  zassert_equal(frame.flags, 0, "Gear frame must be a standard data frame");
+  zassert_equal(frame.data[0], 4);
+  zassert_equal(frame.data[1], 0, "Unused payload must be cleared");
+}
+
+ZTEST_SUITE(gear, NULL, NULL, NULL, NULL, NULL);
+
+/* ---------------------------------------------------------------------- */
+/* SimWheel on the loopback driver                                        */
+/* ---------------------------------------------------------------------- */
+
+ZTEST(sim_wheel, test_not_ready_device) {
+  SimWheel broken(DEVICE_GET(not_ready_can));
+
+  zassert_false(broken.is_ready());
+  zassert_equal(broken.shift_gear(), -ENODEV);
+  zassert_equal(broken.gear(), Gear::N, "Gear must not move without a bus");
+}
+
+ZTEST(sim_wheel, test_frame_content_and_order) {
+  RxRecord rec;
+  Gear expected = wheel->gear();
+
+  /* Two full N -> 6 -> N cycles */
+  for (int i = 0; i < 14; i++) {
+    zassert_ok(wheel->shift_gear());
+  }
+
+  for (int i = 0; i < 14; i++) {
+    ++expected;
+    zassert_ok(k_msgq_get(&rx_msgq, &rec, K_MSEC(100)), "RX %d missing", i);
+    zassert_equal(rec.frame.id, Config::CAN_GEAR_MSG_ID);
+    zassert_equal(rec.frame.dlc, Config::CAN_MSG_DLC);
+    zassert_equal(rec.frame.data[0], static_cast<uint8_t>(expected),
+                  "Frame %d out of order", i);
+  }
+
+  zassert_equal(wheel->gear(), expected);
+  zassert_equal(k_msgq_num_used_get(&rx_msgq), 0, "Unexpected extra frames");
+}
+
+ZTEST(sim_wheel, test_period_and_no_missed_rx) {
+  RxRecord rec;
+  uint32_t prev_cycles = 0;
+  uint32_t max_error_us = 0;
+
+  for (uint32_t i = 0; i < TEST_CYCLES; i++) {
+    zassert_ok(wheel->shift_gear());
+    k_sleep(K_MSEC(TEST_PERIOD_MS));
+  }
+
+  zassert_equal(k_msgq_num_used_get(&rx_msgq), TEST_CYCLES,
+                "Missed loopback RX frames");
+  zassert_equal(atomic_get(&rx_overruns), 0);
+
+  for (uint32_t i = 0; i < TEST_CYCLES; i++) {
+    zassert_ok(k_msgq_get(&rx_msgq, &rec, K_NO_WAIT));
+
+    if (i > 0) {
+      uint32_t interval_us = k_cyc_to_us_floor32(rec.cycles - prev_cycles);
+      uint32_t error_us = (interval_us > TEST_PERIOD_MS * 1000U)
+                              ? interval_us - TEST_PERIOD_MS * 1000U
+                              : TEST_PERIOD_MS * 1000U - interval_us;
+
+      max_error_us = MAX(max_error_us, error_us);
+    }
+    prev_cycles = rec.cycles;
+  }
+
+  TC_PRINT("max period error: %u us\n", max_error_us);
+  zassert_true(max_error_us <= PERIOD_TOLERANCE_US,
+               "Period error %u us exceeds %u us", max_error_us,
+               PERIOD_TOLERANCE_US);
+}
+
+static void* sim_wheel_setup(void) {
+  /* The controller can only be started once, so share one instance */
+  static SimWheel shared_wheel(can_dev);
+  struct can_filter filter = {.id = Config::CAN_GEAR_MSG_ID,
+                              .mask = CAN_STD_ID_MASK};
+
+  zassert_true(shared_wheel.is_ready(), "SimWheel failed to start");
+  rx_filter_id = can_add_rx_filter(can_dev, capture_rx, NULL, &filter);
+  zassert_true(rx_filter_id >= 0, "Failed to add RX filter");
+
+  wheel = &shared_wheel;
+  return NULL;
+}
+
+static void sim_wheel_before(void* fixture) {
+  k_msgq_purge(&rx_msgq);
+  atomic_clear(&rx_overruns);
+}
+
+ZTEST_SUITE(sim_wheel, NULL, sim_wheel_setup, sim_wheel_before, NULL, NULL);
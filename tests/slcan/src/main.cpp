@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * SLCAN bridge on an emulated UART, with the test as the PC: the command
+ * sequence slcand sends, frames injected from the PC, and a bus loaded at
+ * the full 500 kbit/s rate forwarded in ASCII and binary without a drop.
+ * Prints SLCAN,<format>,<frames/s>,<link bytes/s>,<max bytes buffered>.
+ */
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <cstdint>
+#include <string_view>
+
+#include "bus_budget.hpp"
+#include "slcan.hpp"
+
+namespace {
+
+constexpr size_t MAX_CAPTURE = 65536;
+constexpr uint32_t LOAD_FRAMES = 2000;
+constexpr uint32_t BURST = 45;  // Frames sent between two pacing sleeps
+constexpr uint32_t INJECT_ID = 0x345;
+
+const struct device* const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
+const struct device* const uart_dev =
+    DEVICE_DT_GET(DT_CHOSEN(simrig_slcan_uart));
+
+/* Everything the node sent to the PC */
+struct k_spinlock pc_lock;
+uint8_t pc_rx[MAX_CAPTURE];
+size_t pc_len;
+
+K_MSGQ_DEFINE(bus_msgq, sizeof(struct can_frame), 8, 4);
+
+/* The PC drains the emulated UART as soon as bytes arrive */
+void pc_read(const struct device* dev, size_t size, void* user_data) {
+  k_spinlock_key_t key = k_spin_lock(&pc_lock);
+
+  pc_len += uart_emul_get_tx_data(dev, &pc_rx[pc_len], MAX_CAPTURE - pc_len);
+  k_spin_unlock(&pc_lock, key);
+}
+
+void pc_write(std::string_view cmds) {
+  uart_emul_put_rx_data(uart_dev,
+                        reinterpret_cast<const uint8_t*>(cmds.data()),
+                        cmds.size());
+}
+
+size_t pc_received() {
+  k_spinlock_key_t key = k_spin_lock(&pc_lock);
+  size_t len = pc_len;
+
+  k_spin_unlock(&pc_lock, key);
+  return len;
+}
+
+void pc_clear() {
+  k_spinlock_key_t key = k_spin_lock(&pc_lock);
+
+  pc_len = 0;
+  k_spin_unlock(&pc_lock, key);
+}
+
+std::string_view pc_text(size_t from) {
+  return std::string_view(reinterpret_cast<const char*>(&pc_rx[from]),
+                          pc_received() - from);
+}
+
+/* The node has sent at least len bytes */
+bool wait_bytes(size_t len) {
+  for (int i = 0; i < 400; i++) {
+    if (pc_received() >= len) {
+      return true;
+    }
+    k_sleep(K_MSEC(5));
+  }
+  return false;
+}
+
+/* Send commands; the node must answer exactly reply and nothing else */
+void expect_reply(std::string_view cmds, std::string_view reply) {
+  size_t start = pc_received();
+
+  pc_write(cmds);
+  zassert_true(wait_bytes(start + reply.size()), "Reply missing");
+  k_sleep(K_MSEC(10));
+  zassert_true(pc_text(start) == reply, "Unexpected reply (%u bytes)",
+               static_cast<uint32_t>(pc_received() - start));
+}
+
+struct can_frame make(uint32_t id, uint8_t dlc, uint8_t flags = 0) {
+  struct can_frame f = {};
+
+  f.id = id;
+  f.dlc = dlc;
+  f.flags = flags;
+  return f;
+}
+
+/* Send frames at the rate of a fully loaded bus and check that the PC
+ * gets every one of them */
+void full_load(Slcan::Format format, const char* name) {
+  uint32_t bus_fps = Slcan::bus_frames_per_s(BusBudget::BITRATE, false, 8);
+  size_t frame_bytes = Slcan::frame_bytes(format, false, false, 8, false);
+  SlcanStatus before;
+
+  slcan_set_format(format);
+  expect_reply("O\r", "\r");
+  pc_clear();
+  before = slcan_status();
+
+  uint64_t start_us = k_ticks_to_us_floor64(k_uptime_ticks());
+  uint32_t start = k_cycle_get_32();
+
+  for (uint32_t i = 0; i < LOAD_FRAMES; i++) {
+    struct can_frame frame = make(0x200 + (i % 16), 8);
+
+    frame.data[0] = static_cast<uint8_t>(i);
+    frame.data[1] = static_cast<uint8_t>(i >> 8);
+    zassert_ok(can_send(can_dev, &frame, K_FOREVER, NULL, NULL));
+    if ((i + 1) % BURST == 0) {
+      k_sleep(K_TIMEOUT_ABS_US(start_us + uint64_t{i + 1} * 1000000 /
+                                              bus_fps));
+    }
+  }
+  zassert_true(wait_bytes(LOAD_FRAMES * frame_bytes), "%u of %u bytes",
+               static_cast<uint32_t>(pc_received()),
+               static_cast<uint32_t>(LOAD_FRAMES * frame_bytes));
+
+  uint32_t elapsed_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+  SlcanStatus st = slcan_status();
+  uint32_t frames = 0;
+
+  /* Every frame arrives whole and in order */
+  if (format == Slcan::Format::Binary) {
+    SlcanBinaryDecoder decoder;
+
+    for (size_t i = 0; i < pc_received(); i++) {
+      struct can_frame f;
+      uint16_t ms;
+
+      if (decoder.feed(pc_rx[i], f, ms)) {
+        zassert_equal(f.data[0], static_cast<uint8_t>(frames));
+        frames++;
+      }
+    }
+    zassert_equal(decoder.errors(), 0);
+  } else {
+    for (char c : pc_text(0)) {
+      frames += (c == '\r') ? 1 : 0;
+    }
+  }
+
+  uint32_t fps = static_cast<uint32_t>(uint64_t{frames} * 1000000 /
+                                       elapsed_us);
+  uint32_t bytes_s = static_cast<uint32_t>(uint64_t{pc_received()} *
+                                           1000000 / elapsed_us);
+
+  printk("SLCAN,%s,%u,%u,%u\n", name, fps, bytes_s, st.max_buffered);
+  zassert_equal(frames, LOAD_FRAMES);
+  zassert_equal(st.dropped, before.dropped, "Frames dropped");
+  zassert_equal(st.forwarded - before.forwarded, LOAD_FRAMES);
+  zassert_true(fps >= bus_fps * 9 / 10, "%u frames/s", fps);
+}
+
+}  // namespace
+
+/* slcand -o -c -s6 sends C, S6 and O */
+ZTEST(slcan, test_open_and_forward) {
+  expect_reply("C\rS6\rV\rN\rO\r", "\r\rV0101\rN0010\r\r");
+  zassert_true(slcan_status().open);
+
+  struct can_frame std_frame = make(0x123, 2);
+  struct can_frame ext_rtr =
+      make(0x1ABCDEF0, 0, CAN_FRAME_IDE | CAN_FRAME_RTR);
+
+  std_frame.data[0] = 0xAA;
+  std_frame.data[1] = 0xBB;
+  pc_clear();
+  zassert_ok(can_send(can_dev, &std_frame, K_FOREVER, NULL, NULL));
+  zassert_ok(can_send(can_dev, &ext_rtr, K_FOREVER, NULL, NULL));
+  zassert_true(wait_bytes(10 + 11));
+  zassert_true(pc_text(0) == "t1232AABB\rR1ABCDEF00\r");
+}
+
+ZTEST(slcan, test_timestamps) {
+  struct can_frame frame = make(0x100, 1);
+
+  expect_reply("Z1\rO\r", "\r\r");
+  pc_clear();
+  zassert_ok(can_send(can_dev, &frame, K_FOREVER, NULL, NULL));
+  zassert_true(wait_bytes(12));
+
+  std::string_view line = pc_text(0);
+  zassert_equal(line.size(), 12);
+  zassert_true(line.substr(0, 5) == "t1001" && line[11] == '\r');
+}
+
+ZTEST(slcan, test_inject) {
+  struct can_frame frame;
+  SlcanStatus before = slcan_status();
+
+  expect_reply("O\r", "\r");
+  pc_clear();
+  pc_write("t3452C0DE\r");
+  zassert_ok(k_msgq_get(&bus_msgq, &frame, K_MSEC(100)), "Not on the bus");
+  zassert_equal(frame.id, INJECT_ID);
+  zassert_equal(frame.dlc, 2);
+  zassert_equal(frame.data[1], 0xDE);
+
+  /* "z" for the send, and the frame itself as the loopback bus echoes it,
+   * in either order */
+  zassert_true(wait_bytes(2 + 10));
+  std::string_view text = pc_text(0);
+  zassert_equal(text.size(), 12);
+  zassert_true(text.find("z\r") != std::string_view::npos &&
+               text.find("t3452C0DE\r") != std::string_view::npos);
+  zassert_equal(slcan_status().injected, before.injected + 1);
+
+  /* Listen-only: nothing goes on the bus */
+  expect_reply("C\rL\rt3451AA\r", "\r\r\a");
+  zassert_equal(k_msgq_get(&bus_msgq, &frame, K_MSEC(20)), -EAGAIN);
+}
+
+ZTEST(slcan, test_refuses_like_an_adapter) {
+  /* Closed: no frames, no status; the bitrate is the node's */
+  expect_reply("t1000\rF\rS8\rX\r", "\a\a\a\a");
+  expect_reply("O\rO\rS6\rZ1\r", "\r\a\a\a");
+  expect_reply("F\r", "F00\r");
+}
+
+ZTEST(slcan, test_full_bus_rate_ascii) {
+  full_load(Slcan::Format::Ascii, "ascii");
+}
+
+ZTEST(slcan, test_full_bus_rate_binary) {
+  full_load(Slcan::Format::Binary, "binary");
+}
+
+static void* slcan_setup(void) {
+  struct can_filter filter = {
+      .id = INJECT_ID, .mask = CAN_STD_ID_MASK, .flags = 0};
+
+  zassert_ok(can_set_mode(can_dev, CAN_MODE_LOOPBACK));
+  zassert_ok(can_start(can_dev));
+  uart_emul_callback_tx_data_ready_set(uart_dev, pc_read, NULL);
+  zassert_ok(slcan_init(can_dev));
+  zassert_true(can_add_rx_filter_msgq(can_dev, &bus_msgq, &filter) >= 0);
+  return NULL;
+}
+
+/* Every test starts from a closed channel, ASCII without timestamps */
+static void slcan_before(void* fixture) {
+  size_t start = pc_received();
+
+  slcan_set_format(Slcan::Format::Ascii);
+  pc_write("C\rZ0\r");
+  zassert_true(wait_bytes(start + 2));
+  k_sleep(K_MSEC(10));
+  pc_clear();
+  k_msgq_purge(&bus_msgq);
+}
+
+ZTEST_SUITE(slcan, NULL, slcan_setup, slcan_before, NULL, NULL);
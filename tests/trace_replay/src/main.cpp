@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Chanwoo Lee
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Trace replay tests: pacing modes and RX path accounting.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <cstdint>
+
+#include "diagnostics.hpp"
+#include "trace_replay.hpp"
+
+namespace {
+
+/* tests/trace_replay/traces/burst.log */
+constexpr uint32_t TRACE_FRAMES = 200;
+constexpr uint32_t TRACE_BAD_LINES = 2;
+constexpr uint64_t TRACE_SPAN_US = 995000;
+
+/* Allowed lateness of the whole run and of any single frame */
+constexpr uint64_t RUN_TOLERANCE_US = 20000;
+constexpr uint64_t LAG_TOLERANCE_US = 2000;
+
+void check_paced_run(uint32_t speed) {
+  ReplayReport r;
+  uint64_t expected_us = TRACE_SPAN_US / speed;
+
+  zassert_ok(trace_replay_run(speed, r));
+  TC_PRINT("x%u: %u frames in %u us, max lag %u us\n", speed, r.injected,
+           static_cast<uint32_t>(r.elapsed_us),
+           static_cast<uint32_t>(r.max_lag_us));
+
+  zassert_equal(r.injected, TRACE_FRAMES);
+  zassert_equal(r.dropped, 0);
+  zassert_true(r.elapsed_us + 1000 >= expected_us, "Replay ran too fast");
+  zassert_true(r.elapsed_us <= expected_us + RUN_TOLERANCE_US,
+               "Replay took %u us, expected %u us",
+               static_cast<uint32_t>(r.elapsed_us),
+               static_cast<uint32_t>(expected_us));
+  zassert_true(r.max_lag_us <= LAG_TOLERANCE_US, "Frame injected %u us late",
+               static_cast<uint32_t>(r.max_lag_us));
+}
+
+}  // namespace
+
+ZTEST(trace_replay, test_max_speed) {
+  ReplayReport r;
+  uint32_t rx_before = NodeStats::read(node_stats.rx_frames);
+
+  zassert_ok(trace_replay_run(REPLAY_MAX_SPEED, r));
+  TC_PRINT("max: %u frames in %u us\n", r.injected,
+           static_cast<uint32_t>(r.elapsed_us));
+
+  zassert_equal(r.speed, REPLAY_MAX_SPEED);
+  zassert_equal(r.injected, TRACE_FRAMES);
+  zassert_equal(r.skipped_lines, TRACE_BAD_LINES);
+  zassert_equal(r.trace_span_us, TRACE_SPAN_US);
+  zassert_equal(r.dropped, 0, "RX thread must keep up at its priority");
+  zassert_equal(NodeStats::read(node_stats.rx_frames) - rx_before,
+                TRACE_FRAMES, "Every frame must reach the RX queue");
+  zassert_true(r.elapsed_us < TRACE_SPAN_US / 10,
+               "Max speed must beat 10x pacing");
+}
+
+ZTEST(trace_replay, test_ten_times) { check_paced_run(10); }
+
+ZTEST(trace_replay, test_two_times) { check_paced_run(2); }
+
+ZTEST(trace_replay, test_original_timing) { check_paced_run(1); }
+
+ZTEST(trace_replay, test_last_report) {
+  ReplayReport r;
+
+  zassert_ok(trace_replay_run(10, r));
+
+  ReplayReport last = trace_replay_last_report();
+  zassert_equal(last.speed, 10);
+  zassert_equal(last.injected, r.injected);
+  zassert_equal(last.elapsed_us, r.elapsed_us);
+}
+
+ZTEST_SUITE(trace_replay, NULL, NULL, NULL, NULL, NULL);